@@ -0,0 +1,105 @@
+# GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+# This file is part of GNSS-SDR.
+#
+# SPDX-FileCopyrightText: 2011-2022 C. Fernandez-Prades cfernandez(at)cttc.es
+# SPDX-License-Identifier: BSD-3-Clause
+
+# - Find the single-precision FFTW3 library
+# https://www.fftw.org/
+#
+#  FFTW3F_INCLUDE_DIRS - where to find fftw3.h
+#  FFTW3F_LIBRARIES    - List of libraries when using fftw3f.
+#  FFTW3F_FOUND        - True if fftw3f found.
+#
+# Provides the following imported target:
+# Fftw3f::fftw3f
+#
+
+if(NOT COMMAND feature_summary)
+    include(FeatureSummary)
+endif()
+
+if(NOT PKG_CONFIG_FOUND)
+    include(FindPkgConfig)
+endif()
+
+pkg_check_modules(PC_FFTW3F fftw3f QUIET)
+
+if(NOT FFTW3F_ROOT)
+    set(FFTW3F_ROOT_USER_PROVIDED /usr)
+else()
+    set(FFTW3F_ROOT_USER_PROVIDED ${FFTW3F_ROOT})
+endif()
+if(DEFINED ENV{FFTW3F_ROOT})
+    set(FFTW3F_ROOT_USER_PROVIDED
+        ${FFTW3F_ROOT_USER_PROVIDED}
+        $ENV{FFTW3F_ROOT}
+    )
+endif()
+
+find_path(FFTW3F_INCLUDE_DIR
+    NAMES
+        fftw3.h
+    HINTS
+        ${PC_FFTW3F_INCLUDEDIR}
+    PATHS
+        ${FFTW3F_ROOT_USER_PROVIDED}/include
+        /usr/include
+        /usr/local/include
+        /opt/local/include
+)
+
+find_library(FFTW3F_LIBRARY
+    NAMES
+        fftw3f
+        libfftw3f-3
+    HINTS
+        ${PC_FFTW3F_LIBDIR}
+    PATHS
+        ${FFTW3F_ROOT_USER_PROVIDED}/lib
+        ${FFTW3F_ROOT_USER_PROVIDED}/lib64
+        /usr/lib
+        /usr/lib64
+        /usr/lib/x86_64-linux-gnu
+        /usr/lib/aarch64-linux-gnu
+        /usr/lib/arm-linux-gnueabihf
+        /usr/local/lib
+        /usr/local/lib64
+        /opt/local/lib
+)
+
+set(FFTW3F_INCLUDE_DIRS ${FFTW3F_INCLUDE_DIR})
+set(FFTW3F_LIBRARIES ${FFTW3F_LIBRARY})
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW3F DEFAULT_MSG FFTW3F_INCLUDE_DIRS FFTW3F_LIBRARIES)
+
+if(FFTW3F_FOUND AND PC_FFTW3F_VERSION)
+    set(FFTW3F_VERSION ${PC_FFTW3F_VERSION})
+endif()
+
+set_package_properties(FFTW3F PROPERTIES
+    URL "https://www.fftw.org"
+)
+
+if(FFTW3F_FOUND AND FFTW3F_VERSION)
+    set_package_properties(FFTW3F PROPERTIES
+        DESCRIPTION "C library for computing the discrete Fourier transform (found: v${FFTW3F_VERSION})"
+    )
+else()
+    set_package_properties(FFTW3F PROPERTIES
+        DESCRIPTION "C library for computing the discrete Fourier transform"
+    )
+endif()
+
+if(FFTW3F_FOUND AND NOT TARGET Fftw3f::fftw3f)
+    add_library(Fftw3f::fftw3f SHARED IMPORTED)
+    set_target_properties(Fftw3f::fftw3f PROPERTIES
+        IMPORTED_LINK_INTERFACE_LANGUAGES "C"
+        IMPORTED_LOCATION "${FFTW3F_LIBRARIES}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW3F_INCLUDE_DIRS}"
+        INTERFACE_LINK_LIBRARIES "${FFTW3F_LIBRARIES}"
+    )
+endif()
+
+mark_as_advanced(FFTW3F_LIBRARIES FFTW3F_INCLUDE_DIRS)
@@ -918,25 +918,25 @@ void Rtklib_Pvt::clear_ephemeris()
 }
 
 
-std::map<int, Gps_Ephemeris> Rtklib_Pvt::get_gps_ephemeris() const
+std::shared_ptr<const std::map<int, Gps_Ephemeris>> Rtklib_Pvt::get_gps_ephemeris() const
 {
     return pvt_->get_gps_ephemeris_map();
 }
 
 
-std::map<int, Galileo_Ephemeris> Rtklib_Pvt::get_galileo_ephemeris() const
+std::shared_ptr<const std::map<int, Galileo_Ephemeris>> Rtklib_Pvt::get_galileo_ephemeris() const
 {
     return pvt_->get_galileo_ephemeris_map();
 }
 
 
-std::map<int, Gps_Almanac> Rtklib_Pvt::get_gps_almanac() const
+std::shared_ptr<const std::map<int, Gps_Almanac>> Rtklib_Pvt::get_gps_almanac() const
 {
     return pvt_->get_gps_almanac_map();
 }
 
 
-std::map<int, Galileo_Almanac> Rtklib_Pvt::get_galileo_almanac() const
+std::shared_ptr<const std::map<int, Galileo_Almanac>> Rtklib_Pvt::get_galileo_almanac() const
 {
     return pvt_->get_galileo_almanac_map();
 }
@@ -27,6 +27,7 @@
 #include <cstddef>                   // for size_t
 #include <ctime>                     // for time_t
 #include <map>                       // for map
+#include <memory>                    // for shared_ptr
 #include <string>                    // for string
 
 /** \addtogroup PVT
@@ -192,10 +193,10 @@ public:
     }
 
     void clear_ephemeris() override;
-    std::map<int, Gps_Ephemeris> get_gps_ephemeris() const override;
-    std::map<int, Galileo_Ephemeris> get_galileo_ephemeris() const override;
-    std::map<int, Gps_Almanac> get_gps_almanac() const override;
-    std::map<int, Galileo_Almanac> get_galileo_almanac() const override;
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris() const override;
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris() const override;
+    std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac() const override;
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac() const override;
 
     void connect(gr::top_block_sptr top_block) override;
     void disconnect(gr::top_block_sptr top_block) override;
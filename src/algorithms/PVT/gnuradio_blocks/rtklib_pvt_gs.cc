@@ -1199,11 +1199,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gps_nav(d_type_of_rx, new_eph);
                                 }
                         }
-                    d_internal_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                    d_internal_pvt_solver->store_ephemeris(*gps_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->gps_ephemeris_map[gps_eph->PRN] = *gps_eph;
+                            d_user_pvt_solver->store_ephemeris(*gps_eph);
                         }
+                    d_gps_ephemeris_snapshot.publish(d_internal_pvt_solver->gps_ephemeris_map);
                     if (gps_eph->SV_health != 0)
                         {
                             std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("GPS"), gps_eph->PRN)
@@ -1259,10 +1260,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gps_cnav(d_type_of_rx, new_cnav_eph);
                                 }
                         }
-                    d_internal_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                    d_internal_pvt_solver->store_ephemeris(*gps_cnav_ephemeris);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->gps_cnav_ephemeris_map[gps_cnav_ephemeris->PRN] = *gps_cnav_ephemeris;
+                            d_user_pvt_solver->store_ephemeris(*gps_cnav_ephemeris);
                         }
                     if (gps_cnav_ephemeris->signal_health != 0)
                         {
@@ -1303,6 +1304,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                         {
                             d_user_pvt_solver->gps_almanac_map[gps_almanac->PRN] = *gps_almanac;
                         }
+                    d_gps_almanac_snapshot.publish(d_internal_pvt_solver->gps_almanac_map);
                     DLOG(INFO) << "New GPS almanac record has arrived";
                 }
 
@@ -1344,11 +1346,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_gal_nav(d_type_of_rx, new_gal_eph);
                                 }
                         }
-                    d_internal_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                    d_internal_pvt_solver->store_ephemeris(*galileo_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->galileo_ephemeris_map[galileo_eph->PRN] = *galileo_eph;
+                            d_user_pvt_solver->store_ephemeris(*galileo_eph);
                         }
+                    d_galileo_ephemeris_snapshot.publish(d_internal_pvt_solver->galileo_ephemeris_map);
                     if (((galileo_eph->E1B_HS != 0) || (galileo_eph->E1B_DVS == true)) ||
                         ((galileo_eph->E5a_HS != 0) || (galileo_eph->E5a_DVS == true)) ||
                         ((galileo_eph->E5b_HS != 0) || (galileo_eph->E5b_DVS == true)))
@@ -1411,6 +1414,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_user_pvt_solver->galileo_almanac_map[sv3.PRN] = sv3;
                                 }
                         }
+                    d_galileo_almanac_snapshot.publish(d_internal_pvt_solver->galileo_almanac_map);
                     DLOG(INFO) << "New Galileo Almanac data have arrived";
                 }
             else if (msg_type_hash_code == d_galileo_almanac_sptr_type_hash_code)
@@ -1423,6 +1427,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                         {
                             d_user_pvt_solver->galileo_almanac_map[galileo_alm->PRN] = *galileo_alm;
                         }
+                    d_galileo_almanac_snapshot.publish(d_internal_pvt_solver->galileo_almanac_map);
                 }
 
             // **************** GLONASS GNAV Telemetry *************************
@@ -1459,10 +1464,10 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_glo_gnav(d_type_of_rx, new_glo_eph);
                                 }
                         }
-                    d_internal_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                    d_internal_pvt_solver->store_ephemeris(*glonass_gnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->glonass_gnav_ephemeris_map[glonass_gnav_eph->PRN] = *glonass_gnav_eph;
+                            d_user_pvt_solver->store_ephemeris(*glonass_gnav_eph);
                         }
                 }
             else if (msg_type_hash_code == d_glonass_gnav_utc_model_sptr_type_hash_code)
@@ -1522,11 +1527,12 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                                     d_rp->log_rinex_nav_bds_dnav(d_type_of_rx, new_bds_eph);
                                 }
                         }
-                    d_internal_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                    d_internal_pvt_solver->store_ephemeris(*bds_dnav_eph);
                     if (d_enable_rx_clock_correction == true)
                         {
-                            d_user_pvt_solver->beidou_dnav_ephemeris_map[bds_dnav_eph->PRN] = *bds_dnav_eph;
+                            d_user_pvt_solver->store_ephemeris(*bds_dnav_eph);
                         }
+                    d_beidou_dnav_ephemeris_snapshot.publish(d_internal_pvt_solver->beidou_dnav_ephemeris_map);
                     if (bds_dnav_eph->SV_health != 0)
                         {
                             std::cout << TEXT_RED << "Satellite " << Gnss_Satellite(std::string("Beidou"), bds_dnav_eph->PRN)
@@ -1564,6 +1570,7 @@ void rtklib_pvt_gs::msg_handler_telemetry(const pmt::pmt_t& msg)
                         {
                             d_user_pvt_solver->beidou_dnav_almanac_map[bds_dnav_almanac->PRN] = *bds_dnav_almanac;
                         }
+                    d_beidou_dnav_almanac_snapshot.publish(d_internal_pvt_solver->beidou_dnav_almanac_map);
                     DLOG(INFO) << "New BeiDou DNAV almanac record has arrived";
                 }
             else
@@ -1603,39 +1610,39 @@ void rtklib_pvt_gs::msg_handler_has_data(const pmt::pmt_t& msg) const
 }
 
 
-std::map<int, Gps_Ephemeris> rtklib_pvt_gs::get_gps_ephemeris_map() const
+std::shared_ptr<const std::map<int, Gps_Ephemeris>> rtklib_pvt_gs::get_gps_ephemeris_map() const
 {
-    return d_internal_pvt_solver->gps_ephemeris_map;
+    return d_gps_ephemeris_snapshot.load();
 }
 
 
-std::map<int, Gps_Almanac> rtklib_pvt_gs::get_gps_almanac_map() const
+std::shared_ptr<const std::map<int, Gps_Almanac>> rtklib_pvt_gs::get_gps_almanac_map() const
 {
-    return d_internal_pvt_solver->gps_almanac_map;
+    return d_gps_almanac_snapshot.load();
 }
 
 
-std::map<int, Galileo_Ephemeris> rtklib_pvt_gs::get_galileo_ephemeris_map() const
+std::shared_ptr<const std::map<int, Galileo_Ephemeris>> rtklib_pvt_gs::get_galileo_ephemeris_map() const
 {
-    return d_internal_pvt_solver->galileo_ephemeris_map;
+    return d_galileo_ephemeris_snapshot.load();
 }
 
 
-std::map<int, Galileo_Almanac> rtklib_pvt_gs::get_galileo_almanac_map() const
+std::shared_ptr<const std::map<int, Galileo_Almanac>> rtklib_pvt_gs::get_galileo_almanac_map() const
 {
-    return d_internal_pvt_solver->galileo_almanac_map;
+    return d_galileo_almanac_snapshot.load();
 }
 
 
-std::map<int, Beidou_Dnav_Ephemeris> rtklib_pvt_gs::get_beidou_dnav_ephemeris_map() const
+std::shared_ptr<const std::map<int, Beidou_Dnav_Ephemeris>> rtklib_pvt_gs::get_beidou_dnav_ephemeris_map() const
 {
-    return d_internal_pvt_solver->beidou_dnav_ephemeris_map;
+    return d_beidou_dnav_ephemeris_snapshot.load();
 }
 
 
-std::map<int, Beidou_Dnav_Almanac> rtklib_pvt_gs::get_beidou_dnav_almanac_map() const
+std::shared_ptr<const std::map<int, Beidou_Dnav_Almanac>> rtklib_pvt_gs::get_beidou_dnav_almanac_map() const
 {
-    return d_internal_pvt_solver->beidou_dnav_almanac_map;
+    return d_beidou_dnav_almanac_snapshot.load();
 }
 
 
@@ -1656,6 +1663,12 @@ void rtklib_pvt_gs::clear_ephemeris()
             d_user_pvt_solver->beidou_dnav_ephemeris_map.clear();
             d_user_pvt_solver->beidou_dnav_almanac_map.clear();
         }
+    d_gps_ephemeris_snapshot.publish(d_internal_pvt_solver->gps_ephemeris_map);
+    d_gps_almanac_snapshot.publish(d_internal_pvt_solver->gps_almanac_map);
+    d_galileo_ephemeris_snapshot.publish(d_internal_pvt_solver->galileo_ephemeris_map);
+    d_galileo_almanac_snapshot.publish(d_internal_pvt_solver->galileo_almanac_map);
+    d_beidou_dnav_ephemeris_snapshot.publish(d_internal_pvt_solver->beidou_dnav_ephemeris_map);
+    d_beidou_dnav_almanac_snapshot.publish(d_internal_pvt_solver->beidou_dnav_almanac_map);
 }
 
 
@@ -20,6 +20,7 @@
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
 #include "gnss_time.h"
+#include "rcu_snapshot.h"
 #include "rtklib.h"
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
@@ -80,34 +81,40 @@ public:
     ~rtklib_pvt_gs();  //!< Default destructor
 
     /*!
-     * \brief Get latest set of GPS ephemeris from PVT block
+     * \brief Get latest set of GPS ephemeris from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Gps_Ephemeris> get_gps_ephemeris_map() const;
+    std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris_map() const;
 
     /*!
-     * \brief Get latest set of GPS almanac from PVT block
+     * \brief Get latest set of GPS almanac from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Gps_Almanac> get_gps_almanac_map() const;
+    std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac_map() const;
 
     /*!
-     * \brief Get latest set of Galileo ephemeris from PVT block
+     * \brief Get latest set of Galileo ephemeris from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Galileo_Ephemeris> get_galileo_ephemeris_map() const;
+    std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris_map() const;
 
     /*!
-     * \brief Get latest set of Galileo almanac from PVT block
+     * \brief Get latest set of Galileo almanac from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Galileo_Almanac> get_galileo_almanac_map() const;
+    std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac_map() const;
 
     /*!
-     * \brief Get latest set of BeiDou DNAV ephemeris from PVT block
+     * \brief Get latest set of BeiDou DNAV ephemeris from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Beidou_Dnav_Ephemeris> get_beidou_dnav_ephemeris_map() const;
+    std::shared_ptr<const std::map<int, Beidou_Dnav_Ephemeris>> get_beidou_dnav_ephemeris_map() const;
 
     /*!
-     * \brief Get latest set of BeiDou DNAV almanac from PVT block
+     * \brief Get latest set of BeiDou DNAV almanac from PVT block.
+     * The returned snapshot is immutable and can be kept by the caller.
      */
-    std::map<int, Beidou_Dnav_Almanac> get_beidou_dnav_almanac_map() const;
+    std::shared_ptr<const std::map<int, Beidou_Dnav_Almanac>> get_beidou_dnav_almanac_map() const;
 
     /*!
      * \brief Clear all ephemeris information and the almanacs for GPS and Galileo
@@ -173,6 +180,14 @@ private:
     std::shared_ptr<Rtklib_Solver> d_internal_pvt_solver;
     std::shared_ptr<Rtklib_Solver> d_user_pvt_solver;
 
+    // Navigation data published for readers outside the PVT thread
+    Rcu_Snapshot<std::map<int, Gps_Ephemeris>> d_gps_ephemeris_snapshot;
+    Rcu_Snapshot<std::map<int, Gps_Almanac>> d_gps_almanac_snapshot;
+    Rcu_Snapshot<std::map<int, Galileo_Ephemeris>> d_galileo_ephemeris_snapshot;
+    Rcu_Snapshot<std::map<int, Galileo_Almanac>> d_galileo_almanac_snapshot;
+    Rcu_Snapshot<std::map<int, Beidou_Dnav_Ephemeris>> d_beidou_dnav_ephemeris_snapshot;
+    Rcu_Snapshot<std::map<int, Beidou_Dnav_Almanac>> d_beidou_dnav_almanac_snapshot;
+
     std::unique_ptr<Rinex_Printer> d_rp;
     std::unique_ptr<Kml_Printer> d_kml_dump;
     std::unique_ptr<Gpx_Printer> d_gpx_dump;
@@ -0,0 +1,90 @@
+/*!
+ * \file rcu_snapshot.h
+ * \brief Immutable, versioned snapshot of a data structure, published by one
+ * writer and read by other threads without copying.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RCU_SNAPSHOT_H
+#define GNSS_SDR_RCU_SNAPSHOT_H
+
+#include <atomic>   // for std::atomic, std::atomic_load, std::atomic_store
+#include <cstdint>  // for uint64_t
+#include <memory>   // for std::shared_ptr, std::make_shared
+#include <utility>  // for std::move
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Read-copy-update container of an immutable T.
+ *
+ * The writer builds a new T and publishes it; readers get a shared pointer to
+ * the last published version and keep using it for as long as they need,
+ * without locking the writer or copying the data. Old versions are released
+ * when their last reader drops them.
+ */
+template <typename T>
+class Rcu_Snapshot
+{
+public:
+    using const_ptr = std::shared_ptr<const T>;
+
+    Rcu_Snapshot() : d_data(std::make_shared<const T>())
+    {
+    }
+
+    Rcu_Snapshot(const Rcu_Snapshot&) = delete;
+    Rcu_Snapshot& operator=(const Rcu_Snapshot&) = delete;
+
+    /*!
+     * \brief Returns the last published version. Never null.
+     */
+    const_ptr load() const
+    {
+        return std::atomic_load(&d_data);
+    }
+
+    /*!
+     * \brief Publishes a copy of data as the new version.
+     */
+    void publish(const T& data)
+    {
+        publish(std::make_shared<const T>(data));
+    }
+
+    void publish(const_ptr data)
+    {
+        std::atomic_store(&d_data, std::move(data));
+        d_version.fetch_add(1, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Number of versions published so far.
+     */
+    uint64_t version() const
+    {
+        return d_version.load(std::memory_order_acquire);
+    }
+
+private:
+    const_ptr d_data;
+    std::atomic<uint64_t> d_version{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RCU_SNAPSHOT_H
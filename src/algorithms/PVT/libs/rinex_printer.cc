@@ -47,14 +47,34 @@
 #include <array>
 #include <cmath>  // for floor
 #include <exception>
+#include <fstream>   // for fstream, ifstream
 #include <iostream>  // for cout
 #include <iterator>
 #include <ostream>
 #include <set>
+#include <sstream>  // for stringstream
 #include <unistd.h>  // for getlogin_r()
 #include <utility>
 #include <vector>
 
+namespace
+{
+// COMMENT record reserved in the observation file headers right after TIME OF
+// FIRST OBS, overwritten in place by the LEAP SECONDS record when the UTC model
+// is received. A blank line cannot be used instead: every RINEX header record
+// must carry its label in columns 61-80, and COMMENT is the only label allowed
+// anywhere in the header without a value. An empty LEAP SECONDS record would
+// be read as a leap second count of zero.
+std::string leap_seconds_placeholder()
+{
+    std::string line("LEAP SECONDS NOT AVAILABLE YET");
+    line += std::string(60 - line.size(), ' ');
+    line += "COMMENT";
+    line += std::string(13, ' ');
+    return line;
+}
+}  // namespace
+
 
 Rinex_Printer::Rinex_Printer(int32_t conf_version,
     const std::string& base_path,
@@ -3760,478 +3780,170 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Glonass_Gnav_Utc_
     if (glonass_gnav_almanac.i_satellite_freq_channel)
         {
         }  // Avoid compiler warning
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navGlofilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (auto& line_str : data)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            line_aux.clear();
+            if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    line_aux.clear();
-
-                    if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
                 }
-            else
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    data.push_back(line_str);
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
                 }
         }
 
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navGlofilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    overwrite_rinex_header(out, navGlofilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC info.\n";
 }
 
 
 void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navGalfilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navGalfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
+                }
+        }
+
+    overwrite_rinex_header(out, navGalfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
 void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Utc_Model& utc_model, const Gps_Iono& iono, const Gps_Ephemeris& eph) const
 {
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navfilename);
     std::string line_aux;
 
-    int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (auto& line_str : data)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            line_aux.clear();
+            if (d_version == 2)
                 {
-                    line_aux.clear();
-
-                    if (d_version == 2)
+                    if (line_str.find("ION ALPHA", 59) != std::string::npos)
                         {
-                            if (line_str.find("ION ALPHA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("ION BETA", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(2, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
-                                {
-                                    line_aux += std::string(3, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
-                                    if (d_pre_2009_file == false)
-                                        {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
-                                                }
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
-                                        }
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
+                            line_aux += std::string(2, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION ALPHA", 20);
+                            line_str = line_aux;
                         }
-
-                    if (d_version == 3)
+                    else if (line_str.find("ION BETA", 59) != std::string::npos)
                         {
-                            if (line_str.find("GPSA", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSA");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPSB", 0) != std::string::npos)
-                                {
-                                    line_aux += std::string("GPSB");
-                                    line_aux += std::string(1, ' ');
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                                    line_aux += std::string(7, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("GPUT", 0) != std::string::npos)
+                            line_aux += std::string(2, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                            line_aux += std::string(10, ' ');
+                            line_aux += Rinex_Printer::leftJustify("ION BETA", 20);
+                            line_str = line_aux;
+                        }
+                    else if (line_str.find("DELTA-UTC", 59) != std::string::npos)
+                        {
+                            line_aux += std::string(3, ' ');
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 18, 2), 19);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 9);
+                            if (d_pre_2009_file == false)
                                 {
-                                    line_aux += std::string("GPUT");
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                                    if (d_pre_2009_file == false)
+                                    if (eph.WN < 512)
                                         {
-                                            if (eph.WN < 512)
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                                }
-                                            else
-                                                {
-                                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                                }
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 9);  // valid from 2019 to 2029
                                         }
                                     else
                                         {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 9);  // valid from 2009 to 2019
                                         }
-                                    line_aux += std::string(10, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                                {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
                                 }
                             else
                                 {
-                                    data.push_back(line_str);
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256), 9);
                                 }
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("GPSB", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSB");
                             line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("GPUT", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
+                            line_aux += Rinex_Printer::leftJustify("DELTA-UTC: A0,A1,T,W", 20);
+                            line_str = line_aux;
                         }
                     else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
                         {
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
+                            line_aux += std::string(54, ' ');
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
+                            line_str = line_aux;
                         }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
                 }
-        }
-
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
 
-            if (!no_more_finds)
+            if (d_version == 3)
                 {
-                    line_aux.clear();
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    if (line_str.find("GPSA", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSA");
                             line_aux += std::string(1, ' ');
@@ -4241,9 +3953,9 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
                             line_aux += std::string(7, ' ');
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
+                            line_str = line_aux;
                         }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                    else if (line_str.find("GPSB", 0) != std::string::npos)
                         {
                             line_aux += std::string("GPSB");
                             line_aux += std::string(1, ' ');
@@ -4253,30 +3965,7 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
                             line_aux += std::string(7, ' ');
                             line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
+                            line_str = line_aux;
                         }
                     else if (line_str.find("GPUT", 0) != std::string::npos)
                         {
@@ -4284,420 +3973,464 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Mode
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
                             line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
                             line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
-    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
-}
-
-
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
-{
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
                             if (d_pre_2009_file == false)
                                 {
                                     if (eph.WN < 512)
                                         {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
                                         }
                                     else
                                         {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
+                                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
                                         }
                                 }
                             else
                                 {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
                                 }
                             line_aux += std::string(10, ' ');
                             line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPGA");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
+                            line_str = line_aux;
                         }
                     else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
                         {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
                             line_aux += std::string(36, ' ');
                             line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
+                            line_str = line_aux;
                         }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    overwrite_rinex_header(out, navfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono) const
 {
-    if (glonass_gnav_almanac.i_satellite_freq_channel)
-        {
-        }  // Avoid compiler warning
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navfilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("GPSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
+                }
+        }
+
+    overwrite_rinex_header(out, navfilename, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
 
-    bool no_more_finds = false;
-    std::string line_str;
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model, const Gps_CNAV_Iono& iono, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
+{
+    std::vector<std::string> data = read_rinex_header(out, navfilename);
+    std::string line_aux;
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPSA", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("GPUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
+                }
+        }
+
+    overwrite_rinex_header(out, navfilename, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
 
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            if (d_pre_2009_file == false)
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Galileo_Iono& galileo_iono, const Galileo_Utc_Model& galileo_utc_model) const
+{
+    std::vector<std::string> data = read_rinex_header(out, navMixfilename);
+    std::string line_aux;
+
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPSB", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
+                        {
+                            if (eph.WN < 512)
                                 {
-                                    if (eph.WN < 512)
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
-                                        }
-                                    else
-                                        {
-                                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
-                                        }
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
                                 }
                             else
                                 {
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
                                 }
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 1999 to 2008
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
                 }
-            else
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    data.push_back(line_str);
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPGA", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPGA");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_0G, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A_1G, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.t_0G), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_0G), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    overwrite_rinex_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
-void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gps_iono, const Gps_CNAV_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_Iono& gps_iono, const Gps_Utc_Model& gps_utc_model, const Gps_Ephemeris& eph, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
 {
     if (glonass_gnav_almanac.i_satellite_freq_channel)
         {
         }  // Avoid compiler warning
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navMixfilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (auto& line_str : data)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            line_aux.clear();
+            if (line_str.find("GPSA", 0) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("GPSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("GPSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GPUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLGP");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    if (d_pre_2009_file == false)
                         {
-                            data.push_back(line_str);
-                            no_more_finds = true;
+                            if (eph.WN < 512)
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 2048), 5);  // valid from 2019 to 2029
+                                }
+                            else
+                                {
+                                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256 + 1024), 5);  // valid from 2009 to 2019
+                                }
                         }
                     else
                         {
-                            data.push_back(line_str);
+                            line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T + (eph.WN / 256) * 256), 5);
                         }
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
                 }
-            else
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
                 {
-                    data.push_back(line_str);
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
                 }
         }
 
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    overwrite_rinex_header(out, navMixfilename, data);
+    std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
+}
+
+
+void Rinex_Printer::update_nav_header(std::fstream& out, const Gps_CNAV_Iono& gps_iono, const Gps_CNAV_Utc_Model& gps_utc_model, const Glonass_Gnav_Utc_Model& glonass_gnav_utc_model, const Glonass_Gnav_Almanac& glonass_gnav_almanac) const
+{
+    if (glonass_gnav_almanac.i_satellite_freq_channel)
         {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+        }  // Avoid compiler warning
+    std::vector<std::string> data = read_rinex_header(out, navMixfilename);
+    std::string line_aux;
+
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if (line_str.find("GPSA", 0) != std::string::npos)
+                {
+                    line_aux += std::string("GPSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GPUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GPUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(gps_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_T), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GLGP", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLGP");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_gps, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(gps_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
+                }
+        }
+
+    overwrite_rinex_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -4711,188 +4444,118 @@ void Rinex_Printer::update_nav_header(std::fstream& out, const Galileo_Iono& gal
     if (galileo_utc_model.A_0G > 0.0)
         {
         }
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navMixfilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAL ");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
-                            const double zero = 0.0;
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GAUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
-                        {
-                            line_aux += std::string("GLUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
-                            line_aux += std::string(10, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
-
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navMixfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    for (auto& line_str : data)
+        {
+            line_aux.clear();
+            if ((line_str.find("GAL", 0) != std::string::npos) && (line_str.find("IONOSPHERIC CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAL ");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_iono.ai2, 10, 2), 12);
+                    const double zero = 0.0;
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(zero, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GAUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GAUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A0, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(galileo_utc_model.A1, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.tot), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WNot), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if ((line_str.find("GLUT", 0) != std::string::npos) && (line_str.find("TIME SYSTEM CORR", 59) != std::string::npos))
+                {
+                    line_aux += std::string("GLUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(glonass_gnav_utc_model.d_tau_c, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(0.0, 15, 2), 16);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 7);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(0.0), 5);
+                    line_aux += std::string(10, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
+                {
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
+                }
+        }
+
+    overwrite_rinex_header(out, navMixfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
 
 void Rinex_Printer::update_nav_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model, const Beidou_Dnav_Iono& iono) const
 {
-    std::vector<std::string> data;
+    std::vector<std::string> data = read_rinex_header(out, navfilename);
     std::string line_aux;
 
-    const int64_t pos = out.tellp();
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    for (auto& line_str : data)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            line_aux.clear();
+            if (line_str.find("BDSA", 0) != std::string::npos)
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("BDSA", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSA");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDSB", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDSB");
-                            line_aux += std::string(1, ' ');
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
-                            line_aux += std::string(7, ' ');
-                            line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("BDUT", 0) != std::string::npos)
-                        {
-                            line_aux += std::string("BDUT");
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
-                            line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
-                            line_aux += std::string(22, ' ');
-                            line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
-                        {
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    line_aux += std::string("BDSA");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.alpha3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
                 }
-            else
+            else if (line_str.find("BDSB", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDSB");
+                    line_aux += std::string(1, ' ');
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta0, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta1, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta2, 10, 2), 12);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(iono.beta3, 10, 2), 12);
+                    line_aux += std::string(7, ' ');
+                    line_aux += Rinex_Printer::leftJustify("IONOSPHERIC CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("BDUT", 0) != std::string::npos)
+                {
+                    line_aux += std::string("BDUT");
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A0_UTC, 16, 2), 18);
+                    line_aux += Rinex_Printer::rightJustify(Rinex_Printer::doub2for(utc_model.A1_UTC, 15, 2), 16);
+                    line_aux += std::string(22, ' ');
+                    line_aux += Rinex_Printer::leftJustify("TIME SYSTEM CORR", 20);
+                    line_str = line_aux;
+                }
+            else if (line_str.find("LEAP SECONDS", 59) != std::string::npos)
                 {
-                    data.push_back(line_str);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+                    line_aux += std::string(36, ' ');
+                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+                    line_str = line_aux;
                 }
         }
 
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(navfilename, std::ios::out | std::ios::app);
-    out.seekp(pos);
+    overwrite_rinex_header(out, navfilename, data);
     std::cout << "The RINEX Navigation file header has been updated with UTC and IONO info.\n";
 }
 
@@ -6676,6 +6339,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- GLONASS SLOT / FRQ # (On;y version 3)
     if (d_version == 3)
         {
@@ -7004,6 +6670,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- GLONASS SLOT / FRQ #
     // TODO Need to provide system with list of all satellites and update this accordingly
     line.clear();
@@ -7393,6 +7062,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7661,6 +7333,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -7913,6 +7588,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8192,6 +7870,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& eph
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8569,6 +8250,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -8916,6 +8600,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_CNAV_Ephemeris
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9213,6 +8900,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Galileo_Ephemeris&
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9533,6 +9223,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Gps_Ephemeris& gps
     Rinex_Printer::lengthCheck(line);
     out << line << '\n';
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9769,6 +9462,9 @@ void Rinex_Printer::rinex_obs_header(std::fstream& out, const Beidou_Dnav_Epheme
 
     // -------- SYS /PHASE SHIFTS
 
+    // -------- LEAP SECONDS (reserved until the UTC model is received)
+    reserve_leap_seconds_record(out);
+
     // -------- end of header
     line.clear();
     line += std::string(60, ' ');
@@ -9789,260 +9485,165 @@ void Rinex_Printer::update_obs_header(std::fstream& out __attribute__((unused)),
 
 void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    if (d_version == 2)
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (d_version == 2)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)  // TIME OF FIRST OBS last header annotation might change in the future
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += std::string(54, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-
-                    if (d_version == 3)
-                        {
-                            if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                                    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                                    line_aux += std::string(36, ' ');
-                                    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                                    data.push_back(line_aux);
-                                }
-                            else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                                {
-                                    data.push_back(line_str);
-                                    no_more_finds = true;
-                                }
-                            else
-                                {
-                                    data.push_back(line_str);
-                                }
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+            line_aux += std::string(54, ' ');
+            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
         }
-
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    else
         {
-            out << data[i] << '\n';
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+            line_aux += std::string(36, ' ');
+            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    update_obs_leap_seconds(out, line_aux);
 }
 
 
 void Rinex_Printer::update_obs_header(std::fstream& out, const Gps_CNAV_Utc_Model& utc_model) const
 {
-    std::vector<std::string> data;
     std::string line_aux;
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    update_obs_leap_seconds(out, line_aux);
+}
 
-    out.seekp(0);
-    data.clear();
 
-    bool no_more_finds = false;
-    std::string line_str;
+void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model& galileo_utc_model) const
+{
+    std::string line_aux;
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    update_obs_leap_seconds(out, line_aux);
+}
 
-    while (!out.eof())
-        {
-            std::getline(out, line_str);
 
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
-                {
-                    data.push_back(line_str);
-                }
-        }
+void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model) const
+{
+    std::string line_aux;
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
+    line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
+    line_aux += std::string(36, ' ');
+    line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
+    update_obs_leap_seconds(out, line_aux);
+}
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+
+std::vector<std::string> Rinex_Printer::read_rinex_header(std::fstream& out, const std::string& filename) const
+{
+    // Only the header is read, so the cost does not depend on the file size
+    out.flush();
+    std::vector<std::string> header;
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    std::string line_str;
+    while (std::getline(file, line_str))
         {
-            out << data[i] << '\n';
+            header.push_back(line_str);
+            if (line_str.find("END OF HEADER", 59) != std::string::npos)
+                {
+                    break;
+                }
         }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+    return header;
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Galileo_Utc_Model& galileo_utc_model) const
+void Rinex_Printer::overwrite_rinex_header(std::fstream& out, const std::string& filename, const std::vector<std::string>& header) const
 {
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
+    std::string new_header;
+    for (const auto& line : header)
+        {
+            new_header += line;
+            new_header += '\n';
+        }
 
-    bool no_more_finds = false;
+    std::fstream file(filename, std::ios::in | std::ios::out | std::ios::binary);
+    size_t header_size = 0;
     std::string line_str;
-
-    while (!out.eof())
+    while (std::getline(file, line_str))
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
-                {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.Delta_tLSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(galileo_utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
-                }
-            else
+            header_size += line_str.size() + 1;
+            if (line_str.find("END OF HEADER", 59) != std::string::npos)
                 {
-                    data.push_back(line_str);
+                    break;
                 }
         }
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
+    if (header_size == new_header.size())
         {
-            out << data[i] << '\n';
+            // The records after the header are not touched
+            file.clear();
+            file.seekp(0);
+            file.write(new_header.data(), static_cast<std::streamsize>(new_header.size()));
+            return;
         }
+
+    // The header changed its size: the data records have to be moved
+    std::stringstream data_records;
+    if (file)
+        {
+            data_records << file.rdbuf();
+        }
+    file.close();
+    out.close();
+    out.open(filename, std::ios::out | std::ios::trunc);
+    out << new_header << data_records.str();
     out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
+    out.open(filename, std::ios::out | std::ios::in | std::ios::app);
     out.seekp(0, std::ios_base::end);
 }
 
 
-void Rinex_Printer::update_obs_header(std::fstream& out, const Beidou_Dnav_Utc_Model& utc_model) const
+void Rinex_Printer::update_obs_leap_seconds(std::fstream& out, const std::string& leap_seconds_record) const
 {
-    std::vector<std::string> data;
-    std::string line_aux;
-
-    out.seekp(0);
-    data.clear();
-
-    bool no_more_finds = false;
-    std::string line_str;
-
-    while (!out.eof())
+    std::vector<std::string> data = read_rinex_header(out, obsfilename);
+    auto record = std::find(data.begin(), data.end(), leap_seconds_placeholder());
+    if (record != data.end())
         {
-            std::getline(out, line_str);
-
-            if (!no_more_finds)
+            *record = leap_seconds_record;
+        }
+    else
+        {
+            // Header without the reserved record: replace its LEAP SECONDS
+            // record, if any, or insert one after TIME OF FIRST OBS
+            record = std::find_if(data.begin(), data.end(), [](const std::string& line_str) { return line_str.find("LEAP SECONDS", 59) != std::string::npos; });
+            if (record != data.end())
                 {
-                    line_aux.clear();
-
-                    if (line_str.find("TIME OF FIRST OBS", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LS), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DeltaT_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.WN_LSF), 6);
-                            line_aux += Rinex_Printer::rightJustify(std::to_string(utc_model.DN), 6);
-                            line_aux += std::string(36, ' ');
-                            line_aux += Rinex_Printer::leftJustify("LEAP SECONDS", 20);
-                            data.push_back(line_aux);
-                        }
-                    else if (line_str.find("END OF HEADER", 59) != std::string::npos)
-                        {
-                            data.push_back(line_str);
-                            no_more_finds = true;
-                        }
-                    else
-                        {
-                            data.push_back(line_str);
-                        }
+                    *record = leap_seconds_record;
                 }
             else
                 {
-                    data.push_back(line_str);
+                    record = std::find_if(data.begin(), data.end(), [](const std::string& line_str) { return line_str.find("TIME OF FIRST OBS", 59) != std::string::npos; });
+                    if (record != data.end())
+                        {
+                            data.insert(record + 1, leap_seconds_record);
+                        }
                 }
         }
+    overwrite_rinex_header(out, obsfilename, data);
+}
 
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::trunc);
-    out.seekp(0);
-    for (int32_t i = 0; i < static_cast<int32_t>(data.size()) - 1; i++)
-        {
-            out << data[i] << '\n';
-        }
-    out.close();
-    out.open(obsfilename, std::ios::out | std::ios::in | std::ios::app);
-    out.seekp(0, std::ios_base::end);
+
+void Rinex_Printer::reserve_leap_seconds_record(std::fstream& out) const
+{
+    const std::string line = leap_seconds_placeholder();
+    Rinex_Printer::lengthCheck(line);
+    out << line << '\n';
 }
 
 
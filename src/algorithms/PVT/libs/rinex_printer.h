@@ -776,6 +776,32 @@ private:
     void update_obs_header(std::fstream& out,
         const Beidou_Dnav_Utc_Model& utc_model) const;
 
+    /*
+     * Reads the header records of a RINEX file, up to END OF HEADER. The
+     * pending output of out is flushed first.
+     */
+    std::vector<std::string> read_rinex_header(std::fstream& out, const std::string& filename) const;
+
+    /*
+     * Writes back the header records read by read_rinex_header(). If the
+     * header keeps its size, it is overwritten in place with a single write;
+     * otherwise the whole file is rewritten and out is reopened.
+     */
+    void overwrite_rinex_header(std::fstream& out, const std::string& filename, const std::vector<std::string>& header) const;
+
+    /*
+     * Writes the LEAP SECONDS record in the record reserved for it in the
+     * observation file header. Headers written without that record get their
+     * LEAP SECONDS record replaced, or a new one after TIME OF FIRST OBS.
+     */
+    void update_obs_leap_seconds(std::fstream& out, const std::string& leap_seconds_record) const;
+
+    /*
+     * Reserves the record of the observation file header where
+     * update_obs_header() writes the LEAP SECONDS record
+     */
+    void reserve_leap_seconds_record(std::fstream& out) const;
+
     /*
      * Generation of RINEX signal strength indicators
      */
@@ -28,7 +28,7 @@
 #include <boost/date_time/gregorian/gregorian.hpp>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/exception/diagnostic_information.hpp>
-#include <algorithm>  // for std::reverse
+#include <algorithm>  // for std::any_of, std::reverse
 #include <cmath>      // for std::fmod, std::lround
 #include <cstdlib>    // for strtol
 #include <iostream>   // for std::cout
@@ -36,8 +36,6 @@
 
 Rtcm::Rtcm(uint16_t port) : RTCM_port(port), server_is_running(false)
 {
-    preamble = std::bitset<8>("11010011");
-    reserved_field = std::bitset<6>("000000");
     rtcm_message_queue = std::make_shared<Concurrent_Queue<std::string>>();
     boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), RTCM_port);
     servers.emplace_back(io_context, endpoint);
@@ -122,26 +120,6 @@ bool Rtcm::is_server_running() const
 //
 // *****************************************************************************************************
 
-std::string Rtcm::add_CRC(const std::string& message_without_crc) const
-{
-    // ******  Computes Qualcomm CRC-24Q ******
-    boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM;
-    // 1) Converts the string to a vector of uint8_t:
-    boost::dynamic_bitset<uint8_t> frame_bits(message_without_crc);
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
-
-    // 2) Computes CRC
-    CRC_RTCM.process_bytes(bytes.data(), bytes.size());
-    const auto crc_frame = std::bitset<24>(CRC_RTCM.checksum());
-
-    // 3) Builds the complete message
-    const std::string complete_message = message_without_crc + crc_frame.to_string();
-    return bin_to_binary_data(complete_message);
-}
-
-
 bool Rtcm::check_CRC(const std::string& message) const
 {
     boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> CRC_RTCM_CHECK;
@@ -398,17 +376,9 @@ int64_t Rtcm::hex_to_int(const std::string& s) const
 
 std::string Rtcm::build_message(const std::string& data) const
 {
-    const uint32_t msg_length_bits = data.length();
-    const uint32_t msg_length_bytes = std::ceil(static_cast<float>(msg_length_bits) / 8.0);
-    const auto message_length = std::bitset<10>(msg_length_bytes);
-    const uint32_t zeros_to_fill = 8 * msg_length_bytes - msg_length_bits;
-    const std::string b(zeros_to_fill, '0');
-    const std::string msg_content = data + b;
-    const std::string msg_without_crc = preamble.to_string() +
-                                        reserved_field.to_string() +
-                                        message_length.to_string() +
-                                        msg_content;
-    return Rtcm::add_CRC(msg_without_crc);
+    Rtcm_Bit_Writer message;
+    message.append_bin(data);
+    return message.frame();
 }
 
 
@@ -425,7 +395,7 @@ std::string Rtcm::build_message(const std::string& data) const
 //
 // ********************************************************
 
-std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+void Rtcm::add_MT1001_4_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
@@ -441,20 +411,17 @@ std::bitset<64> Rtcm::get_MT1001_4_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF007(divergence_free_smoothing_indicator);
     Rtcm::set_DF008(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF004.to_string() +
-                               DF005.to_string() +
-                               DF006.to_string() +
-                               DF007.to_string() +
-                               DF008.to_string();
-
-    std::bitset<64> header_msg(header);
-    return header_msg;
+    message_writer.append(DF002);
+    message_writer.append(DF003);
+    message_writer.append(DF004);
+    message_writer.append(DF005);
+    message_writer.append(DF006);
+    message_writer.append(DF007);
+    message_writer.append(DF008);
 }
 
 
-std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::add_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -463,14 +430,11 @@ std::bitset<58> Rtcm::get_MT1001_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string();
-
-    std::bitset<58> content_msg(content);
-    return content_msg;
+    message_writer.append(DF009);
+    message_writer.append(DF010);
+    message_writer.append(DF011);
+    message_writer.append(DF012);
+    message_writer.append(DF013);
 }
 
 
@@ -497,18 +461,17 @@ std::string Rtcm::print_MT1001(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1001_4_header(1001, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<58> content = Rtcm::get_MT1001_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1001_sat_content(gps_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -546,18 +509,17 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1001_4_header(1002, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.cbegin();
          observables_iter != observablesL1.cend();
          observables_iter++)
         {
-            const std::bitset<74> content = Rtcm::get_MT1002_sat_content(gps_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1002_sat_content(gps_eph, obs_time, observables_iter->second);
         }
 
-    const std::string msg = build_message(data);
+    const std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -566,7 +528,7 @@ std::string Rtcm::print_MT1002(const Gps_Ephemeris& gps_eph, double obs_time, co
 }
 
 
-std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::add_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchro);
@@ -575,16 +537,13 @@ std::bitset<74> Rtcm::get_MT1002_sat_content(const Gps_Ephemeris& eph, double ob
     Rtcm::set_DF012(gnss_synchro);
     Rtcm::set_DF013(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string();
-
-    std::bitset<74> content_msg(content);
-    return content_msg;
+    message_writer.append(DF009);
+    message_writer.append(DF010);
+    message_writer.append(DF011);
+    message_writer.append(DF012);
+    message_writer.append(DF013);
+    message_writer.append(DF014);
+    message_writer.append(DF015);
 }
 
 
@@ -649,18 +608,17 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1001_4_header(1003, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<101> content = Rtcm::get_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1003_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -669,7 +627,7 @@ std::string Rtcm::print_MT1003(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
 }
 
 
-std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::add_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -682,18 +640,15 @@ std::bitset<101> Rtcm::get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF018(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string();
-
-    std::bitset<101> content_msg(content);
-    return content_msg;
+    message_writer.append(DF009);
+    message_writer.append(DF010);
+    message_writer.append(DF011);
+    message_writer.append(DF012);
+    message_writer.append(DF013);
+    message_writer.append(DF016_);
+    message_writer.append(DF017);
+    message_writer.append(DF018);
+    message_writer.append(DF019);
 }
 
 
@@ -758,18 +713,17 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
                 }
         }
 
-    const std::bitset<64> header = Rtcm::get_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1001_4_header(1004, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.cbegin();
          common_observables_iter != common_observables.cend();
          common_observables_iter++)
         {
-            std::bitset<125> content = Rtcm::get_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1004_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -778,7 +732,7 @@ std::string Rtcm::print_MT1004(const Gps_Ephemeris& ephL1, const Gps_CNAV_Epheme
 }
 
 
-std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::add_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF009(gnss_synchroL1);
@@ -794,21 +748,18 @@ std::bitset<125> Rtcm::get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const
     Rtcm::set_DF019(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF020(gnss_synchroL2);
 
-    const std::string content = DF009.to_string() +
-                                DF010.to_string() +
-                                DF011.to_string() +
-                                DF012.to_string() +
-                                DF013.to_string() +
-                                DF014.to_string() +
-                                DF015.to_string() +
-                                DF016_.to_string() +
-                                DF017.to_string() +
-                                DF018.to_string() +
-                                DF019.to_string() +
-                                DF020.to_string();
-
-    std::bitset<125> content_msg(content);
-    return content_msg;
+    message_writer.append(DF009);
+    message_writer.append(DF010);
+    message_writer.append(DF011);
+    message_writer.append(DF012);
+    message_writer.append(DF013);
+    message_writer.append(DF014);
+    message_writer.append(DF015);
+    message_writer.append(DF016_);
+    message_writer.append(DF017);
+    message_writer.append(DF018);
+    message_writer.append(DF019);
+    message_writer.append(DF020);
 }
 
 
@@ -890,21 +841,22 @@ std::string Rtcm::print_MT1005(uint32_t ref_id, double ecef_x, double ecef_y, do
     DF364 = std::bitset<2>(quarter_cycle_indicator);
     Rtcm::set_DF027(ecef_z);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string();
-
-    std::string msg = build_message(data);
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF003);
+    message_writer.append(DF021);
+    message_writer.append(DF022);
+    message_writer.append(DF023);
+    message_writer.append(DF024);
+    message_writer.append(DF141);
+    message_writer.append(DF025);
+    message_writer.append(DF142);
+    message_writer.append(DF001_);
+    message_writer.append(DF026);
+    message_writer.append(DF364);
+    message_writer.append(DF027);
+
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1011,22 +963,23 @@ std::string Rtcm::print_MT1006(uint32_t ref_id, double ecef_x, double ecef_y, do
     Rtcm::set_DF027(ecef_z);
     Rtcm::set_DF028(height);
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF021.to_string() +
-                             DF022.to_string() +
-                             DF023.to_string() +
-                             DF024.to_string() +
-                             DF141.to_string() +
-                             DF025.to_string() +
-                             DF142.to_string() +
-                             DF001_.to_string() +
-                             DF026.to_string() +
-                             DF364.to_string() +
-                             DF027.to_string() +
-                             DF028.to_string();
-
-    std::string msg = build_message(data);
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF003);
+    message_writer.append(DF021);
+    message_writer.append(DF022);
+    message_writer.append(DF023);
+    message_writer.append(DF024);
+    message_writer.append(DF141);
+    message_writer.append(DF025);
+    message_writer.append(DF142);
+    message_writer.append(DF001_);
+    message_writer.append(DF026);
+    message_writer.append(DF364);
+    message_writer.append(DF027);
+    message_writer.append(DF028);
+
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1054,14 +1007,17 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
         }
     DF029 = std::bitset<8>(len);
 
-    std::string DF030_str_;
+    message_writer.clear();
+    message_writer.append(DF002_);
+    message_writer.append(DF003);
+    message_writer.append(DF029);
     for (char c : ant_descriptor)
         {
-            const auto character = std::bitset<8>(c);
-            DF030_str_ += character.to_string();
+            message_writer.append(std::bitset<8>(c));  // DF030
         }
 
     Rtcm::set_DF031(antenna_setup_id);
+    message_writer.append(DF031);
 
     std::string ant_sn(antenna_serial_number);
     uint32_t len2 = ant_sn.length();
@@ -1072,22 +1028,13 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
         }
     DF032 = std::bitset<8>(len2);
 
-    std::string DF033_str_;
+    message_writer.append(DF032);
     for (char c : ant_sn)
         {
-            const auto character = std::bitset<8>(c);
-            DF033_str_ += character.to_string();
+            message_writer.append(std::bitset<8>(c));  // DF033
         }
 
-    const std::string data = DF002_.to_string() +
-                             DF003.to_string() +
-                             DF029.to_string() +
-                             DF030_str_ +
-                             DF031.to_string() +
-                             DF032.to_string() +
-                             DF033_str_;
-
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1101,7 +1048,7 @@ std::string Rtcm::print_MT1008(uint32_t ref_id, const std::string& antenna_descr
 //   MESSAGE TYPE 1009 (GLONASS L1 Basic RTK Observables)
 //
 // ********************************************************
-std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
+void Rtcm::add_MT1009_12_header(uint32_t msg_number, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id, uint32_t smooth_int, bool sync_flag, bool divergence_free)
 {
     const uint32_t reference_station_id = ref_id;  // Max: 4095
@@ -1117,20 +1064,17 @@ std::bitset<61> Rtcm::get_MT1009_12_header(uint32_t msg_number, double obs_time,
     Rtcm::set_DF036(divergence_free_smoothing_indicator);
     Rtcm::set_DF037(smoothing_interval);
 
-    const std::string header = DF002.to_string() +
-                               DF003.to_string() +
-                               DF034.to_string() +
-                               DF005.to_string() +
-                               DF035.to_string() +
-                               DF036.to_string() +
-                               DF037.to_string();
-
-    std::bitset<61> header_msg(header);
-    return header_msg;
+    message_writer.append(DF002);
+    message_writer.append(DF003);
+    message_writer.append(DF034);
+    message_writer.append(DF005);
+    message_writer.append(DF035);
+    message_writer.append(DF036);
+    message_writer.append(DF037);
 }
 
 
-std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::add_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1140,15 +1084,12 @@ std::bitset<64> Rtcm::get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF042(gnss_synchro);
     Rtcm::set_DF043(eph, obs_time, gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string();
-
-    std::bitset<64> content_msg(content);
-    return content_msg;
+    message_writer.append(DF038);
+    message_writer.append(DF039);
+    message_writer.append(DF040);
+    message_writer.append(DF041);
+    message_writer.append(DF042);
+    message_writer.append(DF043);
 }
 
 
@@ -1175,18 +1116,17 @@ std::string Rtcm::print_MT1009(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1009_12_header(1009, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<64> content = Rtcm::get_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1009_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1224,18 +1164,17 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1009_12_header(1010, obs_time, observablesL1, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (observables_iter = observablesL1.begin();
          observables_iter != observablesL1.end();
          observables_iter++)
         {
-            const std::bitset<79> content = Rtcm::get_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1010_sat_content(glonass_gnav_eph, obs_time, observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1244,7 +1183,7 @@ std::string Rtcm::print_MT1010(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, d
 }
 
 
-std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
+void Rtcm::add_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchro);
@@ -1256,17 +1195,14 @@ std::bitset<79> Rtcm::get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& eph,
     Rtcm::set_DF044(gnss_synchro);
     Rtcm::set_DF045(gnss_synchro);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string();
-
-    std::bitset<79> content_msg(content);
-    return content_msg;
+    message_writer.append(DF038);
+    message_writer.append(DF039);
+    message_writer.append(DF040);
+    message_writer.append(DF041);
+    message_writer.append(DF042);
+    message_writer.append(DF043);
+    message_writer.append(DF044);
+    message_writer.append(DF045);
 }
 
 
@@ -1331,18 +1267,17 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1009_12_header(1011, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<107> content = Rtcm::get_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1011_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1351,7 +1286,7 @@ std::string Rtcm::print_MT1011(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
 }
 
 
-std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::add_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1365,19 +1300,16 @@ std::bitset<107> Rtcm::get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF048(gnss_synchroL1, gnss_synchroL2);
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string();
-
-    std::bitset<107> content_msg(content);
-    return content_msg;
+    message_writer.append(DF038);
+    message_writer.append(DF039);
+    message_writer.append(DF040);
+    message_writer.append(DF041);
+    message_writer.append(DF042);
+    message_writer.append(DF043);
+    message_writer.append(DF046_);
+    message_writer.append(DF047);
+    message_writer.append(DF048);
+    message_writer.append(DF049);
 }
 
 
@@ -1442,18 +1374,17 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
                 }
         }
 
-    const std::bitset<61> header = Rtcm::get_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
-    std::string data = header.to_string();
+    message_writer.clear();
+    Rtcm::add_MT1009_12_header(1012, obs_time, observablesL1_with_L2, ref_id, smooth_int, sync_flag, divergence_free);
 
     for (common_observables_iter = common_observables.begin();
          common_observables_iter != common_observables.end();
          common_observables_iter++)
         {
-            const std::bitset<130> content = Rtcm::get_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
-            data += content.to_string();
+            Rtcm::add_MT1012_sat_content(ephL1, ephL2, obs_time, common_observables_iter->first, common_observables_iter->second);
         }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1462,7 +1393,7 @@ std::string Rtcm::print_MT1012(const Glonass_Gnav_Ephemeris& ephL1, const Glonas
 }
 
 
-std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
+void Rtcm::add_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2)
 {
     const bool code_indicator = false;  // code indicator   0: C/A code   1: P(Y) code direct
     Rtcm::set_DF038(gnss_synchroL1);
@@ -1479,22 +1410,19 @@ std::bitset<130> Rtcm::get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL
     Rtcm::set_DF049(ephL2, obs_time, gnss_synchroL2);
     Rtcm::set_DF050(gnss_synchroL2);
 
-    const std::string content = DF038.to_string() +
-                                DF039.to_string() +
-                                DF040.to_string() +
-                                DF041.to_string() +
-                                DF042.to_string() +
-                                DF043.to_string() +
-                                DF044.to_string() +
-                                DF045.to_string() +
-                                DF046_.to_string() +
-                                DF047.to_string() +
-                                DF048.to_string() +
-                                DF049.to_string() +
-                                DF050.to_string();
-
-    std::bitset<130> content_msg(content);
-    return content_msg;
+    message_writer.append(DF038);
+    message_writer.append(DF039);
+    message_writer.append(DF040);
+    message_writer.append(DF041);
+    message_writer.append(DF042);
+    message_writer.append(DF043);
+    message_writer.append(DF044);
+    message_writer.append(DF045);
+    message_writer.append(DF046_);
+    message_writer.append(DF047);
+    message_writer.append(DF048);
+    message_writer.append(DF049);
+    message_writer.append(DF050);
 }
 
 
@@ -1540,44 +1468,45 @@ std::string Rtcm::print_MT1019(const Gps_Ephemeris& gps_eph)
     Rtcm::set_DF103(gps_eph);
     Rtcm::set_DF137(gps_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF009.to_string() +
-                             DF076.to_string() +
-                             DF077.to_string() +
-                             DF078.to_string() +
-                             DF079.to_string() +
-                             DF071.to_string() +
-                             DF081.to_string() +
-                             DF082.to_string() +
-                             DF083.to_string() +
-                             DF084.to_string() +
-                             DF085.to_string() +
-                             DF086.to_string() +
-                             DF087.to_string() +
-                             DF088.to_string() +
-                             DF089.to_string() +
-                             DF090.to_string() +
-                             DF091.to_string() +
-                             DF092.to_string() +
-                             DF093.to_string() +
-                             DF094.to_string() +
-                             DF095.to_string() +
-                             DF096.to_string() +
-                             DF097.to_string() +
-                             DF098.to_string() +
-                             DF099.to_string() +
-                             DF100.to_string() +
-                             DF101.to_string() +
-                             DF102.to_string() +
-                             DF103.to_string() +
-                             DF137.to_string();
-
-    if (data.length() != 488)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF009);
+    message_writer.append(DF076);
+    message_writer.append(DF077);
+    message_writer.append(DF078);
+    message_writer.append(DF079);
+    message_writer.append(DF071);
+    message_writer.append(DF081);
+    message_writer.append(DF082);
+    message_writer.append(DF083);
+    message_writer.append(DF084);
+    message_writer.append(DF085);
+    message_writer.append(DF086);
+    message_writer.append(DF087);
+    message_writer.append(DF088);
+    message_writer.append(DF089);
+    message_writer.append(DF090);
+    message_writer.append(DF091);
+    message_writer.append(DF092);
+    message_writer.append(DF093);
+    message_writer.append(DF094);
+    message_writer.append(DF095);
+    message_writer.append(DF096);
+    message_writer.append(DF097);
+    message_writer.append(DF098);
+    message_writer.append(DF099);
+    message_writer.append(DF100);
+    message_writer.append(DF101);
+    message_writer.append(DF102);
+    message_writer.append(DF103);
+    message_writer.append(DF137);
+
+    if (message_writer.size() != 488)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1019 (488 bits expected, found " << message_writer.size() << ")";
+        }
+
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1765,50 +1694,51 @@ std::string Rtcm::print_MT1020(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, c
     Rtcm::set_DF135(glonass_gnav_utc_model);
     Rtcm::set_DF136(glonass_gnav_eph);
 
-    const std::string data = DF002.to_string() +
-                             DF038.to_string() +
-                             DF040.to_string() +
-                             DF104.to_string() +
-                             DF105.to_string() +
-                             DF106.to_string() +
-                             DF107.to_string() +
-                             DF108.to_string() +
-                             DF109.to_string() +
-                             DF110.to_string() +
-                             DF111.to_string() +
-                             DF112.to_string() +
-                             DF113.to_string() +
-                             DF114.to_string() +
-                             DF115.to_string() +
-                             DF116.to_string() +
-                             DF117.to_string() +
-                             DF118.to_string() +
-                             DF119.to_string() +
-                             DF120.to_string() +
-                             DF121.to_string() +
-                             DF122.to_string() +
-                             DF123.to_string() +
-                             DF124.to_string() +
-                             DF125.to_string() +
-                             DF126.to_string() +
-                             DF127.to_string() +
-                             DF128.to_string() +
-                             DF129.to_string() +
-                             DF130.to_string() +
-                             DF131.to_string() +
-                             DF132.to_string() +
-                             DF133.to_string() +
-                             DF134.to_string() +
-                             DF135.to_string() +
-                             DF136.to_string() +
-                             std::bitset<7>().to_string();  // Reserved bits
-
-    if (data.length() != 360)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF038);
+    message_writer.append(DF040);
+    message_writer.append(DF104);
+    message_writer.append(DF105);
+    message_writer.append(DF106);
+    message_writer.append(DF107);
+    message_writer.append(DF108);
+    message_writer.append(DF109);
+    message_writer.append(DF110);
+    message_writer.append(DF111);
+    message_writer.append(DF112);
+    message_writer.append(DF113);
+    message_writer.append(DF114);
+    message_writer.append(DF115);
+    message_writer.append(DF116);
+    message_writer.append(DF117);
+    message_writer.append(DF118);
+    message_writer.append(DF119);
+    message_writer.append(DF120);
+    message_writer.append(DF121);
+    message_writer.append(DF122);
+    message_writer.append(DF123);
+    message_writer.append(DF124);
+    message_writer.append(DF125);
+    message_writer.append(DF126);
+    message_writer.append(DF127);
+    message_writer.append(DF128);
+    message_writer.append(DF129);
+    message_writer.append(DF130);
+    message_writer.append(DF131);
+    message_writer.append(DF132);
+    message_writer.append(DF133);
+    message_writer.append(DF134);
+    message_writer.append(DF135);
+    message_writer.append(DF136);
+    message_writer.append(std::bitset<7>());  // Reserved bits
+
+    if (message_writer.size() != 360)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1020 (360 bits expected, found " << message_writer.size() << ")";
+        }
+
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -1995,7 +1925,6 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
 
     uint32_t i = 0;
     bool first = true;
-    std::string text_binary;
     for (char c : message)
         {
             if (isgraph(c) || c == ' ')
@@ -2015,22 +1944,24 @@ std::string Rtcm::print_MT1029(uint32_t ref_id, const Gps_Ephemeris& gps_eph, do
                             first = false;
                         }
                 }
-            const auto character = std::bitset<8>(c);
-            text_binary += character.to_string();
         }
 
     const auto DF138_ = std::bitset<7>(i);
     const auto DF139_ = std::bitset<8>(message.length());
 
-    const std::string data = DF002.to_string() +
-                             DF003.to_string() +
-                             DF051.to_string() +
-                             DF052.to_string() +
-                             DF138_.to_string() +
-                             DF139_.to_string() +
-                             text_binary;
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF003);
+    message_writer.append(DF051);
+    message_writer.append(DF052);
+    message_writer.append(DF138_);
+    message_writer.append(DF139_);
+    for (char c : message)
+        {
+            message_writer.append(std::bitset<8>(c));  // DF140
+        }
 
-    std::string msg = build_message(data);
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -2079,42 +2010,43 @@ std::string Rtcm::print_MT1045(const Galileo_Ephemeris& gal_eph)
     const uint32_t seven_zero = 0;
     const auto DF001_ = std::bitset<7>(seven_zero);
 
-    const std::string data = DF002.to_string() +
-                             DF252.to_string() +
-                             DF289.to_string() +
-                             DF290.to_string() +
-                             DF291.to_string() +
-                             DF292.to_string() +
-                             DF293.to_string() +
-                             DF294.to_string() +
-                             DF295.to_string() +
-                             DF296.to_string() +
-                             DF297.to_string() +
-                             DF298.to_string() +
-                             DF299.to_string() +
-                             DF300.to_string() +
-                             DF301.to_string() +
-                             DF302.to_string() +
-                             DF303.to_string() +
-                             DF304.to_string() +
-                             DF305.to_string() +
-                             DF306.to_string() +
-                             DF307.to_string() +
-                             DF308.to_string() +
-                             DF309.to_string() +
-                             DF310.to_string() +
-                             DF311.to_string() +
-                             DF312.to_string() +
-                             DF314.to_string() +
-                             DF315.to_string() +
-                             DF001_.to_string();
-
-    if (data.length() != 496)
-        {
-            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << data.length() << ")";
-        }
-
-    std::string msg = build_message(data);
+    message_writer.clear();
+    message_writer.append(DF002);
+    message_writer.append(DF252);
+    message_writer.append(DF289);
+    message_writer.append(DF290);
+    message_writer.append(DF291);
+    message_writer.append(DF292);
+    message_writer.append(DF293);
+    message_writer.append(DF294);
+    message_writer.append(DF295);
+    message_writer.append(DF296);
+    message_writer.append(DF297);
+    message_writer.append(DF298);
+    message_writer.append(DF299);
+    message_writer.append(DF300);
+    message_writer.append(DF301);
+    message_writer.append(DF302);
+    message_writer.append(DF303);
+    message_writer.append(DF304);
+    message_writer.append(DF305);
+    message_writer.append(DF306);
+    message_writer.append(DF307);
+    message_writer.append(DF308);
+    message_writer.append(DF309);
+    message_writer.append(DF310);
+    message_writer.append(DF311);
+    message_writer.append(DF312);
+    message_writer.append(DF314);
+    message_writer.append(DF315);
+    message_writer.append(DF001_);
+
+    if (message_writer.size() != 496)
+        {
+            LOG(WARNING) << "Bad-formatted RTCM MT1045 (496 bits expected, found " << message_writer.size() << ")";
+        }
+
+    std::string msg = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(msg);
@@ -2288,7 +2220,8 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
             msg_number = 1071;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2298,11 +2231,11 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_1_content_signal_data(observables);
+    Rtcm::add_MSM_1_content_signal_data(observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
 
     if (server_is_running)
         {
@@ -2313,7 +2246,7 @@ std::string Rtcm::print_MSM_1(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_header(uint32_t msg_number,
+void Rtcm::add_MSM_header(uint32_t msg_number,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables,
     uint32_t ref_id,
@@ -2340,39 +2273,37 @@ std::string Rtcm::get_MSM_header(uint32_t msg_number,
     Rtcm::set_DF394(observables);
     Rtcm::set_DF395(observables);
 
-    std::string header = DF002.to_string() + DF003.to_string();
+    message_writer.append(DF002);
+    message_writer.append(DF003);
     // GNSS Epoch Time Specific to each constellation
     if ((sys == "R"))
         {
             // GLONASS Epoch Time
             Rtcm::set_DF034(obs_time);
-            header += DF034.to_string();
+            message_writer.append(DF034);
         }
     else
         {
             // GPS, Galileo Epoch Time
             Rtcm::set_DF004(obs_time);
-            header += DF004.to_string();
+            message_writer.append(DF004);
         }
 
-    header = header + DF393.to_string() +
-             DF409.to_string() +
-             DF001_.to_string() +
-             DF411.to_string() +
-             DF417.to_string() +
-             DF412.to_string() +
-             DF418.to_string() +
-             DF394.to_string() +
-             DF395.to_string() +
-             Rtcm::set_DF396(observables);
-
-    return header;
+    message_writer.append(DF393);
+    message_writer.append(DF409);
+    message_writer.append(DF001_);
+    message_writer.append(DF411);
+    message_writer.append(DF417);
+    message_writer.append(DF412);
+    message_writer.append(DF418);
+    message_writer.append(DF394);
+    message_writer.append(DF395);
+    message_writer.append_bin(Rtcm::set_DF396(observables));
 }
 
 
-std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2403,16 +2334,13 @@ std::string Rtcm::get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchr
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            sat_data += DF398.to_string();
+            message_writer.append(DF398);
         }
-
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
     const uint32_t Ncells = observables.size();
 
     auto observables_vector = std::vector<std::pair<int32_t, Gnss_Synchro>>();
@@ -2433,10 +2361,8 @@ std::string Rtcm::get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Syn
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
-            signal_data += DF400.to_string();
+            message_writer.append(DF400);
         }
-
-    return signal_data;
 }
 
 
@@ -2486,7 +2412,8 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
             msg_number = 1072;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2496,11 +2423,11 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_2_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2510,17 +2437,13 @@ std::string Rtcm::print_MSM_2(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2539,18 +2462,21 @@ std::string Rtcm::get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF401.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF402.size();
+    message_writer.skip(Ncells * (DF401.size() + DF402.size() + DF420.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF401.to_string();
-            second_data_type += DF402.to_string();
-            third_data_type += DF420.to_string();
+            message_writer.put(first_data_type_pos + cell * DF401.size(), DF401);
+            message_writer.put(second_data_type_pos + cell * DF402.size(), DF402);
+            message_writer.put(third_data_type_pos + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type;
-    return signal_data;
 }
 
 
@@ -2600,7 +2526,8 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
             msg_number = 1073;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2610,11 +2537,11 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_1_content_sat_data(observables);
+    Rtcm::add_MSM_1_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_3_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2624,18 +2551,13 @@ std::string Rtcm::print_MSM_3(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2654,20 +2576,24 @@ std::string Rtcm::get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF400.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF401.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + Ncells * DF402.size();
+    message_writer.skip(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF401(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
+            message_writer.put(first_data_type_pos + cell * DF400.size(), DF400);
+            message_writer.put(second_data_type_pos + cell * DF401.size(), DF401);
+            message_writer.put(third_data_type_pos + cell * DF402.size(), DF402);
+            message_writer.put(fourth_data_type_pos + cell * DF420.size(), DF420);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return signal_data;
 }
 
 
@@ -2717,7 +2643,8 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
             msg_number = 1074;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2727,11 +2654,11 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::add_MSM_4_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_4_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2741,11 +2668,8 @@ std::string Rtcm::print_MSM_4(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2772,31 +2696,28 @@ std::string Rtcm::get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    // Each data type is written for all the satellites before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + num_satellites * DF397.size();
+    message_writer.skip(num_satellites * (DF397.size() + DF398.size()));
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
-            first_data_type += DF397.to_string();
-            second_data_type += DF398.to_string();
+            message_writer.put(first_data_type_pos + nsat * DF397.size(), DF397);
+            message_writer.put(second_data_type_pos + nsat * DF398.size(), DF398);
         }
-    sat_data = first_data_type + second_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2815,6 +2736,14 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF400.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF401.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + Ncells * DF402.size();
+    const uint32_t fifth_data_type_pos = fourth_data_type_pos + Ncells * DF420.size();
+    message_writer.skip(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size() + DF403.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2822,15 +2751,12 @@ std::string Rtcm::get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF402(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
+            message_writer.put(first_data_type_pos + cell * DF400.size(), DF400);
+            message_writer.put(second_data_type_pos + cell * DF401.size(), DF401);
+            message_writer.put(third_data_type_pos + cell * DF402.size(), DF402);
+            message_writer.put(fourth_data_type_pos + cell * DF420.size(), DF420);
+            message_writer.put(fifth_data_type_pos + cell * DF403.size(), DF403);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -2880,7 +2806,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
             msg_number = 1075;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -2890,11 +2817,11 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::add_MSM_5_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_5_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -2904,13 +2831,8 @@ std::string Rtcm::print_MSM_5(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
+void Rtcm::add_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string sat_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
 
     Rtcm::set_DF394(observables);
     const uint32_t num_satellites = DF394.count();
@@ -2937,36 +2859,35 @@ std::string Rtcm::get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchr
 
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(observables_vector);
 
+    const auto reserved = std::bitset<4>("0000");
+
+    // Each data type is written for all the satellites before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + num_satellites * DF397.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + num_satellites * reserved.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + num_satellites * DF398.size();
+    message_writer.skip(num_satellites * (DF397.size() + reserved.size() + DF398.size() + DF399.size()));
     for (uint32_t nsat = 0; nsat < num_satellites; nsat++)
         {
             Rtcm::set_DF397(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF398(ordered_by_PRN_pos.at(nsat).second);
             Rtcm::set_DF399(ordered_by_PRN_pos.at(nsat).second);
-            auto reserved = std::bitset<4>("0000");
-            first_data_type += DF397.to_string();
-            second_data_type += reserved.to_string();
-            third_data_type += DF398.to_string();
-            fourth_data_type += DF399.to_string();
+            message_writer.put(first_data_type_pos + nsat * DF397.size(), DF397);
+            message_writer.put(second_data_type_pos + nsat * reserved.size(), reserved);
+            message_writer.put(third_data_type_pos + nsat * DF398.size(), DF398);
+            message_writer.put(fourth_data_type_pos + nsat * DF399.size(), DF399);
         }
-    sat_data = first_data_type + second_data_type + third_data_type + fourth_data_type;
-    return sat_data;
 }
 
 
-std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -2985,6 +2906,15 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF400.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF401.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + Ncells * DF402.size();
+    const uint32_t fifth_data_type_pos = fourth_data_type_pos + Ncells * DF420.size();
+    const uint32_t sixth_data_type_pos = fifth_data_type_pos + Ncells * DF403.size();
+    message_writer.skip(Ncells * (DF400.size() + DF401.size() + DF402.size() + DF420.size() + DF403.size() + DF404.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF400(ordered_by_PRN_pos.at(cell).second);
@@ -2993,16 +2923,13 @@ std::string Rtcm::get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF403(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF400.to_string();
-            second_data_type += DF401.to_string();
-            third_data_type += DF402.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF403.to_string();
-            sixth_data_type += DF404.to_string();
+            message_writer.put(first_data_type_pos + cell * DF400.size(), DF400);
+            message_writer.put(second_data_type_pos + cell * DF401.size(), DF401);
+            message_writer.put(third_data_type_pos + cell * DF402.size(), DF402);
+            message_writer.put(fourth_data_type_pos + cell * DF420.size(), DF420);
+            message_writer.put(fifth_data_type_pos + cell * DF403.size(), DF403);
+            message_writer.put(sixth_data_type_pos + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 
@@ -3052,7 +2979,8 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3062,11 +2990,11 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_4_content_sat_data(observables);
+    Rtcm::add_MSM_4_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_6_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3076,19 +3004,13 @@ std::string Rtcm::print_MSM_6(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3107,6 +3029,14 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF405.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF406.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + Ncells * DF407.size();
+    const uint32_t fifth_data_type_pos = fourth_data_type_pos + Ncells * DF420.size();
+    message_writer.skip(Ncells * (DF405.size() + DF406.size() + DF407.size() + DF420.size() + DF408.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3114,15 +3044,12 @@ std::string Rtcm::get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF407(ephNAV, ephCNAV, ephFNAV, ephGNAV, obs_time, ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
+            message_writer.put(first_data_type_pos + cell * DF405.size(), DF405);
+            message_writer.put(second_data_type_pos + cell * DF406.size(), DF406);
+            message_writer.put(third_data_type_pos + cell * DF407.size(), DF407);
+            message_writer.put(fourth_data_type_pos + cell * DF420.size(), DF420);
+            message_writer.put(fifth_data_type_pos + cell * DF408.size(), DF408);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type;
-    return signal_data;
 }
 
 
@@ -3172,7 +3099,8 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
             msg_number = 1076;
         }
 
-    const std::string header = Rtcm::get_MSM_header(msg_number,
+    message_writer.clear();
+    Rtcm::add_MSM_header(msg_number,
         obs_time,
         observables,
         ref_id,
@@ -3182,11 +3110,11 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
         divergence_free,
         more_messages);
 
-    const std::string sat_data = Rtcm::get_MSM_5_content_sat_data(observables);
+    Rtcm::add_MSM_5_content_sat_data(observables);
 
-    const std::string signal_data = Rtcm::get_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
+    Rtcm::add_MSM_7_content_signal_data(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, obs_time, observables);
 
-    std::string message = build_message(header + sat_data + signal_data);
+    std::string message = message_writer.frame();
     if (server_is_running)
         {
             rtcm_message_queue->push(message);
@@ -3196,20 +3124,13 @@ std::string Rtcm::print_MSM_7(const Gps_Ephemeris& gps_eph,
 }
 
 
-std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
+void Rtcm::add_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     const Gps_CNAV_Ephemeris& ephCNAV,
     const Galileo_Ephemeris& ephFNAV,
     const Glonass_Gnav_Ephemeris& ephGNAV,
     double obs_time,
     const std::map<int32_t, Gnss_Synchro>& observables)
 {
-    std::string signal_data;
-    std::string first_data_type;
-    std::string second_data_type;
-    std::string third_data_type;
-    std::string fourth_data_type;
-    std::string fifth_data_type;
-    std::string sixth_data_type;
 
     const uint32_t Ncells = observables.size();
 
@@ -3228,6 +3149,15 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
     std::reverse(ordered_by_signal.begin(), ordered_by_signal.end());
     const std::vector<std::pair<int32_t, Gnss_Synchro>> ordered_by_PRN_pos = Rtcm::sort_by_PRN_mask(ordered_by_signal);
 
+    // Each data type is written for all the cells before the next one, so
+    // the whole block is reserved and the fields are put at their positions
+    const uint32_t first_data_type_pos = message_writer.size();
+    const uint32_t second_data_type_pos = first_data_type_pos + Ncells * DF405.size();
+    const uint32_t third_data_type_pos = second_data_type_pos + Ncells * DF406.size();
+    const uint32_t fourth_data_type_pos = third_data_type_pos + Ncells * DF407.size();
+    const uint32_t fifth_data_type_pos = fourth_data_type_pos + Ncells * DF420.size();
+    const uint32_t sixth_data_type_pos = fifth_data_type_pos + Ncells * DF408.size();
+    message_writer.skip(Ncells * (DF405.size() + DF406.size() + DF407.size() + DF420.size() + DF408.size() + DF404.size()));
     for (uint32_t cell = 0; cell < Ncells; cell++)
         {
             Rtcm::set_DF405(ordered_by_PRN_pos.at(cell).second);
@@ -3236,16 +3166,13 @@ std::string Rtcm::get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV,
             Rtcm::set_DF420(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF408(ordered_by_PRN_pos.at(cell).second);
             Rtcm::set_DF404(ordered_by_PRN_pos.at(cell).second);
-            first_data_type += DF405.to_string();
-            second_data_type += DF406.to_string();
-            third_data_type += DF407.to_string();
-            fourth_data_type += DF420.to_string();
-            fifth_data_type += DF408.to_string();
-            sixth_data_type += DF404.to_string();
+            message_writer.put(first_data_type_pos + cell * DF405.size(), DF405);
+            message_writer.put(second_data_type_pos + cell * DF406.size(), DF406);
+            message_writer.put(third_data_type_pos + cell * DF407.size(), DF407);
+            message_writer.put(fourth_data_type_pos + cell * DF420.size(), DF420);
+            message_writer.put(fifth_data_type_pos + cell * DF408.size(), DF408);
+            message_writer.put(sixth_data_type_pos + cell * DF404.size(), DF404);
         }
-
-    signal_data = first_data_type + second_data_type + third_data_type + fourth_data_type + fifth_data_type + sixth_data_type;
-    return signal_data;
 }
 
 // SSR
@@ -5770,6 +5697,7 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
     std::string sig;
     std::vector<uint32_t> list_of_sats;
     std::vector<int> list_of_signals;
+    std::vector<std::pair<int, uint32_t>> list_of_cells;  // signal and PRN of each observable
 
     for (observables_iter = observables.cbegin();
          observables_iter != observables.cend();
@@ -5785,28 +5713,34 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
             if ((sig == "1C") && (sys == "G"))
                 {
                     list_of_signals.push_back(32 - 2);
+                    list_of_cells.emplace_back(32 - 2, observables_iter->second.PRN);
                 }
             if ((sig == "2S") && (sys == "G"))
                 {
                     list_of_signals.push_back(32 - 15);
+                    list_of_cells.emplace_back(32 - 15, observables_iter->second.PRN);
                 }
 
             if ((sig == "5X") && (sys == "G"))
                 {
                     list_of_signals.push_back(32 - 24);
+                    list_of_cells.emplace_back(32 - 24, observables_iter->second.PRN);
                 }
             if ((sig == "1B") && (sys == "E"))
                 {
                     list_of_signals.push_back(32 - 4);
+                    list_of_cells.emplace_back(32 - 4, observables_iter->second.PRN);
                 }
 
             if ((sig == "5X") && (sys == "E"))
                 {
                     list_of_signals.push_back(32 - 24);
+                    list_of_cells.emplace_back(32 - 24, observables_iter->second.PRN);
                 }
             if ((sig == "7X") && (sys == "E"))
                 {
                     list_of_signals.push_back(32 - 16);
+                    list_of_cells.emplace_back(32 - 16, observables_iter->second.PRN);
                 }
         }
 
@@ -5818,51 +5752,15 @@ std::string Rtcm::set_DF396(const std::map<int32_t, Gnss_Synchro>& observables)
     list_of_signals.erase(std::unique(list_of_signals.begin(), list_of_signals.end()), list_of_signals.end());
 
     // fill the matrix
-    bool value;
-
     for (uint32_t row = 0; row < num_signals; row++)
         {
+            // GLONASS signals are counted in DF395 but have no cells in the mask
+            const int signal = row < list_of_signals.size() ? list_of_signals[row] : 0;
             for (uint32_t sat = 0; sat < num_satellites; sat++)
                 {
-                    value = false;
-                    for (observables_iter = observables.cbegin();
-                         observables_iter != observables.cend();
-                         observables_iter++)
-                        {
-                            const std::string sig_(observables_iter->second.Signal);
-                            sig = sig_.substr(0, 2);
-                            const std::string sys(&observables_iter->second.System, 1);
-
-                            if ((sig == "1C") && (sys == "G") && (list_of_signals.at(row) == 32 - 2) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "2S") && (sys == "G") && (list_of_signals.at(row) == 32 - 15) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "5X") && (sys == "G") && (list_of_signals.at(row) == 32 - 24) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "1B") && (sys == "E") && (list_of_signals.at(row) == 32 - 4) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "5X") && (sys == "E") && (list_of_signals.at(row) == 32 - 24) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-
-                            if ((sig == "7X") && (sys == "E") && (list_of_signals.at(row) == 32 - 16) && (observables_iter->second.PRN == list_of_sats.at(sat)))
-                                {
-                                    value = true;
-                                }
-                        }
+                    const uint32_t prn = list_of_sats[sat];
+                    const bool value = std::any_of(list_of_cells.cbegin(), list_of_cells.cend(),
+                        [signal, prn](const std::pair<int, uint32_t>& cell) { return (cell.first == signal) && (cell.second == prn); });
                     matrix[row].push_back(value);
                 }
         }
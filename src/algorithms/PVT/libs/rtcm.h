@@ -27,6 +27,7 @@
 #include "gnss_synchro.h"
 #include "gps_cnav_ephemeris.h"
 #include "gps_ephemeris.h"
+#include "rtcm_bit_writer.h"
 #include <boost/asio.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <glog/logging.h>
@@ -395,9 +396,10 @@ public:
 
 private:
     //
-    // Generation of messages content
+    // Generation of messages content. The add_* methods append the data
+    // fields to message_writer.
     //
-    std::bitset<64> get_MT1001_4_header(uint32_t msg_number,
+    void add_MT1001_4_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -405,15 +407,15 @@ private:
         bool sync_flag,
         bool divergence_free);
 
-    std::bitset<58> get_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<74> get_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
-    std::bitset<101> get_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
-    std::bitset<125> get_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void add_MT1001_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void add_MT1002_sat_content(const Gps_Ephemeris& eph, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void add_MT1003_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void add_MT1004_sat_content(const Gps_Ephemeris& ephL1, const Gps_CNAV_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
     std::bitset<152> get_MT1005_test();
 
     /*!
-     * \brief Generates contents of message header for types 1009, 1010, 1011 and 1012. GLONASS RTK Message
+     * \brief Appends the message header for types 1009, 1010, 1011 and 1012. GLONASS RTK Message
      * \note Code added as part of GSoC 2017 program
      * \param msg_number Message type number, acceptable options include 1009 to 1012
      * \param obs_time Time of observation at the moment of printing
@@ -421,9 +423,8 @@ private:
      * \param ref_id
      * \param smooth_int
      * \param divergence_free
-     * \return Returns the message header content as set of bits
      */
-    std::bitset<61> get_MT1009_12_header(uint32_t msg_number,
+    void add_MT1009_12_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -432,27 +433,25 @@ private:
         bool divergence_free);
 
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1009 Message (GLONASS Basic RTK, L1 Only)
+     * \brief Appends the satellite specific portion of a type 1009 Message (GLONASS Basic RTK, L1 Only)
      * \details Contents generated for each satellite. See table 3.5-11
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<64> get_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void add_MT1009_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1010 Message (GLONASS Extended RTK, L1 Only)
+     * \brief Appends the satellite specific portion of a type 1010 Message (GLONASS Extended RTK, L1 Only)
      * \details Contents generated for each satellite. See table 3.5-12
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAV Ephemeris for GLONASS GNAV in L1 satellites
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchro Information generated by channels while processing the satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<79> get_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
+    void add_MT1010_sat_content(const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const Gnss_Synchro& gnss_synchro);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1011 Message (GLONASS Basic RTK, L1 & L2)
+     * \brief Appends the satellite specific portion of a type 1011 Message (GLONASS Basic RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-13
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAVL1 Ephemeris for GLONASS GNAV in L1 satellites
@@ -460,11 +459,10 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<107> get_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void add_MT1011_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
     /*!
-     * \brief Get the contents of the satellite specific portion of a type 1012 Message (GLONASS Extended RTK, L1 & L2)
+     * \brief Appends the satellite specific portion of a type 1012 Message (GLONASS Extended RTK, L1 & L2)
      * \details Contents generated for each satellite. See table 3.5-14
      * \note Code added as part of GSoC 2017 program
      * \param ephGNAVL1 Ephemeris for GLONASS GNAV in L1 satellites
@@ -472,11 +470,10 @@ private:
      * \param obs_time Time of observation at the moment of printing
      * \param gnss_synchroL1 Information generated by channels while processing the GLONASS GNAV L1 satellite
      * \param gnss_synchroL2 Information generated by channels while processing the GLONASS GNAV L2 satellite
-     * \return Returns the message content as set of bits
      */
-    std::bitset<130> get_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
+    void add_MT1012_sat_content(const Glonass_Gnav_Ephemeris& ephL1, const Glonass_Gnav_Ephemeris& ephL2, double obs_time, const Gnss_Synchro& gnss_synchroL1, const Gnss_Synchro& gnss_synchroL2);
 
-    std::string get_MSM_header(uint32_t msg_number,
+    void add_MSM_header(uint32_t msg_number,
         double obs_time,
         const std::map<int32_t, Gnss_Synchro>& observables,
         uint32_t ref_id,
@@ -486,17 +483,17 @@ private:
         bool divergence_free,
         bool more_messages);
 
-    std::string get_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_1_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_4_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_5_content_sat_data(const std::map<int32_t, Gnss_Synchro>& observables);
 
-    std::string get_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
-    std::string get_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_1_content_signal_data(const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_2_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_3_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_4_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_5_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_6_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
+    void add_MSM_7_content_signal_data(const Gps_Ephemeris& ephNAV, const Gps_CNAV_Ephemeris& ephCNAV, const Galileo_Ephemeris& ephFNAV, const Glonass_Gnav_Ephemeris& ephGNAV, double obs_time, const std::map<int32_t, Gnss_Synchro>& observables);
 
     std::string get_IGM01_header(const Galileo_HAS_data& has_data, uint8_t nsys, bool ssr_multiple_msg_indicator);
     std::string get_IGM01_content_sat(const Galileo_HAS_data& has_data, uint8_t nsys_index);
@@ -991,9 +988,7 @@ private:
     //
     // Transport Layer
     //
-    std::bitset<8> preamble;
-    std::bitset<6> reserved_field;
-    std::string add_CRC(const std::string& m) const;
+    Rtcm_Bit_Writer message_writer;                            // data fields of the message being generated
     std::string build_message(const std::string& data) const;  // adds 0s to complete a byte and adds the CRC
 
     //
@@ -0,0 +1,115 @@
+/*!
+ * \file rtcm_bit_writer.cc
+ * \brief Packs the data fields of RTCM 3 messages into a byte buffer and
+ * builds the transport layer frame.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "rtcm_bit_writer.h"
+#include <algorithm>  // for std::min, std::copy
+#include <array>
+
+
+Rtcm_Bit_Writer::Rtcm_Bit_Writer()
+{
+    d_data.reserve(1023);  // maximum message length allowed by the 10-bit length field
+}
+
+
+void Rtcm_Bit_Writer::clear()
+{
+    d_data.clear();
+    d_bits = 0;
+}
+
+
+void Rtcm_Bit_Writer::append(uint64_t value, uint32_t bits)
+{
+    skip(bits);
+    put(d_bits - bits, value, bits);
+}
+
+
+void Rtcm_Bit_Writer::append_bin(const std::string& bits)
+{
+    for (char bit : bits)
+        {
+            append(bit == '1' ? 1U : 0U, 1);
+        }
+}
+
+
+void Rtcm_Bit_Writer::skip(uint32_t bits)
+{
+    d_bits += bits;
+    d_data.resize((d_bits + 7) / 8, 0);
+}
+
+
+void Rtcm_Bit_Writer::put(uint32_t position, uint64_t value, uint32_t bits)
+{
+    while (bits > 0)
+        {
+            const uint32_t free_bits = 8 - (position & 7U);
+            const uint32_t n = std::min(free_bits, bits);
+            bits -= n;
+            const auto chunk = static_cast<uint32_t>(value >> bits) & ((1U << n) - 1U);
+            d_data[position >> 3] |= static_cast<uint8_t>(chunk << (free_bits - n));
+            position += n;
+        }
+}
+
+
+std::string Rtcm_Bit_Writer::frame() const
+{
+    const size_t length = d_data.size();
+    std::string message(length + 6, '\0');
+    auto* bytes = reinterpret_cast<uint8_t*>(&message[0]);
+    bytes[0] = 0xD3;                                      // preamble
+    bytes[1] = static_cast<uint8_t>((length >> 8) & 3U);  // 6 reserved bits and message length
+    bytes[2] = static_cast<uint8_t>(length & 0xFFU);
+    std::copy(d_data.begin(), d_data.end(), bytes + 3);
+    const uint32_t crc = crc24q(bytes, length + 3);
+    bytes[length + 3] = static_cast<uint8_t>(crc >> 16);
+    bytes[length + 4] = static_cast<uint8_t>(crc >> 8);
+    bytes[length + 5] = static_cast<uint8_t>(crc);
+    return message;
+}
+
+
+uint32_t Rtcm_Bit_Writer::crc24q(const uint8_t* data, size_t length)
+{
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t crc = i << 16;
+                for (int j = 0; j < 8; j++)
+                    {
+                        crc <<= 1;
+                        if (crc & 0x1000000U)
+                            {
+                                crc ^= 0x1864CFBU;
+                            }
+                    }
+                t[i] = crc & 0xFFFFFFU;
+            }
+        return t;
+    }();
+
+    uint32_t crc = 0;
+    for (size_t i = 0; i < length; i++)
+        {
+            crc = ((crc << 8) & 0xFFFFFFU) ^ table[(crc >> 16) ^ data[i]];
+        }
+    return crc;
+}
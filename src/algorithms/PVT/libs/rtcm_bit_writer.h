@@ -0,0 +1,115 @@
+/*!
+ * \file rtcm_bit_writer.h
+ * \brief Packs the data fields of RTCM 3 messages into a byte buffer and
+ * builds the transport layer frame.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTCM_BIT_WRITER_H
+#define GNSS_SDR_RTCM_BIT_WRITER_H
+
+#include <bitset>
+#include <cstddef>  // for size_t
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** \addtogroup PVT
+ * \{ */
+/** \addtogroup PVT_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes the data fields of an RTCM 3 message, most significant bit
+ * first, into a byte buffer that is reused from one message to the next.
+ *
+ * Fields are appended in message order. Messages that group the fields by
+ * type (e.g. the MSM satellite and signal data) can reserve a block of bits
+ * with skip() and fill it with put() at computed positions.
+ *
+ * frame() returns the complete transport layer frame (preamble, reserved
+ * bits, message length, data padded with zeros to a whole number of bytes and
+ * CRC-24Q parity), as binary data.
+ */
+class Rtcm_Bit_Writer
+{
+public:
+    Rtcm_Bit_Writer();
+
+    /*!
+     * \brief Starts a new message
+     */
+    void clear();
+
+    /*!
+     * \brief Appends value as a field of the given number of bits
+     */
+    void append(uint64_t value, uint32_t bits);
+
+    template <size_t N>
+    void append(const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are at most 64 bits long");
+        append(field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Appends a string of '0' and '1' characters
+     */
+    void append_bin(const std::string& bits);
+
+    /*!
+     * \brief Appends bits zeros, to be filled later with put()
+     */
+    void skip(uint32_t bits);
+
+    /*!
+     * \brief Writes a field at the given bit position of a block reserved
+     * with skip()
+     */
+    void put(uint32_t position, uint64_t value, uint32_t bits);
+
+    template <size_t N>
+    void put(uint32_t position, const std::bitset<N>& field)
+    {
+        static_assert(N <= 64, "RTCM data fields are at most 64 bits long");
+        put(position, field.to_ullong(), N);
+    }
+
+    /*!
+     * \brief Returns the number of data bits written so far
+     */
+    inline uint32_t size() const
+    {
+        return d_bits;
+    }
+
+    /*!
+     * \brief Returns the transport layer frame of the message
+     */
+    std::string frame() const;
+
+    /*!
+     * \brief Computes the Qualcomm CRC-24Q of length bytes
+     */
+    static uint32_t crc24q(const uint8_t* data, size_t length);
+
+private:
+    std::vector<uint8_t> d_data;
+    uint32_t d_bits{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_RTCM_BIT_WRITER_H
@@ -131,6 +131,18 @@ Rtklib_Solver::Rtklib_Solver(const rtk_t &rtk,
             break;
         }
 
+    // The RTKLIB navigation data point to persistent ephemeris tables indexed
+    // by satellite number, which are only updated when a new ephemeris arrives
+    d_nav_data.eph = d_eph_data.data();
+    d_nav_data.geph = d_geph_data.data();
+    d_nav_data.n = MAXSAT;
+    d_nav_data.ng = NSATGLO;
+    d_nav_data.ephidx = 1;
+    for (int sat = 1; sat <= MAXSAT; sat++)
+        {
+            update_wavelengths(sat);
+        }
+
     // ############# ENABLE DATA FILE LOG #################
     if (d_flag_dump_enabled == true)
         {
@@ -457,6 +469,128 @@ Monitor_Pvt Rtklib_Solver::get_monitor_pvt() const
 }
 
 
+void Rtklib_Solver::store_ephemeris(const Gps_Ephemeris &gps_eph)
+{
+    gps_ephemeris_map[gps_eph.PRN] = gps_eph;
+    update_ephemeris(gps_eph, true);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Gps_CNAV_Ephemeris &gps_cnav_eph)
+{
+    gps_cnav_ephemeris_map[gps_cnav_eph.PRN] = gps_cnav_eph;
+    update_ephemeris(gps_cnav_eph, true);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Galileo_Ephemeris &gal_eph)
+{
+    galileo_ephemeris_map[gal_eph.PRN] = gal_eph;
+    update_ephemeris(gal_eph, true);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Glonass_Gnav_Ephemeris &glonass_gnav_eph)
+{
+    glonass_gnav_ephemeris_map[glonass_gnav_eph.PRN] = glonass_gnav_eph;
+    update_glonass_clock_model();
+    update_ephemeris(glonass_gnav_eph, true);
+}
+
+
+void Rtklib_Solver::store_ephemeris(const Beidou_Dnav_Ephemeris &bds_dnav_eph)
+{
+    beidou_dnav_ephemeris_map[bds_dnav_eph.PRN] = bds_dnav_eph;
+    update_ephemeris(bds_dnav_eph, true);
+}
+
+
+// The ephemeris is converted if forced, or if the table of its satellite is
+// empty or holds an ephemeris with other reference or transmission times
+void Rtklib_Solver::update_ephemeris(const Gps_Ephemeris &gps_eph, bool force)
+{
+    const int sat = satno(SYS_GPS, gps_eph.PRN);
+    const std::pair<double, double> stamp(gps_eph.toe, gps_eph.tow);
+    if (sat > 0 && (force || d_gps_nav_eph_data[sat - 1].sat != sat || d_gps_nav_eph_stamp[sat - 1] != stamp))
+        {
+            d_gps_nav_eph_data[sat - 1] = eph_to_rtklib(gps_eph, this->is_pre_2009());
+            d_gps_nav_eph_stamp[sat - 1] = stamp;
+        }
+}
+
+
+void Rtklib_Solver::update_ephemeris(const Gps_CNAV_Ephemeris &gps_cnav_eph, bool force)
+{
+    const int sat = satno(SYS_GPS, gps_cnav_eph.PRN);
+    const std::pair<double, double> stamp(gps_cnav_eph.toe1, gps_cnav_eph.tow);
+    if (sat > 0 && (force || d_gps_cnav_eph_data[sat - 1].sat != sat || d_gps_cnav_eph_stamp[sat - 1] != stamp))
+        {
+            d_gps_cnav_eph_data[sat - 1] = eph_to_rtklib(gps_cnav_eph);
+            d_gps_cnav_eph_stamp[sat - 1] = stamp;
+        }
+}
+
+
+void Rtklib_Solver::update_ephemeris(const Galileo_Ephemeris &gal_eph, bool force)
+{
+    const int sat = satno(SYS_GAL, gal_eph.PRN);
+    const std::pair<double, double> stamp(gal_eph.toe, gal_eph.tow);
+    if (sat > 0 && (force || d_eph_data[sat - 1].sat != sat || d_eph_stamp[sat - 1] != stamp))
+        {
+            d_eph_data[sat - 1] = eph_to_rtklib(gal_eph);
+            d_eph_stamp[sat - 1] = stamp;
+        }
+}
+
+
+void Rtklib_Solver::update_ephemeris(const Glonass_Gnav_Ephemeris &glonass_gnav_eph, bool force)
+{
+    const int sat = satno(SYS_GLO, glonass_gnav_eph.i_satellite_slot_number);
+    const std::pair<double, double> stamp(glonass_gnav_eph.d_t_b, glonass_gnav_eph.d_t_k);
+    if (sat > 0 && (force || d_geph_data[sat - NSATGPS - 1].sat != sat || d_geph_stamp[sat - NSATGPS - 1] != stamp))
+        {
+            d_geph_data[sat - NSATGPS - 1] = eph_to_rtklib(glonass_gnav_eph, glonass_gnav_utc_model);
+            d_geph_stamp[sat - NSATGPS - 1] = stamp;
+            update_wavelengths(sat);
+        }
+}
+
+
+void Rtklib_Solver::update_ephemeris(const Beidou_Dnav_Ephemeris &bds_dnav_eph, bool force)
+{
+    const int sat = satno(SYS_BDS, bds_dnav_eph.PRN);
+    const std::pair<double, double> stamp(bds_dnav_eph.toe, bds_dnav_eph.tow);
+    if (sat > 0 && (force || d_eph_data[sat - 1].sat != sat || d_eph_stamp[sat - 1] != stamp))
+        {
+            d_eph_data[sat - 1] = eph_to_rtklib(bds_dnav_eph);
+            d_eph_stamp[sat - 1] = stamp;
+        }
+}
+
+
+void Rtklib_Solver::update_wavelengths(int sat)
+{
+    // GLONASS wavelengths depend on the frequency channel of the ephemeris
+    for (int j = 0; j < NFREQ; j++)
+        {
+            d_nav_data.lam[sat - 1][j] = satwavelen(sat, d_rtklib_freq_index[j], &d_nav_data);
+        }
+}
+
+
+void Rtklib_Solver::update_glonass_clock_model()
+{
+    // The GLONASS ephemerides are converted to GPS time with the clock model,
+    // so they are converted again after a new one arrives
+    if (glonass_gnav_utc_model.d_tau_c != d_glonass_tau_c or glonass_gnav_utc_model.d_tau_gps != d_glonass_tau_gps)
+        {
+            d_glonass_tau_c = glonass_gnav_utc_model.d_tau_c;
+            d_glonass_tau_gps = glonass_gnav_utc_model.d_tau_gps;
+            d_geph_data.fill({});
+        }
+}
+
+
 bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_map, bool flag_averaging)
 {
     std::map<int, Gnss_Synchro>::const_iterator gnss_observables_iter;
@@ -466,8 +600,6 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     std::map<int, Glonass_Gnav_Ephemeris>::const_iterator glonass_gnav_ephemeris_iter;
     std::map<int, Beidou_Dnav_Ephemeris>::const_iterator beidou_ephemeris_iter;
 
-    const Glonass_Gnav_Utc_Model &gnav_utc = this->glonass_gnav_utc_model;
-
     this->set_averaging_flag(flag_averaging);
 
     // ********************************************************************************
@@ -477,8 +609,8 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     int glo_valid_obs = 0;  // GLONASS L1/L2 valid observations counter
 
     d_obs_data.fill({});
-    std::vector<eph_t> eph_data(MAXOBS);
-    std::vector<geph_t> geph_data(MAXOBS);
+    d_obs_index.fill(-1);
+    update_glonass_clock_model();
 
     // Workaround for NAV/CNAV clash problem
     bool gps_dual_band = false;
@@ -514,6 +646,10 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
             gps_dual_band = true;
         }
 
+    // The ephemerides are converted to RTKLIB structures when they are stored,
+    // in tables indexed by satellite number, so each observation only selects
+    // the ephemeris of its satellite. Entries that were added or replaced
+    // directly in the maps are converted here.
     for (gnss_observables_iter = gnss_observables_map.cbegin();
          gnss_observables_iter != gnss_observables_map.cend();
          ++gnss_observables_iter)  // CHECK INCONSISTENCY when combining GLONASS + other system
@@ -523,17 +659,18 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 case 'E':
                     {
                         const std::string sig_(gnss_observables_iter->second.Signal);
+                        const int sat = satno(SYS_GAL, static_cast<int>(gnss_observables_iter->second.PRN));
                         // Galileo E1
                         if (sig_ == "1B")
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
+                                if (galileo_ephemeris_iter != galileo_ephemeris_map.cend() && sat > 0)
                                     {
-                                        // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                        update_ephemeris(galileo_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
+                                        d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                             gnss_observables_iter->second,
                                             galileo_ephemeris_iter->second.WN,
@@ -546,76 +683,32 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                     }
                             }
 
-                        // Galileo E5
-                        if ((sig_ == "5X") || (sig_ == "7X"))
+                        // Galileo E5 and E6
+                        if ((sig_ == "5X") || (sig_ == "7X") || (sig_ == "E6" && d_use_e6_for_pvt))
                             {
                                 // 1 Gal - find the ephemeris for the current GALILEO SV observation. The SV PRN ID is the map key
                                 galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
+                                if (galileo_ephemeris_iter != galileo_ephemeris_map.cend() && sat > 0)
                                     {
-                                        bool found_E1_obs = false;
-                                        for (int i = 0; i < valid_obs; i++)
-                                            {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
-                                                    {
-                                                        d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
-                                                            gnss_observables_iter->second,
-                                                            galileo_ephemeris_iter->second.WN,
-                                                            d_rtklib_band_index[sig_]);
-                                                        found_E1_obs = true;
-                                                        break;
-                                                    }
-                                            }
-                                        if (!found_E1_obs)
+                                        const int obs_index = d_obs_index[sat - 1];
+                                        if (obs_index >= 0)
                                             {
-                                                // insert Galileo E5 obs as new obs and also insert its ephemeris
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
-                                                // convert observation from GNSS-SDR class to RTKLIB structure
-                                                const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
-                                                obsd_t newobs = {{0, 0}, '0', '0', {}, {},
-                                                    {default_code_, default_code_, default_code_},
-                                                    {}, {0.0, 0.0, 0.0}, {}};
-                                                d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
+                                                // attach the observation to the existing one of the same SV
+                                                d_obs_data[obs_index] = insert_obs_to_rtklib(d_obs_data[obs_index],
                                                     gnss_observables_iter->second,
                                                     galileo_ephemeris_iter->second.WN,
                                                     d_rtklib_band_index[sig_]);
-                                                valid_obs++;
-                                            }
-                                    }
-                                else  // the ephemeris are not available for this SV
-                                    {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
-                                    }
-                            }
-                        if (sig_ == "E6" && d_use_e6_for_pvt)
-                            {
-                                galileo_ephemeris_iter = galileo_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (galileo_ephemeris_iter != galileo_ephemeris_map.cend())
-                                    {
-                                        bool found_E1_obs = false;
-                                        for (int i = 0; i < valid_obs; i++)
-                                            {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO)))
-                                                    {
-                                                        d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
-                                                            gnss_observables_iter->second,
-                                                            galileo_ephemeris_iter->second.WN,
-                                                            d_rtklib_band_index[sig_]);
-                                                        found_E1_obs = true;
-                                                        break;
-                                                    }
                                             }
-                                        if (!found_E1_obs)
+                                        else
                                             {
-                                                // insert Galileo E6 obs as new obs and also insert its ephemeris
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(galileo_ephemeris_iter->second);
+                                                // insert Galileo E5 or E6 obs as new obs
+                                                update_ephemeris(galileo_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
+                                                d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                                     gnss_observables_iter->second,
                                                     galileo_ephemeris_iter->second.WN,
@@ -635,15 +728,17 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         // GPS L1
                         // 1 GPS - find the ephemeris for the current GPS SV observation. The SV PRN ID is the map key
                         const std::string sig_(gnss_observables_iter->second.Signal);
+                        const int sat = satno(SYS_GPS, static_cast<int>(gnss_observables_iter->second.PRN));
                         if (sig_ == "1C")
                             {
                                 gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (gps_ephemeris_iter != gps_ephemeris_map.cend())
+                                if (gps_ephemeris_iter != gps_ephemeris_map.cend() && sat > 0)
                                     {
-                                        // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(gps_ephemeris_iter->second, this->is_pre_2009());
+                                        update_ephemeris(gps_ephemeris_iter->second);
+                                        d_eph_data[sat - 1] = d_gps_nav_eph_data[sat - 1];
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
+                                        d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                             gnss_observables_iter->second,
                                             gps_ephemeris_iter->second.WN,
@@ -660,7 +755,7 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         if ((sig_ == "2S") and (gps_dual_band == false))
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
+                                if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend() && sat > 0)
                                     {
                                         // 1. Find the same satellite in GPS L1 band
                                         gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
@@ -669,30 +764,28 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                                                 /* By the moment, GPS L2 observables are not used in pseudorange computations if GPS L1 is available
                                                 // 2. If found, replace the existing GPS L1 ephemeris with the GPS L2 ephemeris
                                                 // (more precise!), and attach the L2 observation to the L1 observation in RTKLIB structure
-                                                for (int i = 0; i < valid_obs; i++)
+                                                const int obs_index = d_obs_index[sat - 1];
+                                                if (obs_index >= 0)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
-                                                            {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
-                                                                d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
-                                                                    gnss_observables_iter->second,
-                                                                    eph_data[i].week,
-                                                                    d_rtklib_band_index[sig_]);
-                                                                break;
-                                                            }
+                                                        d_eph_data[sat - 1] = d_gps_cnav_eph_data[sat - 1];
+                                                        d_obs_data[obs_index] = insert_obs_to_rtklib(d_obs_data[obs_index],
+                                                            gnss_observables_iter->second,
+                                                            d_eph_data[sat - 1].week,
+                                                            d_rtklib_band_index[sig_]);
                                                     }
                                                 */
                                             }
                                         else
                                             {
                                                 // 3. If not found, insert the GPS L2 ephemeris and the observation
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                update_ephemeris(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[sat - 1] = d_gps_cnav_eph_data[sat - 1];
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
+                                                d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                                     gnss_observables_iter->second,
                                                     gps_cnav_ephemeris_iter->second.WN,
@@ -709,37 +802,35 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         if (sig_ == "L5")
                             {
                                 gps_cnav_ephemeris_iter = gps_cnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend())
+                                if (gps_cnav_ephemeris_iter != gps_cnav_ephemeris_map.cend() && sat > 0)
                                     {
+                                        update_ephemeris(gps_cnav_ephemeris_iter->second);
                                         // 1. Find the same satellite in GPS L1 band
                                         gps_ephemeris_iter = gps_ephemeris_map.find(gnss_observables_iter->second.PRN);
                                         if (gps_ephemeris_iter != gps_ephemeris_map.cend())
                                             {
                                                 // 2. If found, replace the existing GPS L1 ephemeris with the GPS L5 ephemeris
                                                 // (more precise!), and attach the L5 observation to the L1 observation in RTKLIB structure
-                                                for (int i = 0; i < valid_obs; i++)
+                                                const int obs_index = d_obs_index[sat - 1];
+                                                if (obs_index >= 0)
                                                     {
-                                                        if (eph_data[i].sat == static_cast<int>(gnss_observables_iter->second.PRN))
-                                                            {
-                                                                eph_data[i] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
-                                                                d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i],
-                                                                    gnss_observables_iter->second,
-                                                                    gps_cnav_ephemeris_iter->second.WN,
-                                                                    d_rtklib_band_index[sig_]);
-                                                                break;
-                                                            }
+                                                        d_eph_data[sat - 1] = d_gps_cnav_eph_data[sat - 1];
+                                                        d_obs_data[obs_index] = insert_obs_to_rtklib(d_obs_data[obs_index],
+                                                            gnss_observables_iter->second,
+                                                            gps_cnav_ephemeris_iter->second.WN,
+                                                            d_rtklib_band_index[sig_]);
                                                     }
                                             }
                                         else
                                             {
                                                 // 3. If not found, insert the GPS L5 ephemeris and the observation
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(gps_cnav_ephemeris_iter->second);
+                                                d_eph_data[sat - 1] = d_gps_cnav_eph_data[sat - 1];
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
+                                                d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                                     gnss_observables_iter->second,
                                                     gps_cnav_ephemeris_iter->second.WN,
@@ -757,55 +848,30 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                 case 'R':  // TODO This should be using rtk lib nomenclature
                     {
                         const std::string sig_(gnss_observables_iter->second.Signal);
-                        // GLONASS GNAV L1
-                        if (sig_ == "1G")
+                        const int sat = satno(SYS_GLO, static_cast<int>(gnss_observables_iter->second.PRN));
+                        // GLONASS GNAV L1 and L2
+                        if (sig_ == "1G" || sig_ == "2G")
                             {
                                 // 1 Glo - find the ephemeris for the current GLONASS SV observation. The SV Slot Number (PRN ID) is the map key
                                 glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
+                                const int eph_sat = glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend() ? satno(SYS_GLO, glonass_gnav_ephemeris_iter->second.i_satellite_slot_number) : 0;
+                                if (eph_sat > 0 && sat > 0)
                                     {
-                                        // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
-                                        // convert observation from GNSS-SDR class to RTKLIB structure
-                                        obsd_t newobs{};
-                                        d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
-                                            gnss_observables_iter->second,
-                                            glonass_gnav_ephemeris_iter->second.d_WN,
-                                            d_rtklib_band_index[sig_]);
-                                        glo_valid_obs++;
-                                    }
-                                else  // the ephemeris are not available for this SV
-                                    {
-                                        DLOG(INFO) << "No ephemeris data for SV " << gnss_observables_iter->second.PRN;
-                                    }
-                            }
-                        // GLONASS GNAV L2
-                        if (sig_ == "2G")
-                            {
-                                // 1 GLONASS - find the ephemeris for the current GLONASS SV observation. The SV PRN ID is the map key
-                                glonass_gnav_ephemeris_iter = glonass_gnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (glonass_gnav_ephemeris_iter != glonass_gnav_ephemeris_map.cend())
-                                    {
-                                        bool found_L1_obs = false;
-                                        for (int i = 0; i < glo_valid_obs; i++)
+                                        const int obs_index = d_obs_index[sat - 1];
+                                        if (sig_ == "2G" && obs_index >= 0)
                                             {
-                                                if (geph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS)))
-                                                    {
-                                                        d_obs_data[i + valid_obs] = insert_obs_to_rtklib(d_obs_data[i + valid_obs],
-                                                            gnss_observables_iter->second,
-                                                            glonass_gnav_ephemeris_iter->second.d_WN,
-                                                            d_rtklib_band_index[sig_]);
-                                                        found_L1_obs = true;
-                                                        break;
-                                                    }
+                                                // attach the L2 observation to the L1 observation of the same SV
+                                                d_obs_data[obs_index] = insert_obs_to_rtklib(d_obs_data[obs_index],
+                                                    gnss_observables_iter->second,
+                                                    glonass_gnav_ephemeris_iter->second.d_WN,
+                                                    d_rtklib_band_index[sig_]);
                                             }
-                                        if (!found_L1_obs)
+                                        else
                                             {
-                                                // insert GLONASS GNAV L2 obs as new obs and also insert its ephemeris
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                geph_data[glo_valid_obs] = eph_to_rtklib(glonass_gnav_ephemeris_iter->second, gnav_utc);
+                                                update_ephemeris(glonass_gnav_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 obsd_t newobs{};
+                                                d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                                     gnss_observables_iter->second,
                                                     glonass_gnav_ephemeris_iter->second.d_WN,
@@ -825,15 +891,16 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         // BEIDOU B1I
                         //  - find the ephemeris for the current BEIDOU SV observation. The SV PRN ID is the map key
                         const std::string sig_(gnss_observables_iter->second.Signal);
+                        const int sat = satno(SYS_BDS, static_cast<int>(gnss_observables_iter->second.PRN));
                         if (sig_ == "B1")
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
+                                if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend() && sat > 0)
                                     {
-                                        // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                        eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                        update_ephemeris(beidou_ephemeris_iter->second);
                                         // convert observation from GNSS-SDR class to RTKLIB structure
                                         obsd_t newobs{};
+                                        d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                         d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                             gnss_observables_iter->second,
                                             beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
@@ -849,31 +916,27 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                         if (sig_ == "B3")
                             {
                                 beidou_ephemeris_iter = beidou_dnav_ephemeris_map.find(gnss_observables_iter->second.PRN);
-                                if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend())
+                                if (beidou_ephemeris_iter != beidou_dnav_ephemeris_map.cend() && sat > 0)
                                     {
-                                        bool found_B1I_obs = false;
-                                        for (int i = 0; i < valid_obs; i++)
+                                        const int obs_index = d_obs_index[sat - 1];
+                                        if (obs_index >= 0)
                                             {
-                                                if (eph_data[i].sat == (static_cast<int>(gnss_observables_iter->second.PRN + NSATGPS + NSATGLO + NSATGAL + NSATQZS)))
-                                                    {
-                                                        d_obs_data[i + glo_valid_obs] = insert_obs_to_rtklib(d_obs_data[i + glo_valid_obs],
-                                                            gnss_observables_iter->second,
-                                                            beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
-                                                            d_rtklib_band_index[sig_]);
-                                                        found_B1I_obs = true;
-                                                        break;
-                                                    }
+                                                // attach the B3I observation to the B1I observation of the same SV
+                                                d_obs_data[obs_index] = insert_obs_to_rtklib(d_obs_data[obs_index],
+                                                    gnss_observables_iter->second,
+                                                    beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
+                                                    d_rtklib_band_index[sig_]);
                                             }
-                                        if (!found_B1I_obs)
+                                        else
                                             {
-                                                // insert BeiDou B3I obs as new obs and also insert its ephemeris
-                                                // convert ephemeris from GNSS-SDR class to RTKLIB structure
-                                                eph_data[valid_obs] = eph_to_rtklib(beidou_ephemeris_iter->second);
+                                                // insert BeiDou B3I obs as new obs
+                                                update_ephemeris(beidou_ephemeris_iter->second);
                                                 // convert observation from GNSS-SDR class to RTKLIB structure
                                                 const auto default_code_ = static_cast<unsigned char>(CODE_NONE);
                                                 obsd_t newobs = {{0, 0}, '0', '0', {}, {},
                                                     {default_code_, default_code_, default_code_},
                                                     {}, {0.0, 0.0, 0.0}, {}};
+                                                d_obs_index[sat - 1] = valid_obs + glo_valid_obs;
                                                 d_obs_data[valid_obs + glo_valid_obs] = insert_obs_to_rtklib(newobs,
                                                     gnss_observables_iter->second,
                                                     beidou_ephemeris_iter->second.WN + BEIDOU_DNAV_BDT2GPST_WEEK_NUM_OFFSET,
@@ -903,11 +966,6 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
     if ((valid_obs + glo_valid_obs) > 3)
         {
             int result = 0;
-            d_nav_data = {};
-            d_nav_data.eph = eph_data.data();
-            d_nav_data.geph = geph_data.data();
-            d_nav_data.n = valid_obs;
-            d_nav_data.ng = glo_valid_obs;
             if (gps_iono.valid)
                 {
                     d_nav_data.ion_gps[0] = gps_iono.alpha0;
@@ -988,15 +1046,6 @@ bool Rtklib_Solver::get_PVT(const std::map<int, Gnss_Synchro> &gnss_observables_
                     d_nav_data.leaps = beidou_dnav_utc_model.DeltaT_LS;
                 }
 
-            /* update carrier wave length using native function call in RTKlib */
-            for (int i = 0; i < MAXSAT; i++)
-                {
-                    for (int j = 0; j < NFREQ; j++)
-                        {
-                            d_nav_data.lam[i][j] = satwavelen(i + 1, d_rtklib_freq_index[j], &d_nav_data);
-                        }
-                }
-
             result = rtkpos(&d_rtk, d_obs_data.data(), valid_obs + glo_valid_obs, &d_nav_data);
 
             if (result == 0)
@@ -62,6 +62,7 @@
 #include <fstream>
 #include <map>
 #include <string>
+#include <utility>
 
 /** \addtogroup PVT
  * \{ */
@@ -84,6 +85,10 @@ public:
         bool use_e6_for_pvt = true);
     ~Rtklib_Solver();
 
+    // d_nav_data points to the ephemeris tables of the object
+    Rtklib_Solver(const Rtklib_Solver&) = delete;
+    Rtklib_Solver& operator=(const Rtklib_Solver&) = delete;
+
     bool get_PVT(const std::map<int, Gnss_Synchro>& gnss_observables_map, bool flag_averaging);
 
     double get_hdop() const override;
@@ -92,6 +97,21 @@ public:
     double get_gdop() const override;
     Monitor_Pvt get_monitor_pvt() const;
 
+    /*!
+     * \brief Stores a new ephemeris in its map and updates the RTKLIB
+     * navigation data of the satellite, so get_PVT() does not convert the
+     * ephemerides on every epoch.
+     *
+     * Entries added or replaced directly in the maps are converted by
+     * get_PVT() when their reference time (toe) or transmission time differ
+     * from the ones of the converted ephemeris.
+     */
+    void store_ephemeris(const Gps_Ephemeris& gps_eph);
+    void store_ephemeris(const Gps_CNAV_Ephemeris& gps_cnav_eph);
+    void store_ephemeris(const Galileo_Ephemeris& gal_eph);
+    void store_ephemeris(const Glonass_Gnav_Ephemeris& glonass_gnav_eph);
+    void store_ephemeris(const Beidou_Dnav_Ephemeris& bds_dnav_eph);
+
     sol_t pvt_sol{};
     std::array<ssat_t, MAXSAT> pvt_ssat{};
 
@@ -121,6 +141,13 @@ public:
 
 private:
     bool save_matfile() const;
+    void update_ephemeris(const Gps_Ephemeris& gps_eph, bool force = false);
+    void update_ephemeris(const Gps_CNAV_Ephemeris& gps_cnav_eph, bool force = false);
+    void update_ephemeris(const Galileo_Ephemeris& gal_eph, bool force = false);
+    void update_ephemeris(const Glonass_Gnav_Ephemeris& glonass_gnav_eph, bool force = false);
+    void update_ephemeris(const Beidou_Dnav_Ephemeris& bds_dnav_eph, bool force = false);
+    void update_wavelengths(int sat);
+    void update_glonass_clock_model();
 
     std::array<obsd_t, MAXOBS> d_obs_data{};
     std::array<double, 4> d_dop{};
@@ -130,7 +157,18 @@ private:
     std::ofstream d_dump_file;
     rtk_t d_rtk{};
     nav_t d_nav_data{};
+    std::array<eph_t, MAXSAT> d_eph_data{};                                 // ephemeris used by RTKLIB, indexed by sat - 1
+    std::array<geph_t, NSATGLO> d_geph_data{};                              // GLONASS ephemeris used by RTKLIB, indexed by slot - 1
+    std::array<eph_t, NSATGPS> d_gps_nav_eph_data{};                        // GPS L1 C/A ephemeris, indexed by PRN - 1
+    std::array<eph_t, NSATGPS> d_gps_cnav_eph_data{};                       // GPS CNAV ephemeris, indexed by PRN - 1
+    std::array<std::pair<double, double>, MAXSAT> d_eph_stamp{};            // reference and transmission times of the ephemerides in d_eph_data
+    std::array<std::pair<double, double>, NSATGLO> d_geph_stamp{};          // reference and transmission times of the ephemerides in d_geph_data
+    std::array<std::pair<double, double>, NSATGPS> d_gps_nav_eph_stamp{};   // reference and transmission times of the ephemerides in d_gps_nav_eph_data
+    std::array<std::pair<double, double>, NSATGPS> d_gps_cnav_eph_stamp{};  // reference and transmission times of the ephemerides in d_gps_cnav_eph_data
+    std::array<int, MAXSAT> d_obs_index{};                                  // index of the observation of each satellite in d_obs_data
     Monitor_Pvt d_monitor_pvt{};
+    double d_glonass_tau_c{0.0};    // GLONASS time scale corrections used by d_geph_data
+    double d_glonass_tau_gps{0.0};
     uint32_t d_type_of_rx;
     bool d_flag_dump_enabled;
     bool d_flag_dump_mat_enabled;
@@ -140,6 +140,12 @@ void BeidouB1iPcpsAcquisition::init()
 
 void BeidouB1iPcpsAcquisition::set_local_code()
 {
+    // The replica only depends on the signal and PRN
+    if (acquisition_->set_cached_local_code(std::string()))
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     beidou_b1i_code_gen_complex_sampled(code, gnss_synchro_->PRN, fs_in_, 0);
@@ -150,7 +156,7 @@ void BeidouB1iPcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), std::string());
 }
 
 
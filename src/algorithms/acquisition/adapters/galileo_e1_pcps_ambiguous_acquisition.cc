@@ -152,6 +152,12 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
     bool cboc = configuration_->property(
         "Acquisition" + std::to_string(channel_) + ".cboc", false);
 
+    const std::string code_options = std::string(acquire_pilot_ ? "pilot" : "data") + (cboc ? " cboc" : " boc");
+    if (acquisition_->set_cached_local_code(code_options))
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     if (acquire_pilot_ == true)
@@ -193,7 +199,7 @@ void GalileoE1PcpsAmbiguousAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), code_options);
 }
 
 
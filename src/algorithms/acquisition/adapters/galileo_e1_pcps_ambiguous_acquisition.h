@@ -99,6 +99,14 @@ public:
         acquisition_->set_channel_fsm(channel_fsm);
     }
 
+    /*!
+     * \brief Set the RF channel that feeds this acquisition instance
+     */
+    inline void set_rf_channel(uint32_t rf_channel) override
+    {
+        acquisition_->set_rf_channel(rf_channel);
+    }
+
     /*!
      * \brief Set statistics threshold of PCPS algorithm
      */
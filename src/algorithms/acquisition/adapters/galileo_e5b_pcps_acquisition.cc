@@ -143,7 +143,6 @@ void GalileoE5bPcpsAcquisition::init()
 
 void GalileoE5bPcpsAcquisition::set_local_code()
 {
-    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
     std::array<char, 3> signal_{};
     signal_[0] = '7';
     signal_[2] = '\0';
@@ -161,6 +160,14 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             signal_[1] = 'I';
         }
 
+    const std::string code_options(signal_.data());
+    if (acquisition_->set_cached_local_code(code_options))
+        {
+            return;
+        }
+
+    volk_gnsssdr::vector<std::complex<float>> code(code_length_);
+
     if (acq_parameters_.use_automatic_resampler)
         {
             galileo_e5_b_code_gen_complex_sampled(code, gnss_synchro_->PRN, signal_, acq_parameters_.resampled_fs, 0);
@@ -175,7 +182,7 @@ void GalileoE5bPcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), code_options);
 }
 
 
@@ -147,6 +147,12 @@ void GalileoE6PcpsAcquisition::init()
 
 void GalileoE6PcpsAcquisition::set_local_code()
 {
+    // The replica only depends on the signal and PRN
+    if (acquisition_->set_cached_local_code(std::string()))
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     if (acq_parameters_.use_automatic_resampler)
@@ -166,7 +172,7 @@ void GalileoE6PcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), std::string());
 }
 
 
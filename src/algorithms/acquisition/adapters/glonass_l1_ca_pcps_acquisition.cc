@@ -141,6 +141,12 @@ void GlonassL1CaPcpsAcquisition::init()
 
 void GlonassL1CaPcpsAcquisition::set_local_code()
 {
+    // The replica only depends on the signal and PRN
+    if (acquisition_->set_cached_local_code(std::string()))
+        {
+            return;
+        }
+
     volk_gnsssdr::vector<std::complex<float>> code(code_length_);
 
     glonass_l1_ca_code_gen_complex_sampled(code, fs_in_, 0);
@@ -151,7 +157,7 @@ void GlonassL1CaPcpsAcquisition::set_local_code()
             std::copy_n(code.data(), code_length_, code_span.subspan(i * code_length_, code_length_).data());
         }
 
-    acquisition_->set_local_code(code_.data());
+    acquisition_->set_local_code(code_.data(), std::string());
 }
 
 
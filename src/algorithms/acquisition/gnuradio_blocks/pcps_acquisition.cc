@@ -33,11 +33,42 @@
 #include <pmt/pmt_sugar.h>  // for mp
 #include <volk/volk.h>
 #include <volk_gnsssdr/volk_gnsssdr.h>
-#include <algorithm>  // for std::fill_n, std::min, std::copy
+#include <algorithm>  // for std::fill_n, std::min, std::copy, std::find_if
 #include <array>
-#include <cmath>  // for floor, fmod, rint, ceil
+#include <atomic>
+#include <cmath>       // for floor, fmod, rint, ceil
+#include <functional>  // for std::function
 #include <iostream>
+#include <iterator>  // for std::distance
 #include <map>
+#include <thread>
+
+
+namespace
+{
+// FFT plans and scratch buffer of a worker pool thread, for a given FFT size.
+// They live as long as the thread, and are shared by all the channels.
+struct Doppler_Helper_Buffers
+{
+    std::unique_ptr<gnss_fft_complex_fwd> fft_if;
+    std::unique_ptr<gnss_fft_complex_rev> ifft;
+    volk_gnsssdr::vector<float> tmp_buffer;
+};
+
+
+Doppler_Helper_Buffers& doppler_helper_buffers(uint32_t fft_size)
+{
+    thread_local std::map<uint32_t, Doppler_Helper_Buffers> buffers;
+    auto& entry = buffers[fft_size];
+    if (!entry.fft_if)
+        {
+            entry.fft_if = gnss_fft_fwd_make_unique(fft_size);
+            entry.ifft = gnss_fft_rev_make_unique(fft_size);
+            entry.tmp_buffer = volk_gnsssdr::vector<float>(fft_size);
+        }
+    return entry;
+}
+}  // namespace
 
 
 pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_)
@@ -55,6 +86,8 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_dump_filename(conf_.dump_filename),
       d_dump_number(0LL),
       d_sample_counter(0ULL),
+      d_batch_sample_stamp(0ULL),
+      d_batch_fingerprint(0ULL),
       d_threshold(0.0),
       d_mag(0),
       d_input_power(0.0),
@@ -73,15 +106,25 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
       d_num_doppler_bins_step2(conf_.num_doppler_bins_step2),
       d_dump_channel(conf_.dump_channel),
       d_buffer_count(0U),
+      d_doppler_threads(conf_.doppler_threads),
       d_active(false),
       d_worker_active(false),
       d_step_two(false),
 	  d_step_repeat(false),
       d_use_CFAR_algorithm_flag(conf_.use_CFAR_algorithm_flag),
+      d_frequency_domain_doppler(conf_.frequency_domain_doppler),
+      d_batch_acquisition(conf_.batch_acquisition),
       d_dump(conf_.dump)
 {
     this->message_port_register_out(pmt::mp("events"));
 
+    if (d_batch_acquisition && d_acq_parameters.blocking_on_standby)
+        {
+            // Channels that do not consume samples on standby never see the same blocks as the others
+            LOG(WARNING) << "Batch acquisition requires blocking_on_standby=false. Batch acquisition has been disabled";
+            d_batch_acquisition = false;
+        }
+
     if (d_acq_parameters.sampled_ms == d_acq_parameters.ms_per_code)
         {
             d_fft_size = d_consumed_samples;
@@ -109,7 +152,7 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
     // }
 
     d_tmp_buffer = volk_gnsssdr::vector<float>(d_fft_size);
-    d_fft_codes = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
+    d_fft_codes = std::make_shared<const Acq_Replica_Cache::spectrum_type>(d_fft_size);
     d_input_signal = volk_gnsssdr::vector<std::complex<float>>(d_fft_size);
     d_fft_if = gnss_fft_fwd_make_unique(d_fft_size);
     d_ifft = gnss_fft_rev_make_unique(d_fft_size);
@@ -166,6 +209,12 @@ pcps_acquisition::pcps_acquisition(const Acq_Conf& conf_)
 }
 
 
+pcps_acquisition::~pcps_acquisition()
+{
+    leave_batch();
+}
+
+
 void pcps_acquisition::set_resampler_latency(uint32_t latency_samples)
 {
     gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
@@ -180,11 +229,93 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
         {
             update_grid_doppler_wipeoffs();
         }
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    update_batch_key();
+
+    // Without code options, the replica is identified by its samples
+    Acq_Replica_Key key = replica_key(std::string());
+    key.code_fingerprint = Acq_Replica_Cache::fingerprint(code, (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_consumed_samples));
+    auto fft_codes = Acq_Replica_Cache::instance().find(key);
+    if (fft_codes)
+        {
+            d_fft_codes = std::move(fft_codes);
+            return;
+        }
+    store_local_code(key, code);
+}
+
+
+void pcps_acquisition::set_local_code(std::complex<float>* code, const std::string& code_options)
+{
+    if (is_fdma())
+        {
+            update_grid_doppler_wipeoffs();
+        }
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    update_batch_key();
+    store_local_code(replica_key(code_options), code);
+}
+
+
+bool pcps_acquisition::set_cached_local_code(const std::string& code_options)
+{
+    auto fft_codes = Acq_Replica_Cache::instance().find(replica_key(code_options));
+    if (!fft_codes)
+        {
+            return false;
+        }
+    if (is_fdma())
+        {
+            update_grid_doppler_wipeoffs();
+        }
+    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+    update_batch_key();
+    d_fft_codes = std::move(fft_codes);
+    return true;
+}
+
+
+Acq_Replica_Key pcps_acquisition::replica_key(const std::string& code_options) const
+{
+    // The spectrum of the replica is shared by all the channels searching the same code
+    Acq_Replica_Key key;
+    key.signal = std::string(d_gnss_synchro->Signal, 2);
+    key.code_options = code_options;
+    key.prn = d_gnss_synchro->PRN;
+    key.fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    key.fft_size = d_fft_size;
+    key.consumed_samples = d_consumed_samples;
+    key.bit_transition_flag = d_acq_parameters.bit_transition_flag;
+    return key;
+}
+
+
+void pcps_acquisition::update_batch_key()
+{
+    leave_batch();
+    d_batch_key.signal = std::string(d_gnss_synchro->Signal, 2);
+    d_batch_key.fs = (d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    d_batch_key.fft_size = d_fft_size;
+    d_batch_key.consumed_samples = d_consumed_samples;
+}
+
+
+void pcps_acquisition::leave_batch()
+{
+    // Do not hold the blocks of the other channels while out of acquisition
+    if (d_batch_acquisition)
+        {
+            Acq_Batch_Engine::instance().unsubscribe(d_batch_key, d_channel);
+        }
+}
+
+
+void pcps_acquisition::store_local_code(const Acq_Replica_Key& key, const std::complex<float>* code)
+{
     // COD
     // Here we want to create a buffer that looks like this:
     // [ 0 0 0 ... 0 c_0 c_1 ... c_L]
     // where c_i is the local code and there are L zeros and L chips
-    gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
     if (d_acq_parameters.bit_transition_flag)
         {
             const int32_t offset = d_fft_size / 2;
@@ -205,7 +336,9 @@ void pcps_acquisition::set_local_code(std::complex<float>* code)
         }
 
     d_fft_if->execute();  // We need the FFT of local code
-    volk_32fc_conjugate_32fc(d_fft_codes.data(), d_fft_if->get_outbuf(), d_fft_size);
+    Acq_Replica_Cache::spectrum_type spectrum(d_fft_size);
+    volk_32fc_conjugate_32fc(spectrum.data(), d_fft_if->get_outbuf(), d_fft_size);
+    d_fft_codes = Acq_Replica_Cache::instance().insert(key, std::move(spectrum));
 }
 
 
@@ -264,7 +397,7 @@ void pcps_acquisition::init()
     d_num_doppler_bins = static_cast<uint32_t>(std::ceil(static_cast<double>(static_cast<int32_t>(d_acq_parameters.doppler_max) - static_cast<int32_t>(-d_acq_parameters.doppler_max)) / static_cast<double>(d_doppler_step)));
 
     // Create the carrier Doppler wipeoff signals
-    if (d_grid_doppler_wipeoffs.empty())
+    if (!d_frequency_domain_doppler && d_grid_doppler_wipeoffs.empty())
         {
             d_grid_doppler_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(d_num_doppler_bins, volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
         }
@@ -297,11 +430,73 @@ void pcps_acquisition::init()
 
 void pcps_acquisition::update_grid_doppler_wipeoffs()
 {
+    if (d_frequency_domain_doppler)
+        {
+            update_frequency_domain_doppler_grid();
+            return;
+        }
+    d_grid_doppler_freqs.resize(d_num_doppler_bins);
+    for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+        {
+            const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
+            d_grid_doppler_freqs[doppler_index] = static_cast<float>(d_doppler_bias + doppler);
+            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], d_grid_doppler_freqs[doppler_index]);
+        }
+}
+
+
+void pcps_acquisition::update_frequency_domain_doppler_grid()
+{
+    // Each Doppler bin is decomposed as shift * (fs / fft_size) + residual, with
+    // 0 <= residual < fs / fft_size. The integer part is removed by a circular
+    // shift of the input spectrum, and the residual by a time-domain wipeoff.
+    // Bins sharing the same residual share a single forward FFT per dwell.
+    const double fs = static_cast<double>(d_acq_parameters.use_automatic_resampler ? d_acq_parameters.resampled_fs : d_acq_parameters.fs_in);
+    const double fft_bin_hz = fs / static_cast<double>(d_fft_size);
+    const double residual_tolerance_hz = 1e-3;
+    std::vector<double> residuals;
+
+    d_doppler_bin_shift.resize(d_num_doppler_bins);
+    d_doppler_bin_residual_index.resize(d_num_doppler_bins);
     for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
         {
             const int32_t doppler = -static_cast<int32_t>(d_acq_parameters.doppler_max) + d_doppler_center + d_doppler_step * doppler_index;
-            update_local_carrier(d_grid_doppler_wipeoffs[doppler_index], static_cast<float>(d_doppler_bias + doppler));
+            const double freq = static_cast<double>(d_doppler_bias + doppler);
+            auto shift = static_cast<int64_t>(std::floor(freq / fft_bin_hz));
+            double residual = freq - static_cast<double>(shift) * fft_bin_hz;
+            if (residual > fft_bin_hz - residual_tolerance_hz)
+                {
+                    shift++;
+                    residual = 0.0;
+                }
+            else if (residual < residual_tolerance_hz)
+                {
+                    residual = 0.0;
+                }
+
+            const auto it = std::find_if(residuals.cbegin(), residuals.cend(), [residual, residual_tolerance_hz](double r) { return std::abs(r - residual) < residual_tolerance_hz; });
+            d_doppler_bin_residual_index[doppler_index] = static_cast<uint32_t>(std::distance(residuals.cbegin(), it));
+            if (it == residuals.cend())
+                {
+                    residuals.push_back(residual);
+                }
+            const auto fft_size = static_cast<int64_t>(d_fft_size);
+            d_doppler_bin_shift[doppler_index] = static_cast<uint32_t>(((shift % fft_size) + fft_size) % fft_size);
+        }
+
+    if (d_grid_doppler_residual_wipeoffs.size() != residuals.size())
+        {
+            d_grid_doppler_residual_wipeoffs = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(residuals.size(), volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+            d_input_spectra = volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>>(residuals.size(), volk_gnsssdr::vector<std::complex<float>>(d_fft_size));
+        }
+    d_residual_freqs.resize(residuals.size());
+    for (size_t i = 0; i < residuals.size(); i++)
+        {
+            d_residual_freqs[i] = static_cast<float>(residuals[i]);
+            update_local_carrier(d_grid_doppler_residual_wipeoffs[i], d_residual_freqs[i]);
         }
+    DLOG(INFO) << "Channel " << d_channel << ": frequency-domain Doppler search with " << d_num_doppler_bins
+               << " bins and " << residuals.size() << " forward FFTs per dwell";
 }
 
 
@@ -612,6 +807,105 @@ float pcps_acquisition::first_vs_second_peak_statistic(uint32_t& indext, int32_t
 }
 
 
+void pcps_acquisition::doppler_grid_search(const gr_complex* in, uint32_t num_doppler_bins)
+{
+    if (d_doppler_threads <= 1 || num_doppler_bins <= 1)
+        {
+            doppler_search(in, 0U, num_doppler_bins, d_fft_if.get(), d_ifft.get(), d_tmp_buffer.data());
+            return;
+        }
+
+    // The bins are taken one at a time by this thread and by the helpers of the
+    // shared worker pool, which use their own FFT plans and scratch buffer. Each
+    // row of the magnitude grid is written by one thread only.
+    std::atomic<uint32_t> next_bin{0U};
+    const std::thread::id caller = std::this_thread::get_id();
+    const std::function<void()> job = [&, caller]() {
+        gnss_fft_complex_fwd* fft_if = d_fft_if.get();
+        gnss_fft_complex_rev* ifft = d_ifft.get();
+        float* tmp_buffer = d_tmp_buffer.data();
+        if (std::this_thread::get_id() != caller)
+            {
+                Doppler_Helper_Buffers& buffers = doppler_helper_buffers(d_fft_size);
+                fft_if = buffers.fft_if.get();
+                ifft = buffers.ifft.get();
+                tmp_buffer = buffers.tmp_buffer.data();
+            }
+        for (uint32_t bin = next_bin++; bin < num_doppler_bins; bin = next_bin++)
+            {
+                doppler_search(in, bin, bin + 1, fft_if, ifft, tmp_buffer);
+            }
+    };
+    Acq_Worker_Pool::instance().run(d_doppler_threads - 1, job);
+}
+
+
+void pcps_acquisition::doppler_search(const gr_complex* in, uint32_t first_bin, uint32_t end_bin,
+    gnss_fft_complex_fwd* fft_if, gnss_fft_complex_rev* ifft, float* tmp_buffer)
+{
+    const int32_t effective_fft_size = (d_acq_parameters.bit_transition_flag ? d_fft_size / 2 : d_fft_size);
+    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
+    const bool frequency_domain = d_frequency_domain_doppler && !d_step_two;
+    const auto& wipeoffs = (d_step_two ? d_grid_doppler_wipeoffs_step_two : d_grid_doppler_wipeoffs);
+    arma::fmat& grid = (d_step_two ? d_narrow_grid : d_grid);
+    const gr_complex* fft_codes = d_fft_codes->data();
+
+    for (uint32_t doppler_index = first_bin; doppler_index < end_bin; doppler_index++)
+        {
+            if (frequency_domain)
+                {
+                    // Remove Doppler as a circular shift of the input spectrum, multiplied by the local FFT'd code reference
+                    const uint32_t shift = d_doppler_bin_shift[doppler_index];
+                    const gr_complex* spectrum = d_input_spectra[d_doppler_bin_residual_index[doppler_index]].data();
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), spectrum + shift, fft_codes, d_fft_size - shift);
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf() + d_fft_size - shift, spectrum, fft_codes + d_fft_size - shift, shift);
+                }
+            else if (d_batch_acquisition && !d_step_two)
+                {
+                    // The wiped-off input spectrum is computed by the first channel searching this block and frequency
+                    const auto spectrum = Acq_Batch_Engine::instance().input_spectrum(d_batch_key, d_channel, d_batch_sample_stamp, d_batch_fingerprint, d_grid_doppler_freqs[doppler_index],
+                        [&](Acq_Batch_Engine::spectrum_type& out) {
+                            volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, wipeoffs[doppler_index].data(), d_fft_size);
+                            fft_if->execute();
+                            std::copy(fft_if->get_outbuf(), fft_if->get_outbuf() + d_fft_size, out.data());
+                        });
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), spectrum->data(), fft_codes, d_fft_size);
+                }
+            else
+                {
+                    // Remove Doppler
+                    volk_32fc_x2_multiply_32fc(fft_if->get_inbuf(), in, wipeoffs[doppler_index].data(), d_fft_size);
+
+                    // Perform the FFT-based convolution  (parallel time search)
+                    // Compute the FFT of the carrier wiped--off incoming signal
+                    fft_if->execute();
+
+                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
+                    volk_32fc_x2_multiply_32fc(ifft->get_inbuf(), fft_if->get_outbuf(), fft_codes, d_fft_size);
+                }
+
+            // Compute the inverse FFT
+            ifft->execute();
+
+            // Compute squared magnitude (and accumulate in case of non-coherent integration)
+            if (d_num_noncoherent_integrations_counter == 1)
+                {
+                    volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), ifft->get_outbuf() + offset, effective_fft_size);
+                }
+            else
+                {
+                    volk_32fc_magnitude_squared_32f(tmp_buffer, ifft->get_outbuf() + offset, effective_fft_size);
+                    volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), tmp_buffer, effective_fft_size);
+                }
+            // Record results to file if required
+            if (d_dump and d_channel == d_dump_channel)
+                {
+                    std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, grid.colptr(doppler_index));
+                }
+        }
+}
+
+
 void pcps_acquisition::acquisition_core(uint64_t samp_count)
 {
     gr::thread::scoped_lock lk(d_setlock);
@@ -636,6 +930,11 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
 
     d_mag = 0.0;
     d_num_noncoherent_integrations_counter++;
+    d_batch_sample_stamp = samp_count;
+    if (d_batch_acquisition && !d_step_two)
+        {
+            d_batch_fingerprint = Acq_Batch_Engine::fingerprint(in, d_consumed_samples);
+        }
 
     DLOG(INFO) << "Channel: " << d_channel
                << " , doing acquisition of satellite: " << d_gnss_synchro->System << " " << d_gnss_synchro->PRN
@@ -652,38 +951,34 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
     // Doppler frequency grid loop
     if (!d_step_two)
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins; doppler_index++)
+            if (d_frequency_domain_doppler)
                 {
-                    // Remove Doppler
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs[doppler_index].data(), d_fft_size);
-
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal with the local FFT'd code reference
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // Compute the inverse FFT
-                    d_ifft->execute();
-
-                    // Compute squared magnitude (and accumulate in case of non-coherent integration)
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
+                    // Compute the FFT of the incoming signal once per residual frequency
+                    for (size_t residual_index = 0; residual_index < d_input_spectra.size(); residual_index++)
                         {
-                            std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, d_grid.colptr(doppler_index));
+                            if (d_batch_acquisition)
+                                {
+                                    const auto spectrum = Acq_Batch_Engine::instance().input_spectrum(d_batch_key, d_channel, samp_count, d_batch_fingerprint, d_residual_freqs[residual_index],
+                                        [&](Acq_Batch_Engine::spectrum_type& out) {
+                                            volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_residual_wipeoffs[residual_index].data(), d_fft_size);
+                                            d_fft_if->execute();
+                                            std::copy(d_fft_if->get_outbuf(), d_fft_if->get_outbuf() + d_fft_size, out.data());
+                                        });
+                                    std::copy(spectrum->cbegin(), spectrum->cend(), d_input_spectra[residual_index].begin());
+                                }
+                            else
+                                {
+                                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_residual_wipeoffs[residual_index].data(), d_fft_size);
+                                    d_fft_if->execute();
+                                    std::copy(d_fft_if->get_outbuf(), d_fft_if->get_outbuf() + d_fft_size, d_input_spectra[residual_index].data());
+                                }
                         }
                 }
+            doppler_grid_search(in, d_num_doppler_bins);
+            if (d_batch_acquisition)
+                {
+                    Acq_Batch_Engine::instance().release(d_batch_key, d_channel, samp_count);
+                }
 
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
@@ -714,37 +1009,8 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
         }
     else
         {
-            for (uint32_t doppler_index = 0; doppler_index < d_num_doppler_bins_step2; doppler_index++)
-                {
-                    volk_32fc_x2_multiply_32fc(d_fft_if->get_inbuf(), in, d_grid_doppler_wipeoffs_step_two[doppler_index].data(), d_fft_size);
+            doppler_grid_search(in, d_num_doppler_bins_step2);
 
-                    // Perform the FFT-based convolution  (parallel time search)
-                    // Compute the FFT of the carrier wiped--off incoming signal
-                    d_fft_if->execute();
-
-                    // Multiply carrier wiped--off, Fourier transformed incoming signal
-                    // with the local FFT'd code reference using SIMD operations with VOLK library
-                    volk_32fc_x2_multiply_32fc(d_ifft->get_inbuf(), d_fft_if->get_outbuf(), d_fft_codes.data(), d_fft_size);
-
-                    // compute the inverse FFT
-                    d_ifft->execute();
-
-                    const size_t offset = (d_acq_parameters.bit_transition_flag ? effective_fft_size : 0);
-                    if (d_num_noncoherent_integrations_counter == 1)
-                        {
-                            volk_32fc_magnitude_squared_32f(d_magnitude_grid[doppler_index].data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                        }
-                    else
-                        {
-                            volk_32fc_magnitude_squared_32f(d_tmp_buffer.data(), d_ifft->get_outbuf() + offset, effective_fft_size);
-                            volk_32f_x2_add_32f(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data(), d_tmp_buffer.data(), effective_fft_size);
-                        }
-                    // Record results to file if required
-                    if (d_dump and d_channel == d_dump_channel)
-                        {
-                            std::copy(d_magnitude_grid[doppler_index].data(), d_magnitude_grid[doppler_index].data() + effective_fft_size, d_narrow_grid.colptr(doppler_index));
-                        }
-                }
             // Compute the test statistic
             if (d_use_CFAR_algorithm_flag)
                 {
@@ -868,6 +1134,10 @@ void pcps_acquisition::acquisition_core(uint64_t samp_count)
                 }
         }
     d_worker_active = false;
+    if (!d_active)
+        {
+            leave_batch();
+        }
 
     if ((d_num_noncoherent_integrations_counter == d_acq_parameters.max_dwells) or (d_positive_acq == 1) or (d_acq_parameters.bit_transition_flag))
         {
@@ -973,6 +1243,14 @@ int pcps_acquisition::general_work(int noutput_items __attribute__((unused)),
         case 1:
             {
                 uint32_t buff_increment;
+                if (d_batch_acquisition && d_buffer_count == 0 && (d_sample_counter % d_consumed_samples) != 0)
+                    {
+                        // Start the dwell at a block boundary, so that all the channels in batch mode see the same blocks
+                        buff_increment = std::min(static_cast<uint32_t>(ninput_items[0]), d_consumed_samples - static_cast<uint32_t>(d_sample_counter % d_consumed_samples));
+                        d_sample_counter += static_cast<uint64_t>(buff_increment);
+                        consume_each(buff_increment);
+                        break;
+                    }
                 if (d_cshort)
                     {
                         const auto* in = reinterpret_cast<const lv_16sc_t*>(input_items[0]);  // Get the input samples pointer
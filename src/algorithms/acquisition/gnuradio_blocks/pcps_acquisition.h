@@ -42,7 +42,10 @@
 #define ARMA_NO_DEBUG 1
 #endif
 
+#include "acq_batch_engine.h"
 #include "acq_conf.h"
+#include "acq_replica_cache.h"
+#include "acq_worker_pool.h"
 #include "channel_fsm.h"
 #include "gnss_sdr_fft.h"
 #include <armadillo>
@@ -59,6 +62,7 @@
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #if HAS_STD_SPAN
 #include <span>
@@ -92,7 +96,7 @@ pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
 class pcps_acquisition : public gr::block
 {
 public:
-    ~pcps_acquisition() override = default;
+    ~pcps_acquisition() override;
 
     /*!
      * \brief Initializes acquisition algorithm and reserves memory.
@@ -116,6 +120,24 @@ public:
      */
     void set_local_code(std::complex<float>* code);
 
+    /*!
+     * \brief Sets local code for PCPS acquisition algorithm, sharing its
+     * spectrum with the other channels that search the same replica.
+     * \param code - Pointer to the PRN code.
+     * \param code_options - Adapter settings that change the replica of the
+     * signal and PRN of the Gnss_Synchro object (e.g., "pilot" or "cboc").
+     */
+    void set_local_code(std::complex<float>* code, const std::string& code_options);
+
+    /*!
+     * \brief Sets the local code from the spectrum already computed by
+     * another channel for the same replica, if any.
+     * \param code_options - Same as in set_local_code().
+     * \return false if the replica is not cached yet, and the caller has to
+     * generate the code and pass it to set_local_code().
+     */
+    bool set_cached_local_code(const std::string& code_options);
+
     /*!
      * \brief If set to 1, ensures that acquisition starts at the
      * first available sample.
@@ -142,6 +164,10 @@ public:
     {
         gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
         d_active = active;
+        if (!active)
+            {
+                leave_batch();
+            }
     }
 
     /*!
@@ -153,6 +179,19 @@ public:
         d_channel = channel;
     }
 
+    /*!
+     * \brief Set the RF channel (i.e., signal conditioner) that feeds this
+     * acquisition. In batch mode, only channels fed by the same RF channel
+     * share their input spectra.
+     * \param rf_channel - RF channel ID.
+     */
+    inline void set_rf_channel(uint32_t rf_channel)
+    {
+        gr::thread::scoped_lock lock(d_setlock);  // require mutex with work function called by the scheduler
+        leave_batch();
+        d_batch_key.rf_channel = rf_channel;
+    }
+
     /*!
      * \brief Set channel fsm associated to this acquisition instance
      */
@@ -218,10 +257,18 @@ private:
     friend pcps_acquisition_sptr pcps_make_acquisition(const Acq_Conf& conf_);
     explicit pcps_acquisition(const Acq_Conf& conf_);
 
+    Acq_Replica_Key replica_key(const std::string& code_options) const;
+    void store_local_code(const Acq_Replica_Key& key, const std::complex<float>* code);
+    void update_batch_key();
+    void leave_batch();
     void update_local_carrier(own::span<gr_complex> carrier_vector, float freq) const;
     void update_grid_doppler_wipeoffs();
     void update_grid_doppler_wipeoffs_step2();
+    void update_frequency_domain_doppler_grid();
     void acquisition_core(uint64_t samp_count);
+    void doppler_grid_search(const gr_complex* in, uint32_t num_doppler_bins);
+    void doppler_search(const gr_complex* in, uint32_t first_bin, uint32_t end_bin,
+        gnss_fft_complex_fwd* fft_if, gnss_fft_complex_rev* ifft, float* tmp_buffer);
     void send_negative_acquisition();
     void send_positive_acquisition();
     void dump_results(int32_t effective_fft_size);
@@ -236,10 +283,12 @@ private:
     volk_gnsssdr::vector<std::complex<float>> d_input_signal;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs;
     volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_wipeoffs_step_two;
-    volk_gnsssdr::vector<std::complex<float>> d_fft_codes;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_grid_doppler_residual_wipeoffs;
+    volk_gnsssdr::vector<volk_gnsssdr::vector<std::complex<float>>> d_input_spectra;
     volk_gnsssdr::vector<std::complex<float>> d_data_buffer;
     volk_gnsssdr::vector<lv_16sc_t> d_data_buffer_sc;
 
+    Acq_Replica_Cache::spectrum_ptr d_fft_codes;
     std::unique_ptr<gnss_fft_complex_fwd> d_fft_if;
     std::unique_ptr<gnss_fft_complex_rev> d_ifft;
     std::weak_ptr<ChannelFsm> d_channel_fsm;
@@ -250,10 +299,17 @@ private:
     arma::fmat d_narrow_grid;
 
     std::queue<Gnss_Synchro> d_monitor_queue;
+    std::vector<uint32_t> d_doppler_bin_shift;
+    std::vector<uint32_t> d_doppler_bin_residual_index;
+    std::vector<float> d_grid_doppler_freqs;
+    std::vector<float> d_residual_freqs;
     std::string d_dump_filename;
+    Acq_Batch_Key d_batch_key;
 
     int64_t d_dump_number;
     uint64_t d_sample_counter;
+    uint64_t d_batch_sample_stamp;
+    uint64_t d_batch_fingerprint;
 
     float d_threshold;
     float d_mag;
@@ -275,6 +331,7 @@ private:
     uint32_t d_num_doppler_bins_step2;
     uint32_t d_dump_channel;
     uint32_t d_buffer_count;
+    uint32_t d_doppler_threads;
 
     bool d_active;
     bool d_worker_active;
@@ -282,6 +339,8 @@ private:
     bool d_step_two;
     bool d_step_repeat;
     bool d_use_CFAR_algorithm_flag;
+    bool d_frequency_domain_doppler;
+    bool d_batch_acquisition;
     bool d_dump;
 };
 
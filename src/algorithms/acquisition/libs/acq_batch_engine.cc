@@ -0,0 +1,213 @@
+/*!
+ * \file acq_batch_engine.cc
+ * \brief Process-wide store of the carrier wiped-off input spectra computed
+ * by the PCPS acquisition channels, shared among the channels searching
+ * different PRNs of the same signal on the same block of samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_batch_engine.h"
+#include <algorithm>  // for std::max, std::min_element
+#include <array>      // for std::array
+#include <cstring>    // for std::memcpy
+#include <exception>  // for std::current_exception
+
+
+Acq_Batch_Engine& Acq_Batch_Engine::instance()
+{
+    // Never destroyed, since the channels unsubscribe when they are destroyed
+    static auto* engine = new Acq_Batch_Engine();
+    return *engine;
+}
+
+
+uint64_t Acq_Batch_Engine::fingerprint(const std::complex<float>* samples, size_t length)
+{
+    // FNV-1a over the bit patterns of the samples
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++)
+        {
+            std::array<uint32_t, 2> words{};
+            std::memcpy(words.data(), &samples[i], sizeof(words));
+            hash = (hash ^ words[0]) * 1099511628211ULL;
+            hash = (hash ^ words[1]) * 1099511628211ULL;
+        }
+    return hash;
+}
+
+
+Acq_Batch_Engine::spectrum_ptr Acq_Batch_Engine::input_spectrum(const Acq_Batch_Key& key, uint32_t channel, uint64_t sample_stamp, uint64_t fingerprint, float freq_hz, const compute_function& compute)
+{
+    std::promise<spectrum_ptr> promise;
+    std::shared_future<spectrum_ptr> pending;
+    bool shared = true;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_requested++;
+        auto& stream = d_streams[key];
+        stream.next_stamp.emplace(channel, sample_stamp);
+        auto& blocks = stream.blocks;
+        if (blocks.find(sample_stamp) == blocks.end() && blocks.size() >= MAX_BLOCKS && sample_stamp < blocks.begin()->first)
+            {
+                // Too old to be shared with any other channel
+                shared = false;
+            }
+        else
+            {
+                while (blocks.find(sample_stamp) == blocks.end() && blocks.size() >= MAX_BLOCKS)
+                    {
+                        blocks.erase(blocks.begin());
+                    }
+                const bool new_block = (blocks.find(sample_stamp) == blocks.end());
+                auto& block = blocks[sample_stamp];
+                if (new_block)
+                    {
+                        block.fingerprint = fingerprint;
+                    }
+                if (block.fingerprint != fingerprint)
+                    {
+                        // Same stamp, other samples: the sample counters are not aligned
+                        shared = false;
+                        d_mismatched++;
+                    }
+                else
+                    {
+                        const auto it = block.spectra.find(freq_hz);
+                        if (it != block.spectra.end())
+                            {
+                                pending = it->second;
+                            }
+                        else
+                            {
+                                block.spectra.emplace(freq_hz, promise.get_future().share());
+                            }
+                    }
+            }
+        if (!pending.valid())
+            {
+                d_computed++;
+            }
+    }
+
+    if (pending.valid())
+        {
+            return pending.get();
+        }
+
+    auto spectrum = std::make_shared<spectrum_type>(key.fft_size);
+    try
+        {
+            compute(*spectrum);
+        }
+    catch (...)
+        {
+            if (shared)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+            throw;
+        }
+    if (shared)
+        {
+            promise.set_value(spectrum);
+        }
+    return spectrum;
+}
+
+
+void Acq_Batch_Engine::release(const Acq_Batch_Key& key, uint32_t channel, uint64_t sample_stamp)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto stream = d_streams.find(key);
+    if (stream == d_streams.end())
+        {
+            return;
+        }
+    const auto subscriber = stream->second.next_stamp.find(channel);
+    if (subscriber == stream->second.next_stamp.end())
+        {
+            return;
+        }
+    subscriber->second = std::max(subscriber->second, sample_stamp + 1);
+    drop_released_blocks(stream->second);
+}
+
+
+void Acq_Batch_Engine::unsubscribe(const Acq_Batch_Key& key, uint32_t channel)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto stream = d_streams.find(key);
+    if (stream == d_streams.end())
+        {
+            return;
+        }
+    stream->second.next_stamp.erase(channel);
+    if (stream->second.next_stamp.empty())
+        {
+            d_streams.erase(stream);
+            return;
+        }
+    drop_released_blocks(stream->second);
+}
+
+
+size_t Acq_Batch_Engine::stored_blocks(const Acq_Batch_Key& key) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto stream = d_streams.find(key);
+    if (stream == d_streams.cend())
+        {
+            return 0;
+        }
+    return stream->second.blocks.size();
+}
+
+
+void Acq_Batch_Engine::drop_released_blocks(Stream& stream)
+{
+    // Channels waiting for a spectrum hold their own copy of its future
+    const auto oldest_needed = std::min_element(stream.next_stamp.cbegin(), stream.next_stamp.cend(),
+        [](const std::pair<const uint32_t, uint64_t>& a, const std::pair<const uint32_t, uint64_t>& b) { return a.second < b.second; });
+    const uint64_t first_needed = (oldest_needed == stream.next_stamp.cend() ? 0ULL : oldest_needed->second);
+    stream.blocks.erase(stream.blocks.begin(), stream.blocks.lower_bound(first_needed));
+}
+
+
+uint64_t Acq_Batch_Engine::computed() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_computed;
+}
+
+
+uint64_t Acq_Batch_Engine::requested() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_requested;
+}
+
+
+uint64_t Acq_Batch_Engine::mismatched() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_mismatched;
+}
+
+
+void Acq_Batch_Engine::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_streams.clear();
+    d_computed = 0ULL;
+    d_requested = 0ULL;
+    d_mismatched = 0ULL;
+}
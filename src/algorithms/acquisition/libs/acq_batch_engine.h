@@ -0,0 +1,183 @@
+/*!
+ * \file acq_batch_engine.h
+ * \brief Process-wide store of the carrier wiped-off input spectra computed
+ * by the PCPS acquisition channels, shared among the channels searching
+ * different PRNs of the same signal on the same block of samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_BATCH_ENGINE_H
+#define GNSS_SDR_ACQ_BATCH_ENGINE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Identifies a stream of sample blocks processed in lockstep by
+ * several acquisition channels. Channels fed by different RF channels (i.e.,
+ * different signal sources or conditioners) never share blocks.
+ */
+class Acq_Batch_Key
+{
+public:
+    std::string signal;
+    int64_t fs{0LL};
+    uint32_t rf_channel{0U};
+    uint32_t fft_size{0U};
+    uint32_t consumed_samples{0U};
+
+    bool operator<(const Acq_Batch_Key& other) const
+    {
+        return std::tie(rf_channel, signal, fs, fft_size, consumed_samples) <
+               std::tie(other.rf_channel, other.signal, other.fs, other.fft_size, other.consumed_samples);
+    }
+};
+
+
+/*!
+ * \brief Batched acquisition engine.
+ *
+ * The acquisition channels in batch mode align their dwells to multiples of
+ * the block length, so all the channels searching the same signal see the
+ * same block under the same sample stamp. Since the sample counters of two
+ * channels are not aligned if they did not start reading the stream at the
+ * same time, each block also stores the fingerprint of its samples, and a
+ * channel only gets the spectra of a block whose fingerprint matches its own
+ * samples. The spectrum of a block wiped off
+ * by a given carrier frequency is computed by the first channel that needs
+ * it; the others wait for it and only correlate it against their own
+ * replica. For a cold start with N channels in acquisition, this turns
+ * N x bins forward FFTs into bins forward FFTs per block.
+ *
+ * A channel subscribes to a stream with its first request, and reports with
+ * release() the blocks it is done with. A block is dropped as soon as all the
+ * subscribed channels have released it. A channel leaving acquisition calls
+ * unsubscribe(), so it does not hold the blocks of the others.
+ */
+class Acq_Batch_Engine
+{
+public:
+    using spectrum_type = volk_gnsssdr::vector<std::complex<float>>;
+    using spectrum_ptr = std::shared_ptr<const spectrum_type>;
+    using compute_function = std::function<void(spectrum_type&)>;
+
+    /*!
+     * \brief Maximum number of blocks kept per stream. When a channel lags
+     * behind, older blocks are dropped before it releases them, and it just
+     * computes its own spectra.
+     */
+    static constexpr size_t MAX_BLOCKS = 4;
+
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Acq_Batch_Engine& instance();
+
+    /*!
+     * \brief Returns the fingerprint of length samples, to be passed to
+     * input_spectrum()
+     */
+    static uint64_t fingerprint(const std::complex<float>* samples, size_t length);
+
+    /*!
+     * \brief Returns the spectrum of the block at sample_stamp of stream key,
+     * wiped off by a carrier at freq_hz, and subscribes channel to the stream.
+     * If no channel has requested it yet, compute is called in the calling
+     * thread to fill it in. If another channel is computing it, waits for the
+     * result. If the block was stored with another fingerprint, the samples
+     * of channel are not the ones of the block, and compute is called without
+     * sharing the result.
+     */
+    spectrum_ptr input_spectrum(const Acq_Batch_Key& key, uint32_t channel, uint64_t sample_stamp, uint64_t fingerprint, float freq_hz, const compute_function& compute);
+
+    /*!
+     * \brief Tells that channel will not request the blocks of stream key up
+     * to sample_stamp anymore
+     */
+    void release(const Acq_Batch_Key& key, uint32_t channel, uint64_t sample_stamp);
+
+    /*!
+     * \brief Removes channel from the subscribers of stream key. The stream
+     * is dropped when it has no subscribers left.
+     */
+    void unsubscribe(const Acq_Batch_Key& key, uint32_t channel);
+
+    /*!
+     * \brief Number of blocks stored for stream key
+     */
+    size_t stored_blocks(const Acq_Batch_Key& key) const;
+
+    /*!
+     * \brief Number of spectra computed since the last call to clear()
+     */
+    uint64_t computed() const;
+
+    /*!
+     * \brief Number of spectra requested since the last call to clear()
+     */
+    uint64_t requested() const;
+
+    /*!
+     * \brief Number of spectra not shared because of a fingerprint mismatch
+     * since the last call to clear()
+     */
+    uint64_t mismatched() const;
+
+    /*!
+     * \brief Drops all the stored spectra and resets the counters
+     */
+    void clear();
+
+private:
+    class Block
+    {
+    public:
+        uint64_t fingerprint{0ULL};
+        std::map<float, std::shared_future<spectrum_ptr>> spectra;
+    };
+
+    class Stream
+    {
+    public:
+        std::map<uint64_t, Block> blocks;
+        std::map<uint32_t, uint64_t> next_stamp;  // first stamp each subscribed channel may still request
+    };
+
+    Acq_Batch_Engine() = default;
+    static void drop_released_blocks(Stream& stream);
+
+    std::map<Acq_Batch_Key, Stream> d_streams;
+    uint64_t d_computed{0ULL};
+    uint64_t d_requested{0ULL};
+    uint64_t d_mismatched{0ULL};
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_BATCH_ENGINE_H
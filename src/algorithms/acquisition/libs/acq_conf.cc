@@ -16,9 +16,13 @@
  */
 
 #include "acq_conf.h"
+#include "display.h"
 #include "item_type_helpers.h"
 #include <glog/logging.h>
+#include <algorithm>  // for std::max
 #include <cmath>
+#include <iostream>
+#include <thread>
 
 
 void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
@@ -76,7 +80,28 @@ void Acq_Conf::SetFromConfiguration(const ConfigurationInterface *configuration,
         }
     make_2_steps = configuration->property(role + ".make_two_steps", make_2_steps);
     make_repeat_steps = configuration->property(role + ".make_repeat_steps", make_repeat_steps);
+    frequency_domain_doppler = configuration->property(role + ".frequency_domain_doppler", frequency_domain_doppler);
     blocking_on_standby = configuration->property(role + ".blocking_on_standby", blocking_on_standby);
+    doppler_threads = configuration->property(role + ".doppler_threads", doppler_threads);
+    if (doppler_threads == 0)
+        {
+            LOG(WARNING) << "Parameter doppler_threads should be at least 1. Setting it to 1";
+            doppler_threads = 1;
+        }
+    const uint32_t hardware_threads = std::max(std::thread::hardware_concurrency(), 1U);
+    if (doppler_threads > hardware_threads)
+        {
+            LOG(WARNING) << "Parameter doppler_threads should not exceed the " << hardware_threads
+                         << " hardware threads. Setting it to " << hardware_threads;
+            doppler_threads = hardware_threads;
+        }
+    batch_acquisition = configuration->property(role + ".batch_acquisition", batch_acquisition);
+    if (batch_acquisition && blocking_on_standby)
+        {
+            std::cout << TEXT_RED << "WARNING: " << role << ".batch_acquisition=true is not supported with " << role << ".blocking_on_standby=true. Batch acquisition has been disabled" << TEXT_RESET << '\n';
+            LOG(WARNING) << "Parameter batch_acquisition requires blocking_on_standby=false. Setting batch_acquisition to false";
+            batch_acquisition = false;
+        }
 
     if (pfa <= 0.0)
         {
@@ -62,6 +62,7 @@ public:
     uint32_t num_doppler_bins_step2{4U};
     uint32_t resampler_latency_samples{0U};
     uint32_t dump_channel{0U};
+    uint32_t doppler_threads{1U};
     int32_t doppler_max{5000};
     int32_t doppler_min{-5000};
 
@@ -72,6 +73,8 @@ public:
     bool blocking_on_standby{false};  // enable it only for unit testing to avoid sample consume on idle status
     bool make_2_steps{false};
     bool make_repeat_steps{false};
+    bool frequency_domain_doppler{false};
+    bool batch_acquisition{false};
     bool use_automatic_resampler{false};
     bool enable_monitor_output{false};
     
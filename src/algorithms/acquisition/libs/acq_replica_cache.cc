@@ -0,0 +1,97 @@
+/*!
+ * \file acq_replica_cache.cc
+ * \brief Process-wide cache of the FFT of local code replicas used by the
+ * PCPS acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_replica_cache.h"
+#include <utility>  // for std::move
+
+
+Acq_Replica_Cache& Acq_Replica_Cache::instance()
+{
+    // Never destroyed, since the spectra held by the channels call release()
+    static auto* cache = new Acq_Replica_Cache();
+    return *cache;
+}
+
+
+Acq_Replica_Cache::spectrum_ptr Acq_Replica_Cache::find(const Acq_Replica_Key& key) const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_spectra.find(key);
+    if (it == d_spectra.cend())
+        {
+            return nullptr;
+        }
+    return it->second.lock();
+}
+
+
+Acq_Replica_Cache::spectrum_ptr Acq_Replica_Cache::insert(const Acq_Replica_Key& key, spectrum_type&& spectrum)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto& entry = d_spectra[key];
+    auto stored = entry.lock();
+    if (stored)
+        {
+            return stored;
+        }
+    stored = spectrum_ptr(new spectrum_type(std::move(spectrum)),
+        [this, key](const spectrum_type* released) {
+            release(key);
+            delete released;
+        });
+    entry = stored;
+    return stored;
+}
+
+
+void Acq_Replica_Cache::release(const Acq_Replica_Key& key)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto it = d_spectra.find(key);
+    // The key may have been cleared, or inserted again after the release
+    if (it != d_spectra.end() && it->second.expired())
+        {
+            d_spectra.erase(it);
+        }
+}
+
+
+size_t Acq_Replica_Cache::size() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_spectra.size();
+}
+
+
+void Acq_Replica_Cache::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_spectra.clear();
+}
+
+
+uint64_t Acq_Replica_Cache::fingerprint(const std::complex<float>* code, size_t length)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(code);
+    const size_t num_bytes = length * sizeof(std::complex<float>);
+    for (size_t i = 0; i < num_bytes; i++)
+        {
+            hash ^= static_cast<uint64_t>(bytes[i]);
+            hash *= 1099511628211ULL;
+        }
+    return hash;
+}
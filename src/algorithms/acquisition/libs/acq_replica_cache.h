@@ -0,0 +1,120 @@
+/*!
+ * \file acq_replica_cache.h
+ * \brief Process-wide cache of the FFT of local code replicas used by the
+ * PCPS acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_REPLICA_CACHE_H
+#define GNSS_SDR_ACQ_REPLICA_CACHE_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Identifies the spectrum of a local code replica.
+ *
+ * The code options distinguish replicas of the same signal and PRN generated
+ * with different adapter settings (e.g., data or pilot component, BOC or CBOC
+ * modulation), so the key is known before the code is generated. Replicas
+ * given directly as samples are identified by their fingerprint instead.
+ */
+class Acq_Replica_Key
+{
+public:
+    std::string signal;
+    std::string code_options;
+    uint64_t code_fingerprint{0ULL};
+    int64_t fs{0LL};
+    uint32_t prn{0U};
+    uint32_t fft_size{0U};
+    uint32_t consumed_samples{0U};
+    bool bit_transition_flag{false};
+
+    bool operator<(const Acq_Replica_Key& other) const
+    {
+        return std::tie(signal, prn, fs, fft_size, consumed_samples, bit_transition_flag, code_options, code_fingerprint) <
+               std::tie(other.signal, other.prn, other.fs, other.fft_size, other.consumed_samples, other.bit_transition_flag, other.code_options, other.code_fingerprint);
+    }
+};
+
+
+/*!
+ * \brief Read-only store of conjugated replica spectra, shared by all the
+ * acquisition channels of the receiver.
+ *
+ * The cache does not own the spectra: an entry is dropped as soon as the last
+ * channel holding it is reassigned or destroyed.
+ */
+class Acq_Replica_Cache
+{
+public:
+    using spectrum_type = volk_gnsssdr::vector<std::complex<float>>;
+    using spectrum_ptr = std::shared_ptr<const spectrum_type>;
+
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Acq_Replica_Cache& instance();
+
+    /*!
+     * \brief Returns the stored spectrum for key, or nullptr if not found
+     */
+    spectrum_ptr find(const Acq_Replica_Key& key) const;
+
+    /*!
+     * \brief Stores spectrum under key and returns the shared copy. If another
+     * channel already inserted the same key, the stored one is returned.
+     */
+    spectrum_ptr insert(const Acq_Replica_Key& key, spectrum_type&& spectrum);
+
+    /*!
+     * \brief Number of spectra held by at least one channel
+     */
+    size_t size() const;
+
+    /*!
+     * \brief Forgets all the stored spectra. Channels holding a pointer keep
+     * their copy alive until they are reassigned.
+     */
+    void clear();
+
+    /*!
+     * \brief FNV-1a hash of the samples of a code replica
+     */
+    static uint64_t fingerprint(const std::complex<float>* code, size_t length);
+
+private:
+    Acq_Replica_Cache() = default;
+    void release(const Acq_Replica_Key& key);
+
+    std::map<Acq_Replica_Key, std::weak_ptr<const spectrum_type>> d_spectra;
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_REPLICA_CACHE_H
@@ -0,0 +1,150 @@
+/*!
+ * \file acq_worker_pool.cc
+ * \brief Process-wide pool of worker threads that help the PCPS acquisition
+ * channels to search their Doppler grids.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <algorithm>  // for std::max, std::min
+#include <exception>  // for std::exception_ptr, std::current_exception
+#include <memory>     // for std::make_shared
+#include <thread>
+#include <utility>    // for std::move
+
+
+namespace
+{
+// State of a call to run(), shared with the helper tasks that may outlive it in the queue
+struct Run_State
+{
+    std::mutex mutex;
+    std::condition_variable finished;
+    const std::function<void()>* job{nullptr};
+    std::exception_ptr error;
+    uint32_t running{0U};
+    bool closed{false};
+};
+}  // namespace
+
+
+Acq_Worker_Pool& Acq_Worker_Pool::instance()
+{
+    // Leaked on purpose, see the header
+    static auto* pool = new Acq_Worker_Pool();
+    return *pool;
+}
+
+
+Acq_Worker_Pool::Acq_Worker_Pool()
+    : d_max_threads(std::max(std::thread::hardware_concurrency(), 2U) - 1U)
+{
+}
+
+
+void Acq_Worker_Pool::run(uint32_t num_helpers, const std::function<void()>& job)
+{
+    num_helpers = static_cast<uint32_t>(std::min(static_cast<size_t>(num_helpers), d_max_threads));
+    if (num_helpers == 0)
+        {
+            job();
+            return;
+        }
+
+    auto state = std::make_shared<Run_State>();
+    state->job = &job;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        for (; d_num_threads < num_helpers; d_num_threads++)
+            {
+                std::thread(&Acq_Worker_Pool::worker, this).detach();
+            }
+        for (uint32_t i = 0; i < num_helpers; i++)
+            {
+                d_tasks.emplace_back([state]() {
+                    {
+                        std::lock_guard<std::mutex> state_lock(state->mutex);
+                        if (state->closed)
+                            {
+                                return;
+                            }
+                        state->running++;
+                    }
+                    try
+                        {
+                            (*state->job)();
+                        }
+                    catch (...)
+                        {
+                            std::lock_guard<std::mutex> state_lock(state->mutex);
+                            state->error = std::current_exception();
+                        }
+                    std::lock_guard<std::mutex> state_lock(state->mutex);
+                    state->running--;
+                    state->finished.notify_all();
+                });
+            }
+    }
+    d_task_available.notify_all();
+
+    std::exception_ptr error;
+    try
+        {
+            job();
+        }
+    catch (...)
+        {
+            error = std::current_exception();
+        }
+
+    std::unique_lock<std::mutex> state_lock(state->mutex);
+    state->closed = true;
+    state->finished.wait(state_lock, [&state]() { return state->running == 0; });
+    if (!error)
+        {
+            error = state->error;
+        }
+    state_lock.unlock();
+    if (error)
+        {
+            std::rethrow_exception(error);
+        }
+}
+
+
+size_t Acq_Worker_Pool::max_threads() const
+{
+    return d_max_threads;
+}
+
+
+size_t Acq_Worker_Pool::num_threads() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_num_threads;
+}
+
+
+void Acq_Worker_Pool::worker()
+{
+    while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(d_mutex);
+                d_task_available.wait(lock, [this]() { return !d_tasks.empty(); });
+                task = std::move(d_tasks.front());
+                d_tasks.pop_front();
+            }
+            task();
+        }
+}
@@ -0,0 +1,90 @@
+/*!
+ * \file acq_worker_pool.h
+ * \brief Process-wide pool of worker threads that help the PCPS acquisition
+ * channels to search their Doppler grids.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_ACQ_WORKER_POOL_H
+#define GNSS_SDR_ACQ_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/** \addtogroup Acquisition
+ * \{ */
+/** \addtogroup acquisition_libs
+ * \{ */
+
+
+/*!
+ * \brief Bounded pool of persistent threads shared by all the acquisition
+ * channels of the receiver.
+ *
+ * The threads are started on demand, up to one less than the number of
+ * hardware threads, and live until the end of the process. A channel calls
+ * run() with the job of a dwell: the calling thread runs it, and up to
+ * num_helpers pool threads run it as well as soon as they are free. The job
+ * must therefore split its work dynamically (e.g., taking Doppler bins from
+ * an atomic counter), since a busy pool can start the helpers late or not at
+ * all.
+ */
+class Acq_Worker_Pool
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance. It is never destroyed, so the
+     * worker threads (and their thread-local FFT plans) outlive the static
+     * objects destroyed at exit.
+     */
+    static Acq_Worker_Pool& instance();
+
+    /*!
+     * \brief Runs job in the calling thread and in up to num_helpers pool
+     * threads, and returns when all the started copies have returned. Helpers
+     * that had not started when the calling thread finishes are skipped. An
+     * exception thrown by a helper is rethrown in the calling thread.
+     */
+    void run(uint32_t num_helpers, const std::function<void()>& job);
+
+    /*!
+     * \brief Maximum number of pool threads
+     */
+    size_t max_threads() const;
+
+    /*!
+     * \brief Number of pool threads started so far
+     */
+    size_t num_threads() const;
+
+    Acq_Worker_Pool(const Acq_Worker_Pool&) = delete;
+    Acq_Worker_Pool& operator=(const Acq_Worker_Pool&) = delete;
+
+private:
+    Acq_Worker_Pool();
+    void worker();
+
+    std::deque<std::function<void()>> d_tasks;
+    size_t d_max_threads;
+    size_t d_num_threads{0};
+    mutable std::mutex d_mutex;
+    std::condition_variable d_task_available;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_ACQ_WORKER_POOL_H
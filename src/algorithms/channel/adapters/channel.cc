@@ -56,6 +56,11 @@ Channel::Channel(const ConfigurationInterface* configuration,
     acq_->set_gnss_synchro(&gnss_synchro_);
     trk_->set_gnss_synchro(&gnss_synchro_);
 
+    // Same RF channel as selected by the flowgraph when connecting this channel to a signal conditioner
+    int rf_channel = configuration->property("Channels_" + signal_str + ".RF_channel_ID", 0);
+    rf_channel = configuration->property("Channel" + std::to_string(channel_) + ".RF_channel_ID", rf_channel);
+    acq_->set_rf_channel(static_cast<uint32_t>(rf_channel));
+
     // Provide a warning to the user about the change of parameter name
     if (channel_ == 0)
         {
@@ -126,10 +131,10 @@ void Channel::connect(gr::top_block_sptr top_block)
     nav_->connect(top_block);
 
     // Synchronous ports
-    top_block->connect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+    top_block->connect(trk_->get_right_block(), get_right_block_trk_port(), nav_->get_left_block(), 0);
 
     // Message ports
-    top_block->msg_connect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
+    top_block->msg_connect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp(trk_msg_port("telemetry_to_trk")));
     if (glonass_dll_pll_c_aid_tracking_check())
         {
             top_block->msg_connect(nav_->get_left_block(), pmt::mp("preamble_timestamp_samples"), trk_->get_right_block(), pmt::mp("preamble_timestamp_samples"));
@@ -141,7 +146,7 @@ void Channel::connect(gr::top_block_sptr top_block)
         {
             top_block->msg_connect(acq_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
         }
-    top_block->msg_connect(trk_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
+    top_block->msg_connect(trk_->get_right_block(), pmt::mp(trk_msg_port("events")), channel_msg_rx_, pmt::mp("events"));
 
     connected_ = true;
 }
@@ -155,7 +160,7 @@ void Channel::disconnect(gr::top_block_sptr top_block)
             return;
         }
 
-    top_block->disconnect(trk_->get_right_block(), 0, nav_->get_left_block(), 0);
+    top_block->disconnect(trk_->get_right_block(), get_right_block_trk_port(), nav_->get_left_block(), 0);
     if (!flag_enable_fpga_)
         {
             acq_->disconnect(top_block);
@@ -163,7 +168,7 @@ void Channel::disconnect(gr::top_block_sptr top_block)
     trk_->disconnect(top_block);
     nav_->disconnect(top_block);
 
-    top_block->msg_disconnect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp("telemetry_to_trk"));
+    top_block->msg_disconnect(nav_->get_left_block(), pmt::mp("telemetry_to_trk"), trk_->get_right_block(), pmt::mp(trk_msg_port("telemetry_to_trk")));
     if (glonass_dll_pll_c_aid_tracking_check())
         {
             top_block->msg_disconnect(nav_->get_left_block(), pmt::mp("preamble_timestamp_samples"), trk_->get_right_block(), pmt::mp("preamble_timestamp_samples"));
@@ -172,7 +177,7 @@ void Channel::disconnect(gr::top_block_sptr top_block)
         {
             top_block->msg_disconnect(acq_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
         }
-    top_block->msg_disconnect(trk_->get_right_block(), pmt::mp("events"), channel_msg_rx_, pmt::mp("events"));
+    top_block->msg_disconnect(trk_->get_right_block(), pmt::mp(trk_msg_port("events")), channel_msg_rx_, pmt::mp("events"));
     connected_ = false;
 }
 
@@ -196,6 +201,13 @@ gr::basic_block_sptr Channel::get_right_block_trk()
 }
 
 
+int32_t Channel::get_right_block_trk_port()
+{
+    const int32_t slot = trk_->get_slot();
+    return slot < 0 ? 0 : slot;
+}
+
+
 gr::basic_block_sptr Channel::get_left_block_acq()
 {
     return acq_->get_left_block();
@@ -297,3 +309,14 @@ bool Channel::glonass_dll_pll_c_aid_tracking_check()
         }
     return false;
 }
+
+
+std::string Channel::trk_msg_port(const std::string& name)
+{
+    const int32_t slot = trk_->get_slot();
+    if (slot < 0)
+        {
+            return name;
+        }
+    return name + "_" + std::to_string(slot);
+}
@@ -77,6 +77,7 @@ public:
     gr::basic_block_sptr get_left_block() override;
     gr::basic_block_sptr get_left_block_trk() override;   //!< Gets the GNU Radio tracking block input pointer
     gr::basic_block_sptr get_right_block_trk() override;  //!< Gets the GNU Radio tracking block output pointer
+    int32_t get_right_block_trk_port() override;          //!< Gets the output port of this channel in the GNU Radio tracking block
     gr::basic_block_sptr get_left_block_acq() override;   //!< Gets the GNU Radio acquisition block input pointer
     gr::basic_block_sptr get_right_block_acq() override;  //!< Gets the GNU Radio acquisition block output pointer
     gr::basic_block_sptr get_right_block() override;      //!< Gets the GNU Radio channel block output pointer
@@ -97,6 +98,7 @@ public:
 
 private:
     bool glonass_dll_pll_c_aid_tracking_check();
+    std::string trk_msg_port(const std::string& name);  // message port of this channel in the tracking block
     std::shared_ptr<ChannelFsm> channel_fsm_;
     std::shared_ptr<AcquisitionInterface> acq_;
     std::shared_ptr<TrackingInterface> trk_;
@@ -17,6 +17,7 @@
  */
 
 #include "beidou_b1i_signal_replica.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <bitset>
 #include <string>
@@ -134,6 +135,13 @@ void beidou_b1i_code_gen_complex_sampled(own::span<std::complex<float>> dest, ui
     constexpr float tc = 1.0 / static_cast<float>(codeFreqBasis);  // B1I chip period in sec
 
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("B1_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
 
     std::array<std::complex<float>, 2046> code_aux{};
@@ -167,4 +175,5 @@ void beidou_b1i_code_gen_complex_sampled(own::span<std::complex<float>> dest, ui
                     dest[i] = code_aux[codeValueIndex];  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
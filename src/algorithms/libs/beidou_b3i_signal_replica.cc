@@ -17,6 +17,7 @@
  */
 
 #include "beidou_b3i_signal_replica.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <bitset>
 #include <string>
@@ -201,6 +202,12 @@ void beidou_b3i_code_gen_complex_sampled(own::span<std::complex<float>> dest, ui
 
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in secs
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("B3_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::array<std::complex<float>, 10230> code_aux{};
 
@@ -234,4 +241,5 @@ void beidou_b3i_code_gen_complex_sampled(own::span<std::complex<float>> dest, ui
                     dest[i] = code_aux[codeValueIndex];  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -0,0 +1,160 @@
+/*!
+ * \file binary_dump_writer.cc
+ * \brief Asynchronous writer of fixed-size binary records for the dump files
+ * of the signal processing blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "binary_dump_writer.h"
+#include <glog/logging.h>
+#include <algorithm>  // for std::min
+#include <chrono>     // for milliseconds
+#include <cstring>    // for memcpy
+#include <exception>  // for exception
+
+
+Binary_Dump_Writer::~Binary_Dump_Writer()
+{
+    try
+        {
+            close();
+        }
+    catch (const std::exception& e)
+        {
+            LOG(WARNING) << "Exception closing dump file " << d_filename << ": " << e.what();
+        }
+}
+
+
+bool Binary_Dump_Writer::open(const std::string& filename, size_t record_size, size_t capacity_records)
+{
+    if (d_thread.joinable() || record_size == 0 || capacity_records == 0)
+        {
+            return false;
+        }
+    d_file.open(filename, std::ios::out | std::ios::binary);
+    if (!d_file.is_open())
+        {
+            return false;
+        }
+    d_filename = filename;
+    d_record_size = record_size;
+    d_capacity = capacity_records;
+    d_ring = std::vector<char>(record_size * capacity_records);
+    d_head.store(0);
+    d_tail.store(0);
+    d_dropped.store(0);
+    d_stop.store(false);
+    d_thread = std::thread(&Binary_Dump_Writer::run, this);
+    d_open.store(true, std::memory_order_release);
+    return true;
+}
+
+
+bool Binary_Dump_Writer::push_bytes(const void* record)
+{
+    const uint64_t head = d_head.load(std::memory_order_relaxed);
+    const uint64_t pending = head - d_tail.load(std::memory_order_acquire);
+    if (!d_open.load(std::memory_order_acquire) || pending >= d_capacity)
+        {
+            d_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    std::memcpy(&d_ring[(head % d_capacity) * d_record_size], record, d_record_size);
+    d_head.store(head + 1, std::memory_order_release);
+    if (pending + 1 == d_capacity / 2)
+        {
+            // the writer thread also wakes up periodically, so a missed
+            // notification only delays the write
+            d_wakeup.notify_one();
+        }
+    return true;
+}
+
+
+void Binary_Dump_Writer::run()
+{
+    while (!d_stop.load(std::memory_order_acquire))
+        {
+            write_pending();
+            std::unique_lock<std::mutex> lock(d_mutex);
+            d_wakeup.wait_for(lock, std::chrono::milliseconds(100), [this] {
+                return d_stop.load(std::memory_order_acquire) ||
+                       d_head.load(std::memory_order_acquire) - d_tail.load(std::memory_order_relaxed) >= d_capacity / 2;
+            });
+        }
+    write_pending();
+}
+
+
+void Binary_Dump_Writer::write_pending()
+{
+    const uint64_t tail = d_tail.load(std::memory_order_relaxed);
+    const uint64_t head = d_head.load(std::memory_order_acquire);
+    if (head == tail)
+        {
+            return;
+        }
+    // at most two writes: up to the end of the ring and from its beginning
+    const auto first = static_cast<size_t>(tail % d_capacity);
+    const auto pending = static_cast<size_t>(head - tail);
+    const size_t until_end = std::min(pending, d_capacity - first);
+    d_file.write(&d_ring[first * d_record_size], static_cast<std::streamsize>(until_end * d_record_size));
+    if (pending > until_end)
+        {
+            d_file.write(d_ring.data(), static_cast<std::streamsize>((pending - until_end) * d_record_size));
+        }
+    d_tail.store(head, std::memory_order_release);
+}
+
+
+void Binary_Dump_Writer::close()
+{
+    if (!d_thread.joinable())
+        {
+            return;
+        }
+    d_open.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        d_stop.store(true, std::memory_order_release);
+    }
+    d_wakeup.notify_one();
+    d_thread.join();
+    if (!d_file)
+        {
+            LOG(WARNING) << "Error writing dump file " << d_filename;
+        }
+    d_file.close();
+    if (d_dropped.load() > 0)
+        {
+            LOG(WARNING) << d_dropped.load() << " records dropped in dump file " << d_filename;
+        }
+}
+
+
+bool Binary_Dump_Writer::is_open() const
+{
+    return d_open.load(std::memory_order_acquire);
+}
+
+
+uint64_t Binary_Dump_Writer::written_records() const
+{
+    return d_tail.load(std::memory_order_acquire);
+}
+
+
+uint64_t Binary_Dump_Writer::dropped_records() const
+{
+    return d_dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,113 @@
+/*!
+ * \file binary_dump_writer.h
+ * \brief Asynchronous writer of fixed-size binary records for the dump files
+ * of the signal processing blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_BINARY_DUMP_WRITER_H
+#define GNSS_SDR_BINARY_DUMP_WRITER_H
+
+#include <atomic>              // for atomic
+#include <condition_variable>  // for condition_variable
+#include <cstddef>             // for size_t
+#include <cstdint>             // for uint64_t
+#include <fstream>             // for ofstream
+#include <mutex>               // for mutex
+#include <string>              // for string
+#include <thread>              // for thread
+#include <type_traits>         // for is_trivially_copyable
+#include <vector>              // for vector
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Writes fixed-size records to a binary file from a background thread.
+ *
+ * push() copies the record into a single-producer, single-consumer ring
+ * buffer and returns without blocking nor making system calls, so it can be
+ * called from the signal processing thread of a block. A writer thread
+ * drains the ring with large sequential writes. When the ring is full, the
+ * record is dropped and counted in dropped_records().
+ *
+ * The file content is the sequence of records as they are laid out in
+ * memory, so the record structs must be packed to keep the dump format
+ * independent of the compiler.
+ */
+class Binary_Dump_Writer
+{
+public:
+    Binary_Dump_Writer() = default;
+    ~Binary_Dump_Writer();
+
+    Binary_Dump_Writer(const Binary_Dump_Writer&) = delete;
+    Binary_Dump_Writer& operator=(const Binary_Dump_Writer&) = delete;
+
+    /*!
+     * \brief Creates the file and starts the writer thread. Returns false
+     * if the file cannot be created or the writer is already open.
+     */
+    bool open(const std::string& filename, size_t record_size, size_t capacity_records = 8192);
+
+    /*!
+     * \brief Queues a record. Only one thread may call it. Returns false if
+     * the record was dropped.
+     */
+    template <typename Record>
+    bool push(const Record& record)
+    {
+        static_assert(std::is_trivially_copyable<Record>::value, "Dump records must be trivially copyable");
+        if (sizeof(Record) != d_record_size)
+            {
+                return false;
+            }
+        return push_bytes(&record);
+    }
+
+    /*!
+     * \brief Writes all the queued records, stops the writer thread and
+     * closes the file.
+     */
+    void close();
+
+    bool is_open() const;
+    uint64_t written_records() const;
+    uint64_t dropped_records() const;
+
+private:
+    bool push_bytes(const void* record);
+    void run();
+    void write_pending();
+
+    std::vector<char> d_ring;
+    std::string d_filename;
+    std::ofstream d_file;
+    std::thread d_thread;
+    std::mutex d_mutex;               // only used to wait for records
+    std::condition_variable d_wakeup;
+    std::atomic<uint64_t> d_head{0};  // records pushed
+    std::atomic<uint64_t> d_tail{0};  // records written
+    std::atomic<uint64_t> d_dropped{0};
+    std::atomic<bool> d_stop{false};
+    std::atomic<bool> d_open{false};
+    size_t d_record_size{0};
+    size_t d_capacity{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_BINARY_DUMP_WRITER_H
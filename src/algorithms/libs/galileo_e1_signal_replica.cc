@@ -18,6 +18,7 @@
 
 #include "galileo_e1_signal_replica.h"
 #include "Galileo_E1.h"
+#include "gnss_replica_store.h"
 #include "gnss_signal_replica.h"
 #include <cmath>
 #include <cstddef>  // for size_t
@@ -98,6 +99,13 @@ void galileo_e1_sinboc_61_gen_int(own::span<int> dest, own::span<const int> prn)
 void galileo_e1_code_gen_sinboc11_float(own::span<float> dest, const std::array<char, 3>& signal_id, uint32_t prn)
 {
     const auto codeLength = static_cast<uint32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS);
+    const Gnss_Replica_Key key(std::string(signal_id.data()) + "_sinboc11_float", 0, prn);
+    const auto replica = dest.first(2 * codeLength);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     std::array<int32_t, 4092> primary_code_E1_chips{};
     galileo_e1_code_gen_int(primary_code_E1_chips, signal_id, prn);  // generate Galileo E1 code, 1 sample per chip
     for (uint32_t i = 0; i < codeLength; i++)
@@ -105,6 +113,7 @@ void galileo_e1_code_gen_sinboc11_float(own::span<float> dest, const std::array<
             dest[2 * i] = static_cast<float>(primary_code_E1_chips[i]);
             dest[2 * i + 1] = -dest[2 * i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
@@ -150,6 +159,13 @@ void galileo_e1_code_gen_float_sampled(own::span<float> dest, const std::array<c
     const std::string galileo_signal = signal_id.data();
     auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / GALILEO_E1_B_CODE_LENGTH_CHIPS));
     const uint32_t delay = ((static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS) - chip_shift) % static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS)) * samplesPerCode / GALILEO_E1_B_CODE_LENGTH_CHIPS;
+    const bool with_secondary = galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2 && secondary_flag;
+    const Gnss_Replica_Key key(galileo_signal + (cboc ? "_cboc" : "_sinboc11") + (with_secondary ? "_secondary" : "") + "_float_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(with_secondary ? samplesPerCode * static_cast<uint32_t>(GALILEO_E1_C_SECONDARY_CODE_LENGTH) : samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::vector<int32_t> primary_code_E1_chips(static_cast<int32_t>(GALILEO_E1_B_CODE_LENGTH_CHIPS));
 
@@ -181,7 +197,7 @@ void galileo_e1_code_gen_float_sampled(own::span<float> dest, const std::array<c
             signal_E1 = std::move(resampled_signal);
         }
 
-    if (galileo_signal.rfind("1C") != std::string::npos && galileo_signal.length() >= 2 && secondary_flag)
+    if (with_secondary)
         {
             std::vector<float> signal_E1C_secondary(static_cast<int32_t>(GALILEO_E1_C_SECONDARY_CODE_LENGTH) * samplesPerCode);
             for (uint32_t i = 0; i < static_cast<uint32_t>(GALILEO_E1_C_SECONDARY_CODE_LENGTH); i++)
@@ -201,6 +217,7 @@ void galileo_e1_code_gen_float_sampled(own::span<float> dest, const std::array<c
         {
             dest[(i + delay) % samplesPerCode] = signal_E1[i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
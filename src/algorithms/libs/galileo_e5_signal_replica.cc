@@ -21,9 +21,11 @@
 #include "galileo_e5_signal_replica.h"
 #include "Galileo_E5a.h"
 #include "Galileo_E5b.h"
+#include "gnss_replica_store.h"
 #include "gnss_signal_replica.h"
 #include <gnuradio/gr_complex.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -104,6 +106,12 @@ void galileo_e5_a_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 
     const auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
     const uint32_t delay = ((codeLength - chip_shift) % codeLength) * samplesPerCode / codeLength;
+    const Gnss_Replica_Key key(std::string(signal_id.data()) + "_E5a_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::vector<std::complex<float>> code_aux(codeLength);
     galileo_e5_a_code_gen_complex_primary(code_aux, prn, signal_id);
@@ -119,6 +127,7 @@ void galileo_e5_a_code_gen_complex_sampled(own::span<std::complex<float>> dest,
         {
             dest[(i + delay) % samplesPerCode] = code_aux[i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
@@ -198,6 +207,12 @@ void galileo_e5_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 
     const auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
     const uint32_t delay = ((codeLength - chip_shift) % codeLength) * samplesPerCode / codeLength;
+    const Gnss_Replica_Key key(std::string(signal_id.data()) + "_E5b_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::vector<std::complex<float>> code_aux(codeLength);
     galileo_e5_b_code_gen_complex_primary(code_aux, prn, signal_id);
@@ -213,4 +228,5 @@ void galileo_e5_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
         {
             dest[(i + delay) % samplesPerCode] = code_aux[i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -19,6 +19,7 @@
 
 #include "galileo_e6_signal_replica.h"
 #include "Galileo_E6.h"
+#include "gnss_replica_store.h"
 #include "gnss_signal_replica.h"
 #include <utility>
 #include <vector>
@@ -88,6 +89,12 @@ void galileo_e6_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 
     const auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
     const uint32_t delay = ((codeLength - chip_shift) % codeLength) * samplesPerCode / codeLength;
+    const Gnss_Replica_Key key("E6B_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::vector<std::complex<float>> code_aux(codeLength);
     galileo_e6_b_code_gen_complex_primary(code_aux, prn);
@@ -103,6 +110,7 @@ void galileo_e6_b_code_gen_complex_sampled(own::span<std::complex<float>> dest,
         {
             dest[(i + delay) % samplesPerCode] = code_aux[i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
@@ -169,6 +177,12 @@ void galileo_e6_c_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 
     const auto samplesPerCode = static_cast<uint32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
     const uint32_t delay = ((codeLength - chip_shift) % codeLength) * samplesPerCode / codeLength;
+    const Gnss_Replica_Key key("E6C_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::vector<std::complex<float>> code_aux(codeLength);
     galileo_e6_c_code_gen_complex_primary(code_aux, prn);
@@ -184,6 +198,7 @@ void galileo_e6_c_code_gen_complex_sampled(own::span<std::complex<float>> dest,
         {
             dest[(i + delay) % samplesPerCode] = code_aux[i];
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
@@ -17,6 +17,7 @@
  */
 
 #include "glonass_l1_signal_replica.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <bitset>
 
@@ -96,6 +97,12 @@ void glonass_l1_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest,
 
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("1G_complex_sampled", sampling_freq, 0U, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
 
     std::array<std::complex<float>, 511> code_aux{};
     int32_t codeValueIndex;
@@ -128,4 +135,5 @@ void glonass_l1_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest,
                     dest[i] = code_aux[codeValueIndex];  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -17,6 +17,7 @@
  */
 
 #include "glonass_l2_signal_replica.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <bitset>
 
@@ -95,6 +96,13 @@ void glonass_l2_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest,
     constexpr float tc = 1.0 / static_cast<float>(codeFreqBasis);  // C/A chip period in sec
 
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("2G_complex_sampled", sampling_freq, 0U, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
 
     std::array<std::complex<float>, 511> code_aux{};
@@ -128,4 +136,5 @@ void glonass_l2_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest,
                     dest[i] = code_aux[codeValueIndex];  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -0,0 +1,93 @@
+/*!
+ * \file gnss_fft_plan_registry.cc
+ * \brief Process-wide registry of FFTW plans shared by all the processing
+ * blocks, and FFT objects executing them on their own buffers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_fft_plan_registry.h"
+#include <glog/logging.h>
+#include <gnuradio/fft/fft.h>  // for gr::fft::planner
+#include <stdexcept>           // for std::runtime_error
+
+
+Gnss_Fft_Plan_Registry& Gnss_Fft_Plan_Registry::instance()
+{
+    // Never destroyed: the plans are needed until the last block is gone, and
+    // destroying them at exit would require the GNU Radio planner mutex, which
+    // may have been destroyed already.
+    static auto* registry = new Gnss_Fft_Plan_Registry();
+    return *registry;
+}
+
+
+fftwf_plan Gnss_Fft_Plan_Registry::get_plan(int fft_size, bool forward, bool aligned)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    const auto key = std::make_tuple(fft_size, forward, aligned);
+    const auto it = d_plans.find(key);
+    if (it != d_plans.cend())
+        {
+            return it->second;
+        }
+
+    // The FFTW planner is not thread-safe. Share the lock used by GNU Radio,
+    // since other blocks in the flowgraph may be planning at the same time.
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    auto* in = reinterpret_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    auto* out = reinterpret_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    const unsigned flags = FFTW_MEASURE | (aligned ? 0U : static_cast<unsigned>(FFTW_UNALIGNED));
+    fftwf_plan plan = fftwf_plan_dft_1d(fft_size, in, out, forward ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+    fftwf_free(in);
+    fftwf_free(out);
+    if (plan == nullptr)
+        {
+            LOG(ERROR) << "Unable to create an FFTW plan of size " << fft_size;
+            throw std::runtime_error("Gnss_Fft_Plan_Registry: fftwf_plan_dft_1d failed");
+        }
+    DLOG(INFO) << "New " << (forward ? "forward" : "reverse") << " FFT plan of size " << fft_size;
+    d_plans.emplace(key, plan);
+    return plan;
+}
+
+
+bool Gnss_Fft_Plan_Registry::load_wisdom(const std::string& filename)
+{
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    if (fftwf_import_wisdom_from_filename(filename.c_str()) == 0)
+        {
+            LOG(WARNING) << "Unable to import FFTW wisdom from " << filename;
+            return false;
+        }
+    LOG(INFO) << "FFTW wisdom imported from " << filename;
+    return true;
+}
+
+
+bool Gnss_Fft_Plan_Registry::save_wisdom(const std::string& filename) const
+{
+    gr::fft::planner::scoped_lock planner_lock(gr::fft::planner::mutex());
+    if (fftwf_export_wisdom_to_filename(filename.c_str()) == 0)
+        {
+            LOG(WARNING) << "Unable to export FFTW wisdom to " << filename;
+            return false;
+        }
+    LOG(INFO) << "FFTW wisdom exported to " << filename;
+    return true;
+}
+
+
+size_t Gnss_Fft_Plan_Registry::size() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_plans.size();
+}
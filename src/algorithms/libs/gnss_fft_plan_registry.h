@@ -0,0 +1,126 @@
+/*!
+ * \file gnss_fft_plan_registry.h
+ * \brief Process-wide registry of FFTW plans shared by all the processing
+ * blocks, and FFT objects executing them on their own buffers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_FFT_PLAN_REGISTRY_H
+#define GNSS_SDR_GNSS_FFT_PLAN_REGISTRY_H
+
+#include <fftw3.h>
+#include <gnuradio/gr_complex.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Stores one FFTW plan per (size, direction, alignment). Plans are
+ * created on first request and executed afterwards with the new-array
+ * execute interface, which is thread-safe.
+ */
+class Gnss_Fft_Plan_Registry
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance. It is never destroyed, so
+     * its plans are released by the operating system at exit.
+     */
+    static Gnss_Fft_Plan_Registry& instance();
+
+    /*!
+     * \brief Returns the plan for a complex FFT of the given size and
+     * direction. If aligned is false, the plan can be executed on buffers
+     * without SIMD alignment.
+     */
+    fftwf_plan get_plan(int fft_size, bool forward, bool aligned = true);
+
+    /*!
+     * \brief Imports FFTW wisdom from filename. Returns false on failure.
+     */
+    bool load_wisdom(const std::string& filename);
+
+    /*!
+     * \brief Exports the accumulated FFTW wisdom to filename. Returns false on failure.
+     */
+    bool save_wisdom(const std::string& filename) const;
+
+    /*!
+     * \brief Number of plans in the registry
+     */
+    size_t size() const;
+
+    Gnss_Fft_Plan_Registry(const Gnss_Fft_Plan_Registry&) = delete;
+    Gnss_Fft_Plan_Registry& operator=(const Gnss_Fft_Plan_Registry&) = delete;
+
+private:
+    Gnss_Fft_Plan_Registry() = default;
+
+    std::map<std::tuple<int, bool, bool>, fftwf_plan> d_plans;
+    mutable std::mutex d_mutex;
+};
+
+
+/*!
+ * \brief Complex FFT with the same interface as gr::fft::fft_complex, but
+ * executing a plan from Gnss_Fft_Plan_Registry on its own aligned buffers.
+ */
+template <bool Forward>
+class Gnss_Fft_Complex
+{
+public:
+    explicit Gnss_Fft_Complex(int fft_size)
+        : d_inbuf(reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(gr_complex) * fft_size))),
+          d_outbuf(reinterpret_cast<gr_complex*>(fftwf_malloc(sizeof(gr_complex) * fft_size))),
+          d_plan(Gnss_Fft_Plan_Registry::instance().get_plan(fft_size, Forward)),
+          d_fft_size(fft_size)
+    {
+    }
+
+    ~Gnss_Fft_Complex()
+    {
+        fftwf_free(d_inbuf);
+        fftwf_free(d_outbuf);
+    }
+
+    Gnss_Fft_Complex(const Gnss_Fft_Complex&) = delete;
+    Gnss_Fft_Complex& operator=(const Gnss_Fft_Complex&) = delete;
+
+    inline gr_complex* get_inbuf() const { return d_inbuf; }
+    inline gr_complex* get_outbuf() const { return d_outbuf; }
+    inline int inbuf_length() const { return d_fft_size; }
+    inline int outbuf_length() const { return d_fft_size; }
+
+    inline void execute()
+    {
+        fftwf_execute_dft(d_plan, reinterpret_cast<fftwf_complex*>(d_inbuf), reinterpret_cast<fftwf_complex*>(d_outbuf));
+    }
+
+private:
+    gr_complex* d_inbuf;
+    gr_complex* d_outbuf;
+    fftwf_plan d_plan;
+    int d_fft_size;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_FFT_PLAN_REGISTRY_H
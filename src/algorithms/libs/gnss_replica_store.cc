@@ -0,0 +1,334 @@
+/*!
+ * \file gnss_replica_store.cc
+ * \brief Process-wide store of sampled local code replicas, shared by the
+ * signal replica generators and optionally persisted in a cache file.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_replica_store.h"
+#include <glog/logging.h>
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+#include <array>       // for array
+#include <cstdio>      // for rename, remove
+#include <cstring>     // for memcpy
+#include <fstream>     // for ofstream
+#include <utility>     // for move
+#include <vector>      // for vector
+
+namespace
+{
+/*
+ * Cache file layout, all the fields in host byte order:
+ *   header:  magic (8 bytes), version (uint32), number of replicas (uint32)
+ *   replica: generator name length, prn, chip_shift, reserved (uint32 each),
+ *            sampling_freq (int64), number of floats (uint64),
+ *            generator name, floats.
+ * The name and the floats are padded to multiples of 8 bytes, so the floats
+ * of a mapped file are aligned. The version only tracks this layout: changes
+ * of the generators are detected by Gnss_Replica_Store::verify_mapped().
+ */
+constexpr std::array<char, 8> CACHE_MAGIC{'G', 'N', 'S', 'S', 'R', 'E', 'P', 'L'};
+constexpr uint32_t CACHE_VERSION = 1;
+
+struct Cache_File_Header
+{
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t count;
+};
+
+struct Cache_Replica_Header
+{
+    uint32_t generator_length;
+    uint32_t prn;
+    uint32_t chip_shift;
+    uint32_t reserved;
+    int64_t sampling_freq;
+    uint64_t length;
+};
+
+size_t padded(size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<size_t>(7);
+}
+}  // namespace
+
+
+Gnss_Replica_Store& Gnss_Replica_Store::instance()
+{
+    static Gnss_Replica_Store store;
+    return store;
+}
+
+
+bool Gnss_Replica_Store::copy(Gnss_Replica_Key key, own::span<float> dest) const
+{
+    return copy_values(key, dest.data(), dest.size());
+}
+
+
+bool Gnss_Replica_Store::copy(Gnss_Replica_Key key, own::span<std::complex<float>> dest) const
+{
+    return copy_values(key, reinterpret_cast<float*>(dest.data()), 2 * dest.size());
+}
+
+
+void Gnss_Replica_Store::insert(Gnss_Replica_Key key, own::span<const float> replica)
+{
+    insert_values(key, replica.data(), replica.size());
+}
+
+
+void Gnss_Replica_Store::insert(Gnss_Replica_Key key, own::span<const std::complex<float>> replica)
+{
+    insert_values(key, reinterpret_cast<const float*>(replica.data()), 2 * replica.size());
+}
+
+
+bool Gnss_Replica_Store::copy_values(Gnss_Replica_Key& key, float* dest, size_t length) const
+{
+    key.length = length;
+    Replica replica;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        const auto it = d_replicas.find(key);
+        if (it == d_replicas.end() || (it->second.mapped && d_verified_generators.count(key.generator) == 0))
+            {
+                return false;
+            }
+        if (!it->second.mapped)
+            {
+                d_lru.splice(d_lru.begin(), d_lru, it->second.lru);
+            }
+        replica = it->second;  // keeps the values alive after unlocking
+    }
+    std::memcpy(dest, replica.data, length * sizeof(float));
+    return true;
+}
+
+
+void Gnss_Replica_Store::insert_values(Gnss_Replica_Key& key, const float* replica, size_t length)
+{
+    key.length = length;
+    const size_t bytes = length * sizeof(float);
+    std::lock_guard<std::mutex> lock(d_mutex);
+    auto it = d_replicas.find(key);
+    if (it != d_replicas.end() && it->second.mapped && d_verified_generators.count(key.generator) == 0)
+        {
+            verify_mapped(key, replica);
+            it = d_replicas.find(key);
+        }
+    if (it != d_replicas.end() || bytes > d_max_bytes)
+        {
+            return;
+        }
+    evict(d_max_bytes - bytes);
+    auto values = std::make_shared<std::vector<float>>(replica, replica + length);
+    Replica stored;
+    stored.data = values->data();
+    stored.owner = std::move(values);
+    d_lru.push_front(key);
+    stored.lru = d_lru.begin();
+    d_replicas.emplace(std::move(key), std::move(stored));
+    d_bytes += bytes;
+}
+
+
+void Gnss_Replica_Store::verify_mapped(const Gnss_Replica_Key& key, const float* replica)
+{
+    d_verified_generators.insert(key.generator);
+    if (std::memcmp(d_replicas.at(key).data, replica, key.length * sizeof(float)) == 0)
+        {
+            return;
+        }
+    LOG(WARNING) << "The " << key.generator << " replicas of the cache file differ from the generated ones, they will be generated again";
+    for (auto it = d_replicas.begin(); it != d_replicas.end();)
+        {
+            if (it->second.mapped && it->first.generator == key.generator)
+                {
+                    it = d_replicas.erase(it);
+                }
+            else
+                {
+                    ++it;
+                }
+        }
+}
+
+
+void Gnss_Replica_Store::evict(size_t bytes)
+{
+    while (d_bytes > bytes && !d_lru.empty())
+        {
+            const auto it = d_replicas.find(d_lru.back());
+            d_bytes -= it->first.length * sizeof(float);
+            d_replicas.erase(it);
+            d_lru.pop_back();
+        }
+}
+
+
+bool Gnss_Replica_Store::load(const std::string& filename)
+{
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        {
+            LOG(INFO) << "Replica cache file " << filename << " not found";
+            return false;
+        }
+    struct stat file_status;
+    if (::fstat(fd, &file_status) != 0 || file_status.st_size < static_cast<off_t>(sizeof(Cache_File_Header)))
+        {
+            ::close(fd);
+            LOG(WARNING) << "Invalid replica cache file " << filename;
+            return false;
+        }
+    const auto file_size = static_cast<size_t>(file_status.st_size);
+    void* address = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED)
+        {
+            LOG(WARNING) << "Cannot map replica cache file " << filename;
+            return false;
+        }
+    const std::shared_ptr<const void> mapping(address, [file_size](const void* p) { ::munmap(const_cast<void*>(p), file_size); });
+    const auto* base = static_cast<const char*>(address);
+
+    Cache_File_Header header{};
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != CACHE_MAGIC || header.version != CACHE_VERSION)
+        {
+            LOG(WARNING) << "Invalid replica cache file " << filename;
+            return false;
+        }
+
+    std::vector<std::pair<Gnss_Replica_Key, Replica>> replicas;
+    replicas.reserve(header.count);
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < header.count; i++)
+        {
+            Cache_Replica_Header replica_header{};
+            if (file_size - offset < sizeof(replica_header))
+                {
+                    LOG(WARNING) << "Truncated replica cache file " << filename;
+                    return false;
+                }
+            std::memcpy(&replica_header, base + offset, sizeof(replica_header));
+            offset += sizeof(replica_header);
+            const size_t name_bytes = padded(replica_header.generator_length);
+            if (replica_header.length > (file_size - offset) / sizeof(float) ||
+                file_size - offset < name_bytes + padded(replica_header.length * sizeof(float)))
+                {
+                    LOG(WARNING) << "Truncated replica cache file " << filename;
+                    return false;
+                }
+            Gnss_Replica_Key key;
+            key.generator = std::string(base + offset, replica_header.generator_length);
+            key.sampling_freq = replica_header.sampling_freq;
+            key.prn = replica_header.prn;
+            key.chip_shift = replica_header.chip_shift;
+            key.length = replica_header.length;
+            offset += name_bytes;
+            Replica replica;
+            replica.owner = mapping;
+            replica.data = reinterpret_cast<const float*>(base + offset);
+            replica.mapped = true;
+            offset += padded(replica_header.length * sizeof(float));
+            replicas.emplace_back(std::move(key), std::move(replica));
+        }
+
+    std::lock_guard<std::mutex> lock(d_mutex);
+    for (auto& replica : replicas)
+        {
+            d_replicas.insert(std::move(replica));
+        }
+    d_verified_generators.clear();
+    LOG(INFO) << "Loaded " << header.count << " code replicas from " << filename;
+    return true;
+}
+
+
+bool Gnss_Replica_Store::save(const std::string& filename) const
+{
+    std::map<Gnss_Replica_Key, Replica> replicas;
+    {
+        std::lock_guard<std::mutex> lock(d_mutex);
+        replicas = d_replicas;
+    }
+
+    // The file may be mapped by this process, so it is replaced instead of overwritten
+    const std::string tmp_filename = filename + ".tmp";
+    std::ofstream file(tmp_filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        {
+            LOG(WARNING) << "Cannot create replica cache file " << tmp_filename;
+            return false;
+        }
+    const std::array<char, 8> padding{};
+    const Cache_File_Header header{CACHE_MAGIC, CACHE_VERSION, static_cast<uint32_t>(replicas.size())};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const auto& replica : replicas)
+        {
+            const Gnss_Replica_Key& key = replica.first;
+            const Cache_Replica_Header replica_header{static_cast<uint32_t>(key.generator.size()), key.prn, key.chip_shift, 0U, key.sampling_freq, key.length};
+            const size_t data_bytes = key.length * sizeof(float);
+            file.write(reinterpret_cast<const char*>(&replica_header), sizeof(replica_header));
+            file.write(key.generator.data(), key.generator.size());
+            file.write(padding.data(), padded(key.generator.size()) - key.generator.size());
+            file.write(reinterpret_cast<const char*>(replica.second.data), data_bytes);
+            file.write(padding.data(), padded(data_bytes) - data_bytes);
+        }
+    file.close();
+    if (file.fail() || std::rename(tmp_filename.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmp_filename.c_str());
+            LOG(WARNING) << "Cannot write replica cache file " << filename;
+            return false;
+        }
+    LOG(INFO) << "Saved " << replicas.size() << " code replicas to " << filename;
+    return true;
+}
+
+
+void Gnss_Replica_Store::set_max_bytes(size_t max_bytes)
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_max_bytes = max_bytes;
+    evict(d_max_bytes);
+}
+
+
+size_t Gnss_Replica_Store::size() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_replicas.size();
+}
+
+
+size_t Gnss_Replica_Store::bytes() const
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    return d_bytes;
+}
+
+
+void Gnss_Replica_Store::clear()
+{
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_replicas.clear();
+    d_lru.clear();
+    d_verified_generators.clear();
+    d_bytes = 0;
+}
@@ -0,0 +1,179 @@
+/*!
+ * \file gnss_replica_store.h
+ * \brief Process-wide store of sampled local code replicas, shared by the
+ * signal replica generators and optionally persisted in a cache file.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GNSS_REPLICA_STORE_H
+#define GNSS_SDR_GNSS_REPLICA_STORE_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#if HAS_STD_SPAN
+#include <span>
+namespace own = std;
+#else
+#include <gsl/gsl-lite.hpp>
+namespace own = gsl;
+#endif
+
+/** \addtogroup Algorithms_Library
+ * \{ */
+/** \addtogroup Algorithm_libs algorithms_libs
+ * \{ */
+
+
+/*!
+ * \brief Identifies a code replica: the generator (including the signal and
+ * its options, e.g. "E1B_cboc_complex_sampled"), the PRN, the sampling
+ * frequency (0 for replicas sampled at a fixed rate per chip) and the code
+ * phase shift. The number of values is appended by Gnss_Replica_Store.
+ */
+class Gnss_Replica_Key
+{
+public:
+    Gnss_Replica_Key() = default;
+    Gnss_Replica_Key(std::string generator_, int64_t sampling_freq_, uint32_t prn_, uint32_t chip_shift_ = 0U)
+        : generator(std::move(generator_)), sampling_freq(sampling_freq_), prn(prn_), chip_shift(chip_shift_)
+    {
+    }
+
+    std::string generator;
+    int64_t sampling_freq{0LL};
+    uint32_t prn{0U};
+    uint32_t chip_shift{0U};
+    uint64_t length{0ULL};  // number of float values
+
+    bool operator<(const Gnss_Replica_Key& other) const
+    {
+        return std::tie(generator, prn, sampling_freq, chip_shift, length) <
+               std::tie(other.generator, other.prn, other.sampling_freq, other.chip_shift, other.length);
+    }
+};
+
+
+/*!
+ * \brief Stores each sampled code replica the first time it is generated, so
+ * that channels assigned to the same PRN afterwards copy it instead of
+ * generating it again.
+ *
+ * The generators use it as:
+ * \code
+ * if (!Gnss_Replica_Store::instance().copy(key, dest))
+ *     {
+ *         // generate the replica in dest
+ *         Gnss_Replica_Store::instance().insert(key, dest);
+ *     }
+ * \endcode
+ *
+ * The store can be saved to a cache file and memory-mapped in later runs, so
+ * the replicas of a known configuration are not generated again. A cache file
+ * may come from a build with different generators, so the first replica of
+ * each generator requested in a run is not served from the file: copy()
+ * returns false, and insert() compares the newly generated values with the
+ * mapped ones. If they differ, all the replicas of that generator in the file
+ * are dropped.
+ *
+ * The generated replicas are bounded by a memory limit, evicting the least
+ * recently used ones. The mapped replicas do not count towards it.
+ */
+class Gnss_Replica_Store
+{
+public:
+    /*!
+     * \brief Returns the process-wide instance
+     */
+    static Gnss_Replica_Store& instance();
+
+    /*!
+     * \brief Copies the replica identified by key into dest. Returns false if
+     * it is not stored for the size of dest.
+     */
+    bool copy(Gnss_Replica_Key key, own::span<float> dest) const;
+    bool copy(Gnss_Replica_Key key, own::span<std::complex<float>> dest) const;
+
+    /*!
+     * \brief Stores a copy of the replica identified by key, unless it is
+     * already stored or larger than the memory limit. The least recently used
+     * replicas are evicted to make room for it.
+     */
+    void insert(Gnss_Replica_Key key, own::span<const float> replica);
+    void insert(Gnss_Replica_Key key, own::span<const std::complex<float>> replica);
+
+    /*!
+     * \brief Memory-maps a cache file written by save() and serves its
+     * replicas. Returns false, leaving the store unchanged, if the file cannot
+     * be read or is not a valid cache file.
+     */
+    bool load(const std::string& filename);
+
+    /*!
+     * \brief Writes all the stored replicas to filename. Returns false on failure.
+     */
+    bool save(const std::string& filename) const;
+
+    /*!
+     * \brief Sets the maximum memory, in bytes, used by the generated
+     * replicas, evicting the least recently used ones above it
+     */
+    void set_max_bytes(size_t max_bytes);
+
+    size_t size() const;   //!< Number of stored replicas
+    size_t bytes() const;  //!< Memory used by the generated replicas
+
+    /*!
+     * \brief Drops all the stored replicas
+     */
+    void clear();
+
+    Gnss_Replica_Store(const Gnss_Replica_Store&) = delete;
+    Gnss_Replica_Store& operator=(const Gnss_Replica_Store&) = delete;
+
+private:
+    class Replica
+    {
+    public:
+        std::shared_ptr<const void> owner;  // vector or file mapping holding the values
+        const float* data{nullptr};
+        std::list<Gnss_Replica_Key>::iterator lru;  // position in d_lru, only for generated replicas
+        bool mapped{false};
+    };
+
+    Gnss_Replica_Store() = default;
+
+    bool copy_values(Gnss_Replica_Key& key, float* dest, size_t length) const;
+    void insert_values(Gnss_Replica_Key& key, const float* replica, size_t length);
+    void verify_mapped(const Gnss_Replica_Key& key, const float* replica);
+    void evict(size_t bytes);
+
+    std::map<Gnss_Replica_Key, Replica> d_replicas;
+    mutable std::list<Gnss_Replica_Key> d_lru;  // generated replicas, most recently used first
+    std::set<std::string> d_verified_generators;
+    size_t d_bytes{0};
+    size_t d_max_bytes{static_cast<size_t>(64) * 1024 * 1024};
+    mutable std::mutex d_mutex;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GNSS_REPLICA_STORE_H
@@ -23,7 +23,27 @@
 #include <memory>
 #include <utility>
 
-#if GNURADIO_FFT_USES_TEMPLATES
+#if USE_FFT_PLAN_REGISTRY
+// FFT plans are created once per size and direction, and shared by all blocks
+#include "gnss_fft_plan_registry.h"
+using gnss_fft_complex_fwd = Gnss_Fft_Complex<true>;
+using gnss_fft_complex_rev = Gnss_Fft_Complex<false>;
+template <typename T>
+using gnss_fft_fwd_unique_ptr = std::unique_ptr<T>;
+template <typename... Args>
+gnss_fft_fwd_unique_ptr<gnss_fft_complex_fwd> gnss_fft_fwd_make_unique(Args&&... args)
+{
+    return std::make_unique<gnss_fft_complex_fwd>(std::forward<Args>(args)...);
+}
+template <typename T>
+using gnss_fft_rev_unique_ptr = std::unique_ptr<T>;
+template <typename... Args>
+gnss_fft_rev_unique_ptr<gnss_fft_complex_rev> gnss_fft_rev_make_unique(Args&&... args)
+{
+    return std::make_unique<gnss_fft_complex_rev>(std::forward<Args>(args)...);
+}
+
+#elif GNURADIO_FFT_USES_TEMPLATES
 using gnss_fft_complex_fwd = gr::fft::fft_complex_fwd;
 using gnss_fft_complex_rev = gr::fft::fft_complex_rev;
 template <typename T>
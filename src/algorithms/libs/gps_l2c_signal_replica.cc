@@ -17,6 +17,7 @@
 
 #include "gps_l2c_signal_replica.h"
 #include "GPS_L2C.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <cmath>
 #include <memory>
@@ -78,6 +79,13 @@ void gps_l2c_m_code_gen_complex_sampled(own::span<std::complex<float>> dest, uin
     constexpr float tc = 1.0F / static_cast<float>(GPS_L2_M_CODE_RATE_CPS);  // L2C chip period in sec
 
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(GPS_L2_M_CODE_RATE_CPS) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("2S_complex_sampled", sampling_freq, prn);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
     int32_t codeValueIndex;
 
@@ -105,4 +113,5 @@ void gps_l2c_m_code_gen_complex_sampled(own::span<std::complex<float>> dest, uin
                     dest[i] = std::complex<float>(0.0, 1.0F - 2.0F * code_aux[codeValueIndex]);  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
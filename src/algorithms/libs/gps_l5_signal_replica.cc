@@ -17,6 +17,7 @@
 
 #include "gps_l5_signal_replica.h"
 #include "GPS_L5.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <cmath>
 #include <deque>
@@ -196,6 +197,13 @@ void gps_l5i_code_gen_complex_sampled(own::span<std::complex<float>> dest, uint3
     constexpr float tc = 1.0 / static_cast<float>(GPS_L5I_CODE_RATE_CPS);  // L5I primary chip period in sec
 
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(GPS_L5I_CODE_RATE_CPS) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("L5I_complex_sampled", sampling_freq, prn);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
     int32_t codeValueIndex;
 
@@ -223,6 +231,7 @@ void gps_l5i_code_gen_complex_sampled(own::span<std::complex<float>> dest, uint3
                     dest[i] = std::complex<float>(1.0F - 2.0F * code_aux[codeValueIndex], 0.0);  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
 
 
@@ -261,17 +270,23 @@ void gps_l5q_code_gen_float(own::span<float> dest, uint32_t prn)
  */
 void gps_l5q_code_gen_complex_sampled(own::span<std::complex<float>> dest, uint32_t prn, int32_t sampling_freq)
 {
-    std::array<int32_t, GPS_L5Q_CODE_LENGTH_CHIPS> code_aux{};
-    if (prn > 0 and prn < 51)
-        {
-            make_l5q(code_aux, prn - 1);
-        }
-
     int32_t codeValueIndex;
     constexpr int32_t codeLength = GPS_L5Q_CODE_LENGTH_CHIPS;
 
     // --- Find number of samples per spreading code ---------------------------
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(GPS_L5Q_CODE_RATE_CPS) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("L5Q_complex_sampled", sampling_freq, prn);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
+    std::array<int32_t, GPS_L5Q_CODE_LENGTH_CHIPS> code_aux{};
+    if (prn > 0 and prn < 51)
+        {
+            make_l5q(code_aux, prn - 1);
+        }
 
     // --- Find time constants -------------------------------------------------
     const float ts = 1.0F / static_cast<float>(sampling_freq);              // Sampling period in sec
@@ -295,4 +310,5 @@ void gps_l5q_code_gen_complex_sampled(own::span<std::complex<float>> dest, uint3
                     dest[i] = std::complex<float>(0.0, 1.0F - 2.0F * code_aux[codeValueIndex]);  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -17,6 +17,7 @@
  */
 
 #include "gps_sdr_signal_replica.h"
+#include "gnss_replica_store.h"
 #include <array>
 #include <bitset>
 
@@ -141,6 +142,13 @@ void gps_l1_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest, uin
     constexpr float tc = 1.0F / static_cast<float>(codeFreqBasis);  // C/A chip period in sec
 
     const auto samplesPerCode = static_cast<int32_t>(static_cast<double>(sampling_freq) / (static_cast<double>(codeFreqBasis) / static_cast<double>(codeLength)));
+    const Gnss_Replica_Key key("1C_complex_sampled", sampling_freq, prn, chip_shift);
+    const auto replica = dest.first(samplesPerCode);
+    if (Gnss_Replica_Store::instance().copy(key, replica))
+        {
+            return;
+        }
+
     const float ts = 1.0F / static_cast<float>(sampling_freq);  // Sampling period in sec
     std::array<std::complex<float>, 1023> code_aux{};
     int32_t codeValueIndex;
@@ -173,4 +181,5 @@ void gps_l1_ca_code_gen_complex_sampled(own::span<std::complex<float>> dest, uin
                     dest[i] = code_aux[codeValueIndex];  // repeat the chip -> upsample
                 }
         }
+    Gnss_Replica_Store::instance().insert(key, replica);
 }
@@ -754,6 +754,7 @@ typedef struct
     int na, namax;                /* number of almanac data */
     int nt, ntmax;                /* number of tec grid data */
     int nf, nfmax;                /* number of satellite fcb data */
+    int ephidx;                   /* eph[sat-1]/geph[prn-1] hold the ephemeris of each satellite (0:off,1:on) */
     eph_t *eph;                   /* GPS/QZS/GAL ephemeris */
     geph_t *geph;                 /* GLONASS ephemeris */
     seph_t *seph;                 /* SBAS ephemeris */
@@ -34,6 +34,7 @@
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
+#include "rtklib_trace.h"
 #include <vector>
 
 /* constants -----------------------------------------------------------------*/
@@ -513,6 +514,8 @@ eph_t *seleph(gtime_t time, int sat, int iode, const nav_t *nav)
     double tmax;
     double tmin;
     int i;
+    int i0;
+    int i1;
     int j = -1;
 
     trace(4, "seleph  : time=%s sat=%2d iode=%d\n", time_str(time, 3), sat, iode);
@@ -534,7 +537,8 @@ eph_t *seleph(gtime_t time, int sat, int iode, const nav_t *nav)
         }
     tmin = tmax + 1.0;
 
-    for (i = 0; i < nav->n; i++)
+    ephrange(sat, nav, &i0, &i1);
+    for (i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -575,11 +579,14 @@ geph_t *selgeph(gtime_t time, int sat, int iode, const nav_t *nav)
     double tmax = MAXDTOE_GLO;
     double tmin = tmax + 1.0;
     int i;
+    int i0;
+    int i1;
     int j = -1;
 
     trace(4, "selgeph : time=%s sat=%2d iode=%2d\n", time_str(time, 3), sat, iode);
 
-    for (i = 0; i < nav->ng; i++)
+    gephrange(sat, nav, &i0, &i1);
+    for (i = i0; i < i1; i++)
         {
             if (nav->geph[i].sat != sat)
                 {
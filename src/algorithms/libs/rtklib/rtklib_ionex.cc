@@ -38,6 +38,7 @@
 
 #include "rtklib_ionex.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 #include <cstring>
 #include <vector>
 
@@ -33,6 +33,7 @@
 #include "rtklib_ephemeris.h"
 #include "rtklib_ionex.h"
 #include "rtklib_sbas.h"
+#include "rtklib_trace.h"
 #include <cstring>
 #include <vector>
 
@@ -55,7 +56,10 @@ double varerr(const prcopt_t *opt, double el, int sys)
 double gettgd(int sat, const nav_t *nav)
 {
     int i;
-    for (i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -69,7 +73,10 @@ double gettgd(int sat, const nav_t *nav)
 /* get isc parameter (m) -----------------------------------------------------*/
 double getiscl1(int sat, const nav_t *nav)
 {
-    for (int i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (int i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -82,7 +89,10 @@ double getiscl1(int sat, const nav_t *nav)
 
 double getiscl2(int sat, const nav_t *nav)
 {
-    for (int i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (int i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -95,7 +105,10 @@ double getiscl2(int sat, const nav_t *nav)
 
 double getiscl5i(int sat, const nav_t *nav)
 {
-    for (int i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (int i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -108,7 +121,10 @@ double getiscl5i(int sat, const nav_t *nav)
 
 double getiscl5q(int sat, const nav_t *nav)
 {
-    for (int i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (int i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
@@ -37,6 +37,7 @@
 #include "rtklib_rtkcmn.h"
 #include "rtklib_sbas.h"
 #include "rtklib_tides.h"
+#include "rtklib_trace.h"
 #include <cstring>
 #include <vector>
 
@@ -1043,7 +1044,10 @@ int ifmeas(const obsd_t *obs, const nav_t *nav, const double *azel,
 double gettgd_ppp(int sat, const nav_t *nav)
 {
     int i;
-    for (i = 0; i < nav->n; i++)
+    int i0;
+    int i1;
+    ephrange(sat, nav, &i0, &i1);
+    for (i = i0; i < i1; i++)
         {
             if (nav->eph[i].sat != sat)
                 {
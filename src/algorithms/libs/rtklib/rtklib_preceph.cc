@@ -42,6 +42,7 @@
 
 #include "rtklib_preceph.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 #include <cstring>
 #include <vector>
 
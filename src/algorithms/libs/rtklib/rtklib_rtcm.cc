@@ -33,6 +33,7 @@
 
 #include "rtklib_rtcm.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 
 // extern int encode_rtcm3(rtcm_t *rtcm, int type, int sync);
 
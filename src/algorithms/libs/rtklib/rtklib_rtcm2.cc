@@ -34,6 +34,7 @@
 
 #include "rtklib_rtcm2.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 
 
 /* adjust hourly rollover of rtcm 2 time -------------------------------------*/
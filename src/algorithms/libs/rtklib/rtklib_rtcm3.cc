@@ -34,6 +34,7 @@
 
 #include "rtklib_rtcm3.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 #include <cstring>
 
 
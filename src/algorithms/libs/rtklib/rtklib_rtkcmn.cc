@@ -30,6 +30,7 @@
  *----------------------------------------------------------------------------*/
 
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 #include <glog/logging.h>
 #include <array>
 #include <cassert>
@@ -2083,11 +2084,12 @@ void time2str(gtime_t t, char *s, int n)
  * args   : gtime_t t        I   gtime_t struct
  *          int    n         I   number of decimals
  * return : time string
- * notes  : not reentrant, do not use multiple in a function
+ * notes  : the string is stored in a buffer of the calling thread, so do not
+ *          use it more than once in the same expression
  *-----------------------------------------------------------------------------*/
 char *time_str(gtime_t t, int n)
 {
-    static char buff[64];
+    thread_local char buff[64];
     time2str(t, buff, n);
     return buff;
 }
@@ -3955,7 +3957,7 @@ void tracet(int level, const char *format, ...)
     fflush(fp_trace);
 }
 
-void tracemat(int level, const double *A, int n, int m, int p, int q)
+void tracematprint(int level, const double *A, int n, int m, int p, int q)
 {
     std::string buffer_;
     matsprint(A, n, m, p, q, buffer_);
@@ -4077,12 +4079,12 @@ void traceobs(int level __attribute__((unused)), const obsd_t *obs __attribute__
 // void traceopen(const char *file) {}
 // void traceclose(void) {}
 // void tracelevel(int level) {}
-void trace(int level, const char *format, ...)
+void traceprintf(int level, const char *format, ...)
 {
     va_list ap;
     char buffer[256];
     va_start(ap, format);
-    vsprintf(buffer, format, ap);
+    vsnprintf(buffer, sizeof(buffer), format, ap);
     va_end(ap);
     std::string str(buffer);
     VLOG(level) << "RTKLIB TRACE[" << level << "]:" << str;
@@ -4251,6 +4253,48 @@ int reppath(std::string const &path, std::string &rpath, gtime_t time, const cha
 }
 
 
+/* range of broadcast ephemeris entries of a satellite -------------------------
+ * get the range of navigation data entries that can hold the broadcast
+ * ephemeris of a satellite
+ * args   : int    sat       I   satellite number
+ *          nav_t  *nav      I   navigation data
+ *          int    *i0       O   first entry
+ *          int    *i1       O   last entry + 1
+ * return : none
+ * notes  : ephrange() gives the range of nav->eph and gephrange() the range of
+ *          nav->geph. if nav->ephidx is set, the ephemeris of a satellite is
+ *          eph[sat-1] (geph[prn-1] for GLONASS) and the range has at most one
+ *          entry, otherwise it is the whole array
+ *-----------------------------------------------------------------------------*/
+void ephrange(int sat, const nav_t *nav, int *i0, int *i1)
+{
+    *i0 = 0;
+    *i1 = nav->n;
+    if (nav->ephidx)
+        {
+            *i0 = sat - 1;
+            *i1 = (0 < sat && sat <= nav->n) ? sat : *i0;
+        }
+}
+
+
+void gephrange(int sat, const nav_t *nav, int *i0, int *i1)
+{
+    int prn;
+    *i0 = 0;
+    *i1 = nav->ng;
+    if (nav->ephidx)
+        {
+            *i0 = *i1 = 0;
+            if (satsys(sat, &prn) == SYS_GLO && prn <= nav->ng)
+                {
+                    *i0 = prn - 1;
+                    *i1 = prn;
+                }
+        }
+}
+
+
 /* satellite carrier wave length -----------------------------------------------
  * get satellite carrier wave lengths
  * args   : int    sat       I   satellite number
@@ -4263,13 +4307,16 @@ double satwavelen(int sat, int frq, const nav_t *nav)
     const double freq_glo[] = {FREQ1_GLO, FREQ2_GLO};
     const double dfrq_glo[] = {DFRQ1_GLO, DFRQ2_GLO};
     int i;
+    int i0;
+    int i1;
     int sys = satsys(sat, nullptr);
 
     if (sys == SYS_GLO)
         {
             if (0 <= frq && frq <= 1)
                 {
-                    for (i = 0; i < nav->ng; i++)
+                    gephrange(sat, nav, &i0, &i1);
+                    for (i = i0; i < i1; i++)
                         {
                             if (nav->geph[i].sat != sat)
                                 {
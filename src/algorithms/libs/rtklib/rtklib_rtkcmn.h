@@ -235,9 +235,9 @@ void traceopen(const char *file);
 void traceclose();
 void tracelevel(int level);
 void traceswap();
-void trace(int level, const char *format, ...);
+void traceprintf(int level, const char *format, ...);  // called through the trace() macro of rtklib_trace.h
 void tracet(int level, const char *format, ...);
-void tracemat(int level, const double *A, int n, int m, int p, int q);
+void tracematprint(int level, const double *A, int n, int m, int p, int q);  // called through the tracemat() macro of rtklib_trace.h
 void traceobs(int level, const obsd_t *obs, int n);
 // void tracenav(int level, const nav_t *nav);
 // void tracegnav(int level, const nav_t *nav);
@@ -250,6 +250,8 @@ int execcmd(const char *cmd);
 void createdir(fs::path const &path);
 int reppath(std::string const &path, std::string &rpath, gtime_t time, const char *rov,
     const char *base);
+void ephrange(int sat, const nav_t *nav, int *i0, int *i1);
+void gephrange(int sat, const nav_t *nav, int *i0, int *i1);
 double satwavelen(int sat, int frq, const nav_t *nav);
 double geodist(const double *rs, const double *rr, double *e);
 double satazel(const double *pos, const double *e, double *azel);
@@ -35,6 +35,7 @@
 #include "rtklib_pntpos.h"
 #include "rtklib_ppp.h"
 #include "rtklib_tides.h"
+#include "rtklib_trace.h"
 #include <cmath>
 #include <cstring>
 #include <string>
@@ -37,6 +37,7 @@
 #include "rtklib_sbas.h"
 #include "rtklib_solution.h"
 #include "rtklib_stream.h"
+#include "rtklib_trace.h"
 #include <cstring>
 
 /* write solution header to output stream ------------------------------------*/
@@ -776,6 +777,7 @@ int rtksvrinit(rtksvr_t *svr)
     svr->nav.n = MAXSAT * 2;
     svr->nav.ng = NSATGLO * 2;
     svr->nav.ns = NSATSBS * 2;
+    svr->nav.ephidx = 0;
 
     for (i = 0; i < 3; i++)
         {
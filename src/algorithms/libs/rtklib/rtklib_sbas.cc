@@ -41,6 +41,7 @@
 
 #include "rtklib_sbas.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 #include <cmath>  // for lround
 #include <cstring>
 
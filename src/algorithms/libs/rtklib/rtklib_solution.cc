@@ -34,6 +34,7 @@
 #include "rtklib_solution.h"
 #include "rtklib_rtkcmn.h"
 #include "rtklib_rtksvr.h"
+#include "rtklib_trace.h"
 #include <cctype>
 #include <cmath>
 #include <cstring>
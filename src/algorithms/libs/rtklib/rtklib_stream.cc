@@ -35,6 +35,7 @@
 #include "gnss_sdr_string_literals.h"  // for std::string_literals
 #include "rtklib_rtkcmn.h"
 #include "rtklib_solution.h"
+#include "rtklib_trace.h"
 #include <arpa/inet.h>
 #include <cctype>
 #include <cerrno>
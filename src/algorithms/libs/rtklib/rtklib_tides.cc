@@ -32,6 +32,7 @@
 
 #include "rtklib_tides.h"
 #include "rtklib_rtkcmn.h"
+#include "rtklib_trace.h"
 
 
 /* solar/lunar tides (ref [2] 7) ---------------------------------------------*/
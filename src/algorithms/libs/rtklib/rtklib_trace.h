@@ -0,0 +1,59 @@
+/*!
+ * \file rtklib_trace.h
+ * \brief Debug trace macros of the rtklib functions
+ *
+ * trace() and tracemat() only evaluate their arguments when the glog verbose
+ * level is at least the trace level, so arguments such as time_str(), which
+ * format strings, cost nothing on the hot paths when tracing is off. Building
+ * with -DENABLE_RTKLIB_TRACE=OFF defines RTKLIB_NO_TRACE and compiles the
+ * traces out.
+ *
+ * This header defines function-like macros named trace and tracemat, which
+ * would clash with other libraries (e.g. arma::trace), so it is meant to be
+ * included only by the rtklib source files.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_RTKLIB_TRACE_H
+#define GNSS_SDR_RTKLIB_TRACE_H
+
+#include "rtklib_rtkcmn.h"
+#include <glog/logging.h>
+
+#if RTKLIB_NO_TRACE
+// The arguments are still type-checked, but the call is never executed
+#define RTKLIB_TRACE_IS_ON(level) false
+#else
+#define RTKLIB_TRACE_IS_ON(level) VLOG_IS_ON(level)
+#endif
+
+#define trace(level, ...)                            \
+    do                                               \
+        {                                            \
+            if (RTKLIB_TRACE_IS_ON(level))           \
+                {                                    \
+                    traceprintf(level, __VA_ARGS__); \
+                }                                    \
+        }                                            \
+    while (0)
+
+#define tracemat(level, ...)                           \
+    do                                                 \
+        {                                              \
+            if (RTKLIB_TRACE_IS_ON(level))             \
+                {                                      \
+                    tracematprint(level, __VA_ARGS__); \
+                }                                      \
+        }                                              \
+    while (0)
+
+#endif  // GNSS_SDR_RTKLIB_TRACE_H
@@ -0,0 +1,852 @@
+/*!
+ * \file volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn.h
+ * \brief VOLK_GNSSSDR kernel: rotates a 16-bit integer complex vector and
+ * correlates it with N shifted replicas of a real local code, resampling the
+ * code on the fly and accumulating in 32-bit floating point.
+ *
+ * VOLK_GNSSSDR kernel equivalent to
+ * volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn for 16-bit integer
+ * complex input samples, which are converted to floating point as they are
+ * read. The carrier wipe-off and the accumulations are done in floating point,
+ * so long integrations do not saturate.
+ * It is optimized to perform the N tap correlation process in GNSS receivers.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn
+ *
+ * \b Overview
+ *
+ * Rotates the reference complex vector, multiplies it by an arbitrary number
+ * of shifted versions of a real local code, accumulates the results and
+ * stores them in the output vector. The rotation is done at a fixed rate per
+ * sample, from an initial \p phase offset. The local code sample of tap k at
+ * sample n is
+ *
+ * local_code[floor(code_phase_step_chips * n + shifts_chips[k] - rem_code_phase_chips) mod code_length_chips]
+ *
+ * exactly as in volk_gnsssdr_32f_xn_resampler_32f_xn, but the code indexes
+ * are computed on the fly and the resampled replicas are never stored, which
+ * saves 2 * num_out_vectors * num_points floats of memory traffic per call.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li in_common:             Pointer to the 16-bit integer complex vector to be rotated, multiplied and accumulated (reference vector).
+ * \li phase_inc:             Phase increment = lv_cmake(cos(phase_step_rad), sin(phase_step_rad))
+ * \li phase:                 Initial phase = lv_cmake(cos(initial_phase_rad), sin(initial_phase_rad))
+ * \li local_code:            One period of the local code.
+ * \li rem_code_phase_chips:  Remnant code phase [chips].
+ * \li code_phase_step_chips: Phase increment per sample [chips/sample].
+ * \li shifts_chips:          Vector of floats that defines the spacing (in chips) between the replicas of \p local_code
+ * \li code_length_chips:     Code length in chips.
+ * \li num_out_vectors:       Number of correlator taps.
+ * \li num_points:            Number of complex values to be multiplied together, accumulated and stored into \p result.
+ *
+ * \b Outputs
+ * \li phase:                 Final phase.
+ * \li result:                Vector of \p num_out_vectors components with the correlation of each code replica with the rotated \p in_common.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_H
+#define INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_H
+
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <volk_gnsssdr/volk_gnsssdr_malloc.h>
+#include <math.h>
+#include <stdlib.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_generic(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    lv_32fc_t tmp32_1;
+    int local_code_chip_index;
+    int n_vec;
+    unsigned int n;
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0.0f, 0.0f);
+        }
+    for (n = 0; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * (*phase);
+
+            // Regenerate phase
+            if (n % 256 == 0)
+                {
+#ifdef __cplusplus
+                    (*phase) /= std::abs((*phase));
+#else
+                    (*phase) /= hypotf(lv_creal(*phase), lv_cimag(*phase));
+#endif
+                }
+
+            (*phase) *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index < 0) local_code_chip_index += (int)code_length_chips * (abs(local_code_chip_index) / code_length_chips + 1);
+                    local_code_chip_index = local_code_chip_index % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index];
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <volk_gnsssdr/volk_gnsssdr_sse3_intrinsics.h>
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_u_sse4_1(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    const unsigned int quarterPoints = num_points / 4;
+    const int16_t* aPtr = (const int16_t*)in_common;
+    int n_vec;
+    int local_code_chip_index_;
+    unsigned int number;
+    unsigned int n;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1;
+
+    __VOLK_ATTR_ALIGNED(16)
+    int local_code_chip_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t phase_vec[4];
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t dotProductVector[2];
+
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < 2 * num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+        }
+
+    // Set up the complex rotator: z0 and z1 hold the phases of four consecutive samples
+    for (n = 0; n < 4; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m128 z0 = _mm_load_ps((float*)phase_vec);
+    __m128 z1 = _mm_load_ps((float*)(phase_vec + 2));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^4;
+    phase_vec[0] = dz;
+    phase_vec[1] = dz;
+    const __m128 dz_reg = _mm_load_ps((float*)phase_vec);
+
+    const __m128 fours = _mm_set1_ps(4.0f);
+    const __m128 code_phase_step_chips_reg = _mm_set_ps1(code_phase_step_chips);
+    const __m128i zeros = _mm_setzero_si128();
+    const __m128 code_length_chips_reg_f = _mm_set_ps1((float)code_length_chips);
+    const __m128i code_length_chips_reg_i = _mm_set1_epi32((int)code_length_chips);
+    __m128i local_code_chip_index_reg, aux_i, negatives, i, in16;
+    __m128 a0Val, a1Val, code_phase, aux, c, cTrunc, base, code, tmp1, tmp2;
+    __m128 indexn = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+    for (number = 0; number < quarterPoints; number++)
+        {
+            in16 = _mm_loadu_si128((const __m128i*)aPtr);  // r0|i0|r1|i1|r2|i2|r3|i3
+            a0Val = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(in16));
+            a1Val = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(in16, 8)));
+            a0Val = _mm_complexmul_ps(a0Val, z0);
+            a1Val = _mm_complexmul_ps(a1Val, z1);
+            z0 = _mm_complexmul_ps(z0, dz_reg);
+            z1 = _mm_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    aux = _mm_add_ps(code_phase, _mm_set_ps1(shifts_chips[n_vec] - rem_code_phase_chips));
+                    // floor
+                    aux = _mm_floor_ps(aux);
+
+                    // fmod
+                    c = _mm_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm_cvttps_epi32(c);
+                    cTrunc = _mm_cvtepi32_ps(i);
+                    base = _mm_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm_cvtps_epi32(_mm_sub_ps(aux, base));
+
+                    negatives = _mm_cmplt_epi32(local_code_chip_index_reg, zeros);
+                    aux_i = _mm_and_si128(code_length_chips_reg_i, negatives);
+                    local_code_chip_index_reg = _mm_add_epi32(local_code_chip_index_reg, aux_i);
+                    _mm_store_si128((__m128i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    code = _mm_set_ps(local_code[local_code_chip_index[3]], local_code[local_code_chip_index[2]], local_code[local_code_chip_index[1]], local_code[local_code_chip_index[0]]);
+                    tmp1 = _mm_unpacklo_ps(code, code);  // t0|t0|t1|t1
+                    tmp2 = _mm_unpackhi_ps(code, code);  // t2|t2|t3|t3
+                    acc[2 * n_vec] = _mm_add_ps(acc[2 * n_vec], _mm_mul_ps(a0Val, tmp1));
+                    acc[2 * n_vec + 1] = _mm_add_ps(acc[2 * n_vec + 1], _mm_mul_ps(a1Val, tmp2));
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(z0, z0);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    z0 = _mm_div_ps(z0, _mm_sqrt_ps(tmp1));
+                    tmp1 = _mm_mul_ps(z1, z1);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    z1 = _mm_div_ps(z1, _mm_sqrt_ps(tmp1));
+                }
+
+            indexn = _mm_add_ps(indexn, fours);
+            aPtr += 8;
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm_store_ps((float*)dotProductVector, _mm_add_ps(acc[2 * n_vec], acc[2 * n_vec + 1]));
+            result[n_vec] = dotProductVector[0] + dotProductVector[1];
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for (n = quarterPoints * 4; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_SSE4_1
+#include <volk_gnsssdr/volk_gnsssdr_sse3_intrinsics.h>
+#include <smmintrin.h>
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_a_sse4_1(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    const unsigned int quarterPoints = num_points / 4;
+    const int16_t* aPtr = (const int16_t*)in_common;
+    int n_vec;
+    int local_code_chip_index_;
+    unsigned int number;
+    unsigned int n;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1;
+
+    __VOLK_ATTR_ALIGNED(16)
+    int local_code_chip_index[4];
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t phase_vec[4];
+    __VOLK_ATTR_ALIGNED(16)
+    lv_32fc_t dotProductVector[2];
+
+    __m128* acc = (__m128*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m128), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < 2 * num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm_setzero_ps();
+        }
+
+    // Set up the complex rotator: z0 and z1 hold the phases of four consecutive samples
+    for (n = 0; n < 4; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m128 z0 = _mm_load_ps((float*)phase_vec);
+    __m128 z1 = _mm_load_ps((float*)(phase_vec + 2));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^4;
+    phase_vec[0] = dz;
+    phase_vec[1] = dz;
+    const __m128 dz_reg = _mm_load_ps((float*)phase_vec);
+
+    const __m128 fours = _mm_set1_ps(4.0f);
+    const __m128 code_phase_step_chips_reg = _mm_set_ps1(code_phase_step_chips);
+    const __m128i zeros = _mm_setzero_si128();
+    const __m128 code_length_chips_reg_f = _mm_set_ps1((float)code_length_chips);
+    const __m128i code_length_chips_reg_i = _mm_set1_epi32((int)code_length_chips);
+    __m128i local_code_chip_index_reg, aux_i, negatives, i, in16;
+    __m128 a0Val, a1Val, code_phase, aux, c, cTrunc, base, code, tmp1, tmp2;
+    __m128 indexn = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+
+    for (number = 0; number < quarterPoints; number++)
+        {
+            in16 = _mm_load_si128((const __m128i*)aPtr);  // r0|i0|r1|i1|r2|i2|r3|i3
+            a0Val = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(in16));
+            a1Val = _mm_cvtepi32_ps(_mm_cvtepi16_epi32(_mm_srli_si128(in16, 8)));
+            a0Val = _mm_complexmul_ps(a0Val, z0);
+            a1Val = _mm_complexmul_ps(a1Val, z1);
+            z0 = _mm_complexmul_ps(z0, dz_reg);
+            z1 = _mm_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    aux = _mm_add_ps(code_phase, _mm_set_ps1(shifts_chips[n_vec] - rem_code_phase_chips));
+                    // floor
+                    aux = _mm_floor_ps(aux);
+
+                    // fmod
+                    c = _mm_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm_cvttps_epi32(c);
+                    cTrunc = _mm_cvtepi32_ps(i);
+                    base = _mm_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm_cvtps_epi32(_mm_sub_ps(aux, base));
+
+                    negatives = _mm_cmplt_epi32(local_code_chip_index_reg, zeros);
+                    aux_i = _mm_and_si128(code_length_chips_reg_i, negatives);
+                    local_code_chip_index_reg = _mm_add_epi32(local_code_chip_index_reg, aux_i);
+                    _mm_store_si128((__m128i*)local_code_chip_index, local_code_chip_index_reg);
+
+                    code = _mm_set_ps(local_code[local_code_chip_index[3]], local_code[local_code_chip_index[2]], local_code[local_code_chip_index[1]], local_code[local_code_chip_index[0]]);
+                    tmp1 = _mm_unpacklo_ps(code, code);  // t0|t0|t1|t1
+                    tmp2 = _mm_unpackhi_ps(code, code);  // t2|t2|t3|t3
+                    acc[2 * n_vec] = _mm_add_ps(acc[2 * n_vec], _mm_mul_ps(a0Val, tmp1));
+                    acc[2 * n_vec + 1] = _mm_add_ps(acc[2 * n_vec + 1], _mm_mul_ps(a1Val, tmp2));
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    tmp1 = _mm_mul_ps(z0, z0);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    z0 = _mm_div_ps(z0, _mm_sqrt_ps(tmp1));
+                    tmp1 = _mm_mul_ps(z1, z1);
+                    tmp2 = _mm_hadd_ps(tmp1, tmp1);
+                    tmp1 = _mm_shuffle_ps(tmp2, tmp2, 0xD8);
+                    z1 = _mm_div_ps(z1, _mm_sqrt_ps(tmp1));
+                }
+
+            indexn = _mm_add_ps(indexn, fours);
+            aPtr += 8;
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm_store_ps((float*)dotProductVector, _mm_add_ps(acc[2 * n_vec], acc[2 * n_vec + 1]));
+            result[n_vec] = dotProductVector[0] + dotProductVector[1];
+        }
+    volk_gnsssdr_free(acc);
+
+    _mm_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+#ifdef __cplusplus
+    _phase /= std::abs(_phase);
+#else
+    _phase /= hypotf(lv_creal(_phase), lv_cimag(_phase));
+#endif
+
+    for (n = quarterPoints * 4; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_SSE4_1 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_u_avx2(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    const unsigned int eighthPoints = num_points / 8;
+    const int16_t* aPtr = (const int16_t*)in_common;
+    int n_vec;
+    int local_code_chip_index_;
+    unsigned int number;
+    unsigned int n;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1;
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < 2 * num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+        }
+
+    // Set up the complex rotator: z0 and z1 hold the phases of eight consecutive samples
+    for (n = 0; n < 8; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m256 z0 = _mm256_load_ps((float*)phase_vec);
+    __m256 z1 = _mm256_load_ps((float*)(phase_vec + 4));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8;
+    for (n = 0; n < 4; n++)
+        {
+            phase_vec[n] = dz;
+        }
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256i zeros = _mm256_setzero_si256();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256i code_length_chips_reg_i = _mm256_set1_epi32((int)code_length_chips);
+    __m256i local_code_chip_index_reg, negatives, i;
+    __m256 a0Val, a1Val, code_phase, aux, c, cTrunc, base, code, codelo, codehi;
+    __m256 indexn = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for (number = 0; number < eighthPoints; number++)
+        {
+            a0Val = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)aPtr)));
+            a1Val = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(aPtr + 8))));
+            a0Val = _mm256_complexmul_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_ps(a1Val, z1);
+            z0 = _mm256_complexmul_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm256_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    aux = _mm256_add_ps(code_phase, _mm256_set1_ps(shifts_chips[n_vec] - rem_code_phase_chips));
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+
+                    // fmod
+                    c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm256_cvttps_epi32(c);
+                    cTrunc = _mm256_cvtepi32_ps(i);
+                    base = _mm256_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(_mm256_sub_ps(aux, base));
+
+                    // no negatives
+                    negatives = _mm256_cmpgt_epi32(zeros, local_code_chip_index_reg);
+                    local_code_chip_index_reg = _mm256_add_epi32(local_code_chip_index_reg, _mm256_and_si256(code_length_chips_reg_i, negatives));
+
+                    code = _mm256_i32gather_ps(local_code, local_code_chip_index_reg, 4);  // t0|t1|t2|t3|t4|t5|t6|t7
+                    codelo = _mm256_unpacklo_ps(code, code);                              // t0|t0|t1|t1|t4|t4|t5|t5
+                    codehi = _mm256_unpackhi_ps(code, code);                              // t2|t2|t3|t3|t6|t6|t7|t7
+                    acc[2 * n_vec] = _mm256_add_ps(acc[2 * n_vec], _mm256_mul_ps(a0Val, _mm256_permute2f128_ps(codelo, codehi, 0x20)));
+                    acc[2 * n_vec + 1] = _mm256_add_ps(acc[2 * n_vec + 1], _mm256_mul_ps(a1Val, _mm256_permute2f128_ps(codelo, codehi, 0x31)));
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                }
+
+            indexn = _mm256_add_ps(indexn, eights);
+            aPtr += 16;
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm256_store_ps((float*)dotProductVector, _mm256_add_ps(acc[2 * n_vec], acc[2 * n_vec + 1]));
+            result[n_vec] = dotProductVector[0] + dotProductVector[1] + dotProductVector[2] + dotProductVector[3];
+        }
+    volk_gnsssdr_free(acc);
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    for (n = eighthPoints * 8; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <volk_gnsssdr/volk_gnsssdr_avx_intrinsics.h>
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_a_avx2(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    const unsigned int eighthPoints = num_points / 8;
+    const int16_t* aPtr = (const int16_t*)in_common;
+    int n_vec;
+    int local_code_chip_index_;
+    unsigned int number;
+    unsigned int n;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1;
+
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t phase_vec[8];
+    __VOLK_ATTR_ALIGNED(32)
+    lv_32fc_t dotProductVector[4];
+
+    __m256* acc = (__m256*)volk_gnsssdr_malloc(2 * num_out_vectors * sizeof(__m256), volk_gnsssdr_get_alignment());
+    for (n_vec = 0; n_vec < 2 * num_out_vectors; n_vec++)
+        {
+            acc[n_vec] = _mm256_setzero_ps();
+        }
+
+    // Set up the complex rotator: z0 and z1 hold the phases of eight consecutive samples
+    for (n = 0; n < 8; n++)
+        {
+            phase_vec[n] = _phase;
+            _phase *= phase_inc;
+        }
+    __m256 z0 = _mm256_load_ps((float*)phase_vec);
+    __m256 z1 = _mm256_load_ps((float*)(phase_vec + 4));
+    lv_32fc_t dz = phase_inc;
+    dz *= dz;
+    dz *= dz;
+    dz *= dz;  // dz = phase_inc^8;
+    for (n = 0; n < 4; n++)
+        {
+            phase_vec[n] = dz;
+        }
+    __m256 dz_reg = _mm256_load_ps((float*)phase_vec);
+    dz_reg = _mm256_complexnormalise_ps(dz_reg);
+
+    const __m256 eights = _mm256_set1_ps(8.0f);
+    const __m256 code_phase_step_chips_reg = _mm256_set1_ps(code_phase_step_chips);
+    const __m256i zeros = _mm256_setzero_si256();
+    const __m256 code_length_chips_reg_f = _mm256_set1_ps((float)code_length_chips);
+    const __m256i code_length_chips_reg_i = _mm256_set1_epi32((int)code_length_chips);
+    __m256i local_code_chip_index_reg, negatives, i;
+    __m256 a0Val, a1Val, code_phase, aux, c, cTrunc, base, code, codelo, codehi;
+    __m256 indexn = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+
+    for (number = 0; number < eighthPoints; number++)
+        {
+            a0Val = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_load_si128((const __m128i*)aPtr)));
+            a1Val = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_load_si128((const __m128i*)(aPtr + 8))));
+            a0Val = _mm256_complexmul_ps(a0Val, z0);
+            a1Val = _mm256_complexmul_ps(a1Val, z1);
+            z0 = _mm256_complexmul_ps(z0, dz_reg);
+            z1 = _mm256_complexmul_ps(z1, dz_reg);
+
+            code_phase = _mm256_mul_ps(code_phase_step_chips_reg, indexn);
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    aux = _mm256_add_ps(code_phase, _mm256_set1_ps(shifts_chips[n_vec] - rem_code_phase_chips));
+                    // floor
+                    aux = _mm256_floor_ps(aux);
+
+                    // fmod
+                    c = _mm256_div_ps(aux, code_length_chips_reg_f);
+                    i = _mm256_cvttps_epi32(c);
+                    cTrunc = _mm256_cvtepi32_ps(i);
+                    base = _mm256_mul_ps(cTrunc, code_length_chips_reg_f);
+                    local_code_chip_index_reg = _mm256_cvttps_epi32(_mm256_sub_ps(aux, base));
+
+                    // no negatives
+                    negatives = _mm256_cmpgt_epi32(zeros, local_code_chip_index_reg);
+                    local_code_chip_index_reg = _mm256_add_epi32(local_code_chip_index_reg, _mm256_and_si256(code_length_chips_reg_i, negatives));
+
+                    code = _mm256_i32gather_ps(local_code, local_code_chip_index_reg, 4);  // t0|t1|t2|t3|t4|t5|t6|t7
+                    codelo = _mm256_unpacklo_ps(code, code);                              // t0|t0|t1|t1|t4|t4|t5|t5
+                    codehi = _mm256_unpackhi_ps(code, code);                              // t2|t2|t3|t3|t6|t6|t7|t7
+                    acc[2 * n_vec] = _mm256_add_ps(acc[2 * n_vec], _mm256_mul_ps(a0Val, _mm256_permute2f128_ps(codelo, codehi, 0x20)));
+                    acc[2 * n_vec + 1] = _mm256_add_ps(acc[2 * n_vec + 1], _mm256_mul_ps(a1Val, _mm256_permute2f128_ps(codelo, codehi, 0x31)));
+                }
+
+            // Force the rotators back onto the unit circle
+            if ((number % 64) == 0)
+                {
+                    z0 = _mm256_complexnormalise_ps(z0);
+                    z1 = _mm256_complexnormalise_ps(z1);
+                }
+
+            indexn = _mm256_add_ps(indexn, eights);
+            aPtr += 16;
+        }
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            _mm256_store_ps((float*)dotProductVector, _mm256_add_ps(acc[2 * n_vec], acc[2 * n_vec + 1]));
+            result[n_vec] = dotProductVector[0] + dotProductVector[1] + dotProductVector[2] + dotProductVector[3];
+        }
+    volk_gnsssdr_free(acc);
+
+    z0 = _mm256_complexnormalise_ps(z0);
+    _mm256_store_ps((float*)phase_vec, z0);
+    _phase = phase_vec[0];
+
+    for (n = eighthPoints * 8; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_neon(lv_32fc_t* result, const lv_16sc_t* in_common, const lv_32fc_t phase_inc, lv_32fc_t* phase, const float* local_code, float rem_code_phase_chips, float code_phase_step_chips, const float* shifts_chips, unsigned int code_length_chips, int num_out_vectors, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const lv_16sc_t* _in_common = in_common;
+    int n_vec;
+    int local_code_chip_index_;
+    unsigned int number;
+    unsigned int n;
+    lv_32fc_t _phase = (*phase);
+    lv_32fc_t tmp32_1;
+
+    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+        {
+            result[n_vec] = lv_cmake(0.0f, 0.0f);
+        }
+
+    if (neon_iters > 0)
+        {
+            float32_t arg_phase0 = cargf(_phase);
+            float32_t arg_phase_inc = cargf(phase_inc);
+            float32_t phase_est;
+
+            lv_32fc_t ___phase4 = phase_inc * phase_inc * phase_inc * phase_inc;
+            __VOLK_ATTR_ALIGNED(16)
+            float32_t __phase4_real[4] = {lv_creal(___phase4), lv_creal(___phase4), lv_creal(___phase4), lv_creal(___phase4)};
+            __VOLK_ATTR_ALIGNED(16)
+            float32_t __phase4_imag[4] = {lv_cimag(___phase4), lv_cimag(___phase4), lv_cimag(___phase4), lv_cimag(___phase4)};
+
+            float32x4_t _phase4_real = vld1q_f32(__phase4_real);
+            float32x4_t _phase4_imag = vld1q_f32(__phase4_imag);
+
+            lv_32fc_t phase2 = (lv_32fc_t)(_phase)*phase_inc;
+            lv_32fc_t phase3 = phase2 * phase_inc;
+            lv_32fc_t phase4 = phase3 * phase_inc;
+
+            __VOLK_ATTR_ALIGNED(16)
+            float32_t __phase_real[4] = {lv_creal((_phase)), lv_creal(phase2), lv_creal(phase3), lv_creal(phase4)};
+            __VOLK_ATTR_ALIGNED(16)
+            float32_t __phase_imag[4] = {lv_cimag((_phase)), lv_cimag(phase2), lv_cimag(phase3), lv_cimag(phase4)};
+
+            float32x4_t _phase_real = vld1q_f32(__phase_real);
+            float32x4_t _phase_imag = vld1q_f32(__phase_imag);
+
+            __VOLK_ATTR_ALIGNED(16)
+            int32_t local_code_chip_index[4];
+            __VOLK_ATTR_ALIGNED(16)
+            float32_t code_vec[4];
+            __VOLK_ATTR_ALIGNED(16)
+            const float vec[4] = {0.0f, 1.0f, 2.0f, 3.0f};
+
+            const int32x4_t ones = vdupq_n_s32(1);
+            const int32x4_t zeros = vdupq_n_s32(0);
+            const float32x4_t fours = vdupq_n_f32(4.0f);
+            const float32x4_t code_phase_step_chips_reg = vdupq_n_f32(code_phase_step_chips);
+            const float32x4_t code_length_chips_reg_f = vdupq_n_f32((float)code_length_chips);
+            const int32x4_t code_length_chips_reg_i = vdupq_n_s32((int32_t)code_length_chips);
+            float32x4_t reciprocal = vrecpeq_f32(code_length_chips_reg_f);
+            reciprocal = vmulq_f32(vrecpsq_f32(code_length_chips_reg_f, reciprocal), reciprocal);
+            reciprocal = vmulq_f32(vrecpsq_f32(code_length_chips_reg_f, reciprocal), reciprocal);  // this refinement is required!
+
+            int32x4_t local_code_chip_index_reg, aux_i, negatives, i;
+            float32x4_t code_phase, aux, fi, j, c, cTrunc, base, code;
+            float32x4_t indexn = vld1q_f32((float*)vec);
+            uint32x4_t igx;
+            float32x4x2_t b_val, tmp32_real, tmp32_imag;
+            int16x4x2_t in16;
+
+            float32x4x2_t* accumulator = (float32x4x2_t*)volk_gnsssdr_malloc(num_out_vectors * sizeof(float32x4x2_t), volk_gnsssdr_get_alignment());
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    accumulator[n_vec].val[0] = vdupq_n_f32(0.0f);
+                    accumulator[n_vec].val[1] = vdupq_n_f32(0.0f);
+                }
+
+            for (number = 0; number < neon_iters; number++)
+                {
+                    /* load 4 complex numbers (integer 16 bits each component) */
+                    in16 = vld2_s16((const int16_t*)_in_common);
+                    b_val.val[0] = vcvtq_f32_s32(vmovl_s16(in16.val[0]));
+                    b_val.val[1] = vcvtq_f32_s32(vmovl_s16(in16.val[1]));
+                    __VOLK_GNSSSDR_PREFETCH(_in_common + 8);
+                    _in_common += 4;
+
+                    /* complex multiplication of four complex samples (float 32 bits each component) */
+                    tmp32_real.val[0] = vmulq_f32(b_val.val[0], _phase_real);
+                    tmp32_real.val[1] = vmulq_f32(b_val.val[1], _phase_imag);
+                    tmp32_imag.val[0] = vmulq_f32(b_val.val[0], _phase_imag);
+                    tmp32_imag.val[1] = vmulq_f32(b_val.val[1], _phase_real);
+
+                    b_val.val[0] = vsubq_f32(tmp32_real.val[0], tmp32_real.val[1]);
+                    b_val.val[1] = vaddq_f32(tmp32_imag.val[0], tmp32_imag.val[1]);
+
+                    /* compute next four phases */
+                    tmp32_real.val[0] = vmulq_f32(_phase_real, _phase4_real);
+                    tmp32_real.val[1] = vmulq_f32(_phase_imag, _phase4_imag);
+                    tmp32_imag.val[0] = vmulq_f32(_phase_real, _phase4_imag);
+                    tmp32_imag.val[1] = vmulq_f32(_phase_imag, _phase4_real);
+
+                    _phase_real = vsubq_f32(tmp32_real.val[0], tmp32_real.val[1]);
+                    _phase_imag = vaddq_f32(tmp32_imag.val[0], tmp32_imag.val[1]);
+
+                    // Regenerate phase
+                    if ((number % 128) == 0)
+                        {
+                            phase_est = arg_phase0 + (number + 1) * 4 * arg_phase_inc;
+
+                            _phase = lv_cmake(cos(phase_est), sin(phase_est));
+                            phase2 = _phase * phase_inc;
+                            phase3 = phase2 * phase_inc;
+                            phase4 = phase3 * phase_inc;
+
+                            __VOLK_ATTR_ALIGNED(16)
+                            float32_t ____phase_real[4] = {lv_creal((_phase)), lv_creal(phase2), lv_creal(phase3), lv_creal(phase4)};
+                            __VOLK_ATTR_ALIGNED(16)
+                            float32_t ____phase_imag[4] = {lv_cimag((_phase)), lv_cimag(phase2), lv_cimag(phase3), lv_cimag(phase4)};
+
+                            _phase_real = vld1q_f32(____phase_real);
+                            _phase_imag = vld1q_f32(____phase_imag);
+                        }
+
+                    code_phase = vmulq_f32(code_phase_step_chips_reg, indexn);
+                    for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                        {
+                            aux = vaddq_f32(code_phase, vdupq_n_f32(shifts_chips[n_vec] - rem_code_phase_chips));
+
+                            // floor
+                            i = vcvtq_s32_f32(aux);
+                            fi = vcvtq_f32_s32(i);
+                            igx = vcgtq_f32(fi, aux);
+                            j = vcvtq_f32_s32(vandq_s32(vreinterpretq_s32_u32(igx), ones));
+                            aux = vsubq_f32(fi, j);
+
+                            // fmod
+                            c = vmulq_f32(aux, reciprocal);
+                            i = vcvtq_s32_f32(c);
+                            cTrunc = vcvtq_f32_s32(i);
+                            base = vmulq_f32(cTrunc, code_length_chips_reg_f);
+                            aux = vsubq_f32(aux, base);
+                            local_code_chip_index_reg = vcvtq_s32_f32(aux);
+
+                            negatives = vreinterpretq_s32_u32(vcltq_s32(local_code_chip_index_reg, zeros));
+                            aux_i = vandq_s32(code_length_chips_reg_i, negatives);
+                            local_code_chip_index_reg = vaddq_s32(local_code_chip_index_reg, aux_i);
+
+                            vst1q_s32((int32_t*)local_code_chip_index, local_code_chip_index_reg);
+                            code_vec[0] = local_code[local_code_chip_index[0]];
+                            code_vec[1] = local_code[local_code_chip_index[1]];
+                            code_vec[2] = local_code[local_code_chip_index[2]];
+                            code_vec[3] = local_code[local_code_chip_index[3]];
+                            code = vld1q_f32(code_vec);
+
+                            accumulator[n_vec].val[0] = vmlaq_f32(accumulator[n_vec].val[0], code, b_val.val[0]);
+                            accumulator[n_vec].val[1] = vmlaq_f32(accumulator[n_vec].val[1], code, b_val.val[1]);
+                        }
+                    indexn = vaddq_f32(indexn, fours);
+                }
+
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    vst1q_f32((float32_t*)__phase_real, accumulator[n_vec].val[0]);
+                    vst1q_f32((float32_t*)__phase_imag, accumulator[n_vec].val[1]);
+                    result[n_vec] = lv_cmake(__phase_real[0] + __phase_real[1] + __phase_real[2] + __phase_real[3],
+                        __phase_imag[0] + __phase_imag[1] + __phase_imag[2] + __phase_imag[3]);
+                }
+            volk_gnsssdr_free(accumulator);
+
+            vst1q_f32((float32_t*)__phase_real, _phase_real);
+            vst1q_f32((float32_t*)__phase_imag, _phase_imag);
+
+            _phase = lv_cmake((float32_t)__phase_real[0], (float32_t)__phase_imag[0]);
+        }
+
+    for (n = neon_iters * 4; n < num_points; n++)
+        {
+            tmp32_1 = lv_cmake((float)lv_creal(in_common[n]), (float)lv_cimag(in_common[n])) * _phase;
+            _phase *= phase_inc;
+            for (n_vec = 0; n_vec < num_out_vectors; n_vec++)
+                {
+                    // resample code for current tap
+                    local_code_chip_index_ = (int)floor(code_phase_step_chips * (float)n + shifts_chips[n_vec] - rem_code_phase_chips);
+                    // Take into account that in multitap correlators, the shifts can be negative!
+                    if (local_code_chip_index_ < 0) local_code_chip_index_ += (int)code_length_chips * (abs(local_code_chip_index_) / code_length_chips + 1);
+                    local_code_chip_index_ = local_code_chip_index_ % code_length_chips;
+                    result[n_vec] += tmp32_1 * local_code[local_code_chip_index_];
+                }
+        }
+    (*phase) = _phase;
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_H */
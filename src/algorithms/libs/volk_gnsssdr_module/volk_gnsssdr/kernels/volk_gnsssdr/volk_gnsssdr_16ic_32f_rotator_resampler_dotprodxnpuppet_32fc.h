@@ -0,0 +1,154 @@
+/*!
+ * \file volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc.h
+ * \brief Volk puppet for the fused resampler and multiple complex dot product
+ * kernel with 16-bit integer input.
+ *
+ * Volk puppet for integrating the fused resampler and rotator dot product
+ * kernel into volk's test system. The puppet input is used as the local code.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_H
+#define INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_H
+
+#include "volk_gnsssdr/volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_generic(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_generic(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // Generic
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_u_sse4_1(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_u_sse4_1(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // SSE4.1
+
+#ifdef LV_HAVE_SSE4_1
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_a_sse4_1(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_a_sse4_1(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // SSE4.1
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_u_avx2(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_u_avx2(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // AVX2
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_a_avx2(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_a_avx2(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // AVX2
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_neon(lv_32fc_t* result, const lv_16sc_t* local_code, const float* in, unsigned int num_points)
+{
+    // phases must be normalized. Phase rotator expects a complex exponential input!
+    float rem_carrier_phase_in_rad = 0.25;
+    float phase_step_rad = 0.1;
+    lv_32fc_t phase[1];
+    phase[0] = lv_cmake(cos(rem_carrier_phase_in_rad), sin(rem_carrier_phase_in_rad));
+    lv_32fc_t phase_inc[1];
+    phase_inc[0] = lv_cmake(cos(phase_step_rad), sin(phase_step_rad));
+    unsigned int code_length_chips = num_points / 4;
+    float code_phase_step_chips = 0.5;
+    float rem_code_phase_chips = 0.234;
+    int num_out_vectors = 3;
+    float shifts_chips[3] = {-0.1, 0.0, 0.1};
+
+    volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn_neon(result, local_code, phase_inc[0], phase, in, rem_code_phase_chips, code_phase_step_chips, shifts_chips, code_length_chips, num_out_vectors, num_points);
+}
+
+#endif  // NEON
+
+#endif  // INCLUDED_volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc_H
@@ -0,0 +1,329 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbi_k7r12_8u.h
+ * \brief VOLK_GNSSSDR kernel: add-compare-select stage of a Viterbi decoder
+ * for the K=7, rate 1/2 convolutional code with generator polynomials 171
+ * and 133 (octal).
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32f_viterbi_k7r12_8u
+ *
+ * \b Overview
+ *
+ * Runs num_points steps of the add-compare-select recursion of a Viterbi
+ * decoder for the K=7, rate 1/2 convolutional code with generator
+ * polynomials 171 and 133 (octal), used by Galileo I/NAV, F/NAV and C/NAV,
+ * GPS L2C and L5 CNAV and SBAS L1.
+ *
+ * The encoder state is formed by the last six input bits, the newest one in
+ * the most significant position, so the state reached from state s with
+ * input bit b is (b << 5) | (s >> 1). The branch metric of a symbol pair
+ * (c0, c1) is c0 * r0 + c1 * r1, where r0 and r1 are the received soft
+ * symbols (positive for a logical one).
+ *
+ * For each step and each of the 64 states, the kernel stores in decisions a
+ * 1 if the surviving path comes from the odd predecessor (2 * (s % 32) + 1)
+ * and a 0 if it comes from the even one. The input bit of a state is
+ * s >> 5, so the decisions are all that is needed for the trace-back.
+ * Path metrics are normalized to a maximum of zero after each step.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32f_viterbi_k7r12_8u(uint8_t* decisions, float* metrics, const float* symbols, unsigned int num_points)
+ * \endcode
+ *
+ * \b Inputs
+ * \li metrics: Path metrics of the 64 states before the first step.
+ * \li symbols: 2 * num_points soft symbols.
+ * \li num_points: The number of trellis steps.
+ *
+ * \b Outputs
+ * \li decisions: 64 * num_points survivor decisions.
+ * \li metrics: Path metrics of the 64 states after the last step.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbi_k7r12_8u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbi_k7r12_8u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <inttypes.h>
+#include <string.h>
+
+/* Encoder output for input bit 0 from the even state 2 * j. The odd state
+ * 2 * j + 1 and input bit 1 produce the complementary symbols. */
+__VOLK_ATTR_ALIGNED(32)
+static const float volk_gnsssdr_viterbi_k7r12_c0[32] = {
+    0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0,
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1};
+__VOLK_ATTR_ALIGNED(32)
+static const float volk_gnsssdr_viterbi_k7r12_c1[32] = {
+    0, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1,
+    0, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1, 0, 0, 1, 0, 1};
+__VOLK_ATTR_ALIGNED(32)
+static const float volk_gnsssdr_viterbi_k7r12_nc0[32] = {
+    1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+    0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0};
+__VOLK_ATTR_ALIGNED(32)
+static const float volk_gnsssdr_viterbi_k7r12_nc1[32] = {
+    1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 0,
+    1, 0, 1, 0, 0, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 0};
+
+
+/* Writes the 8 lowest bits of mask as 8 bytes equal to 0 or 1 */
+static inline void volk_gnsssdr_viterbi_k7r12_store_decisions(uint8_t* dst, unsigned int mask)
+{
+    uint64_t bytes = ((uint64_t)(mask & 0xFF) * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+    bytes = ((bytes + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+    /* byte k of the (little-endian) word is bit k of the mask */
+    unsigned int k;
+    for (k = 0; k < 8; k++)
+        {
+            dst[k] = (uint8_t)(bytes >> (8 * k));
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32f_viterbi_k7r12_8u_generic(uint8_t* decisions, float* metrics, const float* symbols, unsigned int num_points)
+{
+    float new_metrics[64];
+    unsigned int t;
+    unsigned int j;
+    for (t = 0; t < num_points; t++)
+        {
+            const float r0 = symbols[2 * t];
+            const float r1 = symbols[2 * t + 1];
+            uint8_t* dec = decisions + 64 * t;
+            float max_metric;
+            for (j = 0; j < 32; j++)
+                {
+                    const float ga = volk_gnsssdr_viterbi_k7r12_c1[j] * r1 + volk_gnsssdr_viterbi_k7r12_c0[j] * r0;
+                    const float gna = volk_gnsssdr_viterbi_k7r12_nc1[j] * r1 + volk_gnsssdr_viterbi_k7r12_nc0[j] * r0;
+                    const float e0 = metrics[2 * j] + ga;
+                    const float o0 = metrics[2 * j + 1] + gna;
+                    const float e1 = metrics[2 * j] + gna;
+                    const float o1 = metrics[2 * j + 1] + ga;
+                    dec[j] = (o0 > e0) ? 1 : 0;
+                    new_metrics[j] = (o0 > e0) ? o0 : e0;
+                    dec[j + 32] = (o1 > e1) ? 1 : 0;
+                    new_metrics[j + 32] = (o1 > e1) ? o1 : e1;
+                }
+            max_metric = new_metrics[0];
+            for (j = 1; j < 64; j++)
+                {
+                    if (new_metrics[j] > max_metric)
+                        {
+                            max_metric = new_metrics[j];
+                        }
+                }
+            for (j = 0; j < 64; j++)
+                {
+                    metrics[j] = new_metrics[j] - max_metric;
+                }
+        }
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+#include <emmintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r12_8u_u_sse2(uint8_t* decisions, float* metrics, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float new_metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float max_buffer[4];
+    unsigned int t;
+    unsigned int j;
+    for (t = 0; t < num_points; t++)
+        {
+            const __m128 r0 = _mm_set1_ps(symbols[2 * t]);
+            const __m128 r1 = _mm_set1_ps(symbols[2 * t + 1]);
+            uint8_t* dec = decisions + 64 * t;
+            __m128 max_values = _mm_set1_ps(-3.402823466e+38F);
+            float max_metric;
+            for (j = 0; j < 32; j += 8)
+                {
+                    unsigned int k;
+                    unsigned int mask0 = 0;
+                    unsigned int mask1 = 0;
+                    for (k = 0; k < 8; k += 4)
+                        {
+                            const __m128 a = _mm_loadu_ps(metrics + 2 * (j + k));
+                            const __m128 b = _mm_loadu_ps(metrics + 2 * (j + k) + 4);
+                            const __m128 even = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                            const __m128 odd = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                            const __m128 ga = _mm_add_ps(_mm_mul_ps(_mm_load_ps(volk_gnsssdr_viterbi_k7r12_c1 + j + k), r1), _mm_mul_ps(_mm_load_ps(volk_gnsssdr_viterbi_k7r12_c0 + j + k), r0));
+                            const __m128 gna = _mm_add_ps(_mm_mul_ps(_mm_load_ps(volk_gnsssdr_viterbi_k7r12_nc1 + j + k), r1), _mm_mul_ps(_mm_load_ps(volk_gnsssdr_viterbi_k7r12_nc0 + j + k), r0));
+                            const __m128 e0 = _mm_add_ps(even, ga);
+                            const __m128 o0 = _mm_add_ps(odd, gna);
+                            const __m128 e1 = _mm_add_ps(even, gna);
+                            const __m128 o1 = _mm_add_ps(odd, ga);
+                            const __m128 m0 = _mm_max_ps(o0, e0);
+                            const __m128 m1 = _mm_max_ps(o1, e1);
+                            mask0 |= (unsigned int)_mm_movemask_ps(_mm_cmpgt_ps(o0, e0)) << k;
+                            mask1 |= (unsigned int)_mm_movemask_ps(_mm_cmpgt_ps(o1, e1)) << k;
+                            _mm_store_ps(new_metrics + j + k, m0);
+                            _mm_store_ps(new_metrics + j + k + 32, m1);
+                            max_values = _mm_max_ps(max_values, _mm_max_ps(m0, m1));
+                        }
+                    volk_gnsssdr_viterbi_k7r12_store_decisions(dec + j, mask0);
+                    volk_gnsssdr_viterbi_k7r12_store_decisions(dec + j + 32, mask1);
+                }
+            _mm_store_ps(max_buffer, max_values);
+            max_metric = max_buffer[0];
+            for (j = 1; j < 4; j++)
+                {
+                    if (max_buffer[j] > max_metric)
+                        {
+                            max_metric = max_buffer[j];
+                        }
+                }
+            max_values = _mm_set1_ps(max_metric);
+            for (j = 0; j < 64; j += 4)
+                {
+                    _mm_storeu_ps(metrics + j, _mm_sub_ps(_mm_load_ps(new_metrics + j), max_values));
+                }
+        }
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r12_8u_u_avx2(uint8_t* decisions, float* metrics, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(32)
+    float new_metrics[64];
+    __VOLK_ATTR_ALIGNED(32)
+    float max_buffer[8];
+    unsigned int t;
+    unsigned int j;
+    for (t = 0; t < num_points; t++)
+        {
+            const __m256 r0 = _mm256_set1_ps(symbols[2 * t]);
+            const __m256 r1 = _mm256_set1_ps(symbols[2 * t + 1]);
+            uint8_t* dec = decisions + 64 * t;
+            __m256 max_values = _mm256_set1_ps(-3.402823466e+38F);
+            float max_metric;
+            for (j = 0; j < 32; j += 8)
+                {
+                    const __m256 a = _mm256_loadu_ps(metrics + 2 * j);
+                    const __m256 b = _mm256_loadu_ps(metrics + 2 * j + 8);
+                    /* deinterleave: shuffle within lanes, then reorder the 64-bit blocks */
+                    const __m256 even = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0)));
+                    const __m256 odd = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0)));
+                    const __m256 ga = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(volk_gnsssdr_viterbi_k7r12_c1 + j), r1), _mm256_mul_ps(_mm256_load_ps(volk_gnsssdr_viterbi_k7r12_c0 + j), r0));
+                    const __m256 gna = _mm256_add_ps(_mm256_mul_ps(_mm256_load_ps(volk_gnsssdr_viterbi_k7r12_nc1 + j), r1), _mm256_mul_ps(_mm256_load_ps(volk_gnsssdr_viterbi_k7r12_nc0 + j), r0));
+                    const __m256 e0 = _mm256_add_ps(even, ga);
+                    const __m256 o0 = _mm256_add_ps(odd, gna);
+                    const __m256 e1 = _mm256_add_ps(even, gna);
+                    const __m256 o1 = _mm256_add_ps(odd, ga);
+                    const __m256 m0 = _mm256_max_ps(o0, e0);
+                    const __m256 m1 = _mm256_max_ps(o1, e1);
+                    volk_gnsssdr_viterbi_k7r12_store_decisions(dec + j, (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(o0, e0, _CMP_GT_OQ)));
+                    volk_gnsssdr_viterbi_k7r12_store_decisions(dec + j + 32, (unsigned int)_mm256_movemask_ps(_mm256_cmp_ps(o1, e1, _CMP_GT_OQ)));
+                    _mm256_store_ps(new_metrics + j, m0);
+                    _mm256_store_ps(new_metrics + j + 32, m1);
+                    max_values = _mm256_max_ps(max_values, _mm256_max_ps(m0, m1));
+                }
+            _mm256_store_ps(max_buffer, max_values);
+            max_metric = max_buffer[0];
+            for (j = 1; j < 8; j++)
+                {
+                    if (max_buffer[j] > max_metric)
+                        {
+                            max_metric = max_buffer[j];
+                        }
+                }
+            max_values = _mm256_set1_ps(max_metric);
+            for (j = 0; j < 64; j += 8)
+                {
+                    _mm256_storeu_ps(metrics + j, _mm256_sub_ps(_mm256_load_ps(new_metrics + j), max_values));
+                }
+        }
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32f_viterbi_k7r12_8u_neon(uint8_t* decisions, float* metrics, const float* symbols, unsigned int num_points)
+{
+    __VOLK_ATTR_ALIGNED(16)
+    float new_metrics[64];
+    __VOLK_ATTR_ALIGNED(16)
+    float max_buffer[4];
+    const uint8x8_t ones = vdup_n_u8(1);
+    unsigned int t;
+    unsigned int j;
+    for (t = 0; t < num_points; t++)
+        {
+            const float32x4_t r0 = vdupq_n_f32(symbols[2 * t]);
+            const float32x4_t r1 = vdupq_n_f32(symbols[2 * t + 1]);
+            uint8_t* dec = decisions + 64 * t;
+            float32x4_t max_values = vdupq_n_f32(-3.402823466e+38F);
+            float max_metric;
+            for (j = 0; j < 32; j += 8)
+                {
+                    uint32x4_t d0[2];
+                    uint32x4_t d1[2];
+                    unsigned int k;
+                    for (k = 0; k < 2; k++)
+                        {
+                            const float32x4x2_t pm = vld2q_f32(metrics + 2 * (j + 4 * k));
+                            const float32x4_t ga = vaddq_f32(vmulq_f32(vld1q_f32(volk_gnsssdr_viterbi_k7r12_c1 + j + 4 * k), r1), vmulq_f32(vld1q_f32(volk_gnsssdr_viterbi_k7r12_c0 + j + 4 * k), r0));
+                            const float32x4_t gna = vaddq_f32(vmulq_f32(vld1q_f32(volk_gnsssdr_viterbi_k7r12_nc1 + j + 4 * k), r1), vmulq_f32(vld1q_f32(volk_gnsssdr_viterbi_k7r12_nc0 + j + 4 * k), r0));
+                            const float32x4_t e0 = vaddq_f32(pm.val[0], ga);
+                            const float32x4_t o0 = vaddq_f32(pm.val[1], gna);
+                            const float32x4_t e1 = vaddq_f32(pm.val[0], gna);
+                            const float32x4_t o1 = vaddq_f32(pm.val[1], ga);
+                            const float32x4_t m0 = vmaxq_f32(o0, e0);
+                            const float32x4_t m1 = vmaxq_f32(o1, e1);
+                            d0[k] = vcgtq_f32(o0, e0);
+                            d1[k] = vcgtq_f32(o1, e1);
+                            vst1q_f32(new_metrics + j + 4 * k, m0);
+                            vst1q_f32(new_metrics + j + 4 * k + 32, m1);
+                            max_values = vmaxq_f32(max_values, vmaxq_f32(m0, m1));
+                        }
+                    vst1_u8(dec + j, vand_u8(vmovn_u16(vcombine_u16(vmovn_u32(d0[0]), vmovn_u32(d0[1]))), ones));
+                    vst1_u8(dec + j + 32, vand_u8(vmovn_u16(vcombine_u16(vmovn_u32(d1[0]), vmovn_u32(d1[1]))), ones));
+                }
+            vst1q_f32(max_buffer, max_values);
+            max_metric = max_buffer[0];
+            for (j = 1; j < 4; j++)
+                {
+                    if (max_buffer[j] > max_metric)
+                        {
+                            max_metric = max_buffer[j];
+                        }
+                }
+            max_values = vdupq_n_f32(max_metric);
+            for (j = 0; j < 64; j += 4)
+                {
+                    vst1q_f32(metrics + j, vsubq_f32(vld1q_f32(new_metrics + j), max_values));
+                }
+        }
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbi_k7r12_8u_H */
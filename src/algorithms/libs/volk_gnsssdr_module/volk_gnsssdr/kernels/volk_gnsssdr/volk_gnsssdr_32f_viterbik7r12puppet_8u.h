@@ -0,0 +1,79 @@
+/*!
+ * \file volk_gnsssdr_32f_viterbik7r12puppet_8u.h
+ * \brief VOLK_GNSSSDR puppet for the K=7, rate 1/2 Viterbi kernel.
+ *
+ * VOLK_GNSSSDR puppet for integrating the K=7, rate 1/2 Viterbi kernel into
+ * the test system
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32f_viterbik7r12puppet_8u_H
+#define INCLUDED_volk_gnsssdr_32f_viterbik7r12puppet_8u_H
+
+#include "volk_gnsssdr/volk_gnsssdr_32f_viterbi_k7r12_8u.h"
+
+
+static inline void volk_gnsssdr_32f_viterbik7r12puppet_8u_init_metrics(float* metrics)
+{
+    unsigned int n;
+    metrics[0] = 0.0F;
+    for (n = 1; n < 64; n++)
+        {
+            metrics[n] = -1e7F;
+        }
+}
+
+
+#ifdef LV_HAVE_GENERIC
+static inline void volk_gnsssdr_32f_viterbik7r12puppet_8u_generic(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    volk_gnsssdr_32f_viterbik7r12puppet_8u_init_metrics(metrics);
+    volk_gnsssdr_32f_viterbi_k7r12_8u_generic(decisions, metrics, symbols, num_points / 64);
+}
+
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE2
+static inline void volk_gnsssdr_32f_viterbik7r12puppet_8u_u_sse2(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    volk_gnsssdr_32f_viterbik7r12puppet_8u_init_metrics(metrics);
+    volk_gnsssdr_32f_viterbi_k7r12_8u_u_sse2(decisions, metrics, symbols, num_points / 64);
+}
+
+#endif /* LV_HAVE_SSE2 */
+
+
+#ifdef LV_HAVE_AVX2
+static inline void volk_gnsssdr_32f_viterbik7r12puppet_8u_u_avx2(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    volk_gnsssdr_32f_viterbik7r12puppet_8u_init_metrics(metrics);
+    volk_gnsssdr_32f_viterbi_k7r12_8u_u_avx2(decisions, metrics, symbols, num_points / 64);
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+
+#ifdef LV_HAVE_NEON
+static inline void volk_gnsssdr_32f_viterbik7r12puppet_8u_neon(uint8_t* decisions, const float* symbols, unsigned int num_points)
+{
+    float metrics[64];
+    volk_gnsssdr_32f_viterbik7r12puppet_8u_init_metrics(metrics);
+    volk_gnsssdr_32f_viterbi_k7r12_8u_neon(decisions, metrics, symbols, num_points / 64);
+}
+
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32f_viterbik7r12puppet_8u_H */
@@ -0,0 +1,426 @@
+/*!
+ * \file volk_gnsssdr_32fc_moments_32f.h
+ * \brief VOLK_GNSSSDR kernel: accumulates the sums needed by the CN0 and
+ * carrier lock estimators in a single pass over a complex vector.
+ *
+ * VOLK_GNSSSDR kernel that computes, for a vector of complex samples z(i),
+ * the sums of Re(z), Im(z), |Re(z)|, |z|^2 and |z|^4.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+/*!
+ * \page volk_gnsssdr_32fc_moments_32f
+ *
+ * \b Overview
+ *
+ * Computes in a single pass the sums over the input vector of the real part,
+ * the imaginary part, the absolute value of the real part, the squared
+ * magnitude and the squared magnitude squared of the complex samples. These
+ * are the statistics used by the SNV and M2M4 CN0 estimators and by the
+ * carrier lock detector.
+ *
+ * <b>Dispatcher Prototype</b>
+ * \code
+ * void volk_gnsssdr_32fc_moments_32f(float* result, const lv_32fc_t* inputVector, unsigned int num_points);
+ * \endcode
+ *
+ * \b Inputs
+ * \li inputVector: The vector of complex samples.
+ * \li num_points:  The number of samples in \p inputVector.
+ *
+ * \b Outputs
+ * \li result: Array of five values: sum of Re(z), sum of Im(z), sum of
+ * |Re(z)|, sum of |z|^2 and sum of |z|^4.
+ *
+ */
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_moments_32f_u_H
+#define INCLUDED_volk_gnsssdr_32fc_moments_32f_u_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_GENERIC
+
+static inline void volk_gnsssdr_32fc_moments_32f_generic(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    float sum_re = 0.0F;
+    float sum_im = 0.0F;
+    float sum_abs_re = 0.0F;
+    float sum_mag2 = 0.0F;
+    float sum_mag4 = 0.0F;
+    float re, im, mag2;
+    unsigned int number;
+
+    for (number = 0; number < num_points; number++)
+        {
+            re = lv_creal(inputVector[number]);
+            im = lv_cimag(inputVector[number]);
+            mag2 = im * im + re * re;
+            sum_re += re;
+            sum_im += im;
+            sum_abs_re += fabsf(re);
+            sum_mag2 += mag2;
+            sum_mag4 += mag2 * mag2;
+        }
+    result[0] = sum_re;
+    result[1] = sum_im;
+    result[2] = sum_abs_re;
+    result[3] = sum_mag2;
+    result[4] = sum_mag4;
+}
+#endif /* LV_HAVE_GENERIC */
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_u_sse3(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float* inPtr = (const float*)inputVector;
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 sum_ri = _mm_setzero_ps();
+    __m128 sum_abs_re = _mm_setzero_ps();
+    __m128 sum_mag2 = _mm_setzero_ps();
+    __m128 sum_mag4 = _mm_setzero_ps();
+    __m128 a, b, re, mag2;
+    __VOLK_ATTR_ALIGNED(16)
+    float ri[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float abs_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float m2[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float m4[4];
+    unsigned int number;
+    float r, i, m;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_loadu_ps(inPtr);      // r0 i0 r1 i1
+            b = _mm_loadu_ps(inPtr + 4);  // r2 i2 r3 i3
+            sum_ri = _mm_add_ps(sum_ri, _mm_add_ps(a, b));
+            re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));  // r0 r1 r2 r3
+            sum_abs_re = _mm_add_ps(sum_abs_re, _mm_and_ps(re, abs_mask));
+            mag2 = _mm_hadd_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b));
+            sum_mag2 = _mm_add_ps(sum_mag2, mag2);
+            sum_mag4 = _mm_add_ps(sum_mag4, _mm_mul_ps(mag2, mag2));
+            inPtr += 8;
+        }
+
+    _mm_store_ps(ri, sum_ri);
+    _mm_store_ps(abs_re, sum_abs_re);
+    _mm_store_ps(m2, sum_mag2);
+    _mm_store_ps(m4, sum_mag4);
+    result[0] = ri[0] + ri[2];
+    result[1] = ri[1] + ri[3];
+    result[2] = abs_re[0] + abs_re[1] + abs_re[2] + abs_re[3];
+    result[3] = m2[0] + m2[1] + m2[2] + m2[3];
+    result[4] = m4[0] + m4[1] + m4[2] + m4[3];
+
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            r = *inPtr++;
+            i = *inPtr++;
+            m = i * i + r * r;
+            result[0] += r;
+            result[1] += i;
+            result[2] += fabsf(r);
+            result[3] += m;
+            result[4] += m * m;
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_u_avx(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* inPtr = (const float*)inputVector;
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 sum_ri = _mm256_setzero_ps();
+    __m256 sum_abs_re = _mm256_setzero_ps();
+    __m256 sum_mag2 = _mm256_setzero_ps();
+    __m256 sum_mag4 = _mm256_setzero_ps();
+    __m256 a, b, re, mag2;
+    __VOLK_ATTR_ALIGNED(32)
+    float ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float abs_re[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float m2[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float m4[8];
+    unsigned int number;
+    unsigned int k;
+    float r, i, m;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            a = _mm256_loadu_ps(inPtr);
+            b = _mm256_loadu_ps(inPtr + 8);
+            sum_ri = _mm256_add_ps(sum_ri, _mm256_add_ps(a, b));
+            // the order of the samples is not preserved, but it does not matter for the sums
+            re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            sum_abs_re = _mm256_add_ps(sum_abs_re, _mm256_and_ps(re, abs_mask));
+            mag2 = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+            sum_mag2 = _mm256_add_ps(sum_mag2, mag2);
+            sum_mag4 = _mm256_add_ps(sum_mag4, _mm256_mul_ps(mag2, mag2));
+            inPtr += 16;
+        }
+
+    _mm256_store_ps(ri, sum_ri);
+    _mm256_store_ps(abs_re, sum_abs_re);
+    _mm256_store_ps(m2, sum_mag2);
+    _mm256_store_ps(m4, sum_mag4);
+    for (k = 0; k < 5; k++)
+        {
+            result[k] = 0.0F;
+        }
+    for (k = 0; k < 8; k += 2)
+        {
+            result[0] += ri[k];
+            result[1] += ri[k + 1];
+        }
+    for (k = 0; k < 8; k++)
+        {
+            result[2] += abs_re[k];
+            result[3] += m2[k];
+            result[4] += m4[k];
+        }
+
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            r = *inPtr++;
+            i = *inPtr++;
+            m = i * i + r * r;
+            result[0] += r;
+            result[1] += i;
+            result[2] += fabsf(r);
+            result[3] += m;
+            result[4] += m * m;
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+
+#ifdef LV_HAVE_NEON
+#include <arm_neon.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_neon(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int neon_iters = num_points / 4;
+    const float* inPtr = (const float*)inputVector;
+    float32x4_t sum_re = vdupq_n_f32(0.0F);
+    float32x4_t sum_im = vdupq_n_f32(0.0F);
+    float32x4_t sum_abs_re = vdupq_n_f32(0.0F);
+    float32x4_t sum_mag2 = vdupq_n_f32(0.0F);
+    float32x4_t sum_mag4 = vdupq_n_f32(0.0F);
+    float32x4x2_t a;
+    float32x4_t mag2;
+    __VOLK_ATTR_ALIGNED(16)
+    float acc[5][4];
+    unsigned int number;
+    unsigned int k;
+    float r, i, m;
+
+    for (number = 0; number < neon_iters; number++)
+        {
+            a = vld2q_f32(inPtr);  // a.val[0] = real parts, a.val[1] = imaginary parts
+            __VOLK_GNSSSDR_PREFETCH(inPtr + 16);
+            sum_re = vaddq_f32(sum_re, a.val[0]);
+            sum_im = vaddq_f32(sum_im, a.val[1]);
+            sum_abs_re = vaddq_f32(sum_abs_re, vabsq_f32(a.val[0]));
+            mag2 = vmulq_f32(a.val[1], a.val[1]);
+            mag2 = vmlaq_f32(mag2, a.val[0], a.val[0]);
+            sum_mag2 = vaddq_f32(sum_mag2, mag2);
+            sum_mag4 = vmlaq_f32(sum_mag4, mag2, mag2);
+            inPtr += 8;
+        }
+
+    vst1q_f32(acc[0], sum_re);
+    vst1q_f32(acc[1], sum_im);
+    vst1q_f32(acc[2], sum_abs_re);
+    vst1q_f32(acc[3], sum_mag2);
+    vst1q_f32(acc[4], sum_mag4);
+    for (k = 0; k < 5; k++)
+        {
+            result[k] = acc[k][0] + acc[k][1] + acc[k][2] + acc[k][3];
+        }
+
+    for (number = neon_iters * 4; number < num_points; number++)
+        {
+            r = *inPtr++;
+            i = *inPtr++;
+            m = i * i + r * r;
+            result[0] += r;
+            result[1] += i;
+            result[2] += fabsf(r);
+            result[3] += m;
+            result[4] += m * m;
+        }
+}
+#endif /* LV_HAVE_NEON */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_moments_32f_u_H */
+
+
+#ifndef INCLUDED_volk_gnsssdr_32fc_moments_32f_a_H
+#define INCLUDED_volk_gnsssdr_32fc_moments_32f_a_H
+
+#include <volk_gnsssdr/volk_gnsssdr_common.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <math.h>
+
+
+#ifdef LV_HAVE_SSE3
+#include <pmmintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_a_sse3(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int sse_iters = num_points / 4;
+    const float* inPtr = (const float*)inputVector;
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    __m128 sum_ri = _mm_setzero_ps();
+    __m128 sum_abs_re = _mm_setzero_ps();
+    __m128 sum_mag2 = _mm_setzero_ps();
+    __m128 sum_mag4 = _mm_setzero_ps();
+    __m128 a, b, re, mag2;
+    __VOLK_ATTR_ALIGNED(16)
+    float ri[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float abs_re[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float m2[4];
+    __VOLK_ATTR_ALIGNED(16)
+    float m4[4];
+    unsigned int number;
+    float r, i, m;
+
+    for (number = 0; number < sse_iters; number++)
+        {
+            a = _mm_load_ps(inPtr);      // r0 i0 r1 i1
+            b = _mm_load_ps(inPtr + 4);  // r2 i2 r3 i3
+            sum_ri = _mm_add_ps(sum_ri, _mm_add_ps(a, b));
+            re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));  // r0 r1 r2 r3
+            sum_abs_re = _mm_add_ps(sum_abs_re, _mm_and_ps(re, abs_mask));
+            mag2 = _mm_hadd_ps(_mm_mul_ps(a, a), _mm_mul_ps(b, b));
+            sum_mag2 = _mm_add_ps(sum_mag2, mag2);
+            sum_mag4 = _mm_add_ps(sum_mag4, _mm_mul_ps(mag2, mag2));
+            inPtr += 8;
+        }
+
+    _mm_store_ps(ri, sum_ri);
+    _mm_store_ps(abs_re, sum_abs_re);
+    _mm_store_ps(m2, sum_mag2);
+    _mm_store_ps(m4, sum_mag4);
+    result[0] = ri[0] + ri[2];
+    result[1] = ri[1] + ri[3];
+    result[2] = abs_re[0] + abs_re[1] + abs_re[2] + abs_re[3];
+    result[3] = m2[0] + m2[1] + m2[2] + m2[3];
+    result[4] = m4[0] + m4[1] + m4[2] + m4[3];
+
+    for (number = sse_iters * 4; number < num_points; number++)
+        {
+            r = *inPtr++;
+            i = *inPtr++;
+            m = i * i + r * r;
+            result[0] += r;
+            result[1] += i;
+            result[2] += fabsf(r);
+            result[3] += m;
+            result[4] += m * m;
+        }
+}
+#endif /* LV_HAVE_SSE3 */
+
+
+#ifdef LV_HAVE_AVX
+#include <immintrin.h>
+
+static inline void volk_gnsssdr_32fc_moments_32f_a_avx(float* result, const lv_32fc_t* inputVector, unsigned int num_points)
+{
+    const unsigned int avx_iters = num_points / 8;
+    const float* inPtr = (const float*)inputVector;
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 sum_ri = _mm256_setzero_ps();
+    __m256 sum_abs_re = _mm256_setzero_ps();
+    __m256 sum_mag2 = _mm256_setzero_ps();
+    __m256 sum_mag4 = _mm256_setzero_ps();
+    __m256 a, b, re, mag2;
+    __VOLK_ATTR_ALIGNED(32)
+    float ri[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float abs_re[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float m2[8];
+    __VOLK_ATTR_ALIGNED(32)
+    float m4[8];
+    unsigned int number;
+    unsigned int k;
+    float r, i, m;
+
+    for (number = 0; number < avx_iters; number++)
+        {
+            a = _mm256_load_ps(inPtr);
+            b = _mm256_load_ps(inPtr + 8);
+            sum_ri = _mm256_add_ps(sum_ri, _mm256_add_ps(a, b));
+            // the order of the samples is not preserved, but it does not matter for the sums
+            re = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            sum_abs_re = _mm256_add_ps(sum_abs_re, _mm256_and_ps(re, abs_mask));
+            mag2 = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+            sum_mag2 = _mm256_add_ps(sum_mag2, mag2);
+            sum_mag4 = _mm256_add_ps(sum_mag4, _mm256_mul_ps(mag2, mag2));
+            inPtr += 16;
+        }
+
+    _mm256_store_ps(ri, sum_ri);
+    _mm256_store_ps(abs_re, sum_abs_re);
+    _mm256_store_ps(m2, sum_mag2);
+    _mm256_store_ps(m4, sum_mag4);
+    for (k = 0; k < 5; k++)
+        {
+            result[k] = 0.0F;
+        }
+    for (k = 0; k < 8; k += 2)
+        {
+            result[0] += ri[k];
+            result[1] += ri[k + 1];
+        }
+    for (k = 0; k < 8; k++)
+        {
+            result[2] += abs_re[k];
+            result[3] += m2[k];
+            result[4] += m4[k];
+        }
+
+    for (number = avx_iters * 8; number < num_points; number++)
+        {
+            r = *inPtr++;
+            i = *inPtr++;
+            m = i * i + r * r;
+            result[0] += r;
+            result[1] += i;
+            result[2] += fabsf(r);
+            result[3] += m;
+            result[4] += m * m;
+        }
+}
+#endif /* LV_HAVE_AVX */
+
+#endif /* INCLUDED_volk_gnsssdr_32fc_moments_32f_a_H */
@@ -68,11 +68,13 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_TEST(volk_gnsssdr_32f_index_max_32u, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_8ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_convert_16ic, test_params_more_iters))
+    QA(VOLK_INIT_TEST(volk_gnsssdr_32fc_moments_32f, test_params_inacc))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_dot_prod_16ic, test_params))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_x2_multiply_16ic, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_convert_32fc, test_params_more_iters))
     QA(VOLK_INIT_TEST(volk_gnsssdr_16ic_conjugate_16ic, test_params_more_iters))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_s32f_sincospuppet_32fc, volk_gnsssdr_s32f_sincos_32fc, test_params_inacc2))
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32f_viterbik7r12puppet_8u, volk_gnsssdr_32f_viterbi_k7r12_8u, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_rotatorpuppet_16ic, volk_gnsssdr_16ic_s32fc_x2_rotator_16ic, test_params_int1))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastpuppet_16ic, volk_gnsssdr_16ic_resampler_fast_16ic, test_params))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_resamplerfastxnpuppet_16ic, volk_gnsssdr_16ic_xn_resampler_fast_16ic_xn, test_params))
@@ -87,6 +89,9 @@ std::vector<volk_gnsssdr_test_case_t> init_test_list(volk_gnsssdr_test_params_t
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_x2_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_x2_rotator_dot_prod_32fc_xn, test_params_inacc))
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn, test_params_inacc));
     QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_high_dynamic_rotator_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_32fc_32f_rotator_resampler_dotprodxnpuppet_32fc, volk_gnsssdr_32fc_32f_rotator_resampler_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_16ic_32f_rotator_resampler_dotprodxnpuppet_32fc, volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn, test_params_inacc));
+    QA(VOLK_INIT_PUPP(volk_gnsssdr_8ic_32f_rotator_resampler_dotprodxnpuppet_32fc, volk_gnsssdr_8ic_32f_rotator_resampler_dot_prod_32fc_xn, test_params_inacc));
 
     return test_cases;
 }
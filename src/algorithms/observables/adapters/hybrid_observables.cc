@@ -40,6 +40,13 @@ HybridObservables::HybridObservables(const ConfigurationInterface* configuration
     conf.nchannels_out = out_streams_;
     conf.observable_interval_ms = configuration->property("GNSS-SDR.observable_interval_ms", conf.observable_interval_ms);
     conf.enable_carrier_smoothing = configuration->property(role + ".enable_carrier_smoothing", conf.enable_carrier_smoothing);
+    conf.history_depth = configuration->property(role + ".history_depth", conf.history_depth);
+    if (conf.history_depth < 2)
+        {
+            LOG(WARNING) << "Parameter history_depth should be at least 2. Setting it to 2";
+            conf.history_depth = 2;
+        }
+    conf.interpolation_order = configuration->property(role + ".interpolation_order", conf.interpolation_order);
     conf.always_output_gs = configuration->property("PVT.an_output_enabled", conf.always_output_gs) || configuration->property(role + ".always_output_gs", conf.always_output_gs);
 
     if (FLAGS_carrier_smoothing_factor == DEFAULT_CARRIER_SMOOTHING_FACTOR)
@@ -17,12 +17,12 @@
 
 #include "hybrid_observables_gs.h"
 #include "MATH_CONSTANTS.h"  // for SPEED_OF_LIGHT_M_S, TWO_PI
-#include "gnss_circular_deque.h"
 #include "gnss_frequencies.h"
 #include "gnss_sdr_create_directory.h"
 #include "gnss_sdr_filesystem.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_synchro.h"
+#include "observables_history.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <matio.h>
@@ -91,7 +91,7 @@ hybrid_observables_gs::hybrid_observables_gs(const Obs_Conf &conf_)
     // Send Channel status to gnss_flowgraph
     this->message_port_register_out(pmt::mp("status"));
 
-    d_gnss_synchro_history = std::make_unique<Gnss_circular_deque<Gnss_Synchro>>(1000, d_nchannels_out);
+    d_gnss_synchro_history = std::make_unique<Observables_History>(d_conf.history_depth, d_nchannels_out, d_conf.interpolation_order);
 
     d_Rx_clock_buffer.set_capacity(std::min(std::max(200U / d_T_rx_step_ms, 3U), 10U));
     d_Rx_clock_buffer.clear();
@@ -406,95 +406,7 @@ double hybrid_observables_gs::compute_T_rx_s(const Gnss_Synchro &a) const
 
 bool hybrid_observables_gs::interp_trk_obs(Gnss_Synchro &interpolated_obs, uint32_t ch, uint64_t rx_clock) const
 {
-    int32_t nearest_element = -1;
-    int64_t old_abs_diff = std::numeric_limits<int64_t>::max();
-    for (uint32_t i = 0; i < d_gnss_synchro_history->size(ch); i++)
-        {
-            const int64_t abs_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(d_gnss_synchro_history->get(ch, i).Tracking_sample_counter));
-            if (old_abs_diff > abs_diff)
-                {
-                    old_abs_diff = abs_diff;
-                    nearest_element = static_cast<int32_t>(i);
-                }
-        }
-
-    if (nearest_element != -1 and nearest_element != static_cast<int32_t>(d_gnss_synchro_history->size(ch)))
-        {
-            if ((static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs)) < d_T_rx_step_s)
-                {
-                    int32_t neighbor_element;
-                    if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                        {
-                            neighbor_element = nearest_element + 1;
-                        }
-                    else
-                        {
-                            neighbor_element = nearest_element - 1;
-                        }
-                    if (neighbor_element < static_cast<int32_t>(d_gnss_synchro_history->size(ch)) and neighbor_element >= 0)
-                        {
-                            int32_t t1_idx;
-                            int32_t t2_idx;
-                            if (rx_clock > d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter)
-                                {
-                                    // std::cout << "S1= " << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter << '\n';
-                                    t1_idx = nearest_element;
-                                    t2_idx = neighbor_element;
-                                }
-                            else
-                                {
-                                    // std::cout << "inv S1= " << d_gnss_synchro_history->get(ch, neighbor_element).Tracking_sample_counter
-                                    //           << " Si=" << rx_clock << " S2=" << d_gnss_synchro_history->get(ch, nearest_element).Tracking_sample_counter << '\n';
-                                    t1_idx = neighbor_element;
-                                    t2_idx = nearest_element;
-                                }
-
-                            // 1st: copy the nearest gnss_synchro data for that channel
-                            interpolated_obs = d_gnss_synchro_history->get(ch, nearest_element);
-
-                            // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
-                            const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
-
-                            const double time_factor = (T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time) /
-                                                       (d_gnss_synchro_history->get(ch, t2_idx).RX_time -
-                                                           d_gnss_synchro_history->get(ch, t1_idx).RX_time);
-
-                            // CARRIER PHASE INTERPOLATION
-                            interpolated_obs.Carrier_phase_rads = d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_phase_rads - d_gnss_synchro_history->get(ch, t1_idx).Carrier_phase_rads) * time_factor;
-                            // CARRIER DOPPLER INTERPOLATION
-                            interpolated_obs.Carrier_Doppler_hz = d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz + (d_gnss_synchro_history->get(ch, t2_idx).Carrier_Doppler_hz - d_gnss_synchro_history->get(ch, t1_idx).Carrier_Doppler_hz) * time_factor;
-                            // TOW INTERPOLATION
-                            // check TOW rollover
-                            if ((d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms - d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) > 0)
-                                {
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                                }
-                            else
-                                {
-                                    // TOW rollover situation
-                                    interpolated_obs.interp_TOW_ms = static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms) + (static_cast<double>(d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms + 604800000) - static_cast<double>(d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms)) * time_factor;
-                                }
-
-                            // LOG(INFO) << "Channel " << ch << " int idx: " << t1_idx << " TOW Int: " << interpolated_obs.interp_TOW_ms
-                            //           << " TOW p1 : " << d_gnss_synchro_history->get(ch, t1_idx).TOW_at_current_symbol_ms
-                            //           << " TOW p2: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).TOW_at_current_symbol_ms
-                            //           << " t2-t1: "
-                            //           << d_gnss_synchro_history->get(ch, t2_idx).RX_time - d_gnss_synchro_history->get(ch, t1_idx).RX_time
-                            //           << " trx - t1: "
-                            //           << T_rx_s - d_gnss_synchro_history->get(ch, t1_idx).RX_time;
-                            // std::cout << "Rx samplestamp: " << T_rx_s << " Channel " << ch << " interp buff idx " << nearest_element
-                            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-                            return true;
-                        }
-                    return false;
-                }
-            // std::cout << "ALERT: Channel " << ch << " interp buff idx " << nearest_element
-            //           << " ,diff: " << old_abs_diff << " samples (" << static_cast<double>(old_abs_diff) / static_cast<double>(d_gnss_synchro_history->get(ch, nearest_element).fs) << " s)\n";
-            // usleep(1000);
-        }
-    return false;
+    return d_gnss_synchro_history->interpolate(ch, rx_clock, d_T_rx_step_s, interpolated_obs);
 }
 
 
@@ -774,17 +686,8 @@ int hybrid_observables_gs::general_work(int noutput_items __attribute__((unused)
                     // Push the valid tracking Gnss_Synchros to their corresponding deque
                     if (in[n][m].Flag_valid_word)
                         {
-                            if (d_gnss_synchro_history->size(n) > 0)
-                                {
-                                    // Check if the last Gnss_Synchro comes from the same satellite as the previous ones
-                                    if (d_gnss_synchro_history->front(n).PRN != in[n][m].PRN)
-                                        {
-                                            d_gnss_synchro_history->clear(n);
-                                            // LOG(INFO) << "Channel " << d_gnss_synchro_history->front(n).Channel_ID << " changed satellite to PRN " << in[n][m].PRN;
-                                        }
-                                }
-                            d_gnss_synchro_history->push_back(n, in[n][m]);
-                            d_gnss_synchro_history->back(n).RX_time = compute_T_rx_s(in[n][m]);
+                            // the history restarts if the channel changed satellite
+                            d_gnss_synchro_history->push_back(n, in[n][m], compute_T_rx_s(in[n][m]));
                         }
                 }
             consume(n, ninput_items[n]);
@@ -44,11 +44,9 @@
 
 
 class Gnss_Synchro;
+class Observables_History;
 class hybrid_observables_gs;
 
-template <class T>
-class Gnss_circular_deque;
-
 using hybrid_observables_gs_sptr = gnss_shared_ptr<hybrid_observables_gs>;
 
 hybrid_observables_gs_sptr hybrid_observables_gs_make(const Obs_Conf& conf_);
@@ -102,7 +100,7 @@ private:
     };
     std::map<std::string, StringValue_> d_mapStringValues;
 
-    std::unique_ptr<Gnss_circular_deque<Gnss_Synchro>> d_gnss_synchro_history;  // Tracking observable history
+    std::unique_ptr<Observables_History> d_gnss_synchro_history;  // Tracking observable history
 
     boost::circular_buffer<uint64_t> d_Rx_clock_buffer;  // time history
 
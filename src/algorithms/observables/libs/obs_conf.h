@@ -37,6 +37,8 @@ public:
     uint32_t nchannels_in{0U};
     uint32_t nchannels_out{0U};
     uint32_t observable_interval_ms{20U};
+    uint32_t history_depth{1000U};
+    uint32_t interpolation_order{1U};
     bool enable_carrier_smoothing{false};
     bool always_output_gs{false};
     bool dump{false};
@@ -0,0 +1,183 @@
+/*!
+ * \file observables_history.cc
+ * \brief Per-channel history of the tracking observables, with a
+ * struct-of-arrays layout and binary-search interpolation at the receiver
+ * epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "observables_history.h"
+#include <algorithm>  // for lower_bound, min
+#include <cstdlib>    // for llabs
+
+namespace
+{
+constexpr double WEEK_MS = 604800000.0;
+
+// TOW of an observable, unwrapped around the TOW of the reference observable
+double unwrapped_tow_ms(uint32_t tow_ms, uint32_t reference_tow_ms)
+{
+    double tow = static_cast<double>(tow_ms);
+    const double diff = tow - static_cast<double>(reference_tow_ms);
+    if (diff < -WEEK_MS / 2.0)
+        {
+            tow += WEEK_MS;
+        }
+    else if (diff > WEEK_MS / 2.0)
+        {
+            tow -= WEEK_MS;
+        }
+    return tow;
+}
+}  // namespace
+
+
+Observables_History::Channel_History::Channel_History(size_t depth)
+    : sample_counter(depth),
+      rx_time_s(depth),
+      tow_ms(depth),
+      carrier_phase_rads(depth),
+      carrier_doppler_hz(depth),
+      gnss_synchro(depth)
+{
+}
+
+
+void Observables_History::Channel_History::clear()
+{
+    sample_counter.clear();
+    rx_time_s.clear();
+    tow_ms.clear();
+    carrier_phase_rads.clear();
+    carrier_doppler_hz.clear();
+    gnss_synchro.clear();
+}
+
+
+Observables_History::Observables_History(size_t depth, uint32_t nchannels, uint32_t interpolation_order)
+    : d_channels(nchannels, Channel_History(depth)),
+      d_interpolation_order(std::max(interpolation_order, 1U))
+{
+}
+
+
+void Observables_History::push_back(uint32_t ch, const Gnss_Synchro& gnss_synchro, double rx_time_s)
+{
+    Channel_History& history = d_channels[ch];
+    if (!history.gnss_synchro.empty() &&
+        (history.gnss_synchro.back().PRN != gnss_synchro.PRN || history.sample_counter.back() > gnss_synchro.Tracking_sample_counter))
+        {
+            history.clear();
+        }
+    history.sample_counter.push_back(gnss_synchro.Tracking_sample_counter);
+    history.rx_time_s.push_back(rx_time_s);
+    history.tow_ms.push_back(gnss_synchro.TOW_at_current_symbol_ms);
+    history.carrier_phase_rads.push_back(gnss_synchro.Carrier_phase_rads);
+    history.carrier_doppler_hz.push_back(gnss_synchro.Carrier_Doppler_hz);
+    history.gnss_synchro.push_back(gnss_synchro);
+    history.gnss_synchro.back().RX_time = rx_time_s;
+}
+
+
+bool Observables_History::interpolate(uint32_t ch, uint64_t rx_clock, double max_distance_s, Gnss_Synchro& interpolated_obs) const
+{
+    const Channel_History& history = d_channels[ch];
+    // first observable at or after rx_clock; the epoch is bracketed by it and
+    // the previous one
+    const auto it = std::lower_bound(history.sample_counter.begin(), history.sample_counter.end(), rx_clock);
+    if (it != history.sample_counter.end() && *it == rx_clock)
+        {
+            // exact hit, including the first stored observable: no interpolation
+            const auto idx = static_cast<size_t>(it - history.sample_counter.begin());
+            interpolated_obs = history.gnss_synchro[idx];
+            interpolated_obs.Carrier_phase_rads = history.carrier_phase_rads[idx];
+            interpolated_obs.Carrier_Doppler_hz = history.carrier_doppler_hz[idx];
+            interpolated_obs.interp_TOW_ms = static_cast<double>(history.tow_ms[idx]);
+            return true;
+        }
+    if (it == history.sample_counter.begin() || it == history.sample_counter.end())
+        {
+            return false;
+        }
+    const auto t2_idx = static_cast<size_t>(it - history.sample_counter.begin());
+    const size_t t1_idx = t2_idx - 1;
+    const int64_t t1_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(history.sample_counter[t1_idx]));
+    const int64_t t2_diff = llabs(static_cast<int64_t>(rx_clock) - static_cast<int64_t>(history.sample_counter[t2_idx]));
+    const size_t nearest_idx = (t2_diff < t1_diff) ? t2_idx : t1_idx;
+    const int64_t nearest_diff = std::min(t1_diff, t2_diff);
+    if ((static_cast<double>(nearest_diff) / static_cast<double>(history.gnss_synchro[nearest_idx].fs)) >= max_distance_s)
+        {
+            return false;
+        }
+
+    // 1st: copy the nearest gnss_synchro data for that channel
+    interpolated_obs = history.gnss_synchro[nearest_idx];
+    const double T_rx_s = static_cast<double>(rx_clock) / static_cast<double>(interpolated_obs.fs);
+
+    if (d_interpolation_order > 1 && history.sample_counter.size() > 2)
+        {
+            lagrange_interpolation(history, t1_idx, T_rx_s, interpolated_obs);
+            return true;
+        }
+
+    // 2nd: Linear interpolation: y(t) = y(t1) + (y(t2) - y(t1)) * (t - t1) / (t2 - t1)
+    const double time_factor = (T_rx_s - history.rx_time_s[t1_idx]) / (history.rx_time_s[t2_idx] - history.rx_time_s[t1_idx]);
+    interpolated_obs.Carrier_phase_rads = history.carrier_phase_rads[t1_idx] + (history.carrier_phase_rads[t2_idx] - history.carrier_phase_rads[t1_idx]) * time_factor;
+    interpolated_obs.Carrier_Doppler_hz = history.carrier_doppler_hz[t1_idx] + (history.carrier_doppler_hz[t2_idx] - history.carrier_doppler_hz[t1_idx]) * time_factor;
+    const double tow1_ms = static_cast<double>(history.tow_ms[t1_idx]);
+    interpolated_obs.interp_TOW_ms = tow1_ms + (unwrapped_tow_ms(history.tow_ms[t2_idx], history.tow_ms[t1_idx]) - tow1_ms) * time_factor;
+    return true;
+}
+
+
+void Observables_History::lagrange_interpolation(const Channel_History& history, size_t t1_idx, double T_rx_s, Gnss_Synchro& interpolated_obs) const
+{
+    // order + 1 observables centered on the bracketing ones, shifted to fit
+    // in the history
+    const size_t points = std::min(static_cast<size_t>(d_interpolation_order) + 1, history.sample_counter.size());
+    const size_t half = (points - 1) / 2;
+    size_t first = (t1_idx > half) ? t1_idx - half : 0;
+    first = std::min(first, history.sample_counter.size() - points);
+
+    double carrier_phase_rads = 0.0;
+    double carrier_doppler_hz = 0.0;
+    double tow_ms = 0.0;
+    for (size_t i = first; i < first + points; i++)
+        {
+            double weight = 1.0;
+            for (size_t j = first; j < first + points; j++)
+                {
+                    if (j != i)
+                        {
+                            weight *= (T_rx_s - history.rx_time_s[j]) / (history.rx_time_s[i] - history.rx_time_s[j]);
+                        }
+                }
+            carrier_phase_rads += weight * history.carrier_phase_rads[i];
+            carrier_doppler_hz += weight * history.carrier_doppler_hz[i];
+            tow_ms += weight * unwrapped_tow_ms(history.tow_ms[i], history.tow_ms[t1_idx]);
+        }
+    interpolated_obs.Carrier_phase_rads = carrier_phase_rads;
+    interpolated_obs.Carrier_Doppler_hz = carrier_doppler_hz;
+    interpolated_obs.interp_TOW_ms = tow_ms;
+}
+
+
+size_t Observables_History::size(uint32_t ch) const
+{
+    return d_channels[ch].sample_counter.size();
+}
+
+
+void Observables_History::clear(uint32_t ch)
+{
+    d_channels[ch].clear();
+}
@@ -0,0 +1,95 @@
+/*!
+ * \file observables_history.h
+ * \brief Per-channel history of the tracking observables, with a
+ * struct-of-arrays layout and binary-search interpolation at the receiver
+ * epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_OBSERVABLES_HISTORY_H
+#define GNSS_SDR_OBSERVABLES_HISTORY_H
+
+#include "gnss_synchro.h"
+#include <boost/circular_buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Observables
+ * \{ */
+/** \addtogroup Observables_libs
+ * \{ */
+
+
+/*!
+ * \brief Stores the last Gnss_Synchro objects with a valid word received
+ * from each channel, and interpolates their carrier phase, Doppler and TOW at
+ * the receiver epochs.
+ *
+ * The sample counters, RX times, TOWs, carrier phases and Doppler shifts are
+ * kept in separate arrays, so the epoch bracketing is a binary search over
+ * the sample counters and the interpolation reads only the values it uses.
+ * The whole Gnss_Synchro is copied once per interpolated observable.
+ */
+class Observables_History
+{
+public:
+    /*!
+     * \brief Constructor. depth is the capacity of each channel and
+     * interpolation_order the order of the Lagrange polynomial (1 is linear)
+     */
+    Observables_History(size_t depth, uint32_t nchannels, uint32_t interpolation_order = 1U);
+
+    /*!
+     * \brief Appends the observable of a channel, tagged with its RX time.
+     * The history of the channel restarts if the satellite changes or the
+     * sample counter goes backwards.
+     */
+    void push_back(uint32_t ch, const Gnss_Synchro& gnss_synchro, double rx_time_s);
+
+    /*!
+     * \brief Interpolates the observables of channel ch at the sample counter
+     * rx_clock. The other fields are taken from the nearest observable, which
+     * must be less than max_distance_s away. If rx_clock is the sample counter
+     * of a stored observable, that observable is returned as is. Returns false
+     * if rx_clock is not bracketed by the history of the channel.
+     */
+    bool interpolate(uint32_t ch, uint64_t rx_clock, double max_distance_s, Gnss_Synchro& interpolated_obs) const;
+
+    size_t size(uint32_t ch) const;  //!< Number of observables stored for channel ch
+    void clear(uint32_t ch);         //!< Removes the observables of channel ch
+
+private:
+    class Channel_History
+    {
+    public:
+        explicit Channel_History(size_t depth);
+        void clear();
+
+        boost::circular_buffer<uint64_t> sample_counter;
+        boost::circular_buffer<double> rx_time_s;
+        boost::circular_buffer<uint32_t> tow_ms;
+        boost::circular_buffer<double> carrier_phase_rads;
+        boost::circular_buffer<double> carrier_doppler_hz;
+        boost::circular_buffer<Gnss_Synchro> gnss_synchro;  // remaining fields
+    };
+
+    void lagrange_interpolation(const Channel_History& history, size_t t1_idx, double T_rx_s, Gnss_Synchro& interpolated_obs) const;
+
+    std::vector<Channel_History> d_channels;
+    uint32_t d_interpolation_order;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_OBSERVABLES_HISTORY_H
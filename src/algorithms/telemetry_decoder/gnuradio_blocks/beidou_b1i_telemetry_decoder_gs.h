@@ -95,6 +95,7 @@ private:
 
     // Satellite Information and logging capacity
     Gnss_Satellite d_satellite;
+    std::string d_subframe_bits;
     std::string d_dump_filename;
     std::ofstream d_dump_file;
 
@@ -126,6 +127,7 @@ private:
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
     bool d_dump_crc_stats;
+    bool d_first_subframe_decoded;
 };
 
 
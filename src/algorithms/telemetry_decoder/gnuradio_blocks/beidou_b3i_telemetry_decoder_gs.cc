@@ -24,6 +24,7 @@
 #include "display.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
 #include "gnss_synchro.h"
+#include "tlm_allocation_counter.h"  // for Tlm_Allocation_Scope
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -73,7 +74,8 @@ beidou_b3i_telemetry_decoder_gs::beidou_b3i_telemetry_decoder_gs(
       d_dump_mat(conf.dump_mat),
       d_remove_dat(conf.remove_dat),
       d_enable_navdata_monitor(conf.enable_navdata_monitor),
-      d_dump_crc_stats(conf.dump_crc_stats)
+      d_dump_crc_stats(conf.dump_crc_stats),
+      d_first_subframe_decoded(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -107,6 +109,11 @@ beidou_b3i_telemetry_decoder_gs::beidou_b3i_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(d_required_symbols);
+    d_subframe_bits.reserve(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
+    if (d_enable_navdata_monitor)
+        {
+            d_nav_msg_packet.nav_message.reserve(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
+        }
 
     if (d_dump_crc_stats)
         {
@@ -241,37 +248,41 @@ void beidou_b3i_telemetry_decoder_gs::decode_word(
 
 void beidou_b3i_telemetry_decoder_gs::decode_subframe(float *frame_symbols)
 {
-    // 1. Transform from symbols to bits
-    std::string data_bits;
-    data_bits.reserve(BEIDOU_DNAV_WORDS_SUBFRAME * BEIDOU_DNAV_WORD_LENGTH_BITS);
-    std::array<int32_t, 30> dec_word_bits{};
-
-    // Decode each word in subframe
-    for (uint32_t ii = 0; ii < BEIDOU_DNAV_WORDS_SUBFRAME; ii++)
-        {
-            // decode the word
-            decode_word((ii + 1), &frame_symbols[ii * 30], dec_word_bits.data());
-
-            // Save word to string format
-            for (uint32_t jj = 0; jj < (BEIDOU_DNAV_WORD_LENGTH_BITS); jj++)
-                {
-                    data_bits.push_back((dec_word_bits[jj] > 0) ? ('1') : ('0'));
-                }
-        }
-
-    if (d_enable_navdata_monitor)
-        {
-            d_nav_msg_packet.nav_message = data_bits;
-        }
-
-    if (d_satellite.get_PRN() > 0 && d_satellite.get_PRN() < 6)
-        {
-            d_nav.d2_subframe_decoder(data_bits);
-        }
-    else
-        {
-            d_nav.d1_subframe_decoder(data_bits);
-        }
+    // 1. Transform from symbols to bits (the string capacity is reused)
+    {
+        const Tlm_Allocation_Scope subframe_scope(d_first_subframe_decoded);
+        std::array<int32_t, 30> dec_word_bits{};
+        d_subframe_bits.clear();
+
+        // Decode each word in subframe
+        for (uint32_t ii = 0; ii < BEIDOU_DNAV_WORDS_SUBFRAME; ii++)
+            {
+                // decode the word
+                decode_word((ii + 1), &frame_symbols[ii * 30], dec_word_bits.data());
+
+                // Save word to string format
+                for (uint32_t jj = 0; jj < (BEIDOU_DNAV_WORD_LENGTH_BITS); jj++)
+                    {
+                        d_subframe_bits.push_back((dec_word_bits[jj] > 0) ? ('1') : ('0'));
+                    }
+            }
+
+        if (d_enable_navdata_monitor)
+            {
+                d_nav_msg_packet.nav_message = d_subframe_bits;
+            }
+
+        // 2. Call the BeiDou subframe decoder
+        if (d_satellite.get_PRN() > 0 && d_satellite.get_PRN() < 6)
+            {
+                d_nav.d2_subframe_decoder(d_subframe_bits);
+            }
+        else
+            {
+                d_nav.d1_subframe_decoder(d_subframe_bits);
+            }
+        d_first_subframe_decoded = true;
+    }
 
     // 3. Check operation executed correctly
     bool crc_ok = d_nav.get_flag_CRC_test();
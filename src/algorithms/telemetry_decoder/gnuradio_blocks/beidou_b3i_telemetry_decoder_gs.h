@@ -92,6 +92,7 @@ private:
     Nav_Message_Packet d_nav_msg_packet;
     std::unique_ptr<Tlm_CRC_Stats> d_Tlm_CRC_Stats;
 
+    std::string d_subframe_bits;
     std::string d_dump_filename;
     std::ofstream d_dump_file;
 
@@ -122,6 +123,7 @@ private:
     bool d_remove_dat;
     bool d_enable_navdata_monitor;
     bool d_dump_crc_stats;
+    bool d_first_subframe_decoded;
 };
 
 
@@ -31,6 +31,7 @@
 #include "galileo_utc_model.h"       // for Galileo_Utc_Model
 #include "gnss_sdr_make_unique.h"    // for std::make_unique in C++11
 #include "gnss_synchro.h"            // for Gnss_Synchro
+#include "tlm_allocation_counter.h"  // for Tlm_Allocation_Scope
 #include "tlm_crc_stats.h"           // for Tlm_CRC_Stats
 #include "tlm_utils.h"               // for save_tlm_matfile, tlm_remove_file
 #include "viterbi_decoder.h"         // for Viterbi_Decoder
@@ -105,7 +106,8 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
                       d_enable_reed_solomon_inav(false),
                       d_valid_timetag(false),
                       d_E6_TOW_set(false),
-                      d_there_are_e6_channels(conf.there_are_e6_channels)
+                      d_there_are_e6_channels(conf.there_are_e6_channels),
+                      d_first_page_decoded(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -222,7 +224,15 @@ galileo_telemetry_decoder_gs::galileo_telemetry_decoder_gs(
             std::cout << "Galileo unified telemetry decoder error: Unknown frame type\n";
         }
 
+    // page buffers are sized once, so decoding a page does not allocate memory
     d_page_part_symbols = std::vector<float>(d_frame_length_symbols);
+    d_page_symbols_deint = std::vector<float>(d_frame_length_symbols);
+    d_page_bits = std::vector<int32_t>(d_frame_length_symbols / nn);
+    d_page_string.reserve(d_frame_length_symbols / nn);
+    if (d_enable_navdata_monitor)
+        {
+            d_nav_msg_packet.nav_message.reserve(d_frame_length_symbols / nn);
+        }
 
     for (int32_t i = 0; i < d_bits_per_preamble; i++)
         {
@@ -349,49 +359,53 @@ void galileo_telemetry_decoder_gs::deinterleaver(int32_t rows, int32_t cols, con
 }
 
 
-void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
+void galileo_telemetry_decoder_gs::decode_page_symbols(int32_t rows, int32_t cols, const float *page_symbols, int32_t frame_length)
 {
     // 1. De-interleave
-    std::vector<float> page_part_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, page_part_symbols_soft_value.data());
+    deinterleaver(rows, cols, page_symbols, d_page_symbols_deint.data());
 
     // 2. Viterbi decoder
     // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
+    for (int32_t i = 1; i < frame_length; i += 2)
         {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_part_symbols_soft_value[i] = -page_part_symbols_soft_value[i];
-                }
+            d_page_symbols_deint[i] = -d_page_symbols_deint[i];
         }
-    const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_part_bits(decoded_length);
-    d_viterbi->decode(page_part_bits, page_part_symbols_soft_value);
+    d_viterbi->decode(d_page_bits, d_page_symbols_deint);
 
-    // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
+    // 3. Bits to the string expected by the Galileo page decoders
+    const int32_t decoded_length = frame_length / 2;
+    d_page_string.assign(decoded_length, '0');
     for (int32_t i = 0; i < decoded_length; i++)
         {
-            if (page_part_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
+            if (d_page_bits[i] > 0)
                 {
-                    page_String.push_back('0');
+                    d_page_string[i] = '1';
                 }
         }
 
     if (d_enable_navdata_monitor)
         {
-            d_nav_msg_packet.nav_message = page_String;
+            d_nav_msg_packet.nav_message = d_page_string;
         }
+    d_first_page_decoded = true;
+}
+
 
-    if (page_part_bits[0] == 1)
+void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, int32_t frame_length)
+{
+    {
+        const Tlm_Allocation_Scope page_scope(d_first_page_decoded);
+
+        // 1. De-interleave, 2. Viterbi decoder
+        decode_page_symbols(GALILEO_INAV_INTERLEAVER_ROWS, GALILEO_INAV_INTERLEAVER_COLS, page_part_symbols, frame_length);
+
+        // 3. Call the Galileo page decoder (stores the even half word, or decodes the complete word and tests the CRC)
+        d_inav_nav.split_page(d_page_string, d_flag_even_word_arrived);
+    }
+
+    if (d_page_bits[0] == 1)
         {
-            // DECODE COMPLETE WORD (even + odd) and TEST CRC
-            d_inav_nav.split_page(page_String, d_flag_even_word_arrived);
+            // COMPLETE WORD (even + odd) decoded
             if (d_inav_nav.get_flag_CRC_test() == true)
                 {
                     if (d_band == '1')
@@ -418,8 +432,7 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
         }
     else
         {
-            // STORE HALF WORD (even page)
-            d_inav_nav.split_page(page_String, d_flag_even_word_arrived);
+            // HALF WORD (even page) stored
             d_flag_even_word_arrived = 1;
         }
 
@@ -504,46 +517,16 @@ void galileo_telemetry_decoder_gs::decode_INAV_word(float *page_part_symbols, in
 
 void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t frame_length)
 {
-    // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(frame_length);
-    deinterleaver(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
-
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < frame_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
-
-    const int32_t decoded_length = frame_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
-
-    // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
-    for (int32_t i = 0; i < decoded_length; i++)
-        {
-            if (page_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
-        }
+    {
+        const Tlm_Allocation_Scope page_scope(d_first_page_decoded);
 
-    if (d_enable_navdata_monitor)
-        {
-            d_nav_msg_packet.nav_message = page_String;
-        }
+        // 1. De-interleave, 2. Viterbi decoder
+        decode_page_symbols(GALILEO_FNAV_INTERLEAVER_ROWS, GALILEO_FNAV_INTERLEAVER_COLS, page_symbols, frame_length);
 
-    // DECODE COMPLETE WORD (even + odd) and TEST CRC
-    d_fnav_nav.split_page(page_String);
+        // 3. Call the Galileo page decoder
+        // DECODE COMPLETE WORD (even + odd) and TEST CRC
+        d_fnav_nav.split_page(d_page_string);
+    }
     if (d_fnav_nav.get_flag_CRC_test() == true)
         {
             DLOG(INFO) << "Galileo E5a CRC correct in channel " << d_channel << " from satellite " << d_satellite;
@@ -579,44 +562,16 @@ void galileo_telemetry_decoder_gs::decode_FNAV_word(float *page_symbols, int32_t
 
 void galileo_telemetry_decoder_gs::decode_CNAV_word(uint64_t time_stamp, float *page_symbols, int32_t page_length)
 {
-    // 1. De-interleave
-    std::vector<float> page_symbols_soft_value(page_length);
-    deinterleaver(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_symbols_soft_value.data());
+    {
+        // read_HAS_page() still allocates, so only the symbol decoding is counted for E6
+        const Tlm_Allocation_Scope page_scope(d_first_page_decoded);
 
-    // 2. Viterbi decoder
-    // 2.1 Take into account the NOT gate in G2 polynomial (Galileo ICD Figure 13, FEC encoder)
-    for (int32_t i = 0; i < page_length; i++)
-        {
-            if ((i + 1) % 2 == 0)
-                {
-                    page_symbols_soft_value[i] = -page_symbols_soft_value[i];
-                }
-        }
-    const int32_t decoded_length = page_length / 2;
-    std::vector<int32_t> page_bits(decoded_length);
-    d_viterbi->decode(page_bits, page_symbols_soft_value);
+        // 1. De-interleave, 2. Viterbi decoder
+        decode_page_symbols(GALILEO_CNAV_INTERLEAVER_ROWS, GALILEO_CNAV_INTERLEAVER_COLS, page_symbols, page_length);
+    }
 
     // 3. Call the Galileo page decoder
-    std::string page_String;
-    page_String.reserve(decoded_length);
-    for (int32_t i = 0; i < decoded_length; i++)
-        {
-            if (page_bits[i] > 0)
-                {
-                    page_String.push_back('1');
-                }
-            else
-                {
-                    page_String.push_back('0');
-                }
-        }
-
-    if (d_enable_navdata_monitor)
-        {
-            d_nav_msg_packet.nav_message = page_String;
-        }
-
-    d_cnav_nav.read_HAS_page(page_String);
+    d_cnav_nav.read_HAS_page(d_page_string);
     d_cnav_nav.set_time_stamp(time_stamp);
     // 4. If we have a new HAS page, read it
     if (d_cnav_nav.have_new_HAS_page() == true)
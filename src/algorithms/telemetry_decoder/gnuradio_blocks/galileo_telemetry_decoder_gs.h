@@ -82,6 +82,7 @@ private:
 
     void msg_handler_read_galileo_tow_map(const pmt::pmt_t &msg);
     void deinterleaver(int32_t rows, int32_t cols, const float *in, float *out);
+    void decode_page_symbols(int32_t rows, int32_t cols, const float *page_symbols, int32_t frame_length);
     void decode_INAV_word(float *page_part_symbols, int32_t frame_length);
     void decode_FNAV_word(float *page_symbols, int32_t frame_length);
     void decode_CNAV_word(uint64_t time_stamp, float *page_symbols, int32_t page_length);
@@ -89,7 +90,10 @@ private:
     std::unique_ptr<Viterbi_Decoder> d_viterbi;
     std::vector<int32_t> d_preamble_samples;
     std::vector<float> d_page_part_symbols;
+    std::vector<float> d_page_symbols_deint;
+    std::vector<int32_t> d_page_bits;
 
+    std::string d_page_string;
     std::string d_dump_filename;
     std::ofstream d_dump_file;
 
@@ -152,6 +156,7 @@ private:
     bool d_valid_timetag;
     bool d_E6_TOW_set;
     bool d_there_are_e6_channels;
+    bool d_first_page_decoded;
 };
 
 
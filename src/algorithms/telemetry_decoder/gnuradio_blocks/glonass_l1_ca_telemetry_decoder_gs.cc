@@ -21,6 +21,7 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_sdr_make_unique.h"  // for std::make_unique in C++11
+#include "tlm_allocation_counter.h"  // for Tlm_Allocation_Scope
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
@@ -61,7 +62,8 @@ glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
                             d_dump_mat(conf.dump_mat),
                             d_remove_dat(conf.remove_dat),
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
-                            d_dump_crc_stats(conf.dump_crc_stats)
+                            d_dump_crc_stats(conf.dump_crc_stats),
+                            d_first_string_decoded(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -101,6 +103,13 @@ glonass_l1_ca_telemetry_decoder_gs::glonass_l1_ca_telemetry_decoder_gs(
         }
 
     d_symbol_history.set_capacity(GLONASS_GNAV_STRING_SYMBOLS);
+    d_bi_binary_code.reserve(GLONASS_GNAV_DATA_SYMBOLS / GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_BIT);
+    d_relative_code.reserve(GLONASS_GNAV_STRING_BITS);
+    d_string_bits.reserve(GLONASS_GNAV_STRING_BITS);
+    if (d_enable_navdata_monitor)
+        {
+            d_nav_msg_packet.nav_message.reserve(GLONASS_GNAV_STRING_BITS);
+        }
 
     if (d_dump_crc_stats)
         {
@@ -157,62 +166,63 @@ void glonass_l1_ca_telemetry_decoder_gs::decode_string(const double *frame_symbo
     double chip_acc = 0.0;
     int32_t chip_acc_counter = 0;
 
-    // 1. Transform from symbols to bits
-    std::string bi_binary_code;
-    bi_binary_code.reserve(frame_length / GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_BIT);
-    std::string relative_code;
-    relative_code.reserve(GLONASS_GNAV_STRING_BITS);
-    std::string data_bits;
-    data_bits.reserve(GLONASS_GNAV_STRING_BITS + 1);
-
-    // Group samples into bi-binary code
-    for (int32_t i = 0; i < (frame_length); i++)
-        {
-            chip_acc += frame_symbols[i];
-            chip_acc_counter += 1;
-
-            if (chip_acc_counter == (GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_BIT))
-                {
-                    if (chip_acc > 0)
-                        {
-                            bi_binary_code.push_back('1');
-                            chip_acc_counter = 0;
-                            chip_acc = 0;
-                        }
-                    else
-                        {
-                            bi_binary_code.push_back('0');
-                            chip_acc_counter = 0;
-                            chip_acc = 0;
-                        }
-                }
-        }
-    // Convert from bi-binary code to relative code
-    for (int32_t i = 0; i < (GLONASS_GNAV_STRING_BITS); i++)
-        {
-            if (bi_binary_code[2 * i] == '1' && bi_binary_code[2 * i + 1] == '0')
-                {
-                    relative_code.push_back('1');
-                }
-            else
-                {
-                    relative_code.push_back('0');
-                }
-        }
-    // Convert from relative code to data bits
-    data_bits.push_back('0');
-    for (int32_t i = 1; i < (GLONASS_GNAV_STRING_BITS); i++)
-        {
-            data_bits.push_back(((relative_code[i - 1] - '0') ^ (relative_code[i] - '0')) + '0');
-        }
-
-    if (d_enable_navdata_monitor)
-        {
-            d_nav_msg_packet.nav_message = data_bits;
-        }
-
-    // 2. Call the GLONASS GNAV string decoder
-    d_nav.string_decoder(data_bits);
+    // 1. Transform from symbols to bits (the string capacities are reused)
+    {
+        const Tlm_Allocation_Scope string_scope(d_first_string_decoded);
+        d_bi_binary_code.clear();
+        d_relative_code.clear();
+        d_string_bits.clear();
+
+        // Group samples into bi-binary code
+        for (int32_t i = 0; i < (frame_length); i++)
+            {
+                chip_acc += frame_symbols[i];
+                chip_acc_counter += 1;
+
+                if (chip_acc_counter == (GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_BIT))
+                    {
+                        if (chip_acc > 0)
+                            {
+                                d_bi_binary_code.push_back('1');
+                                chip_acc_counter = 0;
+                                chip_acc = 0;
+                            }
+                        else
+                            {
+                                d_bi_binary_code.push_back('0');
+                                chip_acc_counter = 0;
+                                chip_acc = 0;
+                            }
+                    }
+            }
+        // Convert from bi-binary code to relative code
+        for (int32_t i = 0; i < (GLONASS_GNAV_STRING_BITS); i++)
+            {
+                if (d_bi_binary_code[2 * i] == '1' && d_bi_binary_code[2 * i + 1] == '0')
+                    {
+                        d_relative_code.push_back('1');
+                    }
+                else
+                    {
+                        d_relative_code.push_back('0');
+                    }
+            }
+        // Convert from relative code to data bits
+        d_string_bits.push_back('0');
+        for (int32_t i = 1; i < (GLONASS_GNAV_STRING_BITS); i++)
+            {
+                d_string_bits.push_back(((d_relative_code[i - 1] - '0') ^ (d_relative_code[i] - '0')) + '0');
+            }
+
+        if (d_enable_navdata_monitor)
+            {
+                d_nav_msg_packet.nav_message = d_string_bits;
+            }
+
+        // 2. Call the GLONASS GNAV string decoder
+        d_nav.string_decoder(d_string_bits);
+        d_first_string_decoded = true;
+    }
 
     // 3. Check operation executed correctly
     bool crc_ok = d_nav.get_flag_CRC_test();
@@ -23,12 +23,12 @@
 #include "gps_ephemeris.h"         // for Gps_Ephemeris
 #include "gps_iono.h"              // for Gps_Iono
 #include "gps_utc_model.h"         // for Gps_Utc_Model
+#include "tlm_allocation_counter.h"  // for Tlm_Allocation_Scope
 #include "tlm_utils.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>
 #include <pmt/pmt.h>        // for make_any
 #include <pmt/pmt_sugar.h>  // for mp
-#include <bitset>           // for bitset
 #include <cmath>            // for round
 #include <cstddef>          // for size_t
 #include <cstring>          // for memcpy
@@ -93,7 +93,8 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
                             d_dump_mat(conf.dump_mat),
                             d_remove_dat(conf.remove_dat),
                             d_enable_navdata_monitor(conf.enable_navdata_monitor),
-                            d_dump_crc_stats(conf.dump_crc_stats)
+                            d_dump_crc_stats(conf.dump_crc_stats),
+                            d_first_subframe_decoded(false)
 {
     // prevent telemetry symbols accumulation in output buffers
     this->set_max_noutput_items(1);
@@ -108,6 +109,7 @@ gps_l1_ca_telemetry_decoder_gs::gps_l1_ca_telemetry_decoder_gs(
             this->message_port_register_out(pmt::mp("Nav_msg_from_TLM"));
             d_nav_msg_packet.system = std::string("G");
             d_nav_msg_packet.signal = std::string("1C");
+            d_nav_msg_packet.nav_message.reserve(GPS_SUBFRAME_BITS);
         }
 
     d_satellite = Gnss_Satellite(satellite.get_system(), satellite.get_PRN());
@@ -331,23 +333,30 @@ bool gps_l1_ca_telemetry_decoder_gs::decode_subframe(bool flag_invert)
     // NEW GPS SUBFRAME HAS ARRIVED!
     if (subframe_synchro_confirmation)
         {
-            if (d_enable_navdata_monitor)
-                {
-                    uint32_t gps_word;
-                    std::bitset<GPS_SUBFRAME_BITS> subframe_bits;
-                    std::bitset<GPS_WORD_BITS + 2> word_bits;
-                    for (int32_t i = 0; i < 10; i++)
-                        {
-                            memcpy(&gps_word, &subframe[i * 4], sizeof(char) * 4);
-                            word_bits = std::bitset<(GPS_WORD_BITS + 2)>(gps_word);
-                            for (int32_t j = 0; j < GPS_WORD_BITS; j++)
-                                {
-                                    subframe_bits[GPS_WORD_BITS * (9 - i) + j] = word_bits[j];
-                                }
-                        }
-                    d_nav_msg_packet.nav_message = subframe_bits.to_string();
-                }
-            const int32_t subframe_ID = d_nav.subframe_decoder(subframe.data());  // decode the subframe
+            int32_t subframe_ID = 0;
+            {
+                const Tlm_Allocation_Scope subframe_scope(d_first_subframe_decoded);
+                if (d_enable_navdata_monitor)
+                    {
+                        // subframe bits as a string, first word first (the string capacity is reused)
+                        uint32_t gps_word;
+                        std::string &subframe_bits = d_nav_msg_packet.nav_message;
+                        subframe_bits.assign(GPS_SUBFRAME_BITS, '0');
+                        for (int32_t i = 0; i < 10; i++)
+                            {
+                                memcpy(&gps_word, &subframe[i * 4], sizeof(char) * 4);
+                                for (int32_t j = 0; j < GPS_WORD_BITS; j++)
+                                    {
+                                        if ((gps_word >> j) & 1U)
+                                            {
+                                                subframe_bits[GPS_WORD_BITS * i + GPS_WORD_BITS - 1 - j] = '1';
+                                            }
+                                    }
+                            }
+                    }
+                subframe_ID = d_nav.subframe_decoder(subframe.data());  // decode the subframe
+                d_first_subframe_decoded = true;
+            }
             if (subframe_ID > 0 && subframe_ID < 6)
                 {
                     std::cout << "New GPS NAV message received in channel " << this->d_channel << ": "
@@ -33,6 +33,7 @@ typedef struct
 {
     unsigned char c0[32];
     unsigned char c1[32];
+    int k7r12; /* Non-inverted V27POLYA, V27POLYB: decoded with volk_gnsssdr_32f_viterbi_k7r12_8u */
 } v27_poly_t;
 
 typedef struct
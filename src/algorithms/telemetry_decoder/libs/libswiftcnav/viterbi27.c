@@ -20,8 +20,20 @@
 
 
 #include "fec.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <stdlib.h>
 
+/* Number of bits passed to the VOLK_GNSSSDR kernel at once */
+#define V27_K7R12_CHUNK_BITS 16
+
+/* The decoder state holds the newest bit in the least significant position,
+ * and the VOLK_GNSSSDR kernel in the most significant one */
+static const unsigned char v27_reversed_state[64] = {
+    0, 32, 16, 48, 8, 40, 24, 56, 4, 36, 20, 52, 12, 44, 28, 60,
+    2, 34, 18, 50, 10, 42, 26, 58, 6, 38, 22, 54, 14, 46, 30, 62,
+    1, 33, 17, 49, 9, 41, 25, 57, 5, 37, 21, 53, 13, 45, 29, 61,
+    3, 35, 19, 51, 11, 43, 27, 59, 7, 39, 23, 55, 15, 47, 31, 63};
+
 static inline unsigned int parity(unsigned int x)
 {
     x ^= x >> 16U;
@@ -46,6 +58,7 @@ void v27_poly_init(v27_poly_t *poly, const signed char polynomial[2])
             poly->c0[state] = (polynomial[0] < 0) ^ parity((2 * state) & abs(polynomial[0])) ? 255 : 0;
             poly->c1[state] = (polynomial[1] < 0) ^ parity((2 * state) & abs(polynomial[1])) ? 255 : 0;
         }
+    poly->k7r12 = polynomial[0] == V27POLYA && polynomial[1] == V27POLYB;
 }
 
 
@@ -101,6 +114,49 @@ void v27_init(v27_t *v, v27_decision_t *decisions, unsigned int decisions_count,
         d->w[(i) / 16] |= decision << ((2U * (i) + 1U) & 31U);      \
     }
 
+/* Runs nbits steps of the VOLK_GNSSSDR kernel, with the path metrics of
+ * the kernel in metrics, and stores the decisions in the decoder history.
+ * The symbols are centered so that, up to a constant, the metric of the
+ * butterflies is minus twice the one of the kernel, and both keep the same
+ * survivors (also on ties). */
+static void v27_update_k7r12(v27_t *v, float *metrics, const unsigned char *syms, int nbits)
+{
+    unsigned char decisions[64 * V27_K7R12_CHUNK_BITS];
+    float symbols[2 * V27_K7R12_CHUNK_BITS];
+
+    while (nbits > 0)
+        {
+            const int chunk = nbits < V27_K7R12_CHUNK_BITS ? nbits : V27_K7R12_CHUNK_BITS;
+            int i;
+            int s;
+
+            for (i = 0; i < 2 * chunk; i++)
+                {
+                    symbols[i] = (float)syms[i] - 127.5F;
+                }
+            volk_gnsssdr_32f_viterbi_k7r12_8u(decisions, metrics, symbols, (unsigned int)chunk);
+
+            for (i = 0; i < chunk; i++)
+                {
+                    v27_decision_t *d = &v->decisions[v->decisions_index];
+                    const unsigned char *dec = decisions + 64 * i;
+
+                    d->w[0] = d->w[1] = 0;
+                    for (s = 0; s < 64; s++)
+                        {
+                            d->w[s / 32] |= (unsigned int)dec[v27_reversed_state[s]] << (s % 32);
+                        }
+                    if (++v->decisions_index >= v->decisions_count)
+                        {
+                            v->decisions_index = 0;
+                        }
+                }
+            syms += 2 * chunk;
+            nbits -= chunk;
+        }
+}
+
+
 /** Update a v27_t decoder with a block of symbols.
  *
  * \param v Structure to update.
@@ -114,6 +170,31 @@ void v27_update(v27_t *v, const unsigned char *syms, int nbits)
     unsigned char sym1;
     unsigned int *tmp;
 
+    if (v->poly->k7r12 && nbits > 0)
+        {
+            /* The kernel maximizes float metrics, normalized to zero. The
+             * integer metrics of the last two steps are kept up to date, as
+             * the butterflies leave them, for the chain-back functions. */
+            float metrics[64];
+            int s;
+
+            for (s = 0; s < 64; s++)
+                {
+                    metrics[v27_reversed_state[s]] = -0.5F * (float)v->old_metrics[s];
+                }
+            v27_update_k7r12(v, metrics, syms, nbits - 1);
+            for (s = 0; s < 64; s++)
+                {
+                    v->new_metrics[s] = (unsigned int)(-2.0F * metrics[v27_reversed_state[s]]);
+                }
+            v27_update_k7r12(v, metrics, syms + 2 * (nbits - 1), 1);
+            for (s = 0; s < 64; s++)
+                {
+                    v->old_metrics[s] = (unsigned int)(-2.0F * metrics[v27_reversed_state[s]]);
+                }
+            return;
+        }
+
     while (nbits--)
         {
             v27_decision_t *d = &v->decisions[v->decisions_index];
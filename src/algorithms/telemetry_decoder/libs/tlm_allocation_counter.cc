@@ -0,0 +1,72 @@
+/*!
+ * \file tlm_allocation_counter.cc
+ * \brief Debug-build counter of the heap allocations made by the telemetry
+ * decoder blocks while processing a navigation page.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tlm_allocation_counter.h"
+#include <atomic>
+
+namespace
+{
+// Nested scopes (not expected) are not counted twice
+thread_local bool tlm_page_in_progress = false;
+std::atomic<uint64_t> tlm_allocations{0};
+std::atomic<uint64_t> tlm_pages{0};
+}  // namespace
+
+
+void Tlm_Allocation_Counter::on_allocation()
+{
+    if (enabled() && tlm_page_in_progress)
+        {
+            tlm_allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+}
+
+
+uint64_t Tlm_Allocation_Counter::allocations()
+{
+    return tlm_allocations.load();
+}
+
+
+uint64_t Tlm_Allocation_Counter::pages()
+{
+    return tlm_pages.load();
+}
+
+
+void Tlm_Allocation_Counter::reset()
+{
+    tlm_allocations.store(0);
+    tlm_pages.store(0);
+}
+
+
+bool Tlm_Allocation_Counter::begin_page()
+{
+    if (tlm_page_in_progress)
+        {
+            return false;
+        }
+    tlm_page_in_progress = true;
+    return true;
+}
+
+
+void Tlm_Allocation_Counter::end_page()
+{
+    tlm_page_in_progress = false;
+    tlm_pages.fetch_add(1, std::memory_order_relaxed);
+}
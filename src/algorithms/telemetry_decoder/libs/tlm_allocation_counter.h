@@ -0,0 +1,103 @@
+/*!
+ * \file tlm_allocation_counter.h
+ * \brief Debug-build counter of the heap allocations made by the telemetry
+ * decoder blocks while processing a navigation page.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TLM_ALLOCATION_COUNTER_H
+#define GNSS_SDR_TLM_ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+/** \addtogroup Telemetry_Decoder
+ * \{ */
+/** \addtogroup Telemetry_Decoder_libs telemetry_decoder_libs
+ * \{ */
+
+/*!
+ * \brief Counts the heap allocations made by the telemetry decoder blocks
+ * while they process a page in steady state, that is, after the first page.
+ *
+ * The blocks mark their page processing with a Tlm_Allocation_Scope. The
+ * counter only knows which allocations fall inside such a scope: the program
+ * that wants them counted (e.g. the unit tests) replaces the global operator
+ * new and calls on_allocation() from it. Only active in debug builds (NDEBUG
+ * not defined); otherwise all the methods are no-ops.
+ *
+ * The scopes cover the symbol decoding and the call to the navigation message
+ * parser, CRC check included. The publication of new navigation data (the
+ * have_new_*() checks, which include the Galileo I/NAV Reed-Solomon recovery,
+ * and the message port posts), the console and log output, and the Galileo E6
+ * HAS page parser, which still allocates, are left outside.
+ */
+class Tlm_Allocation_Counter
+{
+public:
+    static constexpr bool enabled()
+    {
+#ifdef NDEBUG
+        return false;
+#else
+        return true;
+#endif
+    }
+
+    static void on_allocation();   //!< To be called by the replaced operator new
+    static uint64_t allocations();  //!< Allocations made inside steady-state scopes
+    static uint64_t pages();        //!< Number of steady-state scopes closed
+    static void reset();
+
+private:
+    friend class Tlm_Allocation_Scope;
+    static bool begin_page();
+    static void end_page();
+};
+
+
+/*!
+ * \brief Marks the processing of a page in the calling thread.
+ */
+class Tlm_Allocation_Scope
+{
+public:
+    /*!
+     * \param steady_state Set to false for the first page of a block, whose
+     * allocations (if any) are not counted.
+     */
+    explicit Tlm_Allocation_Scope(bool steady_state)
+    {
+        if (Tlm_Allocation_Counter::enabled() && steady_state)
+            {
+                d_armed = Tlm_Allocation_Counter::begin_page();
+            }
+    }
+
+    ~Tlm_Allocation_Scope()
+    {
+        if (d_armed)
+            {
+                Tlm_Allocation_Counter::end_page();
+            }
+    }
+
+    Tlm_Allocation_Scope(const Tlm_Allocation_Scope &) = delete;
+    Tlm_Allocation_Scope &operator=(const Tlm_Allocation_Scope &) = delete;
+
+private:
+    bool d_armed{false};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TLM_ALLOCATION_COUNTER_H
@@ -15,8 +15,8 @@
  */
 
 #include "viterbi_decoder.h"
-#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u
-#include <algorithm>                    // for std::copy
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_index_max_32u, volk_gnsssdr_32f_viterbi_k7r12_8u
+#include <algorithm>                    // for std::copy, std::fill
 
 Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
     int32_t nn,
@@ -26,9 +26,16 @@ Viterbi_Decoder::Viterbi_Decoder(int32_t KK,
                                        d_nn(nn),
                                        d_LL(LL),
                                        d_mm(KK - 1),
-                                       d_states(1 << d_mm),       //  2^d_mm
-                                       d_number_symbols(1 << nn)  //  2^d_nn
+                                       d_states(1 << d_mm),        //  2^d_mm
+                                       d_number_symbols(1 << nn),  //  2^d_nn
+                                       d_k7r12(KK == 7 && nn == 2 && g[0] == 121 && g[1] == 91)
 {
+    if (d_k7r12)
+        {
+            d_metrics = volk_gnsssdr::vector<float>(d_states, -d_MAXLOG);
+            d_decisions = volk_gnsssdr::vector<uint8_t>(d_states * (d_LL + d_mm));
+            return;
+        }
     d_prev_section = std::vector<float>(d_states, -d_MAXLOG);
     d_next_section = std::vector<float>(d_states, -d_MAXLOG);
     d_rec_array = std::vector<float>(d_nn);
@@ -53,12 +60,19 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
     float metric;
     float max_val;
 
+    if (d_k7r12)
+        {
+            decode_k7r12(output_u_int, input_c);
+            return;
+        }
+
+    std::fill(d_prev_section.begin(), d_prev_section.end(), -d_MAXLOG);
     d_prev_section[0] = 0.0;  //  start in all-zeros state
 
     // go through trellis
     for (t = 0; t < d_LL + d_mm; t++)
         {
-            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + (d_nn - 1), d_rec_array.begin());
+            std::copy(input_c.begin() + d_nn * t, input_c.begin() + d_nn * t + d_nn, d_rec_array.begin());
 
             // precompute all possible branch metrics
             for (i = 0; i < d_number_symbols; i++)
@@ -120,8 +134,34 @@ void Viterbi_Decoder::decode(std::vector<int32_t>& output_u_int, const std::vect
 }
 
 
+void Viterbi_Decoder::decode_k7r12(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c)
+{
+    std::fill(d_metrics.begin(), d_metrics.end(), -d_MAXLOG);
+    d_metrics[0] = 0.0;  //  start in all-zeros state
+
+    // go through trellis
+    volk_gnsssdr_32f_viterbi_k7r12_8u(d_decisions.data(), d_metrics.data(), input_c.data(), d_LL + d_mm);
+
+    // trace-back operation. The newest input bit is the MSB of the state,
+    // and the decision selects the LSB of the predecessor state
+    int32_t state = 0;
+    for (int32_t t = d_LL + d_mm - 1; t >= 0; t--)
+        {
+            if (t < d_LL)
+                {
+                    output_u_int[t] = state >> (d_mm - 1);
+                }
+            state = ((state << 1) & (d_states - 1)) | d_decisions[t * d_states + state];
+        }
+}
+
+
 void Viterbi_Decoder::reset()
 {
+    if (d_k7r12)
+        {
+            return;
+        }
     d_out0 = std::vector<int32_t>(d_states);
     d_out1 = std::vector<int32_t>(d_states);
     d_state0 = std::vector<int32_t>(d_states);
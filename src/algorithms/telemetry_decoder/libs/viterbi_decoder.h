@@ -17,6 +17,7 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_H
 #define GNSS_SDR_VITERBI_DECODER_H
 
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <array>
 #include <cstdint>
 #include <vector>
@@ -30,6 +31,10 @@
 
 /*!
  * \brief Class that implements a Viterbi decoder
+ *
+ * The K=7, rate 1/2 code with generator polynomials 171 and 133 (octal) used
+ * by Galileo is decoded with the volk_gnsssdr_32f_viterbi_k7r12_8u kernel.
+ * Any other code goes through the generic trellis implementation.
  */
 class Viterbi_Decoder
 {
@@ -48,6 +53,9 @@ public:
      * \param[out] output_u_int    Hard decisions on the data bits
      * \param[in] input_c The received signal in LLR-form. For BPSK, must be in form r = 2*a*y/(sigma^2).
      *
+     * Each call decodes an independent frame, terminated with KK - 1 tail
+     * bits: the path metrics are reset, and the trellis starts and ends in
+     * the all-zeros state whatever the previous calls decoded.
      */
     void decode(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c);
 
@@ -57,6 +65,11 @@ public:
     void reset();
 
 private:
+    /*
+     * Decoding of the K=7, rate 1/2 code through the SIMD add-compare-select kernel
+     */
+    void decode_k7r12(std::vector<int32_t>& output_u_int, const std::vector<float>& input_c);
+
     /*
      * Function that creates the transit and output vectors
      */
@@ -115,6 +128,9 @@ private:
     std::vector<int32_t> d_state0;
     std::vector<int32_t> d_state1;
 
+    volk_gnsssdr::vector<float> d_metrics;
+    volk_gnsssdr::vector<uint8_t> d_decisions;
+
     float d_MAXLOG = 1e7;  // Define infinity
     int32_t d_KK{};
     int32_t d_nn{};
@@ -123,6 +139,7 @@ private:
     int32_t d_mm{};
     int32_t d_states{};
     int32_t d_number_symbols{};
+    bool d_k7r12{false};
 };
 
 /** \} */
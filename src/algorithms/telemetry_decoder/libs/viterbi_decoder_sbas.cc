@@ -17,7 +17,8 @@
 
 #include "viterbi_decoder_sbas.h"
 #include <glog/logging.h>
-#include <algorithm>  // for fill_n
+#include <volk_gnsssdr/volk_gnsssdr.h>  // for volk_gnsssdr_32f_viterbi_k7r12_8u
+#include <algorithm>                    // for fill_n, std::copy, std::min
 #include <ostream>    // for operator<<, basic_ostream, char_traits
 
 // logging
@@ -37,7 +38,8 @@ Viterbi_Decoder_Sbas::Viterbi_Decoder_Sbas(const int g_encoder[],
               d_mm(KK - 1),
               d_states(static_cast<int>(1U << (KK - 1))),    // 2^mm
               d_number_symbols(static_cast<int>(1U << nn)),  // 2^nn
-              d_trellis_state_is_initialised(false)
+              d_trellis_state_is_initialised(false),
+              d_k7r12(KK == 7 && nn == 2 && g_encoder[0] == 121 && g_encoder[1] == 91)
 {
     /* create appropriate transition matrices (trellis) */
     d_out0 = std::vector<int>(d_states);
@@ -74,11 +76,19 @@ float Viterbi_Decoder_Sbas::decode_block(const double input_c[], int output_u_in
     // init
     init_trellis_state();
     // do add compare select
-    do_acs(input_c, LL + d_mm);
+    if (d_k7r12)
+        {
+            do_acs_k7r12(input_c, LL + d_mm);
+        }
+    else
+        {
+            do_acs(input_c, LL + d_mm);
+        }
     // tail, no need to output -> traceback, but don't decode
     const int state = do_traceback(d_mm);
     // traceback and decode
-    const int decoding_length_mismatch = do_tb_and_decode(d_mm, LL, state, output_u_int, d_indicator_metric);
+    const int decoding_length_mismatch = d_k7r12 ? do_tb_and_decode_k7r12(d_mm, LL, state, output_u_int, d_indicator_metric)
+                                                 : do_tb_and_decode(d_mm, LL, state, output_u_int, d_indicator_metric);
 
     VLOG(FLOW) << "decoding length mismatch: " << decoding_length_mismatch;
 
@@ -95,12 +105,20 @@ float Viterbi_Decoder_Sbas::decode_continuous(const double sym[],
     VLOG(FLOW) << "decode_continuous(): nbits_requested=" << nbits_requested;
 
     // do add compare select
-    do_acs(sym, nbits_requested);
+    if (d_k7r12)
+        {
+            do_acs_k7r12(sym, nbits_requested);
+        }
+    else
+        {
+            do_acs(sym, nbits_requested);
+        }
     // the ML sequence in the newest part of the trellis can not be decoded
     // since it depends on the future values -> traceback, but don't decode
     const int state = do_traceback(traceback_depth);
     // traceback and decode
-    const int decoding_length_mismatch = do_tb_and_decode(traceback_depth, nbits_requested, state, bits, d_indicator_metric);
+    const int decoding_length_mismatch = d_k7r12 ? do_tb_and_decode_k7r12(traceback_depth, nbits_requested, state, bits, d_indicator_metric)
+                                                 : do_tb_and_decode(traceback_depth, nbits_requested, state, bits, d_indicator_metric);
     nbits_decoded = nbits_requested + decoding_length_mismatch;
 
     VLOG(FLOW) << "decoding length mismatch (continuous decoding): " << decoding_length_mismatch;
@@ -124,6 +142,7 @@ void Viterbi_Decoder_Sbas::init_trellis_state()
     // reserve new trellis state memory
     d_pm_t = std::vector<float>(d_states);
     d_trellis_paths = std::deque<Prev>();
+    d_k7r12_paths = std::deque<K7r12_Section>();
     d_rec_array = std::vector<float>(d_nn);
     d_metric_c = std::vector<float>(d_number_symbols);
     d_trellis_state_is_initialised = true;
@@ -236,6 +255,27 @@ int Viterbi_Decoder_Sbas::do_acs(const double sym[], int nbits)
 }
 
 
+int Viterbi_Decoder_Sbas::do_acs_k7r12(const double sym[], int nbits)
+{
+    d_symbols.resize(2 * nbits);
+    d_decisions.resize(static_cast<size_t>(d_states) * nbits);
+    std::copy(sym, sym + 2 * nbits, d_symbols.begin());
+
+    // go through trellis. As in do_acs(), the path metrics are normalized to
+    // a maximum of zero, and ties keep the lowest predecessor state.
+    volk_gnsssdr_32f_viterbi_k7r12_8u(d_decisions.data(), d_pm_t.data(), d_symbols.data(), nbits);
+
+    for (int t = 0; t < nbits; t++)
+        {
+            K7r12_Section section{};
+            std::copy(d_decisions.begin() + t * d_states, d_decisions.begin() + (t + 1) * d_states, section.decisions.begin());
+            section.symbols = {d_symbols[2 * t], d_symbols[2 * t + 1]};
+            d_k7r12_paths.push_front(section);
+        }
+    return nbits;
+}
+
+
 int Viterbi_Decoder_Sbas::do_traceback(size_t traceback_length)
 {
     // traceback_length is in bits
@@ -244,6 +284,19 @@ int Viterbi_Decoder_Sbas::do_traceback(size_t traceback_length)
 
     VLOG(FLOW) << "do_traceback(): traceback_length=" << traceback_length << '\n';
 
+    if (d_k7r12)
+        {
+            // The newest input bit is the MSB of the state, and the decision
+            // selects the LSB of the predecessor state
+            traceback_length = std::min(traceback_length, d_k7r12_paths.size());
+            state = 0;
+            for (size_t t = 0; t < traceback_length; t++)
+                {
+                    state = ((state << 1) & (d_states - 1)) | d_k7r12_paths[t].decisions[state];
+                }
+            return state;
+        }
+
     if (d_trellis_paths.size() < traceback_length)
         {
             traceback_length = d_trellis_paths.size();
@@ -305,6 +358,51 @@ int Viterbi_Decoder_Sbas::do_tb_and_decode(int traceback_length, int requested_d
 }
 
 
+int Viterbi_Decoder_Sbas::do_tb_and_decode_k7r12(int traceback_length, int requested_decoding_length, int state, int output_u_int[], float& indicator_metric)
+{
+    const int n_of_branches_for_indicator_metric = 500;
+    int n_im = 0;
+
+    // decode only decode_length bits -> overstep newer bits which are too much
+    const int decoding_length_mismatch = static_cast<int>(d_k7r12_paths.size()) - (traceback_length + requested_decoding_length);
+    const int overstep_length = decoding_length_mismatch >= 0 ? decoding_length_mismatch : 0;
+    const int first_decoded = traceback_length + overstep_length;
+
+    for (int t = traceback_length; t < first_decoded; t++)
+        {
+            state = ((state << 1) & (d_states - 1)) | d_k7r12_paths[t].decisions[state];
+        }
+    int t_out = static_cast<int>(d_k7r12_paths.size()) - first_decoded - 1;
+    indicator_metric = 0;
+    for (int t = first_decoded; t < static_cast<int>(d_k7r12_paths.size()); t++)
+        {
+            const K7r12_Section& section = d_k7r12_paths[t];
+            const int bit = state >> (d_mm - 1);
+            const int ancestor = ((state << 1) & (d_states - 1)) | section.decisions[state];
+            if (t - first_decoded < n_of_branches_for_indicator_metric)
+                {
+                    // survivor branch metric, as stored by do_acs()
+                    n_im++;
+                    indicator_metric += gamma(section.symbols.data(), bit ? d_out1[ancestor] : d_out0[ancestor], d_nn);
+                }
+            output_u_int[t_out] = bit;
+            state = ancestor;
+            t_out--;
+        }
+    if (n_im > 0)
+        {
+            indicator_metric /= static_cast<float>(n_im);
+        }
+
+    // remove old states
+    if (first_decoded <= static_cast<int>(d_k7r12_paths.size()))
+        {
+            d_k7r12_paths.erase(d_k7r12_paths.begin() + first_decoded, d_k7r12_paths.end());
+        }
+    return decoding_length_mismatch;
+}
+
+
 /* function Gamma()
 
  Description: Computes the branch metric used for decoding.
@@ -18,7 +18,10 @@
 #ifndef GNSS_SDR_VITERBI_DECODER_SBAS_H
 #define GNSS_SDR_VITERBI_DECODER_SBAS_H
 
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <array>
 #include <cstddef>  // for size_t
+#include <cstdint>
 #include <deque>
 #include <vector>
 
@@ -30,6 +33,9 @@
 
 /*!
  * \brief Class that implements a Viterbi decoder
+ *
+ * The K=7, rate 1/2 code with generator polynomials 171 and 133 (octal) used
+ * by SBAS is decoded with the volk_gnsssdr_32f_viterbi_k7r12_8u kernel.
  */
 class Viterbi_Decoder_Sbas
 {
@@ -77,11 +83,21 @@ private:
         int refcount;
     };
 
+    // trellis section of the K=7, rate 1/2 code
+    class K7r12_Section
+    {
+    public:
+        std::array<uint8_t, 64> decisions;  // 1 if the survivor comes from the odd predecessor
+        std::array<float, 2> symbols;       // received symbols
+    };
+
     // operations on the trellis (change decoder state)
     void init_trellis_state();
     int do_acs(const double sym[], int nbits);
+    int do_acs_k7r12(const double sym[], int nbits);
     int do_traceback(std::size_t traceback_length);
     int do_tb_and_decode(int traceback_length, int requested_decoding_length, int state, int output_u_int[], float& indicator_metric);
+    int do_tb_and_decode_k7r12(int traceback_length, int requested_decoding_length, int state, int output_u_int[], float& indicator_metric);
 
     // branch metric function
     float gamma(const float rec_array[], int symbol, int nn);
@@ -93,6 +109,9 @@ private:
 
     // trellis state
     std::deque<Prev> d_trellis_paths;
+    std::deque<K7r12_Section> d_k7r12_paths;
+    volk_gnsssdr::vector<uint8_t> d_decisions;
+    volk_gnsssdr::vector<float> d_symbols;
     std::vector<float> d_pm_t;
     std::vector<float> d_metric_c;  /* Set of all possible branch metrics */
     std::vector<float> d_rec_array; /* Received values for one trellis section */
@@ -115,6 +134,7 @@ private:
     int d_states;
     int d_number_symbols;
     bool d_trellis_state_is_initialised;
+    bool d_k7r12;
 };
 
 
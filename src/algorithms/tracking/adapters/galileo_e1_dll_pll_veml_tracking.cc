@@ -27,6 +27,7 @@
 #include "dll_pll_conf.h"
 #include "gnss_sdr_flags.h"
 #include <glog/logging.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>  // for lv_16sc_t, lv_8sc_t
 #include <algorithm>
 #include <array>
 
@@ -64,6 +65,16 @@ GalileoE1DllPllVemlTracking::GalileoE1DllPllVemlTracking(
             item_size_ = sizeof(gr_complex);
             tracking_ = dll_pll_veml_make_tracking(trk_params);
         }
+    else if (trk_params.item_type == "cshort")
+        {
+            item_size_ = sizeof(lv_16sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
+    else if (trk_params.item_type == "cbyte")
+        {
+            item_size_ = sizeof(lv_8sc_t);
+            tracking_ = dll_pll_veml_make_tracking(trk_params);
+        }
     else
         {
             item_size_ = 0;
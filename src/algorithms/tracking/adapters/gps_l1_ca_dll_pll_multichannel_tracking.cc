@@ -0,0 +1,159 @@
+/*!
+ * \file gps_l1_ca_dll_pll_multichannel_tracking.cc
+ * \brief Implementation of an adapter of a slot of the multichannel DLL+PLL
+ * tracking block for GPS L1 C/A to a TrackingInterface
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gps_l1_ca_dll_pll_multichannel_tracking.h"
+#include "GPS_L1_CA.h"
+#include "configuration_interface.h"
+#include "display.h"
+#include "dll_pll_conf.h"
+#include <glog/logging.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+
+GpsL1CaDllPllMultichannelTracking::GpsL1CaDllPllMultichannelTracking(
+    const ConfigurationInterface* configuration, const std::string& role,
+    unsigned int in_streams, unsigned int out_streams,
+    dll_pll_multichannel_tracking_sptr& multichannel_block) : role_(role), slot_(-1), in_streams_(in_streams), out_streams_(out_streams)
+{
+    Dll_Pll_Conf trk_params = Dll_Pll_Conf();
+    DLOG(INFO) << "role " << role;
+    trk_params.SetFromConfiguration(configuration, role);
+
+    const auto vector_length = static_cast<int>(std::round(trk_params.fs_in / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+    trk_params.vector_length = vector_length;
+    if (trk_params.extend_correlation_symbols != 1)
+        {
+            trk_params.extend_correlation_symbols = 1;
+            std::cout << TEXT_RED << "WARNING: GPS L1 C/A multichannel tracking only supports 1 ms coherent integrations. Coherent integration has been set to 1 symbol (1 ms)" << TEXT_RESET << '\n';
+        }
+    trk_params.track_pilot = configuration->property(role + ".track_pilot", false);
+    if (trk_params.track_pilot)
+        {
+            trk_params.track_pilot = false;
+            std::cout << TEXT_RED << "WARNING: GPS L1 C/A does not have pilot signal. Data tracking has been enabled" << TEXT_RESET << '\n';
+        }
+
+    trk_params.system = 'G';
+    const std::array<char, 3> sig_{'1', 'C', '\0'};
+    std::copy_n(sig_.data(), 3, trk_params.signal);
+
+    // ######## Make (or share) the GNU Radio multichannel tracking block ######
+    if (trk_params.item_type == "gr_complex")
+        {
+            item_size_ = sizeof(gr_complex);
+            if (!multichannel_block)
+                {
+                    const auto n_channels = static_cast<int32_t>(configuration->property("Channels_1C.count", 1));
+                    multichannel_block = dll_pll_multichannel_make_tracking(trk_params, n_channels);
+                }
+            tracking_ = multichannel_block;
+            slot_ = tracking_->add_channel();
+            if (slot_ < 0)
+                {
+                    LOG(ERROR) << role << ": all the slots of the multichannel tracking block are taken";
+                }
+        }
+    else
+        {
+            item_size_ = 0;
+            LOG(WARNING) << trk_params.item_type << " unknown tracking item type. The multichannel tracking only supports gr_complex";
+        }
+    channel_ = 0;
+    if (tracking_)
+        {
+            DLOG(INFO) << "tracking(" << tracking_->unique_id() << "), slot " << slot_;
+        }
+    if (in_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one input stream";
+        }
+    if (out_streams_ > 1)
+        {
+            LOG(ERROR) << "This implementation only supports one output stream";
+        }
+}
+
+
+void GpsL1CaDllPllMultichannelTracking::stop_tracking()
+{
+    if (slot_ >= 0)
+        {
+            tracking_->stop_tracking(slot_);
+        }
+}
+
+
+void GpsL1CaDllPllMultichannelTracking::start_tracking()
+{
+    if (slot_ >= 0)
+        {
+            tracking_->start_tracking(slot_);
+        }
+}
+
+
+/*
+ * Set tracking channel unique ID
+ */
+void GpsL1CaDllPllMultichannelTracking::set_channel(unsigned int channel)
+{
+    channel_ = channel;
+    if (slot_ >= 0)
+        {
+            tracking_->set_channel(slot_, channel);
+        }
+}
+
+
+void GpsL1CaDllPllMultichannelTracking::set_gnss_synchro(Gnss_Synchro* p_gnss_synchro)
+{
+    if (slot_ >= 0)
+        {
+            tracking_->set_gnss_synchro(slot_, p_gnss_synchro);
+        }
+}
+
+
+void GpsL1CaDllPllMultichannelTracking::connect(gr::top_block_sptr top_block)
+{
+    if (top_block)
+        { /* top_block is not null */
+        };
+    // nothing to connect, the channels of the block are connected by Channel and GNSSFlowgraph
+}
+
+
+void GpsL1CaDllPllMultichannelTracking::disconnect(gr::top_block_sptr top_block)
+{
+    if (top_block)
+        { /* top_block is not null */
+        };
+    // nothing to disconnect, the channels of the block are disconnected by Channel and GNSSFlowgraph
+}
+
+
+gr::basic_block_sptr GpsL1CaDllPllMultichannelTracking::get_left_block()
+{
+    return tracking_;
+}
+
+
+gr::basic_block_sptr GpsL1CaDllPllMultichannelTracking::get_right_block()
+{
+    return tracking_;
+}
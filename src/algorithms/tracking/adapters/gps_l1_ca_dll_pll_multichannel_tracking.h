@@ -0,0 +1,114 @@
+/*!
+ * \file gps_l1_ca_dll_pll_multichannel_tracking.h
+ * \brief  Interface of an adapter of a slot of the multichannel DLL+PLL
+ * tracking block for GPS L1 C/A to a TrackingInterface
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_GPS_L1_CA_DLL_PLL_MULTICHANNEL_TRACKING_H
+#define GNSS_SDR_GPS_L1_CA_DLL_PLL_MULTICHANNEL_TRACKING_H
+
+#include "dll_pll_multichannel_tracking.h"
+#include "tracking_interface.h"
+#include <cstdint>
+#include <string>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_adapters
+ * \{ */
+
+
+class ConfigurationInterface;
+
+/*!
+ * \brief This class implements a code DLL + carrier PLL tracking loop of a
+ * GPS L1 C/A channel hosted, together with the other channels of the same
+ * role, by one dll_pll_multichannel_tracking block.
+ *
+ * The first adapter of a role creates the block, with one slot per
+ * Channels_1C channel, and stores it in multichannel_block. The next ones
+ * take the following slots of the same block.
+ */
+class GpsL1CaDllPllMultichannelTracking : public TrackingInterface
+{
+public:
+    GpsL1CaDllPllMultichannelTracking(
+        const ConfigurationInterface* configuration,
+        const std::string& role,
+        unsigned int in_streams,
+        unsigned int out_streams,
+        dll_pll_multichannel_tracking_sptr& multichannel_block);
+
+    ~GpsL1CaDllPllMultichannelTracking() = default;
+
+    inline std::string role() override
+    {
+        return role_;
+    }
+
+    //! Returns "GPS_L1_CA_DLL_PLL_Multichannel_Tracking"
+    inline std::string implementation() override
+    {
+        return "GPS_L1_CA_DLL_PLL_Multichannel_Tracking";
+    }
+
+    inline size_t item_size() override
+    {
+        return item_size_;
+    }
+
+    void connect(gr::top_block_sptr top_block) override;
+    void disconnect(gr::top_block_sptr top_block) override;
+    gr::basic_block_sptr get_left_block() override;
+    gr::basic_block_sptr get_right_block() override;
+
+    /*!
+     * \brief Returns the slot of this channel in the multichannel block
+     */
+    inline int32_t get_slot() override
+    {
+        return slot_;
+    }
+
+    /*!
+     * \brief Set tracking channel unique ID
+     */
+    void set_channel(unsigned int channel) override;
+
+    /*!
+     * \brief Set acquisition/tracking common Gnss_Synchro object pointer
+     * to efficiently exchange synchronization data between acquisition and tracking blocks
+     */
+    void set_gnss_synchro(Gnss_Synchro* p_gnss_synchro) override;
+
+    void start_tracking() override;
+
+    /*!
+     * \brief Stop running tracking
+     */
+    void stop_tracking() override;
+
+private:
+    dll_pll_multichannel_tracking_sptr tracking_;
+    size_t item_size_;
+    unsigned int channel_;
+    std::string role_;
+    int32_t slot_;
+    unsigned int in_streams_;
+    unsigned int out_streams_;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_GPS_L1_CA_DLL_PLL_MULTICHANNEL_TRACKING_H
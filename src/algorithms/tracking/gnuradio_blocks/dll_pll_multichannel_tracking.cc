@@ -0,0 +1,742 @@
+/*!
+ * \file dll_pll_multichannel_tracking.cc
+ * \brief Code DLL + carrier PLL tracking block hosting several GPS L1 C/A
+ * channels on one pass over the input samples.
+ *
+ * Code DLL + carrier PLL according to the algorithms described in:
+ * [1] K.Borre, D.M.Akos, N.Bertelsen, P.Rinder, and S.H.Jensen,
+ * A Software-Defined GPS and Galileo Receiver. A Single-Frequency
+ * Approach, Birkhauser, 2007
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "dll_pll_multichannel_tracking.h"
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "gnss_satellite.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include "lock_detectors.h"
+#include "tracking_discriminators.h"
+#include <glog/logging.h>
+#include <gnuradio/io_signature.h>   // for io_signature
+#include <gnuradio/thread/thread.h>  // for scoped_lock
+#include <pmt/pmt_sugar.h>           // for mp
+#include <algorithm>                 // for fill, fill_n, max, min
+#include <cmath>                     // for fmod, round, floor, sqrt
+#include <cstdlib>                   // for abs
+#include <exception>                 // for exception
+#include <iostream>                  // for cout
+
+#if HAS_GENERIC_LAMBDA
+#else
+#include <boost/bind/bind.hpp>
+#endif
+
+#if PMT_USES_BOOST_ANY
+#include <boost/any.hpp>
+namespace wht = boost;
+#else
+#include <any>
+namespace wht = std;
+#endif
+
+dll_pll_multichannel_tracking_sptr dll_pll_multichannel_make_tracking(const Dll_Pll_Conf &conf_, int32_t n_channels)
+{
+    return dll_pll_multichannel_tracking_sptr(new dll_pll_multichannel_tracking(conf_, n_channels));
+}
+
+
+dll_pll_multichannel_tracking::dll_pll_multichannel_tracking(const Dll_Pll_Conf &conf_, int32_t n_channels)
+    : gr::block("dll_pll_multichannel_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+          gr::io_signature::make(1, n_channels, sizeof(Gnss_Synchro))),
+      d_trk_parameters(conf_),
+      d_signal_carrier_freq(GPS_L1_FREQ_HZ),
+      d_code_period(GPS_L1_CA_CODE_PERIOD_S),
+      d_code_chip_rate(GPS_L1_CA_CODE_RATE_CPS),
+      d_carrier_lock_threshold(d_trk_parameters.carrier_lock_th),
+      d_n_channels(n_channels),
+      d_used_channels(0),
+      d_n_correlator_taps(3),
+      d_code_length_chips(static_cast<int32_t>(GPS_L1_CA_CODE_LENGTH_CHIPS)),
+      d_symbols_per_bit(GPS_CA_TELEMETRY_SYMBOLS_PER_BIT),
+      d_correlation_length_ms(1),
+      d_window_samples(std::max(static_cast<int32_t>(d_trk_parameters.vector_length / 2), 1)),
+      d_secondary_code_length(static_cast<uint32_t>(GPS_CA_PREAMBLE_LENGTH_SYMBOLS))
+{
+    // prevent telemetry symbols accumulation in output buffers
+    this->set_max_noutput_items(1);
+    this->set_relative_rate(1.0 / static_cast<double>(d_trk_parameters.vector_length));
+
+    // GPS L1 C/A does not have pilot component nor secondary code
+    d_trk_parameters.track_pilot = false;
+    d_trk_parameters.slope = 1.0;
+    d_trk_parameters.spc = d_trk_parameters.early_late_space_chips;
+    d_trk_parameters.y_intercept = 1.0;
+    // set the bit transition pattern in secondary code to obtain bit synchronization
+    d_secondary_code_string = GPS_CA_PREAMBLE_SYMBOLS_STR;
+
+    if (d_trk_parameters.extend_correlation_symbols > 1)
+        {
+            LOG(WARNING) << "Extended coherent integration is not available in the multichannel tracking. Coherent integration has been set to 1 symbol (1 ms)";
+            d_trk_parameters.extend_correlation_symbols = 1;
+        }
+    if (d_trk_parameters.high_dyn)
+        {
+            LOG(WARNING) << "High dynamics tracking is not available in the multichannel tracking. Disabled.";
+            d_trk_parameters.high_dyn = false;
+        }
+    if (d_trk_parameters.enable_doppler_correction)
+        {
+            LOG(WARNING) << "Doppler correction is not available in the multichannel tracking. Disabled.";
+            d_trk_parameters.enable_doppler_correction = false;
+        }
+    if (d_trk_parameters.dump)
+        {
+            LOG(WARNING) << "Tracking dump files are not available in the multichannel tracking. Disabled.";
+            d_trk_parameters.dump = false;
+        }
+
+    // --- Per-channel state ---
+    const auto n = static_cast<size_t>(d_n_channels);
+    d_acquisition_gnss_synchro = std::vector<Gnss_Synchro *>(n, nullptr);
+    d_cn0_smoother = std::vector<Exponential_Smoother>(n);
+    d_carrier_lock_test_smoother = std::vector<Exponential_Smoother>(n);
+    d_carrier_loop_filter = std::vector<Tracking_FLL_PLL_filter>(n);
+    d_code_loop_filter.reserve(n);
+    d_Prompt_circular_buffer.reserve(n);
+    d_events_port.reserve(n);
+    for (int32_t slot = 0; slot < d_n_channels; slot++)
+        {
+            d_cn0_smoother[slot].set_alpha(d_trk_parameters.cn0_smoother_alpha);
+            d_cn0_smoother[slot].set_samples_for_initialization(d_trk_parameters.cn0_smoother_samples / static_cast<int>(d_code_period * 1000.0));
+            d_carrier_lock_test_smoother[slot].set_alpha(d_trk_parameters.carrier_lock_test_smoother_alpha);
+            d_carrier_lock_test_smoother[slot].set_min_value(-1.0);
+            d_carrier_lock_test_smoother[slot].set_offset(0.0);
+            d_carrier_lock_test_smoother[slot].set_samples_for_initialization(d_trk_parameters.carrier_lock_test_smoother_samples);
+            d_carrier_loop_filter[slot].set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
+            d_code_loop_filter.emplace_back(static_cast<float>(d_code_period), d_trk_parameters.dll_bw_hz, d_trk_parameters.dll_filter_order, false);
+            d_Prompt_circular_buffer.emplace_back(d_secondary_code_length);
+            d_events_port.push_back(pmt::mp("events_" + std::to_string(slot)));
+        }
+
+    d_tracking_code = volk_gnsssdr::vector<float>(n * d_code_length_chips, 0.0);
+    d_local_code_shift_chips = volk_gnsssdr::vector<float>(n * d_n_correlator_taps, 0.0);
+    d_correlator_outs = volk_gnsssdr::vector<gr_complex>(n * d_n_correlator_taps, gr_complex(0.0, 0.0));
+    d_Prompt_buffer = volk_gnsssdr::vector<gr_complex>(n * d_trk_parameters.cn0_samples);
+
+    d_acq_code_phase_samples = std::vector<double>(n, 0.0);
+    d_carrier_doppler_hz = std::vector<double>(n, 0.0);
+    d_code_freq_chips = std::vector<double>(n, d_code_chip_rate);
+    d_acc_carrier_phase_rad = std::vector<double>(n, 0.0);
+    d_rem_code_phase_chips = std::vector<double>(n, 0.0);
+    d_rem_code_phase_samples = std::vector<double>(n, 0.0);
+    d_carrier_phase_step_rad = std::vector<double>(n, 0.0);
+    d_code_phase_step_chips = std::vector<double>(n, 0.0);
+    d_carrier_lock_test = std::vector<double>(n, 1.0);
+    d_CN0_SNV_dB_Hz = std::vector<double>(n, 0.0);
+    d_EVM = std::vector<double>(n, 0.0);
+    d_rem_carr_phase_rad = std::vector<float>(n, 0.0);
+    d_P_accu_old = std::vector<gr_complex>(n, gr_complex(0.0, 0.0));
+    d_P_data_accu = std::vector<gr_complex>(n, gr_complex(0.0, 0.0));
+    d_acq_sample_stamp = std::vector<uint64_t>(n, 0ULL);
+    d_epoch_start = std::vector<uint64_t>(n, 0ULL);
+    d_state = std::vector<int32_t>(n, 0);  // initial state: standby
+    d_current_prn_length_samples = std::vector<int32_t>(n, static_cast<int32_t>(d_trk_parameters.vector_length));
+    d_current_data_symbol = std::vector<int32_t>(n, 0);
+    d_cn0_estimation_counter = std::vector<int32_t>(n, 0);
+    d_carrier_lock_fail_counter = std::vector<int32_t>(n, 0);
+    d_code_lock_fail_counter = std::vector<int32_t>(n, 0);
+    d_produced = std::vector<int32_t>(n, 0);
+    d_channel = std::vector<uint32_t>(n, 0U);
+    d_pull_in_transitory = std::vector<uint8_t>(n, 1);
+    d_acc_carrier_phase_initialized = std::vector<uint8_t>(n, 0);
+    d_Flag_PLL_180_deg_phase_locked = std::vector<uint8_t>(n, 0);
+
+    d_correlator.init(d_n_channels, d_n_correlator_taps);
+    d_correlator.set_high_dynamics_resampler(false);
+
+    for (int32_t slot = 0; slot < d_n_channels; slot++)
+        {
+            // Telemetry bit synchronization message port output
+            this->message_port_register_out(d_events_port[slot]);
+
+            // Telemetry message port input
+            const pmt::pmt_t telemetry_port = pmt::mp("telemetry_to_trk_" + std::to_string(slot));
+            this->message_port_register_in(telemetry_port);
+            this->set_msg_handler(
+                telemetry_port,
+#if HAS_GENERIC_LAMBDA
+                [this, slot](auto &&PH1) { msg_handler_telemetry_to_trk(slot, PH1); });
+#else
+#if USE_BOOST_BIND_PLACEHOLDERS
+                boost::bind(&dll_pll_multichannel_tracking::msg_handler_telemetry_to_trk, this, slot, boost::placeholders::_1));
+#else
+                boost::bind(&dll_pll_multichannel_tracking::msg_handler_telemetry_to_trk, this, slot, _1));
+#endif
+#endif
+            clear_tracking_vars(slot);
+        }
+
+    set_tag_propagation_policy(TPP_DONT);  // no tag propagation
+}
+
+
+void dll_pll_multichannel_tracking::forecast(int noutput_items,
+    gr_vector_int &ninput_items_required)
+{
+    if (noutput_items != 0)
+        {
+            ninput_items_required[0] = static_cast<int32_t>(d_trk_parameters.vector_length) * 2;
+        }
+}
+
+
+int32_t dll_pll_multichannel_tracking::add_channel()
+{
+    gr::thread::scoped_lock l(d_setlock);
+    if (d_used_channels == d_n_channels)
+        {
+            return -1;
+        }
+    return d_used_channels++;
+}
+
+
+void dll_pll_multichannel_tracking::msg_handler_telemetry_to_trk(int32_t slot, const pmt::pmt_t &msg)
+{
+    try
+        {
+            if (pmt::any_ref(msg).type().hash_code() == int_type_hash_code)
+                {
+                    const int tlm_event = wht::any_cast<int>(pmt::any_ref(msg));
+                    if (tlm_event == 1)
+                        {
+                            DLOG(INFO) << "Telemetry fault received in ch " << this->d_channel[slot];
+                            gr::thread::scoped_lock lock(d_setlock);
+                            d_carrier_lock_fail_counter[slot] = 200000;  // force loss-of-lock condition
+                        }
+                }
+        }
+    catch (const wht::bad_any_cast &e)
+        {
+            LOG(WARNING) << "msg_handler_telemetry_to_trk Bad any_cast: " << e.what();
+        }
+    catch (std::exception &ex)
+        {
+            LOG(WARNING) << "msg_handler_telemetry_to_trk Bad any_cast: " << ex.what();
+        }
+}
+
+
+void dll_pll_multichannel_tracking::set_channel(int32_t slot, uint32_t channel)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_channel[slot] = channel;
+    LOG(INFO) << "Tracking Channel set to " << channel << " (slot " << slot << ")";
+}
+
+
+void dll_pll_multichannel_tracking::set_gnss_synchro(int32_t slot, Gnss_Synchro *p_gnss_synchro)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    d_acquisition_gnss_synchro[slot] = p_gnss_synchro;
+}
+
+
+void dll_pll_multichannel_tracking::start_tracking(int32_t slot)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    const Gnss_Synchro *acquisition_gnss_synchro = d_acquisition_gnss_synchro[slot];
+    // correct the code phase according to the delay between acq and trk
+    d_acq_code_phase_samples[slot] = acquisition_gnss_synchro->Acq_delay_samples;
+    d_acq_sample_stamp[slot] = acquisition_gnss_synchro->Acq_samplestamp_samples;
+    d_carrier_doppler_hz[slot] = acquisition_gnss_synchro->Acq_doppler_hz;
+    d_carrier_phase_step_rad[slot] = TWO_PI * d_carrier_doppler_hz[slot] / d_trk_parameters.fs_in;
+
+    float *tracking_code = &d_tracking_code[slot * d_code_length_chips];
+    float *local_code_shift_chips = &d_local_code_shift_chips[slot * d_n_correlator_taps];
+    gps_l1_ca_code_gen_float(own::span<float>(tracking_code, d_code_length_chips), acquisition_gnss_synchro->PRN, 0);
+    local_code_shift_chips[0] = -d_trk_parameters.early_late_space_chips;
+    local_code_shift_chips[1] = 0.0;
+    local_code_shift_chips[2] = d_trk_parameters.early_late_space_chips;
+    if (d_state[slot] != 0)
+        {
+            d_correlator.release(slot);  // restarted before losing the lock
+        }
+    d_correlator.set_local_code_and_taps(slot, d_code_length_chips, tracking_code, local_code_shift_chips);
+    std::fill_n(&d_correlator_outs[slot * d_n_correlator_taps], d_n_correlator_taps, gr_complex(0.0, 0.0));
+
+    d_carrier_lock_fail_counter[slot] = 0;
+    d_code_lock_fail_counter[slot] = 0;
+    d_rem_code_phase_samples[slot] = 0.0;
+    d_rem_carr_phase_rad[slot] = 0.0;
+    d_rem_code_phase_chips[slot] = 0.0;
+    d_acc_carrier_phase_rad[slot] = 0.0;
+    d_cn0_estimation_counter[slot] = 0;
+    d_carrier_lock_test[slot] = 1.0;
+    d_CN0_SNV_dB_Hz[slot] = 0.0;
+    d_EVM[slot] = 0.0;
+
+    // Initialize tracking  ==========================================
+    d_carrier_loop_filter[slot].set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
+    d_code_loop_filter[slot].set_noise_bandwidth(d_trk_parameters.dll_bw_hz);
+    d_code_loop_filter[slot].set_update_interval(static_cast<float>(d_code_period));
+    // DLL/PLL filter initialization
+    d_carrier_loop_filter[slot].initialize(static_cast<float>(d_carrier_doppler_hz[slot]));  // initialize the carrier filter
+    d_code_loop_filter[slot].initialize();                                                   // initialize the code filter
+
+    // DEBUG OUTPUT
+    std::cout << "Tracking of GPS L1 C/A signal started on channel " << d_channel[slot] << " for satellite " << Gnss_Satellite("GPS", acquisition_gnss_synchro->PRN) << '\n';
+    DLOG(INFO) << "Starting tracking of satellite " << Gnss_Satellite("GPS", acquisition_gnss_synchro->PRN) << " on channel " << d_channel[slot];
+
+    // enable tracking pull-in
+    if (d_state[slot] == 0)
+        {
+            d_tracking_channels.fetch_add(1, std::memory_order_release);
+        }
+    d_state[slot] = 1;
+    d_pull_in_transitory[slot] = 1;
+    d_Prompt_circular_buffer[slot].clear();
+    d_acc_carrier_phase_initialized[slot] = 0;
+}
+
+
+void dll_pll_multichannel_tracking::stop_tracking(int32_t slot)
+{
+    gr::thread::scoped_lock l(d_setlock);
+    set_standby(slot);
+}
+
+
+void dll_pll_multichannel_tracking::set_standby(int32_t slot)
+{
+    if (d_state[slot] != 0)
+        {
+            d_state[slot] = 0;
+            d_correlator.release(slot);
+            d_tracking_channels.fetch_sub(1, std::memory_order_release);
+        }
+}
+
+
+bool dll_pll_multichannel_tracking::acquire_bit_synchronization(int32_t slot)
+{
+    // ******* preamble correlation ********
+    const boost::circular_buffer<gr_complex> &prompt_circular_buffer = d_Prompt_circular_buffer[slot];
+    int32_t corr_value = 0;
+    for (uint32_t i = 0; i < d_secondary_code_length; i++)
+        {
+            if (prompt_circular_buffer[i].real() < 0.0)  // symbols clipping
+                {
+                    corr_value += (d_secondary_code_string[i] == '0') ? 1 : -1;
+                }
+            else
+                {
+                    corr_value += (d_secondary_code_string[i] == '0') ? -1 : 1;
+                }
+        }
+
+    if (std::abs(corr_value) == static_cast<int32_t>(d_secondary_code_length))
+        {
+            d_Flag_PLL_180_deg_phase_locked[slot] = corr_value < 0 ? 1 : 0;
+            return true;
+        }
+
+    return false;
+}
+
+
+bool dll_pll_multichannel_tracking::cn0_and_tracking_lock_status(int32_t slot)
+{
+    // ####### CN0 ESTIMATION AND LOCK DETECTORS ######
+    gr_complex *prompt_buffer = &d_Prompt_buffer[slot * d_trk_parameters.cn0_samples];
+    const gr_complex prompt = d_correlator_outs[slot * d_n_correlator_taps + 1];
+    if (d_cn0_estimation_counter[slot] < d_trk_parameters.cn0_samples)
+        {
+            // fill buffer with prompt correlator output values
+            prompt_buffer[d_cn0_estimation_counter[slot]] = prompt;
+            d_cn0_estimation_counter[slot]++;
+            return true;
+        }
+
+    prompt_buffer[d_cn0_estimation_counter[slot] % d_trk_parameters.cn0_samples] = prompt;
+    d_cn0_estimation_counter[slot]++;
+    // Code lock indicator
+    const float CN0_SNV_dB_Hz_raw = cn0_m2m4_estimator(prompt_buffer, d_trk_parameters.cn0_samples, static_cast<float>(d_code_period));
+    d_CN0_SNV_dB_Hz[slot] = d_cn0_smoother[slot].smooth(CN0_SNV_dB_Hz_raw);
+    // Carrier lock indicator
+    d_carrier_lock_test[slot] = d_carrier_lock_test_smoother[slot].smooth(carrier_lock_detector(prompt_buffer, 1));
+    // Loss of lock detection
+    if (!d_pull_in_transitory[slot])
+        {
+            if (d_carrier_lock_test[slot] < d_carrier_lock_threshold)
+                {
+                    d_carrier_lock_fail_counter[slot]++;
+                }
+            else if (d_carrier_lock_fail_counter[slot] > 0)
+                {
+                    d_carrier_lock_fail_counter[slot]--;
+                }
+
+            if (d_CN0_SNV_dB_Hz[slot] < d_trk_parameters.cn0_min)
+                {
+                    d_code_lock_fail_counter[slot]++;
+                }
+            else if (d_code_lock_fail_counter[slot] > 0)
+                {
+                    d_code_lock_fail_counter[slot]--;
+                }
+        }
+    if (d_carrier_lock_fail_counter[slot] > d_trk_parameters.max_carrier_lock_fail or d_code_lock_fail_counter[slot] > d_trk_parameters.max_code_lock_fail)
+        {
+            std::cout << "Loss of lock in channel " << d_channel[slot] << "!\n";
+            LOG(INFO) << "Loss of lock in channel " << d_channel[slot]
+                      << " (carrier_lock_fail_counter:" << d_carrier_lock_fail_counter[slot]
+                      << " code_lock_fail_counter : " << d_code_lock_fail_counter[slot] << ")";
+            this->message_port_pub(d_events_port[slot], pmt::from_long(3));  // 3 -> loss of lock
+            d_carrier_lock_fail_counter[slot] = 0;
+            d_code_lock_fail_counter[slot] = 0;
+            return false;
+        }
+
+    // Error vector magnitude of the prompt buffer, as in dll_pll_veml_tracking
+    float sum = 0.0;
+    for (int32_t i = 0; i < d_trk_parameters.cn0_samples; i++)
+        {
+            sum += prompt_buffer[i].real() * prompt_buffer[i].real();
+        }
+    const float rms = std::sqrt(sum / static_cast<float>(d_trk_parameters.cn0_samples));
+    sum = 0.0;
+    for (int32_t i = 0; i < d_trk_parameters.cn0_samples; i++)
+        {
+            const float i_error = std::abs(prompt_buffer[i].real() / rms) - 1.0F;
+            const float q_error = std::abs(prompt_buffer[i].imag() / rms);
+            sum += i_error * i_error + q_error * q_error;
+        }
+    d_EVM[slot] = std::sqrt(sum / static_cast<float>(d_trk_parameters.cn0_samples));
+
+    return true;
+}
+
+
+void dll_pll_multichannel_tracking::run_dll_pll(int32_t slot)
+{
+    const gr_complex *correlator_outs = &d_correlator_outs[slot * d_n_correlator_taps];
+    const gr_complex early = correlator_outs[0];
+    const gr_complex prompt = correlator_outs[1];
+    const gr_complex late = correlator_outs[2];
+
+    // ################## PLL ##########################################################
+    // Costas loop discriminator, insensitive to 180 deg phase transitions
+    const double carr_phase_error_hz = pll_cloop_two_quadrant_atan(prompt) / TWO_PI;
+    double carr_error_filt_hz = 0.0;
+    const bool fll_pull_in = d_pull_in_transitory[slot] and d_trk_parameters.enable_fll_pull_in;
+    if (fll_pull_in or d_trk_parameters.enable_fll_steady_state)
+        {
+            // FLL discriminator
+            const double carr_freq_error_hz = fll_diff_atan(d_P_accu_old[slot], prompt, 0, d_code_period) / TWO_PI;
+            d_P_accu_old[slot] = prompt;
+            // Carrier discriminator filter. Pure FLL during the pull-in, FLL-aided PLL otherwise
+            carr_error_filt_hz = d_carrier_loop_filter[slot].get_carrier_error(static_cast<float>(carr_freq_error_hz),
+                fll_pull_in ? 0.0F : static_cast<float>(carr_phase_error_hz), static_cast<float>(d_code_period));
+        }
+    else
+        {
+            // Carrier discriminator filter
+            carr_error_filt_hz = d_carrier_loop_filter[slot].get_carrier_error(0, static_cast<float>(carr_phase_error_hz), static_cast<float>(d_code_period));
+        }
+
+    // New carrier Doppler frequency estimation
+    d_carrier_doppler_hz[slot] = carr_error_filt_hz;
+
+    // ################## DLL ##########################################################
+    // DLL discriminator
+    const double code_error_chips = dll_nc_e_minus_l_normalized(early, late, d_trk_parameters.spc, d_trk_parameters.slope, d_trk_parameters.y_intercept);  // [chips/Ti]
+    // Code discriminator filter
+    const double code_error_filt_chips = d_code_loop_filter[slot].apply(static_cast<float>(code_error_chips));  // [chips/second]
+    // New code Doppler frequency estimation
+    d_code_freq_chips[slot] = d_code_chip_rate - code_error_filt_chips;
+    if (d_trk_parameters.carrier_aiding)
+        {
+            d_code_freq_chips[slot] += d_carrier_doppler_hz[slot] * d_code_chip_rate / d_signal_carrier_freq;
+        }
+}
+
+
+void dll_pll_multichannel_tracking::update_tracking_vars(int32_t slot)
+{
+    const double T_chip_seconds = 1.0 / d_code_freq_chips[slot];
+    const double T_prn_seconds = T_chip_seconds * static_cast<double>(d_code_length_chips);
+
+    // ################## CARRIER AND CODE NCO BUFFER ALIGNMENT #######################
+    // Compute the next buffer length based in the new period of the PRN sequence and the code phase error estimation
+    const double T_prn_samples = T_prn_seconds * d_trk_parameters.fs_in;
+    const double K_blk_samples = T_prn_samples + d_rem_code_phase_samples[slot];
+    d_current_prn_length_samples[slot] = static_cast<int32_t>(std::floor(K_blk_samples));  // round to a discrete number of samples
+    const auto prn_length_samples = static_cast<double>(d_current_prn_length_samples[slot]);
+
+    // ################### PLL COMMANDS #################################################
+    // carrier phase step (NCO phase increment per sample) [rads/sample]
+    d_carrier_phase_step_rad[slot] = TWO_PI * d_carrier_doppler_hz[slot] / d_trk_parameters.fs_in;
+    // remnant carrier phase to prevent overflow in the code NCO
+    d_rem_carr_phase_rad[slot] += static_cast<float>(d_carrier_phase_step_rad[slot] * prn_length_samples);
+    d_rem_carr_phase_rad[slot] = static_cast<float>(std::fmod(d_rem_carr_phase_rad[slot], TWO_PI));
+    // carrier phase accumulator
+    d_acc_carrier_phase_rad[slot] -= d_carrier_phase_step_rad[slot] * prn_length_samples;
+
+    // ################### DLL COMMANDS #################################################
+    // code phase step (Code resampler phase increment per sample) [chips/sample]
+    d_code_phase_step_chips[slot] = d_code_freq_chips[slot] / d_trk_parameters.fs_in;
+    // remnant code phase [chips]
+    d_rem_code_phase_samples[slot] = K_blk_samples - prn_length_samples;  // rounding error < 1 sample
+    d_rem_code_phase_chips[slot] = d_code_freq_chips[slot] * d_rem_code_phase_samples[slot] / d_trk_parameters.fs_in;
+}
+
+
+void dll_pll_multichannel_tracking::clear_tracking_vars(int32_t slot)
+{
+    std::fill_n(&d_correlator_outs[slot * d_n_correlator_taps], d_n_correlator_taps, gr_complex(0.0, 0.0));
+    d_P_accu_old[slot] = gr_complex(0.0, 0.0);
+    d_P_data_accu[slot] = gr_complex(0.0, 0.0);
+    d_current_data_symbol[slot] = 0;
+    d_Prompt_circular_buffer[slot].clear();
+}
+
+
+void dll_pll_multichannel_tracking::pull_in(int32_t slot, uint64_t first_sample)
+{
+    // Signal alignment (skip samples until the incoming signal is aligned with local replica)
+    const int64_t acq_trk_diff_samples = static_cast<int64_t>(first_sample) - static_cast<int64_t>(d_acq_sample_stamp[slot]);
+    const double acq_trk_diff_seconds = static_cast<double>(acq_trk_diff_samples) / d_trk_parameters.fs_in;
+    const double delta_trk_to_acq_prn_start_samples = static_cast<double>(acq_trk_diff_samples) - d_acq_code_phase_samples[slot];
+
+    d_code_freq_chips[slot] = d_code_chip_rate;
+    d_code_phase_step_chips[slot] = d_code_freq_chips[slot] / d_trk_parameters.fs_in;
+    const double T_chip_mod_seconds = 1.0 / d_code_freq_chips[slot];
+    const double T_prn_mod_seconds = T_chip_mod_seconds * static_cast<double>(d_code_length_chips);
+    const double T_prn_mod_samples = T_prn_mod_seconds * d_trk_parameters.fs_in;
+
+    d_acq_code_phase_samples[slot] = T_prn_mod_samples - std::fmod(delta_trk_to_acq_prn_start_samples, T_prn_mod_samples);
+    d_current_prn_length_samples[slot] = static_cast<int32_t>(std::round(T_prn_mod_samples));
+
+    const auto samples_offset = static_cast<int32_t>(std::round(d_acq_code_phase_samples[slot]));
+    d_acc_carrier_phase_rad[slot] -= d_carrier_phase_step_rad[slot] * static_cast<double>(samples_offset);
+    d_state[slot] = 2;
+    d_cn0_smoother[slot].reset();
+    d_carrier_lock_test_smoother[slot].reset();
+
+    LOG(INFO) << "Number of samples between Acquisition and Tracking = " << acq_trk_diff_samples << " ( " << acq_trk_diff_seconds << " s)";
+    DLOG(INFO) << "PULL-IN Doppler [Hz] = " << d_carrier_doppler_hz[slot]
+               << ". PULL-IN Code Phase [samples] = " << d_acq_code_phase_samples[slot];
+
+    // the first epoch starts at the local replica alignment
+    d_epoch_start[slot] = first_sample + static_cast<uint64_t>(samples_offset);
+    schedule_epoch(slot);
+}
+
+
+void dll_pll_multichannel_tracking::schedule_epoch(int32_t slot)
+{
+    d_correlator.set_epoch(slot, &d_correlator_outs[slot * d_n_correlator_taps], d_epoch_start[slot], static_cast<int>(d_trk_parameters.vector_length),
+        d_rem_carr_phase_rad[slot], static_cast<float>(d_carrier_phase_step_rad[slot]), 0.0F,
+        static_cast<float>(d_rem_code_phase_chips[slot]), static_cast<float>(d_code_phase_step_chips[slot]), 0.0F);
+}
+
+
+bool dll_pll_multichannel_tracking::end_epoch(int32_t slot, Gnss_Synchro &synchro)
+{
+    const uint64_t epoch_start = d_epoch_start[slot];
+    const Gnss_Synchro *acquisition_gnss_synchro = d_acquisition_gnss_synchro[slot];
+    bool output = false;
+    bool loss_of_lock = false;
+
+    if (d_pull_in_transitory[slot] and d_trk_parameters.pull_in_time_s < (epoch_start - d_acq_sample_stamp[slot]) / static_cast<int>(d_trk_parameters.fs_in))
+        {
+            d_pull_in_transitory[slot] = 0;
+            d_carrier_lock_fail_counter[slot] = 0;
+            d_code_lock_fail_counter[slot] = 0;
+        }
+
+    // fail-safe: check if the bit synchronization has not succeeded in a limited time period
+    if (d_state[slot] == 2 and d_trk_parameters.bit_synchronization_time_limit_s < (epoch_start - d_acq_sample_stamp[slot]) / static_cast<int>(d_trk_parameters.fs_in))
+        {
+            d_carrier_lock_fail_counter[slot] = 300000;  // force loss-of-lock condition
+            LOG(INFO) << "GPS L1 C/A tracking synchronization time limit reached in channel " << d_channel[slot]
+                      << " for satellite " << Gnss_Satellite("GPS", acquisition_gnss_synchro->PRN) << '\n';
+        }
+
+    // Check lock status
+    if (!cn0_and_tracking_lock_status(slot))
+        {
+            clear_tracking_vars(slot);
+            set_standby(slot);                                  // loss-of-lock detected
+            loss_of_lock = true;                                // Set the flag so that the negative indication can be generated
+            synchro = *acquisition_gnss_synchro;                // Fill in the Gnss_Synchro object with basic info
+        }
+    else
+        {
+            const gr_complex prompt = d_correlator_outs[slot * d_n_correlator_taps + 1];
+            // Perform DLL/PLL tracking loop computations. Costas Loop enabled
+            run_dll_pll(slot);
+            update_tracking_vars(slot);
+            if (d_state[slot] == 2)
+                {
+                    // Signal does not have secondary code. Search a bit transition by sign change
+                    if (!d_pull_in_transitory[slot])
+                        {
+                            d_Prompt_circular_buffer[slot].push_back(prompt);
+                            if (d_Prompt_circular_buffer[slot].size() == d_secondary_code_length and acquire_bit_synchronization(slot))
+                                {
+                                    LOG(INFO) << "GPS L1 C/A tracking bit synchronization locked in channel " << d_channel[slot]
+                                              << " for satellite " << Gnss_Satellite("GPS", acquisition_gnss_synchro->PRN) << '\n';
+                                    std::cout << "GPS L1 C/A tracking bit synchronization locked in channel " << d_channel[slot]
+                                              << " for satellite " << Gnss_Satellite("GPS", acquisition_gnss_synchro->PRN) << '\n';
+                                    d_P_data_accu[slot] = gr_complex(0.0, 0.0);
+                                    d_Prompt_circular_buffer[slot].clear();
+                                    d_current_data_symbol[slot] = 0;
+                                    d_state[slot] = 4;
+                                }
+                        }
+                }
+            else
+                {
+                    if (d_acc_carrier_phase_initialized[slot] == 0)
+                        {
+                            d_acc_carrier_phase_rad[slot] = -d_rem_carr_phase_rad[slot];
+                            d_acc_carrier_phase_initialized[slot] = 1;
+                        }
+                    // symbol integration: 20 trk symbols (20 ms) = 1 tlm bit
+                    d_P_data_accu[slot] += prompt;
+                    d_current_data_symbol[slot]++;
+                    d_current_data_symbol[slot] %= d_symbols_per_bit;
+                    if (d_current_data_symbol[slot] == 0)
+                        {
+                            // ########### Output the tracking results to Telemetry block ##########
+                            // Fill the acquisition data
+                            synchro = *acquisition_gnss_synchro;
+                            synchro.Prompt_I = static_cast<double>(d_P_data_accu[slot].real());
+                            synchro.Prompt_Q = static_cast<double>(d_P_data_accu[slot].imag());
+                            synchro.Code_phase_samples = d_rem_code_phase_samples[slot];
+                            synchro.Carrier_phase_rads = d_acc_carrier_phase_rad[slot];
+                            synchro.Carrier_Doppler_hz = d_carrier_doppler_hz[slot];
+                            synchro.CN0_dB_hz = d_CN0_SNV_dB_Hz[slot];
+                            synchro.correlation_length_ms = d_correlation_length_ms;
+                            synchro.EVM = d_EVM[slot];
+                            d_P_data_accu[slot] = gr_complex(0.0, 0.0);
+                            output = true;
+                        }
+                }
+        }
+
+    // the next epoch starts where the local replica of this one ends
+    d_epoch_start[slot] = epoch_start + static_cast<uint64_t>(d_current_prn_length_samples[slot]);
+    if (output or loss_of_lock)
+        {
+            synchro.fs = static_cast<int64_t>(d_trk_parameters.fs_in);
+            // stamped with the first sample of the correlated epoch, as dll_pll_veml_tracking does
+            synchro.Tracking_sample_counter = epoch_start;
+            synchro.Flag_valid_symbol_output = !loss_of_lock;
+            synchro.Flag_PLL_180_deg_phase_locked = d_Flag_PLL_180_deg_phase_locked[slot] != 0;
+            return true;
+        }
+    return false;
+}
+
+
+bool dll_pll_multichannel_tracking::output_space(int32_t noutput_items, int32_t n_outputs, uint64_t window_end) const
+{
+    // A channel writes at most one item per window, when its epoch ends inside it
+    for (int32_t slot = 0; slot < n_outputs; slot++)
+        {
+            if ((d_state[slot] == 2 or d_state[slot] == 4) and d_produced[slot] >= noutput_items and
+                d_epoch_start[slot] + d_trk_parameters.vector_length <= window_end)
+                {
+                    return false;
+                }
+        }
+    return true;
+}
+
+
+int dll_pll_multichannel_tracking::general_work(int noutput_items, gr_vector_int &ninput_items,
+    gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
+{
+    if (d_tracking_channels.load(std::memory_order_acquire) == 0)
+        {
+            // Standby: drop the samples at full throttle. start_tracking()
+            // aligns to the acquisition sample stamp from nitems_read(0)
+            consume_each(ninput_items[0]);
+            return 0;
+        }
+    gr::thread::scoped_lock l(d_setlock);
+    const auto *in = static_cast<const gr_complex *>(input_items[0]);
+    auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
+    const int32_t n_outputs = std::min(d_used_channels, static_cast<int32_t>(output_items.size()));
+    const uint64_t first_sample = this->nitems_read(0);
+    std::fill(d_produced.begin(), d_produced.end(), 0);
+
+    // The input is walked in windows shorter than an epoch, so each channel
+    // ends at most one epoch, and writes at most one item, per window
+    int32_t consumed = 0;
+    while (consumed + d_window_samples <= ninput_items[0])
+        {
+            const uint64_t window_start = first_sample + static_cast<uint64_t>(consumed);
+            const uint64_t window_end = window_start + static_cast<uint64_t>(d_window_samples);
+            if (!output_space(noutput_items, n_outputs, window_end))
+                {
+                    break;
+                }
+            for (int32_t slot = 0; slot < n_outputs; slot++)
+                {
+                    if (d_state[slot] == 1)
+                        {
+                            pull_in(slot, window_start);
+                        }
+                }
+            // An epoch that ends inside the window schedules the next one,
+            // which starts inside it too, so the window is walked again for
+            // the samples that the new epochs have not correlated yet
+            bool rescheduled = true;
+            while (rescheduled)
+                {
+                    rescheduled = false;
+                    d_correlator.correlate(&in[consumed], window_start, d_window_samples);
+                    for (int32_t slot = 0; slot < n_outputs; slot++)
+                        {
+                            if ((d_state[slot] != 2 and d_state[slot] != 4) or !d_correlator.epoch_done(slot))
+                                {
+                                    continue;
+                                }
+                            Gnss_Synchro current_synchro_data = Gnss_Synchro();
+                            if (end_epoch(slot, current_synchro_data))
+                                {
+                                    out[slot][d_produced[slot]] = current_synchro_data;
+                                    d_produced[slot]++;
+                                }
+                            if (d_state[slot] != 0)
+                                {
+                                    schedule_epoch(slot);
+                                    rescheduled = rescheduled or d_epoch_start[slot] < window_end;
+                                }
+                        }
+                }
+            consumed += d_window_samples;
+        }
+
+    consume_each(consumed);
+    for (int32_t slot = 0; slot < n_outputs; slot++)
+        {
+            produce(slot, d_produced[slot]);
+        }
+    return WORK_CALLED_PRODUCE;
+}
@@ -0,0 +1,171 @@
+/*!
+ * \file dll_pll_multichannel_tracking.h
+ * \brief Code DLL + carrier PLL tracking block hosting several GPS L1 C/A
+ * channels on one pass over the input samples.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_DLL_PLL_MULTICHANNEL_TRACKING_H
+#define GNSS_SDR_DLL_PLL_MULTICHANNEL_TRACKING_H
+
+#include "cpu_multicorrelator_batch.h"
+#include "dll_pll_conf.h"
+#include "exponential_smoother.h"
+#include "gnss_block_interface.h"
+#include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
+#include "tracking_loop_filter.h"     // for DLL filter
+#include <boost/circular_buffer.hpp>
+#include <gnuradio/block.h>                   // for block
+#include <gnuradio/gr_complex.h>              // for gr_complex
+#include <gnuradio/types.h>                   // for gr_vector_int, gr_vector...
+#include <pmt/pmt.h>                          // for pmt_t
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <atomic>                             // for atomic
+#include <cstddef>                            // for size_t
+#include <cstdint>                            // for int32_t
+#include <string>                             // for string
+#include <typeinfo>                           // for typeid
+#include <vector>                             // for vector
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_gnuradio_blocks
+ * \{ */
+
+
+class Gnss_Synchro;
+class dll_pll_multichannel_tracking;
+
+using dll_pll_multichannel_tracking_sptr = gnss_shared_ptr<dll_pll_multichannel_tracking>;
+
+dll_pll_multichannel_tracking_sptr dll_pll_multichannel_make_tracking(const Dll_Pll_Conf &conf_, int32_t n_channels);
+
+/*!
+ * \brief Code DLL + carrier PLL tracking of up to n_channels GPS L1 C/A
+ * channels sharing one input stream.
+ *
+ * Each channel takes a slot, returned by add_channel(). The slot is the
+ * output port of its Gnss_Synchro items, and the suffix of its message ports
+ * "events_<slot>" and "telemetry_to_trk_<slot>". The channel states are kept
+ * in struct-of-arrays form, and the correlations of all the channels are
+ * computed by Cpu_Multicorrelator_Batch, which reads each input sample once
+ * for all of them. The loops, the lock detectors and the outputs follow
+ * dll_pll_veml_tracking for GPS L1 C/A with 1 ms coherent integrations.
+ * Extended integrations, the high dynamics resampler, the Doppler correction,
+ * the dump files and the time tags are not available.
+ */
+class dll_pll_multichannel_tracking : public gr::block
+{
+public:
+    ~dll_pll_multichannel_tracking() override = default;
+
+    int32_t add_channel();  //!< Reserves the next free slot. Returns -1 if all the slots are taken
+
+    void set_channel(int32_t slot, uint32_t channel);
+    void set_gnss_synchro(int32_t slot, Gnss_Synchro *p_gnss_synchro);
+    void start_tracking(int32_t slot);
+    void stop_tracking(int32_t slot);
+
+    int general_work(int noutput_items, gr_vector_int &ninput_items,
+        gr_vector_const_void_star &input_items, gr_vector_void_star &output_items) override;
+
+    void forecast(int noutput_items, gr_vector_int &ninput_items_required) override;
+
+private:
+    friend dll_pll_multichannel_tracking_sptr dll_pll_multichannel_make_tracking(const Dll_Pll_Conf &conf_, int32_t n_channels);
+    dll_pll_multichannel_tracking(const Dll_Pll_Conf &conf_, int32_t n_channels);
+
+    void msg_handler_telemetry_to_trk(int32_t slot, const pmt::pmt_t &msg);
+    void pull_in(int32_t slot, uint64_t first_sample);
+    void schedule_epoch(int32_t slot);
+    bool end_epoch(int32_t slot, Gnss_Synchro &synchro);
+    void run_dll_pll(int32_t slot);
+    void update_tracking_vars(int32_t slot);
+    void clear_tracking_vars(int32_t slot);
+    void set_standby(int32_t slot);
+    bool cn0_and_tracking_lock_status(int32_t slot);
+    bool acquire_bit_synchronization(int32_t slot);
+    bool output_space(int32_t noutput_items, int32_t n_outputs, uint64_t window_end) const;
+
+    Cpu_Multicorrelator_Batch d_correlator;
+
+    Dll_Pll_Conf d_trk_parameters;
+
+    // Per-channel state, struct-of-arrays
+    std::vector<Gnss_Synchro *> d_acquisition_gnss_synchro;
+    std::vector<Exponential_Smoother> d_cn0_smoother;
+    std::vector<Exponential_Smoother> d_carrier_lock_test_smoother;
+    std::vector<Tracking_loop_filter> d_code_loop_filter;
+    std::vector<Tracking_FLL_PLL_filter> d_carrier_loop_filter;
+    std::vector<boost::circular_buffer<gr_complex>> d_Prompt_circular_buffer;
+    std::vector<pmt::pmt_t> d_events_port;
+
+    volk_gnsssdr::vector<float> d_tracking_code;           // n_channels x code length
+    volk_gnsssdr::vector<float> d_local_code_shift_chips;  // n_channels x taps
+    volk_gnsssdr::vector<gr_complex> d_correlator_outs;    // n_channels x taps
+    volk_gnsssdr::vector<gr_complex> d_Prompt_buffer;      // n_channels x cn0_samples
+
+    std::vector<double> d_acq_code_phase_samples;
+    std::vector<double> d_carrier_doppler_hz;
+    std::vector<double> d_code_freq_chips;
+    std::vector<double> d_acc_carrier_phase_rad;
+    std::vector<double> d_rem_code_phase_chips;
+    std::vector<double> d_rem_code_phase_samples;
+    std::vector<double> d_carrier_phase_step_rad;
+    std::vector<double> d_code_phase_step_chips;
+    std::vector<double> d_carrier_lock_test;
+    std::vector<double> d_CN0_SNV_dB_Hz;
+    std::vector<double> d_EVM;
+    std::vector<float> d_rem_carr_phase_rad;
+    std::vector<gr_complex> d_P_accu_old;
+    std::vector<gr_complex> d_P_data_accu;
+    std::vector<uint64_t> d_acq_sample_stamp;
+    std::vector<uint64_t> d_epoch_start;  // absolute sample of the epoch in progress
+    std::vector<int32_t> d_state;
+    std::vector<int32_t> d_current_prn_length_samples;
+    std::vector<int32_t> d_current_data_symbol;
+    std::vector<int32_t> d_cn0_estimation_counter;
+    std::vector<int32_t> d_carrier_lock_fail_counter;
+    std::vector<int32_t> d_code_lock_fail_counter;
+    std::vector<int32_t> d_produced;  // items written to each output port in the current general_work() call
+    std::vector<uint32_t> d_channel;
+    std::vector<uint8_t> d_pull_in_transitory;
+    std::vector<uint8_t> d_acc_carrier_phase_initialized;
+    std::vector<uint8_t> d_Flag_PLL_180_deg_phase_locked;
+
+    const size_t int_type_hash_code = typeid(int).hash_code();
+
+    std::string d_secondary_code_string;
+
+    double d_signal_carrier_freq;
+    double d_code_period;
+    double d_code_chip_rate;
+    double d_carrier_lock_threshold;
+
+    int32_t d_n_channels;
+    int32_t d_used_channels;
+    int32_t d_n_correlator_taps;
+    int32_t d_code_length_chips;
+    int32_t d_symbols_per_bit;
+    int32_t d_correlation_length_ms;
+    int32_t d_window_samples;  // samples walked by the correlator between two loop updates, shorter than an epoch
+    uint32_t d_secondary_code_length;
+
+    // Number of slots out of standby. general_work() consumes the samples
+    // without taking d_setlock while it is zero
+    std::atomic<int32_t> d_tracking_channels{0};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_DLL_PLL_MULTICHANNEL_TRACKING_H
@@ -43,8 +43,11 @@
 #include "gps_l2c_signal_replica.h"
 #include "gps_l5_signal_replica.h"
 #include "gps_sdr_signal_replica.h"
+#include "item_type_helpers.h"
 #include "lock_detectors.h"
 #include "tracking_discriminators.h"
+#include "tracking_dump_records.h"
+#include "tracking_epoch_grid.h"
 #include <glog/logging.h>
 #include <gnuradio/io_signature.h>   // for io_signature
 #include <gnuradio/thread/thread.h>  // for scoped_lock
@@ -55,6 +58,7 @@
 #include <array>
 #include <cmath>      // for fmod, round, floor
 #include <exception>  // for exception
+#include <fstream>    // for ifstream
 #include <iostream>   // for cout, cerr
 #include <map>
 #include <memory>
@@ -81,7 +85,7 @@ dll_pll_veml_tracking_sptr dll_pll_veml_make_tracking(const Dll_Pll_Conf &conf_)
 
 
 dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
-    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, sizeof(gr_complex)),
+    : gr::block("dll_pll_veml_tracking", gr::io_signature::make(1, 1, item_type_size(conf_.item_type)),
           gr::io_signature::make(1, 1, sizeof(Gnss_Synchro))),
       d_trk_parameters(conf_),
       d_acquisition_gnss_synchro(nullptr),
@@ -105,11 +109,13 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_code_phase_rate_step_chips(0.0),
       d_rem_code_phase_samples(0.0),  // Residual code phase (in chips)
       d_acq_sample_stamp(0ULL),
+      d_loop_update_sample(0ULL),
       d_rem_carr_phase_rad(0.0),  // Residual carrier phase
       d_state(0),                 // initial state: standby
       d_current_prn_length_samples(static_cast<int32_t>(d_trk_parameters.vector_length)),
       d_extend_correlation_symbols_count(0),
       d_extend_correlation_symbols(d_trk_parameters.extend_correlation_symbols),
+      d_extend_correlation_symbols_cycle(d_trk_parameters.extend_correlation_symbols),
       d_cn0_estimation_counter(0),
       d_carrier_lock_fail_counter(0),
       d_code_lock_fail_counter(0),
@@ -124,7 +130,11 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
       d_dump(d_trk_parameters.dump),
       d_dump_mat(d_trk_parameters.dump_mat && d_dump),
       d_acc_carrier_phase_initialized(false),
+      d_aligned_epochs(false),
       d_Flag_PLL_180_deg_phase_locked(false),
+      d_cshort(d_trk_parameters.item_type == "cshort"),
+      d_cbyte(d_trk_parameters.item_type == "cbyte"),
+      d_batch_pilot_data(d_trk_parameters.track_pilot && !d_cshort && !d_cbyte),
 	  d_EVM(0.0)
 {
     // prevent telemetry symbols accumulation in output buffers
@@ -148,6 +158,14 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
 #endif
 #endif
 
+    // integer samples are correlated by the fused resampler kernels, which
+    // follow a constant code and carrier phase step within each epoch
+    if ((d_cshort || d_cbyte) && d_trk_parameters.high_dyn)
+        {
+            LOG(WARNING) << "High dynamics tracking is not available for " << d_trk_parameters.item_type << " samples. Disabled.";
+            d_trk_parameters.high_dyn = false;
+        }
+
     // initialize internal vars
     d_dll_filt_history.set_capacity(1000);
     d_signal_type = std::string(d_trk_parameters.signal);
@@ -507,7 +525,16 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_prompt_data_shift = &d_local_code_shift_chips[1];
         }
 
-    d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+    if (d_batch_pilot_data)
+        {
+            // Pilot taps (channel 0) and data prompt (channel 1) correlated in one pass over the samples
+            d_pilot_data_correlator.init(2, d_n_correlator_taps);
+            d_pilot_data_correlator.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+        }
+    else
+        {
+            d_multicorrelator_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), d_n_correlator_taps);
+        }
 
     if (d_trk_parameters.extend_correlation_symbols > 1)
         {
@@ -519,12 +546,24 @@ dll_pll_veml_tracking::dll_pll_veml_tracking(const Dll_Pll_Conf &conf_)
             d_trk_parameters.extend_correlation_symbols = 1;
         }
 
+    // Shortened integrations keep the secondary code wipe-off of the pilot
+    // component, but they would break the navigation bits of data tracking
+    d_aligned_epochs = d_trk_parameters.aligned_integration_epochs && d_enable_extended_integration && d_secondary && d_trk_parameters.track_pilot;
+    if (d_trk_parameters.aligned_integration_epochs && !d_aligned_epochs)
+        {
+            LOG(WARNING) << "aligned_integration_epochs is ignored for " << d_systemName << " " << d_signal_pretty_name
+                         << ", it requires extend_correlation_symbols greater than 1 and the tracking of a pilot component with a secondary code";
+        }
+
     // Enable Data component prompt correlator (slave to Pilot prompt) if tracking uses Pilot signal
     if (d_trk_parameters.track_pilot)
         {
             // Extra correlator for the data component
-            d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
-            d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+            if (!d_batch_pilot_data)
+                {
+                    d_correlator_data_cpu.init(static_cast<int>(2 * d_trk_parameters.vector_length), 1);
+                    d_correlator_data_cpu.set_high_dynamics_resampler(d_trk_parameters.high_dyn);
+                }
             d_data_code.resize(2 * d_code_length_chips, 0.0);
         }
 
@@ -831,6 +870,12 @@ void dll_pll_veml_tracking::start_tracking()
         }
 
     d_multicorrelator_cpu.set_local_code_and_taps(d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+    if (d_batch_pilot_data)
+        {
+            // the data codes have the length of the pilot codes
+            d_pilot_data_correlator.set_local_code_and_taps(0, d_code_samples_per_chip * d_code_length_chips, d_tracking_code.data(), d_local_code_shift_chips.data());
+            d_pilot_data_correlator.set_local_code_and_taps(1, d_code_samples_per_chip * d_code_length_chips, d_data_code.data(), d_prompt_data_shift, 1);
+        }
     std::fill_n(d_correlator_outs.begin(), d_n_correlator_taps, gr_complex(0.0, 0.0));
 
     d_carrier_lock_fail_counter = 0;
@@ -858,6 +903,7 @@ void dll_pll_veml_tracking::start_tracking()
         }
 
     d_current_correlation_time_s = d_code_period;
+    d_extend_correlation_symbols_cycle = d_extend_correlation_symbols;
 
     // Initialize tracking  ==========================================
     d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_hz, d_trk_parameters.pll_filter_order);
@@ -883,11 +929,11 @@ void dll_pll_veml_tracking::start_tracking()
 
 dll_pll_veml_tracking::~dll_pll_veml_tracking()
 {
-    if (d_dump_file.is_open())
+    if (d_dump_writer.is_open())
         {
             try
                 {
-                    d_dump_file.close();
+                    d_dump_writer.close();
                 }
             catch (const std::exception &ex)
                 {
@@ -1061,11 +1107,44 @@ bool dll_pll_veml_tracking::cn0_and_tracking_lock_status(double coh_integration_
 // - updated remnant code phase in samples (d_rem_code_phase_samples)
 // - d_code_freq_chips
 // - d_carrier_doppler_hz
-void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
+void dll_pll_veml_tracking::set_correlator_input(Cpu_Multicorrelator_Real_Codes &correlator, gr_complex *corr_out, const void *input_samples) const
+{
+    if (d_cshort)
+        {
+            correlator.set_input_output_vectors(corr_out, static_cast<const lv_16sc_t *>(input_samples));
+        }
+    else if (d_cbyte)
+        {
+            correlator.set_input_output_vectors(corr_out, static_cast<const lv_8sc_t *>(input_samples));
+        }
+    else
+        {
+            correlator.set_input_output_vectors(corr_out, static_cast<const gr_complex *>(input_samples));
+        }
+}
+
+
+void dll_pll_veml_tracking::do_correlation_step(const void *input_samples)
 {
     // ################# CARRIER WIPEOFF AND CORRELATORS ##############################
+    if (d_batch_pilot_data)
+        {
+            // Early, Prompt and Late of the pilot and Prompt of the data, reading the samples once
+            const auto rem_code_phase = static_cast<float>(d_rem_code_phase_chips) * static_cast<float>(d_code_samples_per_chip);
+            const auto code_phase_step = static_cast<float>(d_code_phase_step_chips) * static_cast<float>(d_code_samples_per_chip);
+            const auto code_phase_rate_step = static_cast<float>(d_code_phase_rate_step_chips) * static_cast<float>(d_code_samples_per_chip);
+            d_pilot_data_correlator.set_epoch(0, d_correlator_outs.data(), 0, d_trk_parameters.vector_length,
+                d_rem_carr_phase_rad, static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                rem_code_phase, code_phase_step, code_phase_rate_step);
+            d_pilot_data_correlator.set_epoch(1, d_Prompt_Data.data(), 0, d_trk_parameters.vector_length,
+                d_rem_carr_phase_rad, static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
+                rem_code_phase, code_phase_step, code_phase_rate_step);
+            d_pilot_data_correlator.correlate(static_cast<const gr_complex *>(input_samples), 0, d_trk_parameters.vector_length);
+            return;
+        }
+
     // perform carrier wipe-off and compute Early, Prompt and Late correlation
-    d_multicorrelator_cpu.set_input_output_vectors(d_correlator_outs.data(), input_samples);
+    set_correlator_input(d_multicorrelator_cpu, d_correlator_outs.data(), input_samples);
     d_multicorrelator_cpu.Carrier_wipeoff_multicorrelator_resampler(
         d_rem_carr_phase_rad,
         static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
@@ -1077,7 +1156,7 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
     // DATA CORRELATOR (if tracking tracks the pilot signal)
     if (d_trk_parameters.track_pilot)
         {
-            d_correlator_data_cpu.set_input_output_vectors(d_Prompt_Data.data(), input_samples);
+            set_correlator_input(d_correlator_data_cpu, d_Prompt_Data.data(), input_samples);
             d_correlator_data_cpu.Carrier_wipeoff_multicorrelator_resampler(
                 d_rem_carr_phase_rad,
                 static_cast<float>(d_carrier_phase_step_rad), static_cast<float>(d_carrier_phase_rate_step_rad),
@@ -1089,6 +1168,25 @@ void dll_pll_veml_tracking::do_correlation_step(const gr_complex *input_samples)
 }
 
 
+int32_t dll_pll_veml_tracking::schedule_extended_integration()
+{
+    // Sets the length of the next extended integration. Returns the next state.
+    int32_t symbols = d_extend_correlation_symbols;
+    if (d_aligned_epochs)
+        {
+            const uint64_t next_prn_start_sample = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
+            symbols = aligned_integration_symbols(next_prn_start_sample, d_code_period * d_trk_parameters.fs_in, d_extend_correlation_symbols);
+        }
+    d_current_correlation_time_s = static_cast<double>(symbols) * d_code_period;
+    if (symbols != d_extend_correlation_symbols_cycle || d_state == 2)
+        {
+            d_extend_correlation_symbols_cycle = symbols;
+            d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
+        }
+    return symbols > 1 ? 3 : 4;
+}
+
+
 void dll_pll_veml_tracking::run_dll_pll()
 {
     // ################## PLL ##########################################################
@@ -1404,106 +1502,67 @@ void dll_pll_veml_tracking::log_data()
 {
     if (d_dump)
         {
-            // Dump results to file
-            float prompt_I;
-            float prompt_Q;
-            float tmp_VE;
-            float tmp_E;
-            float tmp_P;
-            float tmp_L;
-            float tmp_VL;
-            float tmp_float;
-            double tmp_double;
-            uint64_t tmp_long_int;
-            if (d_trk_parameters.track_pilot)
+            // Dump results to file. The record is written by a background thread
+            Dll_Pll_Veml_Dump_Record record{};
+            if (d_veml)
                 {
-                    prompt_I = d_Prompt_Data.data()->real();
-                    prompt_Q = d_Prompt_Data.data()->imag();
+                    record.abs_VE = std::abs<float>(d_VE_accu);
+                    record.abs_VL = std::abs<float>(d_VL_accu);
                 }
             else
                 {
-                    prompt_I = d_Prompt->real();
-                    prompt_Q = d_Prompt->imag();
+                    record.abs_VE = 0.0;
+                    record.abs_VL = 0.0;
                 }
-            if (d_veml)
+            // Dump correlators output
+            record.abs_E = std::abs<float>(d_E_accu);
+            record.abs_P = std::abs<float>(d_P_accu);
+            record.abs_L = std::abs<float>(d_L_accu);
+            // PROMPT I and Q (to analyze navigation symbols)
+            if (d_trk_parameters.track_pilot)
                 {
-                    tmp_VE = std::abs<float>(d_VE_accu);
-                    tmp_VL = std::abs<float>(d_VL_accu);
+                    record.Prompt_I = d_Prompt_Data.data()->real();
+                    record.Prompt_Q = d_Prompt_Data.data()->imag();
                 }
             else
                 {
-                    tmp_VE = 0.0;
-                    tmp_VL = 0.0;
-                }
-            tmp_E = std::abs<float>(d_E_accu);
-            tmp_P = std::abs<float>(d_P_accu);
-            tmp_L = std::abs<float>(d_L_accu);
-            
-            try
-                {
-                    // Dump correlators output
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VE), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_E), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_P), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_L), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_VL), sizeof(float));
-                    // PROMPT I and Q (to analyze navigation symbols)
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_I), sizeof(float));
-                    d_dump_file.write(reinterpret_cast<char *>(&prompt_Q), sizeof(float));
-                    // PRN start sample stamp
-                    tmp_long_int = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_long_int), sizeof(uint64_t));
-                    // accumulated carrier phase
-                    tmp_float = static_cast<float>(d_acc_carrier_phase_rad);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier and code frequency
-                    tmp_float = static_cast<float>(d_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // carrier phase rate [Hz/s]
-                    tmp_float = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_freq_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // code phase rate [chips/s^2]
-                    tmp_float = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // PLL commands
-                    tmp_float = static_cast<float>(d_carr_phase_error_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carr_error_filt_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // DLL commands
-                    tmp_float = static_cast<float>(d_code_error_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_code_error_filt_chips);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // CN0 and carrier lock test
-                    tmp_float = static_cast<float>(d_CN0_SNV_dB_Hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_carrier_lock_test);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // AUX vars (for debug purposes)
-                    tmp_float = static_cast<float>(d_rem_code_phase_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_double = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_double), sizeof(double));
-                    // PRN
-                    uint32_t prn_ = d_acquisition_gnss_synchro->PRN;
-                    d_dump_file.write(reinterpret_cast<char *>(&prn_), sizeof(uint32_t));
-                    // acq_code_phase_samples & acq_carrier_doppler_hz
-                    tmp_float = static_cast<float>(d_acq_code_phase_samples);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_acq_carrier_doppler_hz);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    // indicators
-                    // EVM
-                    tmp_float = static_cast<float>(d_EVM);
-                    d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                }
-            catch (const std::ifstream::failure &e)
-                {
-                    LOG(WARNING) << "Exception writing trk dump file " << e.what();
-                }
+                    record.Prompt_I = d_Prompt->real();
+                    record.Prompt_Q = d_Prompt->imag();
+                }
+            // PRN start sample stamp
+            record.PRN_start_sample_count = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
+            // accumulated carrier phase
+            record.acc_carrier_phase_rad = static_cast<float>(d_acc_carrier_phase_rad);
+            // carrier and code frequency
+            record.carrier_doppler_hz = static_cast<float>(d_carrier_doppler_hz);
+            // carrier phase rate [Hz/s]
+            record.carrier_doppler_rate_hz = static_cast<float>(d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in * d_trk_parameters.fs_in / TWO_PI);
+            record.code_freq_chips = static_cast<float>(d_code_freq_chips);
+            // code phase rate [chips/s^2]
+            record.code_freq_rate_chips = static_cast<float>(d_code_phase_rate_step_chips * d_trk_parameters.fs_in * d_trk_parameters.fs_in);
+            // PLL commands
+            record.carr_error_hz = static_cast<float>(d_carr_phase_error_hz);
+            record.carr_error_filt_hz = static_cast<float>(d_carr_error_filt_hz);
+            // DLL commands
+            record.code_error_chips = static_cast<float>(d_code_error_chips);
+            record.code_error_filt_chips = static_cast<float>(d_code_error_filt_chips);
+            // CN0 and carrier lock test
+            record.CN0_SNV_dB_Hz = static_cast<float>(d_CN0_SNV_dB_Hz);
+            record.carrier_lock_test = static_cast<float>(d_carrier_lock_test);
+            // AUX vars (for debug purposes)
+            record.aux1 = static_cast<float>(d_rem_code_phase_samples);
+            record.aux2 = static_cast<double>(this->nitems_read(0) + d_current_prn_length_samples);
+            // PRN
+            record.PRN = d_acquisition_gnss_synchro->PRN;
+            // acq_code_phase_samples & acq_carrier_doppler_hz
+            record.acq_code_phase_samples = static_cast<float>(d_acq_code_phase_samples);
+            record.acq_carrier_doppler_hz = static_cast<float>(d_acq_carrier_doppler_hz);
+            // indicators
+            // EVM
+            record.EVM = static_cast<float>(d_EVM);
+            // end of the last integration that updated the loops
+            record.loop_update_sample_count = d_loop_update_sample;
+            d_dump_writer.push(record);
         }
 }
 
@@ -1512,10 +1571,7 @@ int32_t dll_pll_veml_tracking::save_matfile() const
 {
     // READ DUMP FILE
     std::ifstream::pos_type size;
-    const int32_t number_of_double_vars = 1;
-    const int32_t number_of_float_vars = 22;
-    const int32_t epoch_size_bytes = sizeof(uint64_t) + sizeof(double) * number_of_double_vars +
-                                     sizeof(float) * number_of_float_vars + sizeof(uint32_t);
+    const auto epoch_size_bytes = static_cast<int64_t>(sizeof(Dll_Pll_Veml_Dump_Record));
     std::ifstream dump_file;
     std::string dump_filename_ = d_dump_filename;
     // add channel number to the filename
@@ -1538,13 +1594,25 @@ int32_t dll_pll_veml_tracking::save_matfile() const
     if (dump_file.is_open())
         {
             size = dump_file.tellg();
-            num_epoch = static_cast<int64_t>(size) / static_cast<int64_t>(epoch_size_bytes);
+            num_epoch = static_cast<int64_t>(size) / epoch_size_bytes;
             dump_file.seekg(0, std::ios::beg);
         }
     else
         {
             return 1;
         }
+    auto records = std::vector<Dll_Pll_Veml_Dump_Record>(num_epoch);
+    try
+        {
+            // the records are stored as laid out in memory, read them at once
+            dump_file.read(reinterpret_cast<char *>(records.data()), num_epoch * epoch_size_bytes);
+            dump_file.close();
+        }
+    catch (const std::ifstream::failure &e)
+        {
+            std::cerr << "Problem reading dump file:" << e.what() << '\n';
+            return 1;
+        }
     auto abs_VE = std::vector<float>(num_epoch);
     auto abs_E = std::vector<float>(num_epoch);
     auto abs_P = std::vector<float>(num_epoch);
@@ -1570,45 +1638,36 @@ int32_t dll_pll_veml_tracking::save_matfile() const
     auto acq_code_phase_samples = std::vector<float>(num_epoch);
     auto acq_carrier_doppler_hz = std::vector<float>(num_epoch);
     auto EVM = std::vector<float>(num_epoch);
-    try
-        {
-            if (dump_file.is_open())
-                {
-                    for (int64_t i = 0; i < num_epoch; i++)
-                        {
-                            dump_file.read(reinterpret_cast<char *>(&abs_VE[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_E[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_P[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_L[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&abs_VL[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_I[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&Prompt_Q[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&PRN_start_sample_count[i]), sizeof(uint64_t));
-                            dump_file.read(reinterpret_cast<char *>(&acc_carrier_phase_rad[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_doppler_rate_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_freq_rate_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carr_error_filt_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&code_error_filt_chips[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&CN0_SNV_dB_Hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&carrier_lock_test[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux1[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&aux2[i]), sizeof(double));
-                            dump_file.read(reinterpret_cast<char *>(&PRN[i]), sizeof(uint32_t));
-                            dump_file.read(reinterpret_cast<char *>(&acq_code_phase_samples[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&acq_carrier_doppler_hz[i]), sizeof(float));
-                            dump_file.read(reinterpret_cast<char *>(&EVM[i]), sizeof(float));
-                        }
-                }
-            dump_file.close();
-        }
-    catch (const std::ifstream::failure &e)
-        {
-            std::cerr << "Problem reading dump file:" << e.what() << '\n';
-            return 1;
+    auto loop_update_sample_count = std::vector<uint64_t>(num_epoch);
+    for (int64_t i = 0; i < num_epoch; i++)
+        {
+            const Dll_Pll_Veml_Dump_Record &record = records[i];
+            abs_VE[i] = record.abs_VE;
+            abs_E[i] = record.abs_E;
+            abs_P[i] = record.abs_P;
+            abs_L[i] = record.abs_L;
+            abs_VL[i] = record.abs_VL;
+            Prompt_I[i] = record.Prompt_I;
+            Prompt_Q[i] = record.Prompt_Q;
+            PRN_start_sample_count[i] = record.PRN_start_sample_count;
+            acc_carrier_phase_rad[i] = record.acc_carrier_phase_rad;
+            carrier_doppler_hz[i] = record.carrier_doppler_hz;
+            carrier_doppler_rate_hz[i] = record.carrier_doppler_rate_hz;
+            code_freq_chips[i] = record.code_freq_chips;
+            code_freq_rate_chips[i] = record.code_freq_rate_chips;
+            carr_error_hz[i] = record.carr_error_hz;
+            carr_error_filt_hz[i] = record.carr_error_filt_hz;
+            code_error_chips[i] = record.code_error_chips;
+            code_error_filt_chips[i] = record.code_error_filt_chips;
+            CN0_SNV_dB_Hz[i] = record.CN0_SNV_dB_Hz;
+            carrier_lock_test[i] = record.carrier_lock_test;
+            aux1[i] = record.aux1;
+            aux2[i] = record.aux2;
+            PRN[i] = record.PRN;
+            acq_code_phase_samples[i] = record.acq_code_phase_samples;
+            acq_carrier_doppler_hz[i] = record.acq_carrier_doppler_hz;
+            EVM[i] = record.EVM;
+            loop_update_sample_count[i] = record.loop_update_sample_count;
         }
 
     // WRITE MAT FILE
@@ -1722,6 +1781,10 @@ int32_t dll_pll_veml_tracking::save_matfile() const
             matvar = Mat_VarCreate("EVM", MAT_C_SINGLE, MAT_T_SINGLE, 2, dims.data(), EVM.data(), 0);
             Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
             Mat_VarFree(matvar);
+
+            matvar = Mat_VarCreate("loop_update_sample_count", MAT_C_UINT64, MAT_T_UINT64, 2, dims.data(), loop_update_sample_count.data(), 0);
+            Mat_VarWrite(matfp, matvar, MAT_COMPRESSION_ZLIB);  // or MAT_COMPRESSION_NONE
+            Mat_VarFree(matvar);
         }
     Mat_Close(matfp);
     return 0;
@@ -1742,17 +1805,15 @@ void dll_pll_veml_tracking::set_channel(uint32_t channel)
             // add extension
             dump_filename_.append(".dat");
 
-            if (!d_dump_file.is_open())
+            if (!d_dump_writer.is_open())
                 {
-                    try
+                    if (d_dump_writer.open(dump_filename_, sizeof(Dll_Pll_Veml_Dump_Record)))
                         {
-                            d_dump_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-                            d_dump_file.open(dump_filename_.c_str(), std::ios::out | std::ios::binary);
                             LOG(INFO) << "Tracking dump enabled on channel " << d_channel << " Log file: " << dump_filename_.c_str();
                         }
-                    catch (const std::ifstream::failure &e)
+                    else
                         {
-                            LOG(WARNING) << "channel " << d_channel << " Exception opening trk dump file " << e.what();
+                            LOG(WARNING) << "channel " << d_channel << " Error opening trk dump file " << dump_filename_;
                         }
                 }
         }
@@ -1785,7 +1846,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
     gr_vector_const_void_star &input_items, gr_vector_void_star &output_items)
 {
     gr::thread::scoped_lock l(d_setlock);
-    const auto *in = reinterpret_cast<const gr_complex *>(input_items[0]);
+    const void *in = input_items[0];
     auto **out = reinterpret_cast<Gnss_Synchro **>(&output_items[0]);
     Gnss_Synchro current_synchro_data = Gnss_Synchro();
     current_synchro_data.Flag_valid_symbol_output = false;
@@ -1883,6 +1944,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         // Perform DLL/PLL tracking loop computations. Costas Loop enabled
                         run_dll_pll();
                         update_tracking_vars();
+                        d_loop_update_sample = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
 
                         // enable write dump file this cycle (valid DLL/PLL cycle)
                         log_data();
@@ -1946,8 +2008,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                     {
                                         // UPDATE INTEGRATION TIME
                                         d_extend_correlation_symbols_count = 0;
-                                        d_current_correlation_time_s = static_cast<float>(d_extend_correlation_symbols) * static_cast<float>(d_code_period);
-                                        d_state = 3;  // next state is the extended correlator integrator
+                                        d_state = schedule_extended_integration();  // next state is the extended correlator integrator
                                         LOG(INFO) << "Enabled " << d_extend_correlation_symbols * static_cast<int32_t>(d_code_period * 1000.0) << " ms extended correlator in channel "
                                                   << d_channel
                                                   << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN);
@@ -1955,7 +2016,6 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                                                   << d_channel
                                                   << " for satellite " << Gnss_Satellite(d_systemName, d_acquisition_gnss_synchro->PRN) << '\n';
                                         // Set narrow taps delay values [chips]
-                                        d_code_loop_filter.set_update_interval(static_cast<float>(d_current_correlation_time_s));
                                         d_code_loop_filter.set_noise_bandwidth(d_trk_parameters.dll_bw_narrow_hz);
                                         d_carrier_loop_filter.set_params(d_trk_parameters.fll_bw_hz, d_trk_parameters.pll_bw_narrow_hz, d_trk_parameters.pll_filter_order);
                                         if (d_veml)
@@ -2018,7 +2078,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_P_data_accu = gr_complex(0.0, 0.0);
                     }
                 d_extend_correlation_symbols_count++;
-                if (d_extend_correlation_symbols_count == (d_extend_correlation_symbols - 1))
+                if (d_extend_correlation_symbols_count == (d_extend_correlation_symbols_cycle - 1))
                     {
                         d_extend_correlation_symbols_count = 0;
                         d_state = 4;
@@ -2032,7 +2092,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                 save_correlation_results();
 
                 // check lock status
-                if (!cn0_and_tracking_lock_status(d_code_period * static_cast<double>(d_extend_correlation_symbols)))
+                if (!cn0_and_tracking_lock_status(d_current_correlation_time_s))
                     {
                         clear_tracking_vars();
                         d_state = 0;                                         // loss-of-lock detected
@@ -2043,6 +2103,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                     {
                         run_dll_pll();
                         update_tracking_vars();
+                        d_loop_update_sample = this->nitems_read(0) + static_cast<uint64_t>(d_current_prn_length_samples);
                         check_carrier_phase_coherent_initialization();
                         if (d_current_data_symbol == 0)
                             {
@@ -2079,7 +2140,7 @@ int dll_pll_veml_tracking::general_work(int noutput_items __attribute__((unused)
                         d_VL_accu = gr_complex(0.0, 0.0);
                         if (d_enable_extended_integration)
                             {
-                                d_state = 3;  // new coherent integration (correlation time extension) cycle
+                                d_state = schedule_extended_integration();  // new coherent integration (correlation time extension) cycle
                             }
                     }
             }
@@ -18,6 +18,8 @@
 #ifndef GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 #define GNSS_SDR_DLL_PLL_VEML_TRACKING_H
 
+#include "binary_dump_writer.h"
+#include "cpu_multicorrelator_batch.h"
 #include "cpu_multicorrelator_real_codes.h"
 #include "dll_pll_conf.h"
 #include "exponential_smoother.h"
@@ -33,7 +35,6 @@
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
 #include <cstddef>                            // for size_t
 #include <cstdint>                            // for int32_t
-#include <fstream>                            // for ofstream
 #include <string>                             // for string
 #include <typeinfo>                           // for typeid
 #include <utility>                            // for pair
@@ -75,7 +76,8 @@ private:
     explicit dll_pll_veml_tracking(const Dll_Pll_Conf &conf_);
 
     void msg_handler_telemetry_to_trk(const pmt::pmt_t &msg);
-    void do_correlation_step(const gr_complex *input_samples);
+    void do_correlation_step(const void *input_samples);
+    void set_correlator_input(Cpu_Multicorrelator_Real_Codes &correlator, gr_complex *corr_out, const void *input_samples) const;
     void run_dll_pll();
     void check_carrier_phase_coherent_initialization();
     void update_tracking_vars();
@@ -84,11 +86,13 @@ private:
     void log_data();
     bool cn0_and_tracking_lock_status(double coh_integration_time_s);
     bool acquire_secondary();
+    int32_t schedule_extended_integration();
     int64_t uint64diff(uint64_t first, uint64_t second);
     int32_t save_matfile() const;
 
     Cpu_Multicorrelator_Real_Codes d_multicorrelator_cpu;
     Cpu_Multicorrelator_Real_Codes d_correlator_data_cpu;  // for data channel
+    Cpu_Multicorrelator_Batch d_pilot_data_correlator;     // pilot and data channels in one pass, for gr_complex samples
 
     Dll_Pll_Conf d_trk_parameters;
 
@@ -163,10 +167,11 @@ private:
     std::string d_signal_pretty_name;
     std::string d_dump_filename;
 
-    std::ofstream d_dump_file;
+    Binary_Dump_Writer d_dump_writer;
 
     // uint64_t d_sample_counter;
     uint64_t d_acq_sample_stamp;
+    uint64_t d_loop_update_sample;  // sample stamp of the end of the last integration that updated the loops
     GnssTime d_last_timetag{};
     uint64_t d_last_timetag_samplecounter;
     bool d_timetag_waiting;
@@ -181,6 +186,7 @@ private:
     int32_t d_current_prn_length_samples;
     int32_t d_extend_correlation_symbols_count;
     int32_t d_extend_correlation_symbols;
+    int32_t d_extend_correlation_symbols_cycle;  // code periods of the current extended integration
     int32_t d_current_symbol;
     int32_t d_current_data_symbol;
     int32_t d_cn0_estimation_counter;
@@ -203,7 +209,11 @@ private:
     bool d_dump_mat;
     bool d_acc_carrier_phase_initialized;
     bool d_enable_extended_integration;
+    bool d_aligned_epochs;  // extended integrations end at the epochs shared by all the channels
     bool d_Flag_PLL_180_deg_phase_locked;
+    bool d_cshort;            // input samples are lv_16sc_t
+    bool d_cbyte;             // input samples are lv_8sc_t
+    bool d_batch_pilot_data;  // d_pilot_data_correlator replaces d_multicorrelator_cpu and d_correlator_data_cpu
     
     // Indicators
     double d_EVM;
@@ -878,20 +878,20 @@ void kf_tracking::init_kf(double acq_code_phase_chips, double acq_doppler_hz)
         {0.0, 0.0, 0.0, pow(d_trk_parameters.carrier_freq_rate_sd_hz_s, 2.0)}};
 
     // initial Kalman covariance matrix
-    d_P_old_old = {{pow(d_trk_parameters.init_code_phase_sd_chips, 2.0), 0.0, 0.0, 0.0},
+    d_kf.P() = {{pow(d_trk_parameters.init_code_phase_sd_chips, 2.0), 0.0, 0.0, 0.0},
         {0.0, pow(d_trk_parameters.init_carrier_phase_sd_rad, 2.0), 0.0, 0.0},
         {0.0, 0.0, pow(d_trk_parameters.init_carrier_freq_sd_hz, 2.0), 0.0},
         {0.0, 0.0, 0.0, pow(d_trk_parameters.init_carrier_freq_rate_sd_hz_s, 2.0)}};
 
     // states: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz_s
-    d_x_old_old = {acq_code_phase_chips, 0.0, acq_doppler_hz, 0.0};
+    d_kf.x() = {acq_code_phase_chips, 0.0, acq_doppler_hz, 0.0};
 
     DLOG(INFO) << "F: " << d_F;
     DLOG(INFO) << "H: " << d_H;
     DLOG(INFO) << "R: " << d_R;
     DLOG(INFO) << "Q: " << d_Q;
-    DLOG(INFO) << "P: " << d_P_old_old;
-    DLOG(INFO) << "x: " << d_x_old_old;
+    DLOG(INFO) << "P: " << d_kf.P();
+    DLOG(INFO) << "x: " << d_kf.x();
 }
 
 
@@ -930,8 +930,8 @@ void kf_tracking::update_kf_narrow_integration_time()
     DLOG(INFO) << "Hu: " << d_H;
     DLOG(INFO) << "Ru: " << d_R;
     DLOG(INFO) << "Qu: " << d_Q;
-    DLOG(INFO) << "Pu: " << d_P_old_old;
-    DLOG(INFO) << "xu: " << d_x_old_old;
+    DLOG(INFO) << "Pu: " << d_kf.P();
+    DLOG(INFO) << "xu: " << d_kf.x();
 }
 
 
@@ -1153,38 +1153,38 @@ void kf_tracking::run_Kf()
     //  Kalman loop
 
     // Prediction
-    d_x_new_old = d_F * d_x_old_old;
-
-    d_P_new_old = d_F * d_P_old_old * d_F.t() + d_Q;
+    d_kf.predict(d_F, d_Q);
 
     // Measurement update
-    arma::vec z = {d_code_error_disc_chips, d_carr_phase_error_disc_hz * TWO_PI};
-    arma::mat K = d_P_new_old * d_H.t() * arma::inv(d_H * d_P_new_old * d_H.t() + d_R);  // Kalman gain
-
-    d_x_new_new = d_x_new_old + K * z;
-
-    d_P_new_new = (arma::eye(4, 4) - K * d_H) * d_P_new_old;
+    Kf_Core::Measurement z;
+    z.at(0) = d_code_error_disc_chips;
+    z.at(1) = d_carr_phase_error_disc_hz * TWO_PI;
+    if (!d_kf.update(z, d_H, d_R))
+        {
+            DLOG(WARNING) << "Innovation covariance not positive definite in channel " << d_channel << ", Kalman update skipped";
+        }
+    Kf_Core::State &x = d_kf.x();
 
     // new code phase estimation
-    d_code_error_kf_chips = d_x_new_new(0);
-    d_x_new_new(0) = 0;  // reset error estimation because the NCO corrects the code phase
+    d_code_error_kf_chips = x(0);
+    x(0) = 0;  // reset error estimation because the NCO corrects the code phase
 
     // new carrier phase estimation
-    d_carrier_phase_kf_rad = d_x_new_new(1);
+    d_carrier_phase_kf_rad = x(1);
 
     // New carrier Doppler frequency estimation
-    d_carrier_doppler_kf_hz = d_x_new_new(2);
+    d_carrier_doppler_kf_hz = x(2);
 
     // d_carr_freq_error_hz = fll_four_quadrant_atan(d_P_accu_old, d_P_accu, 0, d_current_correlation_time_s) / TWO_PI;
-    // d_x_new_new(2) = d_x_new_new(2) + fll_four_quadrant_atan(d_P_accu_old, d_P_accu, 0, d_current_correlation_time_s) / TWO_PI;
+    // x(2) = x(2) + fll_four_quadrant_atan(d_P_accu_old, d_P_accu, 0, d_current_correlation_time_s) / TWO_PI;
     d_P_accu_old = d_P_accu;
 
-    d_carrier_doppler_rate_kf_hz_s = d_x_new_new(3);
+    d_carrier_doppler_rate_kf_hz_s = x(3);
 
     // New code Doppler frequency estimation
     d_code_freq_kf_chips_s = d_code_chip_rate + d_carrier_doppler_kf_hz * d_code_chip_rate / d_signal_carrier_freq;
 
-    // d_x_new_new(4) = 0;
+    // x(4) = 0;
     //  Experimental: detect Carrier Doppler vs. Code Doppler incoherence and correct the Carrier Doppler
     //     if (d_trk_parameters.enable_doppler_correction == true)
     //         {
@@ -1197,10 +1197,6 @@ void kf_tracking::run_Kf()
     // correct code and carrier phase
     d_rem_code_phase_samples += d_trk_parameters.fs_in * d_code_error_kf_chips / d_code_freq_kf_chips_s;
     d_rem_carr_phase_rad = d_carrier_phase_kf_rad;
-
-    // prepare data for next KF epoch
-    d_x_old_old = d_x_new_new;
-    d_P_old_old = d_P_new_new;
 }
 
 
@@ -1272,7 +1268,7 @@ void kf_tracking::update_tracking_vars()
                     tmp_cp1 /= static_cast<double>(d_trk_parameters.smoother_length);
                     tmp_cp2 /= static_cast<double>(d_trk_parameters.smoother_length);
                     d_carrier_phase_rate_step_rad = (tmp_cp2 - tmp_cp1) / tmp_samples;
-                    d_x_old_old(3) = d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in / TWO_PI;
+                    d_kf.x()(3) = d_carrier_phase_rate_step_rad * d_trk_parameters.fs_in / TWO_PI;
                 }
         }
     // remnant carrier phase to prevent overflow in the code NCO
@@ -1496,7 +1492,7 @@ void kf_tracking::log_data()
                     // Carrier estimation
                     tmp_float = static_cast<float>(d_carr_phase_error_disc_hz);
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
-                    tmp_float = static_cast<float>(d_x_new_new(2));
+                    tmp_float = static_cast<float>(d_kf.x()(2));
                     d_dump_file.write(reinterpret_cast<char *>(&tmp_float), sizeof(float));
                     // code estimation
                     tmp_float = static_cast<float>(d_code_error_disc_chips);
@@ -29,6 +29,7 @@
 #include "exponential_smoother.h"
 #include "gnss_block_interface.h"
 #include "gnss_time.h"  // for timetags produced by File_Timestamp_Signal_Source
+#include "kalman_filter.h"
 #include "kf_conf.h"
 #include "tracking_FLL_PLL_filter.h"  // for PLL/FLL filter
 #include "tracking_loop_filter.h"     // for DLL filter
@@ -118,16 +119,14 @@ private:
     const size_t d_int_type_hash_code = typeid(int).hash_code();
 
     // Kalman Filter class variables
-    arma::mat d_F;
-    arma::mat d_H;
-    arma::mat d_R;
-    arma::mat d_Q;
-    arma::mat d_P_old_old;
-    arma::mat d_P_new_old;
-    arma::mat d_P_new_new;
-    arma::vec d_x_old_old;
-    arma::vec d_x_new_old;
-    arma::vec d_x_new_new;
+    // states: code_phase_chips, carrier_phase_rads, carrier_freq_hz, carrier_freq_rate_hz_s
+    // measurements: code phase error, carrier phase error
+    using Kf_Core = Kalman_Filter<4, 2>;
+    Kf_Core d_kf;
+    Kf_Core::State_Matrix d_F;
+    Kf_Core::Measurement_Matrix d_H;
+    Kf_Core::Measurement_Covariance d_R;
+    Kf_Core::State_Matrix d_Q;
 
     std::string d_secondary_code_string;
     std::string d_data_secondary_code_string;
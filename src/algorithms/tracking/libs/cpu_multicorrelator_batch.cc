@@ -0,0 +1,256 @@
+/*!
+ * \file cpu_multicorrelator_batch.cc
+ * \brief Multichannel CPU correlator that walks the input samples once and
+ * correlates all the active channels tile by tile.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "cpu_multicorrelator_batch.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <algorithm>  // for std::min, std::copy, std::fill_n
+#include <cmath>      // for std::cos, std::sin, std::fmod
+
+
+bool Cpu_Multicorrelator_Batch::init(
+    int max_channels,
+    int n_correlators,
+    int tile_samples)
+{
+    if (max_channels <= 0 || n_correlators <= 0 || tile_samples <= 0)
+        {
+            return false;
+        }
+    d_max_channels = max_channels;
+    d_n_correlators = n_correlators;
+    d_tile_samples = tile_samples;
+    d_active_channels = 0;
+
+    d_local_codes_resampled = volk_gnsssdr::vector<volk_gnsssdr::vector<float>>(n_correlators, volk_gnsssdr::vector<float>(tile_samples));
+    d_local_codes_ptrs = std::vector<float*>(n_correlators);
+    for (int n = 0; n < n_correlators; n++)
+        {
+            d_local_codes_ptrs[n] = d_local_codes_resampled[n].data();
+        }
+    d_tile_corr = volk_gnsssdr::vector<std::complex<float>>(n_correlators);
+
+    d_accumulated = volk_gnsssdr::vector<std::complex<float>>(max_channels * n_correlators);
+    d_local_code_in = std::vector<const float*>(max_channels, nullptr);
+    d_shifts_chips = std::vector<float*>(max_channels, nullptr);
+    d_corr_out = std::vector<std::complex<float>*>(max_channels, nullptr);
+    d_start_sample = std::vector<uint64_t>(max_channels, 0ULL);
+    d_rem_carrier_phase = std::vector<double>(max_channels, 0.0);
+    d_phase_step = std::vector<double>(max_channels, 0.0);
+    d_phase_rate_step = std::vector<double>(max_channels, 0.0);
+    d_rem_code_phase = std::vector<double>(max_channels, 0.0);
+    d_code_phase_step = std::vector<double>(max_channels, 0.0);
+    d_code_phase_rate_step = std::vector<double>(max_channels, 0.0);
+    d_code_length_chips = std::vector<int>(max_channels, 0);
+    d_n_taps = std::vector<int>(max_channels, n_correlators);
+    d_length = std::vector<int>(max_channels, 0);
+    d_done = std::vector<int>(max_channels, 0);
+    d_active = std::vector<uint8_t>(max_channels, 0);
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Batch::set_high_dynamics_resampler(
+    bool use_high_dynamics_resampler)
+{
+    d_use_high_dynamics_resampler = use_high_dynamics_resampler;
+}
+
+
+bool Cpu_Multicorrelator_Batch::set_local_code_and_taps(
+    int channel,
+    int code_length_chips,
+    const float* local_code_in,
+    float* shifts_chips,
+    int n_taps)
+{
+    if (channel < 0 || channel >= d_max_channels || n_taps < 0 || n_taps > d_n_correlators)
+        {
+            return false;
+        }
+    d_local_code_in[channel] = local_code_in;
+    d_shifts_chips[channel] = shifts_chips;
+    d_code_length_chips[channel] = code_length_chips;
+    d_n_taps[channel] = (n_taps == 0) ? d_n_correlators : n_taps;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Batch::set_epoch(int channel,
+    std::complex<float>* corr_out,
+    uint64_t start_sample,
+    int signal_length_samples,
+    float rem_carrier_phase_in_rad,
+    float phase_step_rad,
+    float phase_rate_step_rad,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    float code_phase_rate_step_chips)
+{
+    if (channel < 0 || channel >= d_max_channels || d_local_code_in[channel] == nullptr || signal_length_samples <= 0)
+        {
+            return false;
+        }
+    if (d_active[channel] == 0)
+        {
+            d_active[channel] = 1;
+            d_active_channels++;
+        }
+    d_corr_out[channel] = corr_out;
+    d_start_sample[channel] = start_sample;
+    d_length[channel] = signal_length_samples;
+    d_done[channel] = 0;
+    d_rem_carrier_phase[channel] = rem_carrier_phase_in_rad;
+    d_phase_step[channel] = phase_step_rad;
+    d_phase_rate_step[channel] = phase_rate_step_rad;
+    d_rem_code_phase[channel] = rem_code_phase_chips;
+    d_code_phase_step[channel] = code_phase_step_chips;
+    d_code_phase_rate_step[channel] = code_phase_rate_step_chips;
+    std::fill_n(&d_accumulated[channel * d_n_correlators], d_n_correlators, std::complex<float>(0.0, 0.0));
+    return true;
+}
+
+
+void Cpu_Multicorrelator_Batch::correlate(const std::complex<float>* sig_in, uint64_t first_sample, int num_samples)
+{
+    for (int tile_start = 0; tile_start < num_samples && d_active_channels > 0; tile_start += d_tile_samples)
+        {
+            const int tile_length = std::min(d_tile_samples, num_samples - tile_start);
+            const uint64_t tile_first = first_sample + tile_start;
+            const uint64_t tile_end = tile_first + tile_length;
+            for (int channel = 0; channel < d_max_channels; channel++)
+                {
+                    if (d_active[channel] == 0)
+                        {
+                            continue;
+                        }
+                    const uint64_t epoch_end = d_start_sample[channel] + d_length[channel];
+                    uint64_t next_sample = d_start_sample[channel] + d_done[channel];
+                    if (next_sample >= tile_end)
+                        {
+                            continue;
+                        }
+                    if (next_sample < tile_first)
+                        {
+                            // samples not fed to the correlator, skip them
+                            next_sample = std::min(tile_first, epoch_end);
+                        }
+                    const uint64_t segment_end = std::min(epoch_end, tile_end);
+                    if (segment_end > next_sample)
+                        {
+                            correlate_segment(channel, &sig_in[next_sample - first_sample],
+                                static_cast<int>(next_sample - d_start_sample[channel]),
+                                static_cast<int>(segment_end - next_sample));
+                        }
+                    d_done[channel] = static_cast<int>(segment_end - d_start_sample[channel]);
+                    if (d_done[channel] == d_length[channel])
+                        {
+                            std::copy(&d_accumulated[channel * d_n_correlators],
+                                &d_accumulated[channel * d_n_correlators + d_n_taps[channel]],
+                                d_corr_out[channel]);
+                            d_active[channel] = 0;
+                            d_active_channels--;
+                        }
+                }
+        }
+}
+
+
+void Cpu_Multicorrelator_Batch::correlate_segment(int channel, const std::complex<float>* sig_in, int first_index, int num_samples)
+{
+    const auto k0 = static_cast<double>(first_index);
+    const int n_taps = d_n_taps[channel];
+    lv_32fc_t phase_offset_as_complex[1];
+
+    if (d_use_high_dynamics_resampler)
+        {
+            // Code and carrier phases at the first sample of the segment,
+            // following phase(n) = rem + step * n + rate * n^2 along the epoch
+            const double code_rate = d_code_phase_rate_step[channel];
+            const double code_step = d_code_phase_step[channel] + 2.0 * code_rate * k0;
+            const double rem_code = std::fmod(d_rem_code_phase[channel] - d_code_phase_step[channel] * k0 - code_rate * k0 * k0,
+                static_cast<double>(d_code_length_chips[channel]));
+            const double carrier_rate = d_phase_rate_step[channel];
+            const double carrier_step = d_phase_step[channel] + 2.0 * carrier_rate * k0;
+            const double carrier_phase = d_rem_carrier_phase[channel] + d_phase_step[channel] * k0 + carrier_rate * k0 * k0;
+            phase_offset_as_complex[0] = lv_cmake(static_cast<float>(std::cos(carrier_phase)), static_cast<float>(-std::sin(carrier_phase)));
+            const auto phase_inc = lv_cmake(static_cast<float>(std::cos(carrier_step)), static_cast<float>(-std::sin(carrier_step)));
+            const auto phase_inc_rate = lv_cmake(static_cast<float>(std::cos(carrier_rate)), static_cast<float>(-std::sin(carrier_rate)));
+
+            // one tap at a time: the kernel derives the other taps by shifting
+            // the first one, which would wrap around at the tile boundaries
+            for (int n = 0; n < n_taps; n++)
+                {
+                    volk_gnsssdr_32f_xn_high_dynamics_resampler_32f_xn(&d_local_codes_ptrs[n],
+                        d_local_code_in[channel],
+                        static_cast<float>(rem_code),
+                        static_cast<float>(code_step),
+                        static_cast<float>(code_rate),
+                        &d_shifts_chips[channel][n],
+                        d_code_length_chips[channel],
+                        1,
+                        num_samples);
+                }
+            volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_tile_corr.data(), sig_in, phase_inc, phase_inc_rate, phase_offset_as_complex, const_cast<const float**>(d_local_codes_ptrs.data()), n_taps, num_samples);
+        }
+    else
+        {
+            // As in Cpu_Multicorrelator_Real_Codes, the rotator-resampler keeps
+            // the code and carrier steps of the epoch and ignores their rates
+            const double rem_code = std::fmod(d_rem_code_phase[channel] - d_code_phase_step[channel] * k0,
+                static_cast<double>(d_code_length_chips[channel]));
+            const double carrier_phase = d_rem_carrier_phase[channel] + d_phase_step[channel] * k0;
+            phase_offset_as_complex[0] = lv_cmake(static_cast<float>(std::cos(carrier_phase)), static_cast<float>(-std::sin(carrier_phase)));
+            const auto phase_inc = lv_cmake(static_cast<float>(std::cos(d_phase_step[channel])), static_cast<float>(-std::sin(d_phase_step[channel])));
+            volk_gnsssdr_32fc_32f_rotator_resampler_dot_prod_32fc_xn(d_tile_corr.data(), sig_in, phase_inc, phase_offset_as_complex,
+                d_local_code_in[channel],
+                static_cast<float>(rem_code),
+                static_cast<float>(d_code_phase_step[channel]),
+                d_shifts_chips[channel],
+                d_code_length_chips[channel],
+                n_taps,
+                num_samples);
+        }
+
+    std::complex<float>* accumulated = &d_accumulated[channel * d_n_correlators];
+    for (int n = 0; n < n_taps; n++)
+        {
+            accumulated[n] += d_tile_corr[n];
+        }
+}
+
+
+bool Cpu_Multicorrelator_Batch::epoch_done(int channel) const
+{
+    return d_active[channel] == 0 && d_length[channel] > 0 && d_done[channel] == d_length[channel];
+}
+
+
+void Cpu_Multicorrelator_Batch::release(int channel)
+{
+    if (d_active[channel] != 0)
+        {
+            d_active[channel] = 0;
+            d_active_channels--;
+        }
+    d_length[channel] = 0;
+    d_done[channel] = 0;
+}
+
+
+int Cpu_Multicorrelator_Batch::active_channels() const
+{
+    return d_active_channels;
+}
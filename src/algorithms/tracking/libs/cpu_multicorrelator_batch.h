@@ -0,0 +1,136 @@
+/*!
+ * \file cpu_multicorrelator_batch.h
+ * \brief Multichannel CPU correlator that walks the input samples once and
+ * correlates all the active channels tile by tile.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
+#define GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
+
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>  // for volk_gnsssdr::vector
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Carrier wipe-off and multitap correlation of many channels over a
+ * shared stream of samples, using real-valued local codes.
+ *
+ * Each channel requests the correlation of one integration period (epoch),
+ * given by its first absolute sample and its length, with the same
+ * parameters as Cpu_Multicorrelator_Real_Codes. The input stream is then
+ * fed in chunks of any size through correlate(). Each chunk is walked once,
+ * in tiles small enough to stay in the L1/L2 cache, and every active channel
+ * whose epoch overlaps a tile correlates it before moving to the next one.
+ * This reads the samples from memory once for all the channels, instead of
+ * once per channel.
+ *
+ * The per-channel loop parameters and partial sums are kept in a
+ * struct-of-arrays layout. The carrier phase and code phase of each epoch
+ * are evaluated at the start of each tile, so splitting an epoch across
+ * tiles and chunks does not accumulate rounding errors. As in
+ * Cpu_Multicorrelator_Real_Codes, the carrier and code phase rates are only
+ * applied by the high dynamics resampler.
+ *
+ * dll_pll_veml_tracking uses it to correlate the pilot and data components
+ * of a channel in one pass over the samples.
+ */
+class Cpu_Multicorrelator_Batch
+{
+public:
+    static constexpr int DEFAULT_TILE_SAMPLES = 2048;  //!< 16 KiB of gr_complex samples
+
+    Cpu_Multicorrelator_Batch() = default;
+    ~Cpu_Multicorrelator_Batch() = default;
+
+    bool init(int max_channels, int n_correlators, int tile_samples = DEFAULT_TILE_SAMPLES);
+    void set_high_dynamics_resampler(bool use_high_dynamics_resampler);
+
+    /*!
+     * \brief Sets the local code and the tap shifts of a channel. The channel
+     * uses the first n_taps correlators, or all of them if n_taps is 0.
+     */
+    bool set_local_code_and_taps(int channel, int code_length_chips, const float *local_code_in, float *shifts_chips, int n_taps = 0);
+
+    /*!
+     * \brief Schedules the correlation of the epoch of a channel starting at
+     * the absolute sample start_sample. The results are written to corr_out
+     * (one value per tap of the channel) once the last sample of the epoch is
+     * correlated.
+     */
+    bool set_epoch(int channel,
+        std::complex<float> *corr_out,
+        uint64_t start_sample,
+        int signal_length_samples,
+        float rem_carrier_phase_in_rad,
+        float phase_step_rad,
+        float phase_rate_step_rad,
+        float rem_code_phase_chips,
+        float code_phase_step_chips,
+        float code_phase_rate_step_chips);
+
+    /*!
+     * \brief Correlates the num_samples samples in sig_in, the first one being
+     * the absolute sample first_sample, with all the scheduled epochs. The
+     * samples of an epoch must be fed in order; samples of an epoch that fall
+     * before first_sample and were not fed before are skipped.
+     */
+    void correlate(const std::complex<float> *sig_in, uint64_t first_sample, int num_samples);
+
+    bool epoch_done(int channel) const;  //!< True once the scheduled epoch of channel has been fully correlated
+    void release(int channel);           //!< Cancels the scheduled epoch of channel, if any
+    int active_channels() const;         //!< Number of channels with an epoch in progress
+
+private:
+    void correlate_segment(int channel, const std::complex<float> *sig_in, int first_index, int num_samples);
+
+    // Input tile working memory, shared by all channels
+    volk_gnsssdr::vector<volk_gnsssdr::vector<float>> d_local_codes_resampled;
+    std::vector<float *> d_local_codes_ptrs;
+    volk_gnsssdr::vector<std::complex<float>> d_tile_corr;
+
+    // Per-channel state, struct-of-arrays
+    volk_gnsssdr::vector<std::complex<float>> d_accumulated;  // max_channels x n_correlators
+    std::vector<const float *> d_local_code_in;
+    std::vector<float *> d_shifts_chips;
+    std::vector<std::complex<float> *> d_corr_out;
+    std::vector<uint64_t> d_start_sample;
+    std::vector<double> d_rem_carrier_phase;
+    std::vector<double> d_phase_step;
+    std::vector<double> d_phase_rate_step;
+    std::vector<double> d_rem_code_phase;
+    std::vector<double> d_code_phase_step;
+    std::vector<double> d_code_phase_rate_step;
+    std::vector<int> d_code_length_chips;
+    std::vector<int> d_n_taps;
+    std::vector<int> d_length;
+    std::vector<int> d_done;
+    std::vector<uint8_t> d_active;
+
+    int d_max_channels{0};
+    int d_n_correlators{0};
+    int d_tile_samples{DEFAULT_TILE_SAMPLES};
+    int d_active_channels{0};
+    bool d_use_high_dynamics_resampler{true};
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_CPU_MULTICORRELATOR_BATCH_H
@@ -67,6 +67,28 @@ bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float
 {
     // Save CPU pointers
     d_sig_in = sig_in;
+    d_sig_in_16sc = nullptr;
+    d_sig_in_8sc = nullptr;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<int16_t>* sig_in)
+{
+    d_sig_in = nullptr;
+    d_sig_in_16sc = sig_in;
+    d_sig_in_8sc = nullptr;
+    d_corr_out = corr_out;
+    return true;
+}
+
+
+bool Cpu_Multicorrelator_Real_Codes::set_input_output_vectors(std::complex<float>* corr_out, const std::complex<int8_t>* sig_in)
+{
+    d_sig_in = nullptr;
+    d_sig_in_16sc = nullptr;
+    d_sig_in_8sc = sig_in;
     d_corr_out = corr_out;
     return true;
 }
@@ -109,18 +131,19 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
-    if (d_use_high_dynamics_resampler)
+    if (d_use_high_dynamics_resampler && d_sig_in != nullptr)
         {
+            update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
             volk_gnsssdr_32fc_32f_high_dynamic_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), std::exp(lv_32fc_t(0.0, -phase_rate_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
         }
     else
         {
-            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+            // the code replicas are resampled on the fly, without storing them
+            rotator_resampler_dot_prod(phase_step_rad, phase_offset_as_complex, rem_code_phase_chips, code_phase_step_chips, signal_length_samples);
         }
     return true;
 }
@@ -134,16 +157,46 @@ bool Cpu_Multicorrelator_Real_Codes::Carrier_wipeoff_multicorrelator_resampler(
     float code_phase_rate_step_chips,
     int signal_length_samples)
 {
-    update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
     // Regenerate phase at each call in order to avoid numerical issues
     lv_32fc_t phase_offset_as_complex[1];
     phase_offset_as_complex[0] = lv_cmake(std::cos(rem_carrier_phase_in_rad), -std::sin(rem_carrier_phase_in_rad));
     // call VOLK_GNSSSDR kernel
-    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+    if (d_use_high_dynamics_resampler && d_sig_in != nullptr)
+        {
+            update_local_code(signal_length_samples, rem_code_phase_chips, code_phase_step_chips, code_phase_rate_step_chips);
+            volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(d_corr_out, d_sig_in, std::exp(lv_32fc_t(0.0, -phase_step_rad)), phase_offset_as_complex, const_cast<const float**>(d_local_codes_resampled), d_n_correlators, signal_length_samples);
+        }
+    else
+        {
+            rotator_resampler_dot_prod(phase_step_rad, phase_offset_as_complex, rem_code_phase_chips, code_phase_step_chips, signal_length_samples);
+        }
     return true;
 }
 
 
+void Cpu_Multicorrelator_Real_Codes::rotator_resampler_dot_prod(
+    float phase_step_rad,
+    std::complex<float>* phase,
+    float rem_code_phase_chips,
+    float code_phase_step_chips,
+    int signal_length_samples)
+{
+    const lv_32fc_t phase_inc = std::exp(lv_32fc_t(0.0, -phase_step_rad));
+    if (d_sig_in_16sc != nullptr)
+        {
+            volk_gnsssdr_16ic_32f_rotator_resampler_dot_prod_32fc_xn(d_corr_out, d_sig_in_16sc, phase_inc, phase, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
+    else if (d_sig_in_8sc != nullptr)
+        {
+            volk_gnsssdr_8ic_32f_rotator_resampler_dot_prod_32fc_xn(d_corr_out, d_sig_in_8sc, phase_inc, phase, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
+    else
+        {
+            volk_gnsssdr_32fc_32f_rotator_resampler_dot_prod_32fc_xn(d_corr_out, d_sig_in, phase_inc, phase, d_local_code_in, rem_code_phase_chips, code_phase_step_chips, d_shifts_chips, d_code_length_chips, d_n_correlators, signal_length_samples);
+        }
+}
+
+
 bool Cpu_Multicorrelator_Real_Codes::free()
 {
     // Free memory
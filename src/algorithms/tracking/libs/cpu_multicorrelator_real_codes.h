@@ -24,6 +24,7 @@
 
 
 #include <complex>
+#include <cstdint>
 
 /** \addtogroup Tracking
  * \{ */
@@ -43,14 +44,30 @@ public:
     bool init(int max_signal_length_samples, int n_correlators);
     bool set_local_code_and_taps(int code_length_chips, const float *local_code_in, float *shifts_chips);
     bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<float> *sig_in);
+    /*!
+     * \brief Sets 16-bit integer input samples. They are converted to floating
+     * point inside the correlator kernel, and the high dynamics resampler is
+     * not used for them.
+     */
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<int16_t> *sig_in);
+    /*!
+     * \brief Sets 8-bit integer input samples. They are converted to floating
+     * point inside the correlator kernel, and the high dynamics resampler is
+     * not used for them.
+     */
+    bool set_input_output_vectors(std::complex<float> *corr_out, const std::complex<int8_t> *sig_in);
     void update_local_code(int correlator_length_samples, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips = 0.0);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float phase_rate_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool Carrier_wipeoff_multicorrelator_resampler(float rem_carrier_phase_in_rad, float phase_step_rad, float rem_code_phase_chips, float code_phase_step_chips, float code_phase_rate_step_chips, int signal_length_samples);
     bool free();
 
 private:
+    void rotator_resampler_dot_prod(float phase_step_rad, std::complex<float> *phase, float rem_code_phase_chips, float code_phase_step_chips, int signal_length_samples);
+
     // Allocate the device input vectors
     const std::complex<float> *d_sig_in{nullptr};
+    const std::complex<int16_t> *d_sig_in_16sc{nullptr};
+    const std::complex<int8_t> *d_sig_in_8sc{nullptr};
     const float *d_local_code_in{nullptr};
     std::complex<float> *d_corr_out{nullptr};
     float **d_local_codes_resampled{nullptr};
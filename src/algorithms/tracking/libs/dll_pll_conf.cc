@@ -111,6 +111,7 @@ void Dll_Pll_Conf::SetFromConfiguration(const ConfigurationInterface *configurat
     max_carrier_lock_fail = configuration->property(role + ".max_carrier_lock_fail", max_carrier_lock_fail);
     carrier_lock_th = configuration->property(role + ".carrier_lock_th", carrier_lock_th);
     carrier_aiding = configuration->property(role + ".carrier_aiding", carrier_aiding);
+    aligned_integration_epochs = configuration->property(role + ".aligned_integration_epochs", aligned_integration_epochs);
 
     // tracking lock tests smoother parameters
     cn0_smoother_samples = configuration->property(role + ".cn0_smoother_samples", cn0_smoother_samples);
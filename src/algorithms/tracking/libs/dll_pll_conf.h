@@ -77,6 +77,7 @@ public:
     bool track_pilot{true};
     bool enable_doppler_correction{false};
     bool carrier_aiding{true};
+    bool aligned_integration_epochs{false};
     bool high_dyn{false};
     bool dump{false};
     bool dump_mat{true};
@@ -0,0 +1,289 @@
+/*!
+ * \file kalman_filter.h
+ * \brief Fixed-size linear / extended Kalman filter core
+ *
+ * Kalman_Filter keeps the state and covariance of a filter whose state and
+ * measurement dimensions are known at compile time in Armadillo fixed-size
+ * objects, so prediction and update run without heap allocations. The update
+ * computes the gain with a Cholesky factorization of the innovation
+ * covariance instead of inverting it, and propagates the covariance in
+ * Joseph form, which keeps it symmetric and positive definite.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_KALMAN_FILTER_H
+#define GNSS_SDR_KALMAN_FILTER_H
+
+#if ARMA_NO_BOUND_CHECKING
+#define ARMA_NO_DEBUG 1
+#endif
+
+#include <armadillo>
+#include <cmath>  // for sqrt
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Computes the Kalman gain K = P_xz * S^-1 without inverting S.
+ *
+ * S is factorized as L * L' (Cholesky) in L_work, and each row of K is
+ * obtained by forward and back substitution. P_xz is nx x nz, S and L_work
+ * are nz x nz and K must have the size of P_xz. It works with both fixed-size
+ * and dynamic Armadillo matrices. Returns false, leaving K undefined, if S is
+ * not positive definite.
+ */
+template <typename Mat_Xz, typename Mat_Zz, typename Mat_K>
+bool kalman_gain(const Mat_Xz& P_xz, const Mat_Zz& S, Mat_Zz& L_work, Mat_K& K)
+{
+    const arma::uword nx = P_xz.n_rows;
+    const arma::uword nz = S.n_rows;
+    // lower triangular Cholesky factor, only the lower triangle is used
+    for (arma::uword j = 0; j < nz; j++)
+        {
+            double d = S.at(j, j);
+            for (arma::uword k = 0; k < j; k++)
+                {
+                    d -= L_work.at(j, k) * L_work.at(j, k);
+                }
+            if (!(d > 0.0))
+                {
+                    return false;
+                }
+            L_work.at(j, j) = std::sqrt(d);
+            for (arma::uword i = j + 1; i < nz; i++)
+                {
+                    double s = S.at(i, j);
+                    for (arma::uword k = 0; k < j; k++)
+                        {
+                            s -= L_work.at(i, k) * L_work.at(j, k);
+                        }
+                    L_work.at(i, j) = s / L_work.at(j, j);
+                }
+        }
+    // K * L * L' = P_xz, solved row by row
+    for (arma::uword r = 0; r < nx; r++)
+        {
+            for (arma::uword j = 0; j < nz; j++)
+                {
+                    double s = P_xz.at(r, j);
+                    for (arma::uword k = 0; k < j; k++)
+                        {
+                            s -= K.at(r, k) * L_work.at(j, k);
+                        }
+                    K.at(r, j) = s / L_work.at(j, j);
+                }
+            for (arma::uword j = nz; j-- > 0;)
+                {
+                    double s = K.at(r, j);
+                    for (arma::uword k = j + 1; k < nz; k++)
+                        {
+                            s -= K.at(r, k) * L_work.at(k, j);
+                        }
+                    K.at(r, j) = s / L_work.at(j, j);
+                }
+        }
+    return true;
+}
+
+
+/*!
+ * \brief Kalman filter with NX states and NZ measurements.
+ *
+ * The linear filter uses the transition matrix F and the measurement matrix
+ * H. For an extended Kalman filter, pass the Jacobians of the transition and
+ * measurement functions instead, and the innovation z - h(x) to update().
+ */
+template <arma::uword NX, arma::uword NZ>
+class Kalman_Filter
+{
+public:
+    using State = typename arma::Col<double>::template fixed<NX>;
+    using State_Matrix = typename arma::Mat<double>::template fixed<NX, NX>;
+    using Measurement = typename arma::Col<double>::template fixed<NZ>;
+    using Measurement_Covariance = typename arma::Mat<double>::template fixed<NZ, NZ>;
+    using Measurement_Matrix = typename arma::Mat<double>::template fixed<NZ, NX>;
+    using Gain = typename arma::Mat<double>::template fixed<NX, NZ>;
+
+    Kalman_Filter()
+    {
+        d_x.zeros();
+        d_P.eye();
+        d_K.zeros();
+    }
+
+    void initialize(const State& x0, const State_Matrix& P0)
+    {
+        d_x = x0;
+        d_P = P0;
+    }
+
+    /*!
+     * \brief x = F * x, P = F * P * F' + Q
+     */
+    void predict(const State_Matrix& F, const State_Matrix& Q)
+    {
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                double s = 0.0;
+                for (arma::uword k = 0; k < NX; k++)
+                    {
+                        s += F.at(i, k) * d_x.at(k);
+                    }
+                d_x_tmp.at(i) = s;
+            }
+        d_x = d_x_tmp;
+        multiply_transpose(F, d_P, Q);
+    }
+
+    /*!
+     * \brief Measurement update with the innovation (measurement residual)
+     * z - H * x. Returns false, keeping the predicted state, if the
+     * innovation covariance H * P * H' + R is not positive definite.
+     */
+    bool update(const Measurement& innovation, const Measurement_Matrix& H, const Measurement_Covariance& R)
+    {
+        // P_xz = P * H'
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NZ; j++)
+                    {
+                        double s = 0.0;
+                        for (arma::uword k = 0; k < NX; k++)
+                            {
+                                s += d_P.at(i, k) * H.at(j, k);
+                            }
+                        d_P_xz.at(i, j) = s;
+                    }
+            }
+        // S = H * P * H' + R
+        for (arma::uword i = 0; i < NZ; i++)
+            {
+                for (arma::uword j = 0; j < NZ; j++)
+                    {
+                        double s = R.at(i, j);
+                        for (arma::uword k = 0; k < NX; k++)
+                            {
+                                s += H.at(i, k) * d_P_xz.at(k, j);
+                            }
+                        d_S.at(i, j) = s;
+                    }
+            }
+        if (!kalman_gain(d_P_xz, d_S, d_L, d_K))
+            {
+                return false;
+            }
+        // x = x + K * innovation
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NZ; j++)
+                    {
+                        d_x.at(i) += d_K.at(i, j) * innovation.at(j);
+                    }
+            }
+        // Joseph form: P = (I - K * H) * P * (I - K * H)' + K * R * K'
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NX; j++)
+                    {
+                        double s = (i == j) ? 1.0 : 0.0;
+                        for (arma::uword k = 0; k < NZ; k++)
+                            {
+                                s -= d_K.at(i, k) * H.at(k, j);
+                            }
+                        d_A.at(i, j) = s;
+                    }
+            }
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NZ; j++)
+                    {
+                        double s = 0.0;
+                        for (arma::uword k = 0; k < NZ; k++)
+                            {
+                                s += d_K.at(i, k) * R.at(k, j);
+                            }
+                        d_P_xz.at(i, j) = s;  // reused to store K * R
+                    }
+            }
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NX; j++)
+                    {
+                        double s = 0.0;
+                        for (arma::uword k = 0; k < NZ; k++)
+                            {
+                                s += d_P_xz.at(i, k) * d_K.at(j, k);
+                            }
+                        d_Q_tmp.at(i, j) = s;
+                    }
+            }
+        multiply_transpose(d_A, d_P, d_Q_tmp);
+        return true;
+    }
+
+    State& x() { return d_x; }
+    const State& x() const { return d_x; }
+    State_Matrix& P() { return d_P; }
+    const State_Matrix& P() const { return d_P; }
+    const Gain& K() const { return d_K; }  //!< Gain of the last update
+
+private:
+    // P = M * P * M' + Q, symmetrized
+    void multiply_transpose(const State_Matrix& M, State_Matrix& P, const State_Matrix& Q)
+    {
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j < NX; j++)
+                    {
+                        double s = 0.0;
+                        for (arma::uword k = 0; k < NX; k++)
+                            {
+                                s += M.at(i, k) * P.at(k, j);
+                            }
+                        d_MP.at(i, j) = s;
+                    }
+            }
+        for (arma::uword i = 0; i < NX; i++)
+            {
+                for (arma::uword j = 0; j <= i; j++)
+                    {
+                        double s = 0.0;
+                        for (arma::uword k = 0; k < NX; k++)
+                            {
+                                s += d_MP.at(i, k) * M.at(j, k);
+                            }
+                        P.at(i, j) = s + 0.5 * (Q.at(i, j) + Q.at(j, i));
+                        P.at(j, i) = P.at(i, j);
+                    }
+            }
+    }
+
+    State d_x;
+    State d_x_tmp;
+    State_Matrix d_P;
+    State_Matrix d_MP;
+    State_Matrix d_A;
+    State_Matrix d_Q_tmp;
+    Gain d_K;
+    Gain d_P_xz;
+    Measurement_Covariance d_S;
+    Measurement_Covariance d_L;
+};
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_KALMAN_FILTER_H
@@ -33,8 +33,25 @@
  */
 
 #include "lock_detectors.h"
+#include <volk_gnsssdr/volk_gnsssdr.h>
+#include <array>
 #include <cmath>
 
+namespace
+{
+// Indexes of the sums computed by volk_gnsssdr_32fc_moments_32f
+enum Prompt_Moments
+{
+    SUM_RE = 0,
+    SUM_IM,
+    SUM_ABS_RE,
+    SUM_MAG2,
+    SUM_MAG4,
+    NUM_MOMENTS
+};
+}  // namespace
+
+
 /*
  * Signal-to-Noise (SNR) (\f$\rho\f$) estimator using the Signal-to-Noise Variance (SNV) estimator:
  * \f{equation}
@@ -55,16 +72,11 @@ float cn0_svn_estimator(const gr_complex* Prompt_buffer, int length, float coh_i
 {
     float SNR = 0.0;
     float SNR_dB_Hz = 0.0;
-    float Psig = 0.0;
-    float Ptot = 0.0;
-    for (int i = 0; i < length; i++)
-        {
-            Psig += std::abs(Prompt_buffer[i].real());
-            Ptot += Prompt_buffer[i].imag() * Prompt_buffer[i].imag() + Prompt_buffer[i].real() * Prompt_buffer[i].real();
-        }
-    Psig /= static_cast<float>(length);
+    std::array<float, NUM_MOMENTS> moments{};
+    volk_gnsssdr_32fc_moments_32f(moments.data(), Prompt_buffer, static_cast<unsigned int>(length));
+    float Psig = moments[SUM_ABS_RE] / static_cast<float>(length);
     Psig = Psig * Psig;
-    Ptot /= static_cast<float>(length);
+    const float Ptot = moments[SUM_MAG2] / static_cast<float>(length);
     SNR = Psig / (Ptot - Psig);
     SNR_dB_Hz = 10.0F * std::log10(SNR) - 10.0F * std::log10(coh_integration_time_s);
     return SNR_dB_Hz;
@@ -91,23 +103,14 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
 {
     float SNR_aux = 0.0;
     float SNR_dB_Hz = 0.0;
-    float Psig = 0.0;
-    float m_2 = 0.0;
-    float m_4 = 0.0;
-    float aux;
+    std::array<float, NUM_MOMENTS> moments{};
     const auto n = static_cast<float>(length);
-    for (int i = 0; i < length; i++)
-        {
-            Psig += std::abs(Prompt_buffer[i].real());
-            aux = Prompt_buffer[i].imag() * Prompt_buffer[i].imag() + Prompt_buffer[i].real() * Prompt_buffer[i].real();
-            m_2 += aux;
-            m_4 += (aux * aux);
-        }
-    Psig /= n;
+    volk_gnsssdr_32fc_moments_32f(moments.data(), Prompt_buffer, static_cast<unsigned int>(length));
+    float Psig = moments[SUM_ABS_RE] / n;
     Psig = Psig * Psig;
-    m_2 /= n;
-    m_4 /= n;
-    aux = std::sqrt(2.0F * m_2 * m_2 - m_4);
+    const float m_2 = moments[SUM_MAG2] / n;
+    const float m_4 = moments[SUM_MAG4] / n;
+    const float aux = std::sqrt(2.0F * m_2 * m_2 - m_4);
     if (std::isnan(aux))
         {
             SNR_aux = Psig / (m_2 - Psig);
@@ -133,15 +136,12 @@ float cn0_m2m4_estimator(const gr_complex* Prompt_buffer, int length, float coh_
  */
 float carrier_lock_detector(gr_complex* Prompt_buffer, int length)
 {
-    float tmp_sum_I = 0.0;
-    float tmp_sum_Q = 0.0;
+    std::array<float, NUM_MOMENTS> moments{};
+    volk_gnsssdr_32fc_moments_32f(moments.data(), Prompt_buffer, static_cast<unsigned int>(length));
+    const float tmp_sum_I = moments[SUM_RE];
+    const float tmp_sum_Q = moments[SUM_IM];
     float NBD = 0.0;
     float NBP = 0.0;
-    for (int i = 0; i < length; i++)
-        {
-            tmp_sum_I += Prompt_buffer[i].real();
-            tmp_sum_Q += Prompt_buffer[i].imag();
-        }
     NBP = tmp_sum_I * tmp_sum_I + tmp_sum_Q * tmp_sum_Q;
     NBD = tmp_sum_I * tmp_sum_I - tmp_sum_Q * tmp_sum_Q;
     return NBD / NBP;
@@ -27,6 +27,7 @@
  */
 
 #include "nonlinear_tracking.h"
+#include "kalman_filter.h"
 
 /***************** CUBATURE KALMAN FILTER *****************/
 
@@ -149,7 +150,12 @@ void CubatureFilter::update_sequential(const arma::vec& z_upd, const arma::vec&
     P_xz_pred = P_xz_pred / static_cast<float>(np) - x_pred * z_pred.t();
 
     // Compute cubature Kalman gain
-    arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
+    arma::mat W_k(nx, nz);
+    arma::mat L_zz(nz, nz);
+    if (!kalman_gain(P_xz_pred, P_zz_pred, L_zz, W_k))
+        {
+            W_k = P_xz_pred * arma::pinv(P_zz_pred);
+        }
 
     // Compute and store the updated mean and error covariance
     x_est = x_pred + W_k * (z_upd - z_pred);
@@ -327,7 +333,12 @@ void UnscentedFilter::update_sequential(const arma::vec& z_upd, const arma::vec&
     P_zz_pred = P_zz_pred + noise_covariance;
 
     // Estimate cubature Kalman gain
-    arma::mat W_k = P_xz_pred * arma::inv(P_zz_pred);
+    arma::mat W_k(nx, nz);
+    arma::mat L_zz(nz, nz);
+    if (!kalman_gain(P_xz_pred, P_zz_pred, L_zz, W_k))
+        {
+            W_k = P_xz_pred * arma::pinv(P_zz_pred);
+        }
 
     // Estimate and store the updated mean and error covariance
     x_est = x_pred + W_k * (z_upd - z_pred);
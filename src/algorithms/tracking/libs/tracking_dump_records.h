@@ -0,0 +1,75 @@
+/*!
+ * \file tracking_dump_records.h
+ * \brief Records of the binary dump files written by the tracking blocks
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_DUMP_RECORDS_H
+#define GNSS_SDR_TRACKING_DUMP_RECORDS_H
+
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+#pragma pack(push, 1)
+
+/*!
+ * \brief Record written by dll_pll_veml_tracking at each integration period.
+ *
+ * The fields up to EVM are packed in the order of the dump files written by
+ * previous versions. loop_update_sample_count, the sample stamp of the end of
+ * the last integration that updated the loops, was appended after them, so
+ * readers of older files must account for the larger record size.
+ */
+struct Dll_Pll_Veml_Dump_Record
+{
+    float abs_VE;
+    float abs_E;
+    float abs_P;
+    float abs_L;
+    float abs_VL;
+    float Prompt_I;
+    float Prompt_Q;
+    uint64_t PRN_start_sample_count;
+    float acc_carrier_phase_rad;
+    float carrier_doppler_hz;
+    float carrier_doppler_rate_hz;
+    float code_freq_chips;
+    float code_freq_rate_chips;
+    float carr_error_hz;
+    float carr_error_filt_hz;
+    float code_error_chips;
+    float code_error_filt_chips;
+    float CN0_SNV_dB_Hz;
+    float carrier_lock_test;
+    float aux1;
+    double aux2;
+    uint32_t PRN;
+    float acq_code_phase_samples;
+    float acq_carrier_doppler_hz;
+    float EVM;
+    uint64_t loop_update_sample_count;
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(Dll_Pll_Veml_Dump_Record) == 2 * sizeof(uint64_t) + sizeof(double) + 22 * sizeof(float) + sizeof(uint32_t),
+    "Dll_Pll_Veml_Dump_Record must not have padding");
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_DUMP_RECORDS_H
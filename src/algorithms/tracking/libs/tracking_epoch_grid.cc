@@ -0,0 +1,37 @@
+/*!
+ * \file tracking_epoch_grid.cc
+ * \brief Alignment of the extended coherent integrations of the tracking
+ * channels to an epoch grid shared by all the channels of a signal.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_epoch_grid.h"
+#include <cmath>  // for fmod, round
+
+
+int32_t aligned_integration_symbols(uint64_t start_sample, double code_period_samples, int32_t extend_symbols)
+{
+    if (extend_symbols <= 1 || !(code_period_samples > 0.0))
+        {
+            return 1;
+        }
+    const double grid_period_samples = code_period_samples * static_cast<double>(extend_symbols);
+    const double grid_phase_samples = std::fmod(static_cast<double>(start_sample), grid_period_samples);
+    // code periods until the closest grid epoch after start_sample
+    const auto symbols = static_cast<int32_t>(std::round((grid_period_samples - grid_phase_samples) / code_period_samples));
+    if (symbols < 1 || symbols > extend_symbols)
+        {
+            // already aligned: the integration ends at the next epoch
+            return extend_symbols;
+        }
+    return symbols;
+}
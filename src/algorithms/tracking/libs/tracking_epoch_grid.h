@@ -0,0 +1,46 @@
+/*!
+ * \file tracking_epoch_grid.h
+ * \brief Alignment of the extended coherent integrations of the tracking
+ * channels to an epoch grid shared by all the channels of a signal.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#ifndef GNSS_SDR_TRACKING_EPOCH_GRID_H
+#define GNSS_SDR_TRACKING_EPOCH_GRID_H
+
+#include <cstdint>
+
+/** \addtogroup Tracking
+ * \{ */
+/** \addtogroup Tracking_libs
+ * \{ */
+
+
+/*!
+ * \brief Returns the number of code periods, between 1 and extend_symbols,
+ * of the extended coherent integration starting at start_sample, so that it
+ * ends within half a code period of the epoch grid.
+ *
+ * The grid has a period of extend_symbols nominal code periods
+ * (code_period_samples) and its origin at sample 0 of the receiver sample
+ * counter, so it is shared by all the channels of a signal tracked with the
+ * same sampling rate and extend_symbols. The first integration after the
+ * extended integration is enabled, and the ones correcting the drift of the
+ * code epochs against the receiver clock, are shortened; all the others have
+ * extend_symbols code periods.
+ */
+int32_t aligned_integration_symbols(uint64_t start_sample, double code_period_samples, int32_t extend_symbols);
+
+
+/** \} */
+/** \} */
+#endif  // GNSS_SDR_TRACKING_EPOCH_GRID_H
@@ -60,6 +60,10 @@ public:
     {
         return;
     }
+    virtual void set_rf_channel(uint32_t rf_channel __attribute__((unused)))
+    {
+        return;
+    }
     virtual void init() = 0;
     virtual void set_local_code() = 0;
     virtual void set_state(int state) = 0;
@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_signal.h"
+#include <cstdint>
 
 /** \addtogroup Core
  * \{ */
@@ -45,6 +46,10 @@ class ChannelInterface : public GNSSBlockInterface
 public:
     virtual gr::basic_block_sptr get_left_block_trk() = 0;
     virtual gr::basic_block_sptr get_right_block_trk() = 0;
+    virtual int32_t get_right_block_trk_port()
+    {
+        return 0;  // output port of the tracking block, not shared by default
+    }
     virtual gr::basic_block_sptr get_left_block_acq() = 0;
     virtual gr::basic_block_sptr get_right_block_acq() = 0;
     virtual gr::basic_block_sptr get_left_block() = 0;
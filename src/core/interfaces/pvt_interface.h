@@ -29,6 +29,7 @@
 #include "gps_almanac.h"
 #include "gps_ephemeris.h"
 #include <map>
+#include <memory>
 
 /** \addtogroup Core
  * \{ */
@@ -50,10 +51,10 @@ class PvtInterface : public GNSSBlockInterface
 public:
     virtual void reset() = 0;
     virtual void clear_ephemeris() = 0;
-    virtual std::map<int, Gps_Ephemeris> get_gps_ephemeris() const = 0;
-    virtual std::map<int, Galileo_Ephemeris> get_galileo_ephemeris() const = 0;
-    virtual std::map<int, Gps_Almanac> get_gps_almanac() const = 0;
-    virtual std::map<int, Galileo_Almanac> get_galileo_almanac() const = 0;
+    virtual std::shared_ptr<const std::map<int, Gps_Ephemeris>> get_gps_ephemeris() const = 0;
+    virtual std::shared_ptr<const std::map<int, Galileo_Ephemeris>> get_galileo_ephemeris() const = 0;
+    virtual std::shared_ptr<const std::map<int, Gps_Almanac>> get_gps_almanac() const = 0;
+    virtual std::shared_ptr<const std::map<int, Galileo_Almanac>> get_galileo_almanac() const = 0;
 
     virtual bool get_latest_PVT(double* longitude_deg,
         double* latitude_deg,
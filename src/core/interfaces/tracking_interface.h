@@ -25,6 +25,7 @@
 
 #include "gnss_block_interface.h"
 #include "gnss_synchro.h"
+#include <cstdint>
 
 /** \addtogroup Core
  * \{ */
@@ -51,6 +52,15 @@ public:
     virtual void stop_tracking() = 0;
     virtual void set_gnss_synchro(Gnss_Synchro* gnss_synchro) = 0;
     virtual void set_channel(unsigned int channel) = 0;
+
+    /*!
+     * \brief Slot of the channel in a tracking block shared by several
+     * channels, or -1 if the block tracks a single channel
+     */
+    virtual int32_t get_slot()
+    {
+        return -1;
+    }
 };
 
 
@@ -1,6 +1,7 @@
 /*!
  * \file concurrent_queue.h
- * \brief Interface of a thread-safe std::queue
+ * \brief Interface of a thread-safe, lock-free multi-producer,
+ * single-consumer queue
  * \author Javier Arribas, 2011. jarribas(at)cttc.es
  *
  * -----------------------------------------------------------------------------
@@ -17,11 +18,15 @@
 #ifndef GNSS_SDR_CONCURRENT_QUEUE_H
 #define GNSS_SDR_CONCURRENT_QUEUE_H
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <mutex>
-#include <queue>
 #include <thread>
+#include <utility>
 
 /** \addtogroup Core
  * \{ */
@@ -32,71 +37,201 @@
 template <typename Data>
 
 /*!
- * \brief This class implements a thread-safe std::queue
+ * \brief This class implements a thread-safe queue
  *
- * Thread-safe object queue which uses the library
- * boost_thread to perform MUTEX based on the code available at
- * https://www.justsoftwaresolutions.co.uk/threading/implementing-a-thread-safe-queue-using-condition-variables.html
+ * Multi-producer, single-consumer queue. Producers link new nodes with a
+ * single atomic exchange (D. Vyukov's intrusive MPSC algorithm), so pushing
+ * never takes a lock. The mutex and condition variable are only used to put
+ * the consumer to sleep when the queue is empty, and producers only touch
+ * them if the consumer is actually waiting.
+ *
+ * Any number of threads can call push() and emplace(), but only one thread
+ * at a time can call try_pop(), wait_and_pop(), timed_wait_and_pop() or
+ * drain().
+ *
+ * If constructed with a non-zero capacity, items pushed to a full queue are
+ * dropped and counted in overflows().
  */
 class Concurrent_Queue
 {
 public:
-    void push(Data const& data)
+    explicit Concurrent_Queue(size_t capacity = 0) : the_capacity(capacity),
+                                                     the_head(new Node()),
+                                                     the_tail(the_head.load(std::memory_order_relaxed))
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        the_queue.push(data);
-        lock.unlock();
-        the_condition_variable.notify_one();
+    }
+
+    ~Concurrent_Queue()
+    {
+        Node* node = the_tail;
+        while (node != nullptr)
+            {
+                Node* next = node->next.load(std::memory_order_relaxed);
+                delete node;
+                node = next;
+            }
+    }
+
+    Concurrent_Queue(const Concurrent_Queue&) = delete;
+    Concurrent_Queue& operator=(const Concurrent_Queue&) = delete;
+
+    bool push(Data const& data)
+    {
+        return emplace(data);
+    }
+
+    bool push(Data&& data)
+    {
+        return emplace(std::move(data));
+    }
+
+    template <typename... Args>
+    bool emplace(Args&&... args)
+    {
+        if (!reserve())
+            {
+                return false;
+            }
+        Node* node = new Node(std::forward<Args>(args)...);
+        Node* prev = the_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_seq_cst);
+        if (the_consumer_waiting.load(std::memory_order_seq_cst))
+            {
+                std::lock_guard<std::mutex> lock(the_mutex);
+                the_condition_variable.notify_one();
+            }
+        return true;
     }
 
     bool empty() const
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        return the_queue.empty();
+        return the_size.load(std::memory_order_acquire) == 0;
+    }
+
+    size_t size() const
+    {
+        return the_size.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const
+    {
+        return the_capacity;
+    }
+
+    uint64_t overflows() const
+    {
+        return the_overflows.load(std::memory_order_relaxed);
     }
 
     bool try_pop(Data& popped_value)
     {
-        std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
+        Node* tail = the_tail;
+        Node* next = tail->next.load(std::memory_order_seq_cst);
+        if (next == nullptr)
             {
                 return false;
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
+        popped_value = std::move(next->value);
+        the_tail = next;
+        delete tail;
+        the_size.fetch_sub(1, std::memory_order_release);
         return true;
     }
 
     void wait_and_pop(Data& popped_value)
     {
+        if (try_pop(popped_value))
+            {
+                return;
+            }
         std::unique_lock<std::mutex> lock(the_mutex);
-        while (the_queue.empty())
+        start_waiting();
+        while (!try_pop(popped_value))
             {
                 the_condition_variable.wait(lock);
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
+        the_consumer_waiting.store(false, std::memory_order_relaxed);
     }
 
     bool timed_wait_and_pop(Data& popped_value, int wait_ms)
     {
+        if (try_pop(popped_value))
+            {
+                return true;
+            }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_ms);
         std::unique_lock<std::mutex> lock(the_mutex);
-        if (the_queue.empty())
+        start_waiting();
+        bool popped = try_pop(popped_value);
+        while (!popped && the_condition_variable.wait_until(lock, deadline) != std::cv_status::timeout)
             {
-                the_condition_variable.wait_for(lock, std::chrono::milliseconds(wait_ms));
-                if (the_queue.empty())
-                    {
-                        return false;
-                    }
+                popped = try_pop(popped_value);
             }
-        popped_value = the_queue.front();
-        the_queue.pop();
-        return true;
+        the_consumer_waiting.store(false, std::memory_order_relaxed);
+        return popped || try_pop(popped_value);
+    }
+
+    /*!
+     * \brief Moves up to max_items queued items to the back of out, in
+     * arrival order, and returns how many were moved
+     */
+    template <typename Container>
+    size_t drain(Container& out, size_t max_items = std::numeric_limits<size_t>::max())
+    {
+        size_t count = 0;
+        Data value;
+        while (count < max_items && try_pop(value))
+            {
+                out.push_back(std::move(value));
+                count++;
+            }
+        return count;
     }
 
 private:
-    std::queue<Data> the_queue;
-    mutable std::mutex the_mutex;
+    struct Node
+    {
+        Node() = default;
+
+        template <typename... Args>
+        explicit Node(Args&&... args) : value(std::forward<Args>(args)...)
+        {
+        }
+
+        std::atomic<Node*> next{nullptr};
+        Data value{};
+    };
+
+    bool reserve()
+    {
+        if (the_capacity == 0)
+            {
+                the_size.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        if (the_size.fetch_add(1, std::memory_order_relaxed) >= the_capacity)
+            {
+                the_size.fetch_sub(1, std::memory_order_relaxed);
+                the_overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        return true;
+    }
+
+    void start_waiting()
+    {
+        // Pairs with the check of the producers, so that either they see the
+        // flag or the consumer sees their item before going to sleep
+        the_consumer_waiting.store(true, std::memory_order_seq_cst);
+    }
+
+    const size_t the_capacity;
+    std::atomic<Node*> the_head;                 // last pushed node, updated by the producers
+    Node* the_tail;                              // stub node, owned by the consumer
+    std::atomic<size_t> the_size{0};
+    std::atomic<uint64_t> the_overflows{0};
+    std::atomic<bool> the_consumer_waiting{false};
+    std::mutex the_mutex;
     std::condition_variable the_condition_variable;
 };
 
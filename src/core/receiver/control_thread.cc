@@ -34,6 +34,7 @@
 #include "glonass_gnav_ephemeris.h"
 #include "glonass_gnav_utc_model.h"
 #include "gnss_flowgraph.h"
+#include "gnss_replica_store.h"
 #include "gnss_satellite.h"
 #include "gnss_sdr_flags.h"
 #include "gps_acq_assist.h"        // for Gps_Acq_Assist
@@ -69,6 +70,10 @@
 #include <boost/chrono.hpp>  // for steady_clock
 #endif
 
+#if USE_FFT_PLAN_REGISTRY
+#include "gnss_fft_plan_registry.h"
+#endif
+
 #if PMT_USES_BOOST_ANY
 namespace wht = boost;
 #else
@@ -147,6 +152,26 @@ void ControlThread::init()
     telecommand_enabled_ = configuration_->property("GNSS-SDR.telecommand_enabled", false);
     // OPTIONAL: specify a custom year to override the system time in order to postprocess old gnss records and avoid wrong week rollover
     pre_2009_file_ = configuration_->property("GNSS-SDR.pre_2009_file", false);
+#if USE_FFT_PLAN_REGISTRY
+    // OPTIONAL: FFTW wisdom file, loaded before the processing blocks create their FFT plans
+    fftw_wisdom_file_ = configuration_->property("GNSS-SDR.fftw_wisdom_file", std::string(""));
+    if (!fftw_wisdom_file_.empty())
+        {
+            Gnss_Fft_Plan_Registry::instance().load_wisdom(fftw_wisdom_file_);
+        }
+#else
+    if (!configuration_->property("GNSS-SDR.fftw_wisdom_file", std::string("")).empty())
+        {
+            LOG(WARNING) << "GNSS-SDR.fftw_wisdom_file is ignored, since GNSS-SDR was built without the FFTW3 library";
+        }
+#endif
+    // OPTIONAL: code replica cache file, memory-mapped before the processing blocks generate their local codes
+    replica_cache_file_ = configuration_->property("GNSS-SDR.replica_cache_file", std::string(""));
+    Gnss_Replica_Store::instance().set_max_bytes(static_cast<size_t>(configuration_->property("GNSS-SDR.replica_store_max_size_mb", 64)) * 1024 * 1024);
+    if (!replica_cache_file_.empty())
+        {
+            Gnss_Replica_Store::instance().load(replica_cache_file_);
+        }
     // Instantiates a control queue, a GNSS flowgraph, and a control message factory
     control_queue_ = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
     cmd_interface_.set_msg_queue(control_queue_);  // set also the queue pointer for the telecommand thread
@@ -392,18 +417,44 @@ int ControlThread::run()
 #endif
     // Main loop to read and process the control messages
     pmt::pmt_t msg;
+    std::vector<pmt::pmt_t> pending_msgs;
     while (flowgraph_->running() && !stop_)
         {
             // read event messages, triggered by event signaling with a 100 ms timeout to perform low priority receiver management tasks
             bool valid_event = control_queue_->timed_wait_and_pop(msg, 100);
             // call the new sat dispatcher and receiver controller
             event_dispatcher(valid_event, msg);
+            if (valid_event)
+                {
+                    // process the events queued in the meantime (e.g., many channels losing lock at once) in a single pass
+                    pending_msgs.clear();
+                    control_queue_->drain(pending_msgs);
+                    for (auto& pending_msg : pending_msgs)
+                        {
+                            if (stop_)
+                                {
+                                    break;
+                                }
+                            event_dispatcher(valid_event, pending_msg);
+                        }
+                }
         }
     std::cout << "Stopping GNSS-SDR, please wait!\n";
     flowgraph_->stop();
     stop_ = true;
     flowgraph_->disconnect();
 
+#if USE_FFT_PLAN_REGISTRY
+    if (!fftw_wisdom_file_.empty())
+        {
+            Gnss_Fft_Plan_Registry::instance().save_wisdom(fftw_wisdom_file_);
+        }
+#endif
+    if (!replica_cache_file_.empty())
+        {
+            Gnss_Replica_Store::instance().save(replica_cache_file_);
+        }
+
 #ifdef ENABLE_FPGA
     // trigger a HW reset
     // The HW reset causes any HW accelerator module that is waiting for more samples to complete its calculations
@@ -1005,8 +1056,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
     std::cout << "Get visible satellites at " << str_time
               << "UTC, assuming RX position " << LLH[0] << " [deg], " << LLH[1] << " [deg], " << LLH[2] << " [m]\n";
 
-    const std::map<int, Gps_Ephemeris> gps_eph_map = pvt_ptr->get_gps_ephemeris();
-    for (const auto &it : gps_eph_map)
+    const auto gps_eph_map = pvt_ptr->get_gps_ephemeris();
+    for (const auto &it : *gps_eph_map)
         {
             const eph_t rtklib_eph = eph_to_rtklib(it.second, pre_2009_file_);
             std::array<double, 3> r_sat{};
@@ -1030,8 +1081,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Galileo_Ephemeris> gal_eph_map = pvt_ptr->get_galileo_ephemeris();
-    for (const auto &it : gal_eph_map)
+    const auto gal_eph_map = pvt_ptr->get_galileo_ephemeris();
+    for (const auto &it : *gal_eph_map)
         {
             const eph_t rtklib_eph = eph_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -1055,8 +1106,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Gps_Almanac> gps_alm_map = pvt_ptr->get_gps_almanac();
-    for (const auto &it : gps_alm_map)
+    const auto gps_alm_map = pvt_ptr->get_gps_almanac();
+    for (const auto &it : *gps_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -1085,8 +1136,8 @@ std::vector<std::pair<int, Gnss_Satellite>> ControlThread::get_visible_sats(time
                 }
         }
 
-    const std::map<int, Galileo_Almanac> gal_alm_map = pvt_ptr->get_galileo_almanac();
-    for (const auto &it : gal_alm_map)
+    const auto gal_alm_map = pvt_ptr->get_galileo_almanac();
+    for (const auto &it : *gal_alm_map)
         {
             const alm_t rtklib_alm = alm_to_rtklib(it.second);
             std::array<double, 3> r_sat{};
@@ -171,6 +171,9 @@ private:
     const std::string gal_almanac_default_xml_filename_ = "./gal_almanac.xml";
     const std::string gps_almanac_default_xml_filename_ = "./gps_almanac.xml";
 
+    std::string fftw_wisdom_file_;
+    std::string replica_cache_file_;
+
     const size_t channel_event_type_hash_code_ = typeid(channel_event_sptr).hash_code();
     const size_t command_event_type_hash_code_ = typeid(command_event_sptr).hash_code();
 
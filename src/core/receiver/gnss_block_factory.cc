@@ -71,6 +71,7 @@
 #include "gnss_block_interface.h"
 #include "gnss_sdr_make_unique.h"
 #include "gnss_sdr_string_literals.h"
+#include "gps_l1_ca_dll_pll_multichannel_tracking.h"
 #include "gps_l1_ca_dll_pll_tracking.h"
 #include "gps_l1_ca_gaussian_tracking.h"
 #include "gps_l1_ca_kf_tracking.h"
@@ -1079,6 +1080,12 @@ std::unique_ptr<GNSSBlockInterface> GNSSBlockFactory::GetBlock(
                         out_streams);
                     block = std::move(block_);
                 }
+            else if (implementation == "GPS_L1_CA_DLL_PLL_Multichannel_Tracking")
+                {
+                    std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GpsL1CaDllPllMultichannelTracking>(configuration, role, in_streams,
+                        out_streams, multichannel_tracking_[role]);
+                    block = std::move(block_);
+                }
             else if (implementation == "GPS_L1_CA_Gaussian_Tracking")
                 {
                     std::unique_ptr<GNSSBlockInterface> block_ = std::make_unique<GpsL1CaGaussianTracking>(configuration, role, in_streams,
@@ -1535,6 +1542,12 @@ std::unique_ptr<TrackingInterface> GNSSBlockFactory::GetTrkBlock(
                 out_streams);
             block = std::move(block_);
         }
+    else if (implementation == "GPS_L1_CA_DLL_PLL_Multichannel_Tracking")
+        {
+            std::unique_ptr<TrackingInterface> block_ = std::make_unique<GpsL1CaDllPllMultichannelTracking>(configuration, role, in_streams,
+                out_streams, multichannel_tracking_[role]);
+            block = std::move(block_);
+        }
     else if (implementation == "GPS_L1_CA_Gaussian_Tracking")
         {
             std::unique_ptr<TrackingInterface> block_ = std::make_unique<GpsL1CaGaussianTracking>(configuration, role, in_streams,
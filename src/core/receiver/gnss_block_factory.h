@@ -25,7 +25,9 @@
 #define GNSS_SDR_BLOCK_FACTORY_H
 
 #include "concurrent_queue.h"
+#include "gnss_block_interface.h"  // for gnss_shared_ptr
 #include <pmt/pmt.h>
+#include <map>     // for map
 #include <memory>  // for unique_ptr
 #include <string>  // for string
 #include <vector>  // for vector
@@ -42,6 +44,7 @@ class SignalSourceInterface;
 class AcquisitionInterface;
 class TrackingInterface;
 class TelemetryDecoderInterface;
+class dll_pll_multichannel_tracking;
 
 /*!
  * \brief Class that produces all kinds of GNSS blocks
@@ -97,6 +100,9 @@ private:
         const std::string& role,
         unsigned int in_streams,
         unsigned int out_streams);
+
+    // Multichannel tracking blocks, shared by all the channels of a tracking role
+    std::map<std::string, gnss_shared_ptr<dll_pll_multichannel_tracking>> multichannel_tracking_;
 };
 
 
@@ -1131,8 +1131,22 @@ int GNSSFlowgraph::connect_signal_conditioners_to_channels()
                             top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
                                 channels_.at(i)->get_left_block_acq(), 0);
                         }
-                    top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
-                        channels_.at(i)->get_left_block_trk(), 0);
+                    // A multichannel tracking block is shared by several channels,
+                    // and its input is connected only once
+                    bool trk_input_connected = false;
+                    for (int j = 0; j < i; j++)
+                        {
+                            if (channels_.at(j)->get_left_block_trk() == channels_.at(i)->get_left_block_trk())
+                                {
+                                    trk_input_connected = true;
+                                    break;
+                                }
+                        }
+                    if (!trk_input_connected)
+                        {
+                            top_block_->connect(sig_conditioner_.at(selected_signal_conditioner_ID)->get_right_block(), 0,
+                                channels_.at(i)->get_left_block_trk(), 0);
+                        }
                 }
             catch (const std::exception& e)
                 {
@@ -1254,7 +1268,7 @@ int GNSSFlowgraph::connect_tracking_monitor()
         {
             for (int i = 0; i < channels_count_; i++)
                 {
-                    top_block_->connect(channels_.at(i)->get_right_block_trk(), 0, GnssSynchroTrackingMonitor_, i);
+                    top_block_->connect(channels_.at(i)->get_right_block_trk(), channels_.at(i)->get_right_block_trk_port(), GnssSynchroTrackingMonitor_, i);
                 }
         }
     catch (const std::exception& e)
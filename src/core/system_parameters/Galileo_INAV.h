@@ -266,6 +266,7 @@ const std::vector<std::pair<int32_t, int32_t>> CED_af1red_BIT({{123, 6}});
 
 /* Pages 17, 18, 19, 20 */
 const std::vector<std::pair<int32_t, int32_t>> RS_IODNAV_LSBS({{15, 2}});
+const std::vector<std::pair<int32_t, int32_t>> RS_INFO_FIRST_OCTET_BIT({{1, 6}, {15, 2}});  // Word type and IODnav LSBs of word type 1
 constexpr size_t INAV_RS_SUBVECTOR_LENGTH = 15;
 constexpr size_t INAV_RS_PARITY_VECTOR_LENGTH = 60;
 constexpr size_t INAV_RS_INFO_VECTOR_LENGTH = 58;
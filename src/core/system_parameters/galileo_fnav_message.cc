@@ -22,26 +22,28 @@
 
 #include "galileo_fnav_message.h"
 #include <boost/crc.hpp>  // for boost::crc_basic, boost::crc_optimal
-#include <boost/dynamic_bitset.hpp>
 #include <glog/logging.h>
-#include <algorithm>  // for reverse
-#include <iostream>   // for string, operator<<
-#include <iterator>   // for back_insert_iterator
+#include <array>     // for std::array
+#include <iostream>  // for string, operator<<
 
 using CRC_Galileo_FNAV_type = boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false>;
 
+namespace
+{
+// Position of the joined Omega0 pieces of SVID2 in the bitset built by decode_page()
+const std::vector<std::pair<int32_t, int32_t>> OMEGA0_2_JOINED_BIT({{0, 12}});
+}  // namespace
+
 
 void Galileo_Fnav_Message::split_page(const std::string& page_string)
 {
-    const std::string message_word = page_string.substr(0, 214);
-    const std::string CRC_data = page_string.substr(214, 24);
-    const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> Word_for_CRC_bits(message_word);
-    const std::bitset<24> checksum(CRC_data);
+    const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> Word_for_CRC_bits(page_string, 0, GALILEO_FNAV_DATA_FRAME_BITS);
+    const std::bitset<24> checksum(page_string, GALILEO_FNAV_DATA_FRAME_BITS, 24);
     if (CRC_test(Word_for_CRC_bits, checksum.to_ulong()) == true)
         {
             flag_CRC_test = true;
-            // CRC correct: Decode word
-            decode_page(message_word);
+            // CRC correct: Decode word (decode_page() only reads the first GALILEO_FNAV_DATA_FRAME_BITS bits)
+            decode_page(page_string);
         }
     else
         {
@@ -56,15 +58,14 @@ bool Galileo_Fnav_Message::CRC_test(const std::bitset<GALILEO_FNAV_DATA_FRAME_BI
 
     // Galileo FNAV frame for CRC is not an integer multiple of bytes
     // it needs to be filled with zeroes at the start of the frame.
-    // This operation is done in the transformation from bits to bytes
-    // using boost::dynamic_bitset.
-    // ToDo: Use boost::dynamic_bitset for all the bitset operations in this class
-
-    boost::dynamic_bitset<uint8_t> frame_bits(std::string(bits.to_string()));
-
-    std::vector<uint8_t> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
+    std::array<uint8_t, GALILEO_FNAV_DATA_FRAME_BYTES> bytes{};
+    for (int32_t i = 0; i < GALILEO_FNAV_DATA_FRAME_BITS; i++)
+        {
+            if (bits[i])
+                {
+                    bytes[GALILEO_FNAV_DATA_FRAME_BYTES - 1 - i / 8] |= static_cast<uint8_t>(1U << static_cast<uint32_t>(i % 8));
+                }
+        }
 
     CRC_Galileo.process_bytes(bytes.data(), GALILEO_FNAV_DATA_FRAME_BYTES);
 
@@ -227,7 +228,7 @@ void Galileo_Fnav_Message::decode_page(const std::string& data)
             FNAV_deltai_2_5 *= FNAV_DELTAI_5_LSB;
             // TODO check this
             // Omega0_2 must be decoded when the two pieces are joined
-            omega0_1 = data.substr(210, 4);
+            omega0_1 = std::bitset<4>(data, 210, 4);
             // omega_flag=true;
             //
             // FNAV_Omega012_2_5=static_cast<double>(read_navigation_signed(data_bits, FNAV_Omega012_2_5_bit);
@@ -237,11 +238,19 @@ void Galileo_Fnav_Message::decode_page(const std::string& data)
             FNAV_IODa_6 = static_cast<int32_t>(read_navigation_unsigned(data_bits, FNAV_IO_DA_6_BIT));
             // Don't worry about omega pieces. If page 5 has not been received, all_ephemeris
             // flag will be set to false and the data won't be recorded.*/
-            const std::string omega0_2 = data.substr(10, 12);
-            const std::string Omega0 = omega0_1 + omega0_2;
-            const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> omega_bits(Omega0);
-            const std::vector<std::pair<int32_t, int32_t>> om_bit({{0, 12}});
-            FNAV_Omega0_2_6 = static_cast<double>(read_navigation_signed(omega_bits, om_bit));
+            {
+                // Omega0 = omega0_1 (4 bits, page 5) + omega0_2 (12 bits, page 6), in the lowest bits
+                std::bitset<GALILEO_FNAV_DATA_FRAME_BITS> omega_bits;
+                for (int32_t i = 0; i < 4; i++)
+                    {
+                        omega_bits[15 - i] = omega0_1[3 - i];
+                    }
+                for (int32_t i = 0; i < 12; i++)
+                    {
+                        omega_bits[11 - i] = (data[10 + i] == '1');
+                    }
+                FNAV_Omega0_2_6 = static_cast<double>(read_navigation_signed(omega_bits, OMEGA0_2_JOINED_BIT));
+            }
             FNAV_Omega0_2_6 *= FNAV_OMEGA0_5_LSB;
             FNAV_Omegadot_2_6 = static_cast<double>(read_navigation_signed(data_bits, FNAV_OMEGADOT_2_6_BIT));
             FNAV_Omegadot_2_6 *= FNAV_OMEGADOT_5_LSB;
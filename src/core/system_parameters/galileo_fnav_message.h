@@ -143,7 +143,7 @@ private:
     uint64_t read_navigation_unsigned(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
     int64_t read_navigation_signed(const std::bitset<GALILEO_FNAV_DATA_FRAME_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
 
-    std::string omega0_1{};
+    std::bitset<4> omega0_1{};
     // std::string omega0_2{};
     // bool omega_flag{};
 
@@ -20,9 +20,9 @@
 #include "galileo_reduced_ced.h"
 #include "reed_solomon.h"
 #include <boost/crc.hpp>             // for boost::crc_basic, boost::crc_optimal
-#include <boost/dynamic_bitset.hpp>  // for boost::dynamic_bitset
 #include <glog/logging.h>            // for DLOG
-#include <algorithm>                 // for reverse
+#include <algorithm>                 // for std::fill
+#include <array>                     // for std::array
 #include <iostream>                  // for operator<<
 #include <limits>                    // for std::numeric_limits
 #include <numeric>                   // for std::accumulate
@@ -37,6 +37,7 @@ Galileo_Inav_Message::Galileo_Inav_Message()
     // Instantiate ReedSolomon without encoding capabilities, saves some memory
     rs = std::make_unique<ReedSolomon>(60, 29, 1, 195, 0, 137);
     inav_rs_pages = std::vector<int>(8, 0);
+    page_Even.reserve(114);
 }
 
 
@@ -50,15 +51,14 @@ bool Galileo_Inav_Message::CRC_test(const std::bitset<GALILEO_DATA_FRAME_BITS>&
 
     // Galileo INAV frame for CRC is not an integer multiple of bytes
     // it needs to be filled with zeroes at the start of the frame.
-    // This operation is done in the transformation from bits to bytes
-    // using boost::dynamic_bitset.
-    // ToDo: Use boost::dynamic_bitset for all the bitset operations in this class
-
-    boost::dynamic_bitset<unsigned char> frame_bits(std::string(bits.to_string()));
-
-    std::vector<unsigned char> bytes;
-    boost::to_block_range(frame_bits, std::back_inserter(bytes));
-    std::reverse(bytes.begin(), bytes.end());
+    std::array<uint8_t, GALILEO_DATA_FRAME_BYTES> bytes{};
+    for (int32_t i = 0; i < GALILEO_DATA_FRAME_BITS; i++)
+        {
+            if (bits[i])
+                {
+                    bytes[GALILEO_DATA_FRAME_BYTES - 1 - i / 8] |= static_cast<uint8_t>(1U << static_cast<uint32_t>(i % 8));
+                }
+        }
 
     CRC_Galileo.process_bytes(bytes.data(), GALILEO_DATA_FRAME_BYTES);
 
@@ -109,6 +109,21 @@ uint8_t Galileo_Inav_Message::read_octet_unsigned(const std::bitset<GALILEO_DATA
 }
 
 
+uint8_t Galileo_Inav_Message::read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, int32_t first_bit) const
+{
+    uint8_t value = 0;
+    for (int32_t j = 0; j < BITS_IN_OCTET; j++)
+        {
+            value <<= 1;  // shift left
+            if (static_cast<int>(bits[GALILEO_DATA_JK_BITS - first_bit - j]) == 1)
+                {
+                    value += 1;  // insert the bit
+                }
+        }
+    return value;
+}
+
+
 uint64_t Galileo_Inav_Message::read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const
 {
     uint64_t value = 0ULL;
@@ -174,51 +189,47 @@ bool Galileo_Inav_Message::read_navigation_bool(const std::bitset<GALILEO_DATA_J
 }
 
 
-void Galileo_Inav_Message::split_page(std::string page_string, int32_t flag_even_word)
+void Galileo_Inav_Message::split_page(const std::string& page_string, int32_t flag_even_word)
 {
-    int32_t Page_type = 0;
-
+    // The bits are read in place: the even page is kept in page_Even, whose
+    // capacity is reserved in the constructor, and the odd page is not copied
     if (page_string.at(0) == '1')  // if page is odd
         {
-            const std::string& page_Odd = page_string;
-
             if (flag_even_word == 1)  // An odd page has been received but the previous even page is kept in memory and it is considered to join pages
                 {
-                    const std::string page_INAV_even = page_Even;
-                    const std::string page_INAV = page_INAV_even + page_Odd;  // Join pages: Even + Odd = INAV page
-                    const std::string Even_bit = page_INAV.substr(0, 1);
-                    const std::string Page_type_even = page_INAV.substr(1, 1);
-                    const std::string nominal = "0";
-
-                    const std::string Data_k = page_INAV.substr(2, 112);
-                    const std::string Odd_bit = page_INAV.substr(114, 1);
-                    const std::string Page_type_Odd = page_INAV.substr(115, 1);
-                    const std::string Data_j = page_INAV.substr(116, 16);
-
-                    const std::string Reserved_1 = page_INAV.substr(132, 40);
-                    const std::string SAR = page_INAV.substr(172, 22);
-                    const std::string Spare = page_INAV.substr(194, 2);
-                    const std::string CRC_data = page_INAV.substr(196, 24);
-                    const std::string Reserved_2 = page_INAV.substr(220, 8);
-                    const std::string Tail_odd = page_INAV.substr(228, 6);
+                    // INAV page = Even + Odd:
+                    // Even: even bit (1), page type (1), Data_k (112), tail (6)
+                    // Odd: odd bit (1), page type (1), Data_j (16), Reserved 1 (40), SAR (22), spare (2), CRC (24), Reserved 2 (8), tail (6)
+                    constexpr int32_t even_bits = 114;
+                    constexpr int32_t odd_crc_start = 82;
 
                     // ************ CRC checksum control *******/
-                    std::stringstream TLM_word_for_CRC_stream;
-                    TLM_word_for_CRC_stream << page_INAV;
-                    const std::string TLM_word_for_CRC = TLM_word_for_CRC_stream.str().substr(0, GALILEO_DATA_FRAME_BITS);
-                    const std::bitset<GALILEO_DATA_FRAME_BITS> TLM_word_for_CRC_bits(TLM_word_for_CRC);
-                    const std::bitset<24> checksum(CRC_data);
+                    std::bitset<GALILEO_DATA_FRAME_BITS> TLM_word_for_CRC_bits;
+                    for (int32_t i = 0; i < even_bits; i++)
+                        {
+                            TLM_word_for_CRC_bits[GALILEO_DATA_FRAME_BITS - 1 - i] = (page_Even[i] == '1');
+                        }
+                    for (int32_t i = 0; i < odd_crc_start; i++)
+                        {
+                            TLM_word_for_CRC_bits[GALILEO_DATA_FRAME_BITS - 1 - even_bits - i] = (page_string[i] == '1');
+                        }
+                    const std::bitset<24> checksum(page_string, odd_crc_start, 24);
 
                     if (CRC_test(TLM_word_for_CRC_bits, checksum.to_ulong()) == true)
                         {
                             flag_CRC_test = true;
-                            // CRC correct: Decode word
-                            const std::string page_number_bits = Data_k.substr(0, 6);
-                            const std::bitset<GALILEO_PAGE_TYPE_BITS> page_type_bits(page_number_bits);  // from string to bitset
-                            Page_type = static_cast<int32_t>(read_page_type_unsigned(page_type_bits, TYPE));
-                            Page_type_time_stamp = Page_type;
-                            const std::string Data_jk_ephemeris = Data_k + Data_j;
-                            page_jk_decoder(Data_jk_ephemeris.c_str());
+                            // CRC correct: Decode word Data_jk = Data_k + Data_j
+                            std::bitset<GALILEO_DATA_JK_BITS> data_jk_bits;
+                            for (int32_t i = 0; i < 112; i++)
+                                {
+                                    data_jk_bits[GALILEO_DATA_JK_BITS - 1 - i] = (page_Even[2 + i] == '1');
+                                }
+                            for (int32_t i = 0; i < 16; i++)
+                                {
+                                    data_jk_bits[GALILEO_DATA_JK_BITS - 113 - i] = (page_string[2 + i] == '1');
+                                }
+                            Page_type_time_stamp = static_cast<int32_t>(read_navigation_unsigned(data_jk_bits, PAGE_TYPE_BIT));
+                            decode_data_jk(data_jk_bits);
                         }
                     else
                         {
@@ -229,7 +240,7 @@ void Galileo_Inav_Message::split_page(std::string page_string, int32_t flag_even
         }          // end if (page_string.at(0)=='1')
     else
         {
-            page_Even = page_string.substr(0, 114);
+            page_Even.assign(page_string, 0, 114);
         }
 }
 
@@ -351,7 +362,7 @@ bool Galileo_Inav_Message::have_new_ephemeris()  // Check if we have a new ephem
                                 }
 
                             // Reset flags
-                            inav_rs_pages = std::vector<int>(8, 0);
+                            std::fill(inav_rs_pages.begin(), inav_rs_pages.end(), 0);
                             flag_ephemeris_1 = false;  // clear the flag
                             flag_ephemeris_2 = false;  // clear the flag
                             flag_ephemeris_3 = false;  // clear the flag
@@ -838,9 +849,13 @@ std::bitset<GALILEO_DATA_JK_BITS> Galileo_Inav_Message::regenerate_page_4(const
 
 int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
 {
-    const std::string data_jk_string = data_jk;
-    const std::bitset<GALILEO_DATA_JK_BITS> data_jk_bits(data_jk_string);
+    const std::bitset<GALILEO_DATA_JK_BITS> data_jk_bits(data_jk);
+    return decode_data_jk(data_jk_bits);
+}
+
 
+int32_t Galileo_Inav_Message::decode_data_jk(const std::bitset<GALILEO_DATA_JK_BITS>& data_jk_bits)
+{
     const auto page_number = static_cast<int32_t>(read_navigation_unsigned(data_jk_bits, PAGE_TYPE_BIT));
     DLOG(INFO) << "Page number = " << page_number;
 
@@ -859,21 +874,18 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                             {
                                 // IODnav changed, reset buffer
                                 current_IODnav = IOD_nav_1;
-                                rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
+                                std::fill(rs_buffer.begin(), rs_buffer.end(), 0);
                                 // Reed-Solomon data is invalid
-                                inav_rs_pages = std::vector<int>(8, 0);
+                                std::fill(inav_rs_pages.begin(), inav_rs_pages.end(), 0);
                             }
 
                         // Store RS information vector C_{RS,0}
-                        std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{1, 6}, {15, 2}});
-                        rs_buffer[0] = read_octet_unsigned(data_jk_bits, info_octet_bits);
-                        info_octet_bits = std::vector<std::pair<int32_t, int32_t>>({{7, BITS_IN_OCTET}});
-                        rs_buffer[1] = read_octet_unsigned(data_jk_bits, info_octet_bits);
+                        rs_buffer[0] = read_octet_unsigned(data_jk_bits, RS_INFO_FIRST_OCTET_BIT);
+                        rs_buffer[1] = read_octet_unsigned(data_jk_bits, FIRST_RS_BIT);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 2; i < 16; i++)
                             {
-                                info_octet_bits = std::vector<std::pair<int32_t, int32_t>>({{start_bit, BITS_IN_OCTET}});
-                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
+                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[0] = 1;
@@ -895,9 +907,9 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                             {
                                 // IODnav changed, reset buffer
                                 current_IODnav = IOD_nav_2;
-                                rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
+                                std::fill(rs_buffer.begin(), rs_buffer.end(), 0);
                                 // Reed-Solomon data is invalid
-                                inav_rs_pages = std::vector<int>(8, 0);
+                                std::fill(inav_rs_pages.begin(), inav_rs_pages.end(), 0);
                             }
 
                         // Store RS information vector C_{RS,1}
@@ -905,8 +917,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 16; i < 30; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
-                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
+                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[1] = 1;
@@ -926,9 +937,9 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                             {
                                 // IODnav changed, reset buffer
                                 current_IODnav = IOD_nav_3;
-                                rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
+                                std::fill(rs_buffer.begin(), rs_buffer.end(), 0);
                                 // Reed-Solomon data is invalid
-                                inav_rs_pages = std::vector<int>(8, 0);
+                                std::fill(inav_rs_pages.begin(), inav_rs_pages.end(), 0);
                             }
 
                         // Store RS information vector C_{RS,2}
@@ -936,8 +947,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 30; i < 44; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
-                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
+                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[2] = 1;
@@ -958,9 +968,9 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                             {
                                 // IODnav changed, reset buffer
                                 current_IODnav = IOD_nav_4;
-                                rs_buffer = std::vector<uint8_t>(INAV_RS_BUFFER_LENGTH, 0);
+                                std::fill(rs_buffer.begin(), rs_buffer.end(), 0);
                                 // Reed-Solomon data is invalid
-                                inav_rs_pages = std::vector<int>(8, 0);
+                                std::fill(inav_rs_pages.begin(), inav_rs_pages.end(), 0);
                             }
 
                         // Store RS information vector C_{RS,3}
@@ -968,8 +978,7 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 44; i < INAV_RS_INFO_VECTOR_LENGTH; i++)
                             {
-                                std::vector<std::pair<int32_t, int32_t>> info_octet_bits({{start_bit, BITS_IN_OCTET}});
-                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, info_octet_bits);
+                                rs_buffer[i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[3] = 1;
@@ -1251,13 +1260,11 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,0}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
-                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, FIRST_RS_BIT);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 1; i < INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
-                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[4] = 1;
@@ -1280,13 +1287,11 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,1}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
-                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, FIRST_RS_BIT);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = INAV_RS_SUBVECTOR_LENGTH + 1; i < 2 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
-                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[5] = 1;
@@ -1309,13 +1314,11 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,2}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
-                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 2 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 2 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, FIRST_RS_BIT);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 2 * INAV_RS_SUBVECTOR_LENGTH + 1; i < 3 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
-                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[6] = 1;
@@ -1338,13 +1341,11 @@ int32_t Galileo_Inav_Message::page_jk_decoder(const char* data_jk)
                                 inav_rs_pages[3] = 0;
                             }
                         // Store RS parity vector gamma_{RS,4}
-                        std::vector<std::pair<int32_t, int32_t>> gamma_octet_bits({{FIRST_RS_BIT, BITS_IN_OCTET}});
-                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 3 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                        rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + 3 * INAV_RS_SUBVECTOR_LENGTH] = read_octet_unsigned(data_jk_bits, FIRST_RS_BIT);
                         int32_t start_bit = FIRST_RS_BIT_AFTER_IODNAV;
                         for (size_t i = 3 * INAV_RS_SUBVECTOR_LENGTH + 1; i < 4 * INAV_RS_SUBVECTOR_LENGTH; i++)
                             {
-                                gamma_octet_bits[0] = std::pair<int32_t, int32_t>({start_bit, BITS_IN_OCTET});
-                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, gamma_octet_bits);
+                                rs_buffer[INAV_RS_INFO_VECTOR_LENGTH + i] = read_octet_unsigned(data_jk_bits, start_bit);
                                 start_bit += BITS_IN_OCTET;
                             }
                         inav_rs_pages[7] = 1;
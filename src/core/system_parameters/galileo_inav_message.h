@@ -55,7 +55,7 @@ public:
     /*
      * \brief Takes in input a page (Odd or Even) of 120 bit, split it according ICD 4.3.2.3 and join Data_k with Data_j
      */
-    void split_page(std::string page_string, int32_t flag_even_word);
+    void split_page(const std::string& page_string, int32_t flag_even_word);
 
     /*
      * \brief Takes in input Data_jk (128 bit) and split it in ephemeris parameters according ICD 4.3.5
@@ -227,6 +227,8 @@ private:
     uint64_t read_page_type_unsigned(const std::bitset<GALILEO_PAGE_TYPE_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
     int64_t read_navigation_signed(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
     uint8_t read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, const std::vector<std::pair<int32_t, int32_t>>& parameter) const;
+    uint8_t read_octet_unsigned(const std::bitset<GALILEO_DATA_JK_BITS>& bits, int32_t first_bit) const;
+    int32_t decode_data_jk(const std::bitset<GALILEO_DATA_JK_BITS>& data_jk_bits);
     void read_page_1(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
     void read_page_2(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
     void read_page_3(const std::bitset<GALILEO_DATA_JK_BITS>& data_bits);
@@ -20,6 +20,7 @@
 #include "MATH_CONSTANTS.h"  // for TWO_N20, TWO_N30, TWO_N14, TWO_N15, TWO_N18
 #include "gnss_satellite.h"
 #include <glog/logging.h>
+#include <array>    // for std::array
 #include <cstddef>  // for size_t
 #include <ostream>  // for operator<<
 
@@ -40,7 +41,7 @@ bool Glonass_Gnav_Navigation_Message::CRC_test(const std::bitset<GLONASS_GNAV_ST
 {
     uint32_t sum_bits = 0;
     int32_t sum_hamming = 0;
-    std::vector<uint32_t> string_bits(GLONASS_GNAV_STRING_BITS);
+    std::array<uint32_t, GLONASS_GNAV_STRING_BITS> string_bits{};
 
     // Populate data and hamming code vectors
     for (size_t i = 0; i < string_bits.size(); i++)
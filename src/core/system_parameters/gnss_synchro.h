@@ -22,7 +22,6 @@
 
 #include <boost/serialization/nvp.hpp>
 #include <cstdint>
-#include <utility>
 
 /** \addtogroup Core
  * \{ */
@@ -34,25 +33,25 @@
 /*!
  * \brief This is the class that contains the information that is shared
  * by the processing blocks.
+ *
+ * It is the item type of the streams from tracking to telemetry decoding,
+ * observables and PVT, so it is kept trivially copyable: buffers of
+ * Gnss_Synchro objects can be copied with memcpy. Members are ordered to
+ * avoid padding, with the fields used along the tracking to PVT path in the
+ * first two cache lines (128 bytes) and the acquisition results, only read
+ * by tracking at pull-in and by the monitors, at the end.
  */
 class Gnss_Synchro
 {
 public:
-    Gnss_Synchro() = default;  //!< Default constructor
-
-    ~Gnss_Synchro() = default;  //!< Default destructor
-
     // Satellite and signal info
     char System{};         //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     char Signal[3]{};      //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     uint32_t PRN{};        //!< Set by Channel::set_signal(Gnss_Signal gnss_signal)
     int32_t Channel_ID{};  //!< Set by Channel constructor
 
-    // Acquisition
-    double Acq_delay_samples{};          //!< Set by Acquisition processing block
-    double Acq_doppler_hz{};             //!< Set by Acquisition processing block
-    uint64_t Acq_samplestamp_samples{};  //!< Set by Acquisition processing block
-    uint32_t Acq_doppler_step{};         //!< Set by Acquisition processing block
+    // Telemetry Decoder
+    uint32_t TOW_at_current_symbol_ms{};  //!< Set by Telemetry Decoder processing block
 
     // Tracking
     int64_t fs{};                        //!< Set by Tracking processing block
@@ -63,114 +62,29 @@ public:
     double Carrier_phase_rads{};         //!< Set by Tracking processing block
     double Code_phase_samples{};         //!< Set by Tracking processing block
     uint64_t Tracking_sample_counter{};  //!< Set by Tracking processing block
-    int32_t correlation_length_ms{};     //!< Set by Tracking processing block
-
-    // Telemetry Decoder
-    uint32_t TOW_at_current_symbol_ms{};  //!< Set by Telemetry Decoder processing block
 
     // Observables
     double Pseudorange_m{};  //!< Set by Observables processing block
     double RX_time{};        //!< Set by Observables processing block
     double interp_TOW_ms{};  //!< Set by Observables processing block
 
+    // Indicators
+    double EVM{};  //!< Set by Tracking processing block
+
+    int32_t correlation_length_ms{};  //!< Set by Tracking processing block
+
     // Flags
     bool Flag_valid_acquisition{};         //!< Set by Acquisition processing block
     bool Flag_valid_symbol_output{};       //!< Set by Tracking processing block
     bool Flag_valid_word{};                //!< Set by Telemetry Decoder processing block
     bool Flag_valid_pseudorange{};         //!< Set by Observables processing block
     bool Flag_PLL_180_deg_phase_locked{};  //!< Set by Telemetry Decoder processing block
-     
-    // Indicators
-    double EVM{};					//!< Set by Tracking processing block
-    
-    /// Copy constructor
-    Gnss_Synchro(const Gnss_Synchro& other) noexcept
-    {
-        *this = other;
-    };
-
-    /// Copy assignment operator
-    Gnss_Synchro& operator=(const Gnss_Synchro& rhs) noexcept
-    {
-        // Only do assignment if RHS is a different object from this.
-        if (this != &rhs)
-            {
-                this->System = rhs.System;
-                this->Signal[0] = rhs.Signal[0];
-                this->Signal[1] = rhs.Signal[1];
-                this->Signal[2] = rhs.Signal[2];
-                this->PRN = rhs.PRN;
-                this->Channel_ID = rhs.Channel_ID;
-                this->Acq_delay_samples = rhs.Acq_delay_samples;
-                this->Acq_doppler_hz = rhs.Acq_doppler_hz;
-                this->Acq_samplestamp_samples = rhs.Acq_samplestamp_samples;
-                this->Acq_doppler_step = rhs.Acq_doppler_step;
-                this->fs = rhs.fs;
-                this->Prompt_I = rhs.Prompt_I;
-                this->Prompt_Q = rhs.Prompt_Q;
-                this->CN0_dB_hz = rhs.CN0_dB_hz;
-                this->Carrier_Doppler_hz = rhs.Carrier_Doppler_hz;
-                this->Carrier_phase_rads = rhs.Carrier_phase_rads;
-                this->Code_phase_samples = rhs.Code_phase_samples;
-                this->Tracking_sample_counter = rhs.Tracking_sample_counter;
-                this->correlation_length_ms = rhs.correlation_length_ms;
-                this->TOW_at_current_symbol_ms = rhs.TOW_at_current_symbol_ms;
-                this->Pseudorange_m = rhs.Pseudorange_m;
-                this->RX_time = rhs.RX_time;
-                this->interp_TOW_ms = rhs.interp_TOW_ms;
-                this->Flag_valid_acquisition = rhs.Flag_valid_acquisition;
-                this->Flag_valid_symbol_output = rhs.Flag_valid_symbol_output;
-                this->Flag_valid_word = rhs.Flag_valid_word;
-                this->Flag_valid_pseudorange = rhs.Flag_valid_pseudorange;
-                this->Flag_PLL_180_deg_phase_locked = rhs.Flag_PLL_180_deg_phase_locked;
-                this->EVM = rhs.EVM;
-            }
-        return *this;
-    };
-
-    /// Move constructor
-    Gnss_Synchro(Gnss_Synchro&& other) noexcept
-    {
-        *this = std::move(other);
-    };
 
-    /// Move assignment operator
-    Gnss_Synchro& operator=(Gnss_Synchro&& other) noexcept
-    {
-        if (this != &other)
-            {
-                this->System = other.System;
-                this->Signal[0] = other.Signal[0];
-                this->Signal[1] = other.Signal[1];
-                this->Signal[2] = other.Signal[2];
-                this->PRN = other.PRN;
-                this->Channel_ID = other.Channel_ID;
-                this->Acq_delay_samples = other.Acq_delay_samples;
-                this->Acq_doppler_hz = other.Acq_doppler_hz;
-                this->Acq_samplestamp_samples = other.Acq_samplestamp_samples;
-                this->Acq_doppler_step = other.Acq_doppler_step;
-                this->fs = other.fs;
-                this->Prompt_I = other.Prompt_I;
-                this->Prompt_Q = other.Prompt_Q;
-                this->CN0_dB_hz = other.CN0_dB_hz;
-                this->Carrier_Doppler_hz = other.Carrier_Doppler_hz;
-                this->Carrier_phase_rads = other.Carrier_phase_rads;
-                this->Code_phase_samples = other.Code_phase_samples;
-                this->Tracking_sample_counter = other.Tracking_sample_counter;
-                this->correlation_length_ms = other.correlation_length_ms;
-                this->TOW_at_current_symbol_ms = other.TOW_at_current_symbol_ms;
-                this->Pseudorange_m = other.Pseudorange_m;
-                this->RX_time = other.RX_time;
-                this->interp_TOW_ms = other.interp_TOW_ms;
-                this->Flag_valid_acquisition = other.Flag_valid_acquisition;
-                this->Flag_valid_symbol_output = other.Flag_valid_symbol_output;
-                this->Flag_valid_word = other.Flag_valid_word;
-                this->Flag_valid_pseudorange = other.Flag_valid_pseudorange;
-                this->Flag_PLL_180_deg_phase_locked = other.Flag_PLL_180_deg_phase_locked;
-                this->EVM = other.EVM;
-            }
-        return *this;
-    };
+    // Acquisition
+    uint32_t Acq_doppler_step{};         //!< Set by Acquisition processing block
+    double Acq_delay_samples{};          //!< Set by Acquisition processing block
+    double Acq_doppler_hz{};             //!< Set by Acquisition processing block
+    uint64_t Acq_samplestamp_samples{};  //!< Set by Acquisition processing block
 
     /*!
      * \brief This member function serializes and restores
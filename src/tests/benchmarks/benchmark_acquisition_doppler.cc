@@ -0,0 +1,135 @@
+/*!
+ * \file benchmark_acquisition_doppler.cc
+ * \brief Benchmark for the Doppler search strategies of the PCPS acquisition
+ *
+ * Runs a pcps_acquisition block in a flowgraph over a GPS L1 C/A signal buried
+ * in noise, with a threshold that is never reached, so that every block of
+ * samples goes through a full Doppler grid search. Compares the time-domain
+ * Doppler wipeoff (one forward FFT per Doppler bin) with the frequency-domain
+ * search (one forward FFT per residual frequency, Doppler bins formed by
+ * circular shifts of the input spectrum). The reported items per second are
+ * dwells per second.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "acq_conf.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include "pcps_acquisition.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/top_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+constexpr int64_t FS_HZ = 4000000;     // sampling rate, 1 ms of signal per FFT
+constexpr uint32_t FFT_SIZE = 4000;    // 1 kHz FFT resolution
+constexpr float DOPPLER_STEP = 250.0;  // 4 residual frequencies
+constexpr uint64_t NUM_DWELLS = 50;
+constexpr uint32_t PRN = 1;
+
+
+namespace
+{
+std::vector<gr_complex> make_signal()
+{
+    // 10 ms of PRN 1 at 1250 Hz of Doppler plus noise, repeated by the source
+    const uint32_t length = 10 * FFT_SIZE;
+    volk_gnsssdr::vector<std::complex<float>> code(FFT_SIZE);
+    gps_l1_ca_code_gen_complex_sampled(code, PRN, FS_HZ, 0);
+    std::default_random_engine e2(1);
+    std::normal_distribution<float> dist(0.0, 4.0);
+    std::vector<gr_complex> signal(length);
+    for (uint32_t i = 0; i < length; i++)
+        {
+            const double phase = TWO_PI * 1250.0 * static_cast<double>(i) / static_cast<double>(FS_HZ);
+            signal[i] = code[i % FFT_SIZE] * gr_complex(std::cos(phase), std::sin(phase)) + gr_complex(dist(e2), dist(e2));
+        }
+    return signal;
+}
+
+
+void run_acquisition(benchmark::State& state, bool frequency_domain_doppler)
+{
+    Acq_Conf conf;
+    conf.fs_in = FS_HZ;
+    conf.resampled_fs = FS_HZ;
+    conf.samples_per_ms = static_cast<float>(FS_HZ) * 0.001F;
+    conf.samples_per_code = conf.samples_per_ms;
+    conf.samples_per_chip = static_cast<uint32_t>(std::ceil(static_cast<double>(FS_HZ) / GPS_L1_CA_CODE_RATE_CPS));
+    conf.chips_per_second = static_cast<uint32_t>(GPS_L1_CA_CODE_RATE_CPS);
+    conf.doppler_max = static_cast<int32_t>(state.range(0));
+    conf.doppler_step = DOPPLER_STEP;
+    conf.max_dwells = NUM_DWELLS + 1;  // never ends the search
+    conf.blocking = true;
+    conf.frequency_domain_doppler = frequency_domain_doppler;
+
+    const std::vector<gr_complex> signal = make_signal();
+    volk_gnsssdr::vector<std::complex<float>> code(FFT_SIZE);
+    gps_l1_ca_code_gen_complex_sampled(code, PRN, FS_HZ, 0);
+
+    while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            Gnss_Synchro gnss_synchro{};
+            gnss_synchro.System = 'G';
+            gnss_synchro.Signal[0] = '1';
+            gnss_synchro.Signal[1] = 'C';
+            gnss_synchro.PRN = PRN;
+            auto acquisition = pcps_make_acquisition(conf);
+            acquisition->set_gnss_synchro(&gnss_synchro);
+            acquisition->set_local_code(code.data());
+            acquisition->set_threshold(1e9);
+            acquisition->init();
+            acquisition->set_state(1);
+
+            auto top_block = gr::make_top_block("Acquisition Doppler benchmark");
+            auto source = gr::blocks::vector_source_c::make(signal, true);
+            auto head = gr::blocks::head::make(sizeof(gr_complex), NUM_DWELLS * FFT_SIZE);
+            top_block->connect(source, 0, head, 0);
+            top_block->connect(head, 0, acquisition, 0);
+            state.ResumeTiming();
+            top_block->run();
+        }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(NUM_DWELLS));
+}
+}  // namespace
+
+
+void bm_time_domain_doppler_search(benchmark::State& state)
+{
+    run_acquisition(state, false);
+}
+
+
+void bm_frequency_domain_doppler_search(benchmark::State& state)
+{
+    run_acquisition(state, true);
+}
+
+
+BENCHMARK(bm_time_domain_doppler_search)->Arg(5000)->Arg(10000)->Arg(20000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_frequency_domain_doppler_search)->Arg(5000)->Arg(10000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
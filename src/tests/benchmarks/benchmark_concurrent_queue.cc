@@ -0,0 +1,130 @@
+/*!
+ * \file benchmark_concurrent_queue.cc
+ * \brief Benchmark for the contention of the control event queue when many
+ * channels post events at once
+ *
+ * Compares the lock-free Concurrent_Queue with a std::queue protected by a
+ * mutex and a condition variable.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include <benchmark/benchmark.h>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+constexpr int EVENTS_PER_CHANNEL = 2000;
+
+namespace
+{
+// Same size and ownership semantics as a channel event wrapped in a pmt
+struct Event
+{
+    int32_t channel_id;
+    int32_t event_type;
+};
+using Event_Ptr = std::shared_ptr<Event>;
+
+
+template <typename Data>
+class Mutex_Queue
+{
+public:
+    void push(Data const& data)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        the_queue.push(data);
+        lock.unlock();
+        the_condition_variable.notify_one();
+    }
+
+    void wait_and_pop(Data& popped_value)
+    {
+        std::unique_lock<std::mutex> lock(the_mutex);
+        while (the_queue.empty())
+            {
+                the_condition_variable.wait(lock);
+            }
+        popped_value = the_queue.front();
+        the_queue.pop();
+    }
+
+private:
+    std::queue<Data> the_queue;
+    std::mutex the_mutex;
+    std::condition_variable the_condition_variable;
+};
+
+
+template <typename Queue>
+void run_channels(Queue& queue, int num_channels)
+{
+    std::vector<std::thread> channels;
+    channels.reserve(num_channels);
+    for (int ch = 0; ch < num_channels; ch++)
+        {
+            channels.emplace_back([&queue, ch]() {
+                for (int i = 0; i < EVENTS_PER_CHANNEL; i++)
+                    {
+                        queue.push(std::make_shared<Event>(Event{ch, i % 3}));
+                    }
+            });
+        }
+    Event_Ptr event;
+    int64_t received = 0;
+    for (int i = 0; i < num_channels * EVENTS_PER_CHANNEL; i++)
+        {
+            queue.wait_and_pop(event);
+            received += event->event_type;
+        }
+    for (auto& channel : channels)
+        {
+            channel.join();
+        }
+    benchmark::DoNotOptimize(received);
+}
+}  // namespace
+
+
+void bm_mutex_queue(benchmark::State& state)
+{
+    const auto num_channels = static_cast<int>(state.range(0));
+    while (state.KeepRunning())
+        {
+            Mutex_Queue<Event_Ptr> queue;
+            run_channels(queue, num_channels);
+        }
+    state.SetItemsProcessed(state.iterations() * num_channels * EVENTS_PER_CHANNEL);
+}
+
+
+void bm_lock_free_queue(benchmark::State& state)
+{
+    const auto num_channels = static_cast<int>(state.range(0));
+    while (state.KeepRunning())
+        {
+            Concurrent_Queue<Event_Ptr> queue;
+            run_channels(queue, num_channels);
+        }
+    state.SetItemsProcessed(state.iterations() * num_channels * EVENTS_PER_CHANNEL);
+}
+
+
+BENCHMARK(bm_mutex_queue)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bm_lock_free_queue)->RangeMultiplier(2)->Range(1, 32)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
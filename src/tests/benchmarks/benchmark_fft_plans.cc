@@ -0,0 +1,122 @@
+/*!
+ * \file benchmark_fft_plans.cc
+ * \brief Benchmark for the creation of the FFT objects of a multi-channel,
+ * multi-constellation receiver at startup
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_sdr_fft.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/fft/fft.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+#if USE_FFT_PLAN_REGISTRY
+#include "gnss_fft_plan_registry.h"
+#include <fftw3.h>
+#endif
+
+// 64 channels at 4 Msps: GPS L1 C/A (1 ms), Galileo E1 (4 ms), GPS L5 and Galileo E5a (1 ms at 4x chip rate)
+constexpr int NUM_CHANNELS = 64;
+constexpr std::array<int, 4> FFT_SIZES{4000, 16000, 4000, 4000};
+
+
+void bm_gr_fft_per_block_plans(benchmark::State& state)
+{
+    while (state.KeepRunning())
+        {
+#if GNURADIO_FFT_USES_TEMPLATES
+            std::vector<std::unique_ptr<gr::fft::fft_complex_fwd>> fwd;
+            std::vector<std::unique_ptr<gr::fft::fft_complex_rev>> rev;
+#else
+            std::vector<std::unique_ptr<gr::fft::fft_complex>> fwd;
+            std::vector<std::unique_ptr<gr::fft::fft_complex>> rev;
+#endif
+            for (int ch = 0; ch < NUM_CHANNELS; ch++)
+                {
+                    const int fft_size = FFT_SIZES[ch % FFT_SIZES.size()];
+#if GNURADIO_FFT_USES_TEMPLATES
+                    fwd.push_back(std::make_unique<gr::fft::fft_complex_fwd>(fft_size));
+                    rev.push_back(std::make_unique<gr::fft::fft_complex_rev>(fft_size));
+#else
+                    fwd.push_back(std::make_unique<gr::fft::fft_complex>(fft_size, true));
+                    rev.push_back(std::make_unique<gr::fft::fft_complex>(fft_size, false));
+#endif
+                }
+            benchmark::DoNotOptimize(fwd.data());
+            benchmark::DoNotOptimize(rev.data());
+        }
+}
+
+
+void bm_gnss_sdr_fft_plans(benchmark::State& state)
+{
+    while (state.KeepRunning())
+        {
+            std::vector<std::unique_ptr<gnss_fft_complex_fwd>> fwd;
+            std::vector<std::unique_ptr<gnss_fft_complex_rev>> rev;
+            for (int ch = 0; ch < NUM_CHANNELS; ch++)
+                {
+                    const int fft_size = FFT_SIZES[ch % FFT_SIZES.size()];
+                    fwd.push_back(gnss_fft_fwd_make_unique(fft_size));
+                    rev.push_back(gnss_fft_rev_make_unique(fft_size));
+                }
+            benchmark::DoNotOptimize(fwd.data());
+            benchmark::DoNotOptimize(rev.data());
+        }
+}
+
+
+#if USE_FFT_PLAN_REGISTRY
+// Cost of one forward FFT plan for each acquisition FFT size at 4 Msps: GPS L1
+// C/A, Galileo E5a and GPS L5 (1 ms), GPS L1 C/A with bit_transition_flag
+// (2 ms), Galileo E1 (4 ms) and GPS L2C (M) (20 ms). Plans are made with
+// FFTW_MEASURE as in the registry, and after the first iteration FFTW reuses
+// its accumulated wisdom, as any block planning the same size would.
+void bm_fft_plan_creation(benchmark::State& state)
+{
+    const int fft_size = static_cast<int>(state.range(0));
+    auto* in = reinterpret_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    auto* out = reinterpret_cast<fftwf_complex*>(fftwf_malloc(sizeof(fftwf_complex) * fft_size));
+    while (state.KeepRunning())
+        {
+            fftwf_plan plan = fftwf_plan_dft_1d(fft_size, in, out, FFTW_FORWARD, FFTW_MEASURE);
+            benchmark::DoNotOptimize(plan);
+            fftwf_destroy_plan(plan);
+        }
+    fftwf_free(in);
+    fftwf_free(out);
+}
+
+
+void bm_fft_plan_registry_lookup(benchmark::State& state)
+{
+    const int fft_size = static_cast<int>(state.range(0));
+    auto& registry = Gnss_Fft_Plan_Registry::instance();
+    registry.get_plan(fft_size, true);
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(registry.get_plan(fft_size, true));
+        }
+}
+#endif
+
+
+BENCHMARK(bm_gr_fft_per_block_plans)->Unit(benchmark::kMillisecond);
+BENCHMARK(bm_gnss_sdr_fft_plans)->Unit(benchmark::kMillisecond);
+#if USE_FFT_PLAN_REGISTRY
+BENCHMARK(bm_fft_plan_creation)->Arg(4000)->Arg(8000)->Arg(16000)->Arg(80000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(bm_fft_plan_registry_lookup)->Arg(4000)->Arg(8000)->Arg(16000)->Arg(80000)->Unit(benchmark::kMicrosecond);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,170 @@
+/*!
+ * \file benchmark_rtcm.cc
+ * \brief Benchmarks for the generation of RTCM 3 messages
+ *
+ * The observation cases are parametrised by the number of satellites, so the
+ * reported items per second are messages per second for a given epoch size.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_synchro.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "rtcm.h"
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+constexpr double OBS_TIME = 1000.0;
+
+
+std::map<int32_t, Gnss_Synchro> gps_observables(int num_satellites)
+{
+    // GPS L1 C/A, L2C and L5 observables for num_satellites satellites
+    const char* signals[] = {"1C", "2S", "5X"};
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::map<int32_t, Gnss_Synchro> observables;
+    int32_t channel = 0;
+    for (int sat = 0; sat < num_satellites; sat++)
+        {
+            for (const auto* signal : signals)
+                {
+                    Gnss_Synchro gnss_synchro{};
+                    gnss_synchro.System = 'G';
+                    gnss_synchro.Signal[0] = signal[0];
+                    gnss_synchro.Signal[1] = signal[1];
+                    gnss_synchro.PRN = sat + 1;
+                    gnss_synchro.Channel_ID = channel;
+                    gnss_synchro.Pseudorange_m = 2.0e7 + uniform(gen) * 5.0e6;
+                    gnss_synchro.Carrier_phase_rads = (uniform(gen) - 0.5) * 1.0e9;
+                    gnss_synchro.Carrier_Doppler_hz = (uniform(gen) - 0.5) * 8000.0;
+                    gnss_synchro.CN0_dB_hz = 30.0 + uniform(gen) * 20.0;
+                    gnss_synchro.RX_time = OBS_TIME;
+                    gnss_synchro.Flag_valid_pseudorange = true;
+                    observables[channel++] = gnss_synchro;
+                }
+        }
+    return observables;
+}
+
+
+// number of satellites
+void bm_rtcm_mt1004(benchmark::State& state)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    const auto observables = gps_observables(static_cast<int>(state.range(0)));
+    const Gps_Ephemeris gps_eph{};
+    const Gps_CNAV_Ephemeris gps_cnav_eph{};
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(rtcm->print_MT1004(gps_eph, gps_cnav_eph, OBS_TIME, observables, 0));
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+// MSM number x number of satellites (the cell mask is limited to 64 cells)
+void bm_rtcm_msm(benchmark::State& state)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    const auto msm = static_cast<int>(state.range(0));
+    const auto observables = gps_observables(static_cast<int>(state.range(1)));
+    Gps_Ephemeris gps_eph{};
+    gps_eph.PRN = 1;  // selects the GPS message numbers
+    const Gps_CNAV_Ephemeris gps_cnav_eph{};
+    const Galileo_Ephemeris gal_eph{};
+    const Glonass_Gnav_Ephemeris glo_gnav_eph{};
+
+    while (state.KeepRunning())
+        {
+            std::string msg;
+            switch (msm)
+                {
+                case 4:
+                    msg = rtcm->print_MSM_4(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, OBS_TIME, observables, 0, 0, 0, 0, false, false);
+                    break;
+                case 5:
+                    msg = rtcm->print_MSM_5(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, OBS_TIME, observables, 0, 0, 0, 0, false, false);
+                    break;
+                case 6:
+                    msg = rtcm->print_MSM_6(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, OBS_TIME, observables, 0, 0, 0, 0, false, false);
+                    break;
+                default:
+                    msg = rtcm->print_MSM_7(gps_eph, gps_cnav_eph, gal_eph, glo_gnav_eph, OBS_TIME, observables, 0, 0, 0, 0, false, false);
+                }
+            benchmark::DoNotOptimize(msg);
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_rtcm_mt1019(benchmark::State& state)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Gps_Ephemeris gps_eph{};
+    gps_eph.PRN = 3;
+    gps_eph.sqrtA = 5153.6;
+    gps_eph.ecc = 0.01;
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(rtcm->print_MT1019(gps_eph));
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_rtcm_mt1020(benchmark::State& state)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Glonass_Gnav_Ephemeris glo_gnav_eph{};
+    glo_gnav_eph.PRN = 3;
+    const Glonass_Gnav_Utc_Model glo_gnav_utc_model{};
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(rtcm->print_MT1020(glo_gnav_eph, glo_gnav_utc_model));
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+void bm_rtcm_mt1045(benchmark::State& state)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Galileo_Ephemeris gal_eph{};
+    gal_eph.PRN = 3;
+    gal_eph.sqrtA = 5440.6;
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(rtcm->print_MT1045(gal_eph));
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+BENCHMARK(bm_rtcm_mt1004)->Arg(4)->Arg(12)->Arg(24);
+BENCHMARK(bm_rtcm_msm)->ArgsProduct({{4, 5, 6, 7}, {4, 12, 21}})->ArgNames({"msm", "sats"});
+BENCHMARK(bm_rtcm_mt1019);
+BENCHMARK(bm_rtcm_mt1020);
+BENCHMARK(bm_rtcm_mt1045);
+
+BENCHMARK_MAIN();
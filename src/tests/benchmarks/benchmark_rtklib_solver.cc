@@ -0,0 +1,321 @@
+/*!
+ * \file benchmark_rtklib_solver.cc
+ * \brief Benchmark of the computation of PVT solutions with RTKLIB
+ *
+ * The satellites are split among GPS (L1 C/A), Galileo (E1B + E5a), GLONASS
+ * (L1 C/A) and BeiDou (B1I + B3I). Their orbits are chosen above the receiver
+ * and the pseudoranges are error free, so every epoch ends in a valid single
+ * point solution. The reported items per second are epochs per second.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "beidou_dnav_ephemeris.h"
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_synchro.h"
+#include "gps_ephemeris.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_solver.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+constexpr double RX_LATITUDE_DEG = 41.275;
+constexpr double RX_LONGITUDE_DEG = 1.987;
+constexpr double RX_HEIGHT_M = 80.0;
+constexpr double MIN_ELEVATION_RAD = 20.0 * D2R;
+constexpr int32_t EPH_AGE_S = 600;  // from the reference time of the ephemerides to the epoch
+constexpr double GLONASS_TB_S = 12.0 * 3600.0;
+constexpr double GLONASS_RADIUS_M = 25510e3;
+constexpr double GLONASS_INCLINATION_RAD = 64.8 * D2R;
+constexpr double EARTH_GM = 3.9860044e14;
+constexpr double EARTH_ROTATION_RATE = 7.292115e-5;
+
+
+class Pvt_Scenario
+{
+public:
+    explicit Pvt_Scenario(int num_satellites);
+
+    std::unique_ptr<Rtklib_Solver> solver;
+    std::map<int, Gnss_Synchro> observables;
+
+private:
+    double pseudorange(int sat);
+    void add_observable(char system, const char* signal, int prn, double pseudorange_m);
+    bool add_gps(int prn, double raan, double arg_lat);
+    bool add_galileo(int prn, double raan, double arg_lat);
+    bool add_glonass(int prn, double raan, double arg_lat);
+    bool add_beidou(int prn, double raan, double arg_lat);
+
+    std::unique_ptr<nav_t> d_nav;
+    eph_t d_eph{};
+    geph_t d_geph{};
+    std::array<double, 3> d_rr{};
+    gtime_t d_time{};
+    int32_t d_toe{};  // GPS time of week
+    int d_week{};
+};
+
+
+Pvt_Scenario::Pvt_Scenario(int num_satellites) : d_nav(std::make_unique<nav_t>())
+{
+    prcopt_t opt{};
+    opt.mode = PMODE_SINGLE;
+    opt.nf = 1;
+    opt.navsys = SYS_GPS | SYS_GLO | SYS_GAL | SYS_BDS;
+    opt.elmin = 10.0 * D2R;
+    opt.sateph = EPHOPT_BRDC;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    opt.maxgdop = 30.0;
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    solver = std::make_unique<Rtklib_Solver>(rtk, "", 0, false, false);
+
+    const double pos[3] = {RX_LATITUDE_DEG * D2R, RX_LONGITUDE_DEG * D2R, RX_HEIGHT_M};
+    pos2ecef(pos, d_rr.data());
+
+    // The reference time of the GLONASS ephemerides is given in calendar
+    // terms, so the other systems follow it
+    Glonass_Gnav_Ephemeris glo_eph{};
+    glo_eph.d_yr = 2022;
+    glo_eph.d_N_T = 100;
+    glo_eph.d_t_b = GLONASS_TB_S;
+    const gtime_t toe = eph_to_rtklib(glo_eph, Glonass_Gnav_Utc_Model{}).toe;
+    d_toe = static_cast<int32_t>(std::round(time2gpst(toe, &d_week)));
+    d_time = timeadd(toe, EPH_AGE_S);
+
+    d_nav->eph = &d_eph;
+    d_nav->geph = &d_geph;
+
+    // GPS, Galileo, GLONASS and BeiDou in turn, with orbital planes and
+    // positions tried along the R2 low discrepancy sequence until the
+    // satellite is in view
+    int trial = 0;
+    for (int i = 0; i < num_satellites; i++)
+        {
+            const int prn = i / 4 + 1;
+            bool in_view = false;
+            while (!in_view)
+                {
+                    trial++;
+                    const double raan = TWO_PI * std::fmod(trial * 0.7548776662, 1.0);
+                    const double arg_lat = TWO_PI * std::fmod(trial * 0.5698402910, 1.0);
+                    switch (i % 4)
+                        {
+                        case 0:
+                            in_view = add_gps(prn, raan, arg_lat);
+                            break;
+                        case 1:
+                            in_view = add_galileo(prn, raan, arg_lat);
+                            break;
+                        case 2:
+                            in_view = add_glonass(prn, raan, arg_lat);
+                            break;
+                        default:
+                            in_view = add_beidou(prn + 5, raan, arg_lat);  // skip the GEO satellites
+                        }
+                }
+        }
+}
+
+
+// Pseudorange of the satellite in d_nav, or 0.0 if it is below the mask
+double Pvt_Scenario::pseudorange(int sat)
+{
+    d_nav->n = satsys(sat, nullptr) == SYS_GLO ? 0 : 1;
+    d_nav->ng = 1 - d_nav->n;
+    obsd_t obs{};
+    obs.time = d_time;
+    obs.sat = sat;
+    obs.P[0] = 2.2e7;
+    std::array<double, 6> rs{};
+    std::array<double, 2> dts{};
+    std::array<double, 3> e{};
+    double var;
+    int svh;
+    for (int iter = 0; iter < 3; iter++)
+        {
+            satposs(d_time, &obs, 1, d_nav.get(), EPHOPT_BRDC, rs.data(), dts.data(), &var, &svh);
+            obs.P[0] = geodist(rs.data(), d_rr.data(), e.data()) - SPEED_OF_LIGHT_M_S * dts[0];
+        }
+    std::array<double, 3> pos{};
+    std::array<double, 2> azel{};
+    ecef2pos(d_rr.data(), pos.data());
+    satazel(pos.data(), e.data(), azel.data());
+    return azel[1] < MIN_ELEVATION_RAD ? 0.0 : obs.P[0];
+}
+
+
+void Pvt_Scenario::add_observable(char system, const char* signal, int prn, double pseudorange_m)
+{
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.System = system;
+    gnss_synchro.Signal[0] = signal[0];
+    gnss_synchro.Signal[1] = signal[1];
+    gnss_synchro.PRN = prn;
+    gnss_synchro.Channel_ID = static_cast<int32_t>(observables.size());
+    gnss_synchro.Pseudorange_m = pseudorange_m;
+    gnss_synchro.CN0_dB_hz = 45.0;
+    gnss_synchro.RX_time = d_toe + EPH_AGE_S;
+    gnss_synchro.Flag_valid_pseudorange = true;
+    observables[gnss_synchro.Channel_ID] = gnss_synchro;
+}
+
+
+bool Pvt_Scenario::add_gps(int prn, double raan, double arg_lat)
+{
+    Gps_Ephemeris eph{};
+    eph.PRN = prn;
+    eph.sqrtA = 5153.6;
+    eph.ecc = 0.01;
+    eph.i_0 = 55.0 * D2R;
+    eph.OMEGA_0 = raan;
+    eph.M_0 = arg_lat;
+    eph.WN = d_week;
+    eph.toe = d_toe;
+    eph.toc = d_toe;
+    eph.tow = d_toe;
+    d_eph = eph_to_rtklib(eph, false);
+    const double pseudorange_m = pseudorange(d_eph.sat);
+    if (pseudorange_m == 0.0)
+        {
+            return false;
+        }
+    solver->store_ephemeris(eph);
+    add_observable('G', "1C", prn, pseudorange_m);
+    return true;
+}
+
+
+bool Pvt_Scenario::add_galileo(int prn, double raan, double arg_lat)
+{
+    Galileo_Ephemeris eph{};
+    eph.PRN = prn;
+    eph.sqrtA = 5440.6;
+    eph.ecc = 0.0002;
+    eph.i_0 = 56.0 * D2R;
+    eph.OMEGA_0 = raan;
+    eph.M_0 = arg_lat;
+    eph.WN = d_week - 1024;
+    eph.toe = d_toe;
+    eph.toc = d_toe;
+    eph.tow = d_toe;
+    d_eph = eph_to_rtklib(eph);
+    const double pseudorange_m = pseudorange(d_eph.sat);
+    if (pseudorange_m == 0.0)
+        {
+            return false;
+        }
+    solver->store_ephemeris(eph);
+    add_observable('E', "1B", prn, pseudorange_m);
+    add_observable('E', "5X", prn, pseudorange_m);
+    return true;
+}
+
+
+bool Pvt_Scenario::add_glonass(int prn, double raan, double arg_lat)
+{
+    // circular orbit, with the velocity in the rotating Earth-fixed frame
+    const double speed = std::sqrt(EARTH_GM / GLONASS_RADIUS_M);
+    const double cos_i = std::cos(GLONASS_INCLINATION_RAD);
+    const double sin_i = std::sin(GLONASS_INCLINATION_RAD);
+    const std::array<double, 3> r{
+        GLONASS_RADIUS_M * (std::cos(raan) * std::cos(arg_lat) - std::sin(raan) * std::sin(arg_lat) * cos_i),
+        GLONASS_RADIUS_M * (std::sin(raan) * std::cos(arg_lat) + std::cos(raan) * std::sin(arg_lat) * cos_i),
+        GLONASS_RADIUS_M * std::sin(arg_lat) * sin_i};
+    const std::array<double, 3> v{
+        speed * (-std::cos(raan) * std::sin(arg_lat) - std::sin(raan) * std::cos(arg_lat) * cos_i) + EARTH_ROTATION_RATE * r[1],
+        speed * (-std::sin(raan) * std::sin(arg_lat) + std::cos(raan) * std::cos(arg_lat) * cos_i) - EARTH_ROTATION_RATE * r[0],
+        speed * std::cos(arg_lat) * sin_i};
+
+    Glonass_Gnav_Ephemeris eph{};
+    eph.PRN = prn;
+    eph.i_satellite_slot_number = prn;
+    eph.i_satellite_freq_channel = prn % 14 - 7;
+    eph.d_yr = 2022;
+    eph.d_N_T = 100;
+    eph.d_t_b = GLONASS_TB_S;
+    eph.d_t_k = GLONASS_TB_S;
+    eph.d_WN = d_week;
+    eph.d_Xn = r[0] / 1e3;
+    eph.d_Yn = r[1] / 1e3;
+    eph.d_Zn = r[2] / 1e3;
+    eph.d_VXn = v[0] / 1e3;
+    eph.d_VYn = v[1] / 1e3;
+    eph.d_VZn = v[2] / 1e3;
+    d_geph = eph_to_rtklib(eph, Glonass_Gnav_Utc_Model{});
+    const double pseudorange_m = pseudorange(d_geph.sat);
+    if (pseudorange_m == 0.0)
+        {
+            return false;
+        }
+    solver->store_ephemeris(eph);
+    add_observable('R', "1G", prn, pseudorange_m);
+    return true;
+}
+
+
+bool Pvt_Scenario::add_beidou(int prn, double raan, double arg_lat)
+{
+    Beidou_Dnav_Ephemeris eph{};
+    eph.PRN = prn;
+    eph.sqrtA = 5282.6;
+    eph.ecc = 0.001;
+    eph.i_0 = 55.0 * D2R;
+    eph.OMEGA_0 = raan;
+    eph.M_0 = arg_lat;
+    eph.WN = d_week - 1356;
+    eph.toe = d_toe - 14;  // BDT is 14 s behind GPS time
+    eph.toc = eph.toe;
+    eph.tow = eph.toe;
+    d_eph = eph_to_rtklib(eph);
+    const double pseudorange_m = pseudorange(d_eph.sat);
+    if (pseudorange_m == 0.0)
+        {
+            return false;
+        }
+    solver->store_ephemeris(eph);
+    add_observable('C', "B1", prn, pseudorange_m);
+    add_observable('C', "B3", prn, pseudorange_m);
+    return true;
+}
+
+
+// number of satellites
+void bm_rtklib_solver_get_pvt(benchmark::State& state)
+{
+    Pvt_Scenario scenario(static_cast<int>(state.range(0)));
+
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(scenario.solver->get_PVT(scenario.observables, false));
+        }
+    if (!scenario.solver->is_valid_position())
+        {
+            state.SkipWithError("No valid PVT solution");
+        }
+    state.SetItemsProcessed(state.iterations());
+}
+
+
+BENCHMARK(bm_rtklib_solver_get_pvt)->Arg(8)->Arg(20)->Arg(40)->Arg(60);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,299 @@
+/*!
+ * \file benchmark_tracking.cc
+ * \brief Benchmarks for the building blocks of the tracking loops
+ *
+ * Cases are parametrised by the sampling frequency (in Msps), the number of
+ * correlator taps and the coherent integration time (in ms), so the cost of
+ * each piece of the tracking hot path can be compared among releases,
+ * machines and Volk kernel choices.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_16sc.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "dll_pll_conf.h"
+#include "dll_pll_veml_tracking.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include "lock_detectors.h"
+#include "tracking_FLL_PLL_filter.h"
+#include "tracking_loop_filter.h"
+#include <benchmark/benchmark.h>
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/top_block.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <volk_gnsssdr/volk_gnsssdr_complex.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+constexpr double CARRIER_DOPPLER_HZ = 1234.5;
+constexpr uint32_t PRN = 1;
+
+
+std::vector<float> tap_shifts_chips(int taps)
+{
+    // equally spaced taps between -0.5 and +0.5 chips
+    std::vector<float> shifts(taps);
+    for (int i = 0; i < taps; i++)
+        {
+            shifts[i] = -0.5F + static_cast<float>(i) / static_cast<float>(taps - 1);
+        }
+    return shifts;
+}
+
+
+int samples_per_code(double fs_in)
+{
+    return static_cast<int>(std::round(fs_in / (GPS_L1_CA_CODE_RATE_CPS / GPS_L1_CA_CODE_LENGTH_CHIPS)));
+}
+
+
+// sampling frequency [Msps] x correlator taps x coherent integration time [ms]
+template <bool high_dynamics>
+void bm_multicorrelator_real_codes(benchmark::State& state)
+{
+    const double fs_in = static_cast<double>(state.range(0)) * 1e6;
+    const auto taps = static_cast<int>(state.range(1));
+    const auto integration_ms = static_cast<int>(state.range(2));
+    const int code_samples = samples_per_code(fs_in);
+
+    volk_gnsssdr::vector<float> local_code(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    gps_l1_ca_code_gen_float(local_code, PRN, 0);
+    volk_gnsssdr::vector<gr_complex> input(code_samples);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::generate(input.begin(), input.end(), [&]() { return gr_complex(dist(e2), dist(e2)); });
+    volk_gnsssdr::vector<gr_complex> corr_out(taps);
+    std::vector<float> shifts = tap_shifts_chips(taps);
+
+    Cpu_Multicorrelator_Real_Codes correlator;
+    correlator.set_high_dynamics_resampler(high_dynamics);
+    correlator.init(2 * code_samples, taps);
+    correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), local_code.data(), shifts.data());
+    correlator.set_input_output_vectors(corr_out.data(), input.data());
+
+    const auto phase_step_rad = static_cast<float>(TWO_PI * CARRIER_DOPPLER_HZ / fs_in);
+    const auto code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_RATE_CPS / fs_in);
+    while (state.KeepRunning())
+        {
+            // the correlator is called once per code period
+            for (int ms = 0; ms < integration_ms; ms++)
+                {
+                    correlator.Carrier_wipeoff_multicorrelator_resampler(0.1F, phase_step_rad, 0.0F, 0.25F, code_phase_step_chips, 0.0F, code_samples);
+                }
+            benchmark::DoNotOptimize(corr_out.data());
+        }
+    correlator.free();
+    state.SetItemsProcessed(state.iterations() * integration_ms * code_samples);
+}
+
+
+void bm_multicorrelator_16sc(benchmark::State& state)
+{
+    const double fs_in = static_cast<double>(state.range(0)) * 1e6;
+    const auto taps = static_cast<int>(state.range(1));
+    const auto integration_ms = static_cast<int>(state.range(2));
+    const int code_samples = samples_per_code(fs_in);
+
+    std::vector<float> code_float(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    gps_l1_ca_code_gen_float(code_float, PRN, 0);
+    volk_gnsssdr::vector<lv_16sc_t> local_code(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    std::transform(code_float.cbegin(), code_float.cend(), local_code.begin(), [](float chip) { return lv_16sc_t(static_cast<int16_t>(chip), 0); });
+    volk_gnsssdr::vector<lv_16sc_t> input(code_samples);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::uniform_int_distribution<int16_t> dist(-100, 100);
+    std::generate(input.begin(), input.end(), [&]() { return lv_16sc_t(dist(e2), dist(e2)); });
+    volk_gnsssdr::vector<lv_16sc_t> corr_out(taps);
+    std::vector<float> shifts = tap_shifts_chips(taps);
+
+    Cpu_Multicorrelator_16sc correlator;
+    correlator.init(2 * code_samples, taps);
+    correlator.set_local_code_and_taps(static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS), local_code.data(), shifts.data());
+    correlator.set_input_output_vectors(corr_out.data(), input.data());
+
+    const auto phase_step_rad = static_cast<float>(TWO_PI * CARRIER_DOPPLER_HZ / fs_in);
+    const auto code_phase_step_chips = static_cast<float>(GPS_L1_CA_CODE_RATE_CPS / fs_in);
+    while (state.KeepRunning())
+        {
+            for (int ms = 0; ms < integration_ms; ms++)
+                {
+                    correlator.Carrier_wipeoff_multicorrelator_resampler(0.1F, phase_step_rad, 0.25F, code_phase_step_chips, code_samples);
+                }
+            benchmark::DoNotOptimize(corr_out.data());
+        }
+    correlator.free();
+    state.SetItemsProcessed(state.iterations() * integration_ms * code_samples);
+}
+
+
+// loop order x coherent integration time [ms]
+void bm_tracking_loop_filter(benchmark::State& state)
+{
+    const auto order = static_cast<int>(state.range(0));
+    const auto update_interval_s = static_cast<float>(state.range(1)) * 1e-3F;
+    Tracking_loop_filter filter(update_interval_s, 2.0, order, false);
+    filter.initialize(0.0);
+    float input = 0.01;
+    while (state.KeepRunning())
+        {
+            input = -input;
+            benchmark::DoNotOptimize(filter.apply(input));
+        }
+}
+
+
+void bm_tracking_fll_pll_filter(benchmark::State& state)
+{
+    const auto order = static_cast<int>(state.range(0));
+    const auto correlation_time_s = static_cast<float>(state.range(1)) * 1e-3F;
+    Tracking_FLL_PLL_filter filter;
+    filter.set_params(10.0, 35.0, order);
+    filter.initialize(static_cast<float>(CARRIER_DOPPLER_HZ));
+    float input = 0.01;
+    while (state.KeepRunning())
+        {
+            input = -input;
+            benchmark::DoNotOptimize(filter.get_carrier_error(input, -input, correlation_time_s));
+        }
+}
+
+
+// number of prompt correlator outputs used by the estimators
+void bm_cn0_svn_estimator(benchmark::State& state)
+{
+    const auto length = static_cast<int>(state.range(0));
+    std::vector<gr_complex> prompt(length);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::generate(prompt.begin(), prompt.end(), [&]() { return gr_complex(100.0F + dist(e2), dist(e2)); });
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(cn0_svn_estimator(prompt.data(), length, 0.001));
+        }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+
+void bm_cn0_m2m4_estimator(benchmark::State& state)
+{
+    const auto length = static_cast<int>(state.range(0));
+    std::vector<gr_complex> prompt(length);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::generate(prompt.begin(), prompt.end(), [&]() { return gr_complex(100.0F + dist(e2), dist(e2)); });
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(cn0_m2m4_estimator(prompt.data(), length, 0.001));
+        }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+
+void bm_carrier_lock_detector(benchmark::State& state)
+{
+    const auto length = static_cast<int>(state.range(0));
+    std::vector<gr_complex> prompt(length);
+    std::random_device rd;
+    std::default_random_engine e2(rd());
+    std::normal_distribution<float> dist(0.0, 1.0);
+    std::generate(prompt.begin(), prompt.end(), [&]() { return gr_complex(100.0F + dist(e2), dist(e2)); });
+    while (state.KeepRunning())
+        {
+            benchmark::DoNotOptimize(carrier_lock_detector(prompt.data(), length));
+        }
+    state.SetItemsProcessed(state.iterations() * length);
+}
+
+
+// sampling frequency [Msps] x coherent integration time [ms]
+void bm_dll_pll_veml_tracking(benchmark::State& state)
+{
+    const double fs_in = static_cast<double>(state.range(0)) * 1e6;
+    const auto integration_ms = static_cast<int32_t>(state.range(1));
+    const int code_samples = samples_per_code(fs_in);
+    const uint64_t num_samples = 2000 * static_cast<uint64_t>(code_samples);  // 2 s of signal
+
+    Dll_Pll_Conf trk_params;
+    trk_params.fs_in = fs_in;
+    trk_params.vector_length = code_samples;
+    trk_params.system = 'G';
+    trk_params.extend_correlation_symbols = integration_ms;
+    trk_params.dump = false;
+    trk_params.dump_mat = false;
+
+    // 40 ms of noiseless GPS L1 C/A signal, with a navigation bit transition
+    // every 20 ms so the loops can switch to the extended integration time
+    std::vector<gr_complex> code(code_samples);
+    gps_l1_ca_code_gen_complex_sampled(code, PRN, static_cast<int32_t>(fs_in), 0);
+    std::vector<gr_complex> signal(40 * code_samples);
+    for (int ms = 0; ms < 40; ms++)
+        {
+            const float bit = (ms < 20) ? 1.0F : -1.0F;
+            std::transform(code.cbegin(), code.cend(), signal.begin() + ms * code_samples, [bit](const gr_complex& chip) { return bit * chip; });
+        }
+
+    while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            auto top_block = gr::make_top_block("Tracking benchmark");
+            auto source = gr::blocks::vector_source_c::make(signal, true);
+            auto head = gr::blocks::head::make(sizeof(gr_complex), num_samples);
+            auto tracking = dll_pll_veml_make_tracking(trk_params);
+            auto sink = gr::blocks::null_sink::make(sizeof(Gnss_Synchro));
+            top_block->connect(source, 0, head, 0);
+            top_block->connect(head, 0, tracking, 0);
+            top_block->connect(tracking, 0, sink, 0);
+
+            Gnss_Synchro gnss_synchro{};
+            gnss_synchro.System = 'G';
+            gnss_synchro.Signal[0] = '1';
+            gnss_synchro.Signal[1] = 'C';
+            gnss_synchro.PRN = PRN;
+            gnss_synchro.Acq_delay_samples = 0.0;
+            gnss_synchro.Acq_doppler_hz = 0.0;
+            gnss_synchro.Acq_samplestamp_samples = 0;
+            tracking->set_channel(0);
+            tracking->set_gnss_synchro(&gnss_synchro);
+            tracking->start_tracking();
+            state.ResumeTiming();
+            top_block->run();
+        }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(num_samples));
+}
+
+
+BENCHMARK_TEMPLATE(bm_multicorrelator_real_codes, false)->ArgsProduct({{2, 4, 8, 16}, {3, 5, 7}, {1, 20}})->ArgNames({"fs_msps", "taps", "int_ms"});
+BENCHMARK_TEMPLATE(bm_multicorrelator_real_codes, true)->ArgsProduct({{2, 4, 8, 16}, {3, 5, 7}, {1, 20}})->ArgNames({"fs_msps", "taps", "int_ms"});
+BENCHMARK(bm_multicorrelator_16sc)->ArgsProduct({{2, 4, 8, 16}, {3, 5, 7}, {1, 20}})->ArgNames({"fs_msps", "taps", "int_ms"});
+BENCHMARK(bm_tracking_loop_filter)->ArgsProduct({{1, 2, 3}, {1, 20}})->ArgNames({"order", "int_ms"});
+BENCHMARK(bm_tracking_fll_pll_filter)->ArgsProduct({{2, 3}, {1, 20}})->ArgNames({"order", "int_ms"});
+BENCHMARK(bm_cn0_svn_estimator)->Arg(10)->Arg(20)->Arg(100);
+BENCHMARK(bm_cn0_m2m4_estimator)->Arg(10)->Arg(20)->Arg(100);
+BENCHMARK(bm_carrier_lock_detector)->Arg(10)->Arg(20)->Arg(100);
+BENCHMARK(bm_dll_pll_veml_tracking)->ArgsProduct({{2, 4, 8, 16}, {1, 20}})->ArgNames({"fs_msps", "int_ms"})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
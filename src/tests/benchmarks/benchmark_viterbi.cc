@@ -0,0 +1,92 @@
+/*!
+ * \file benchmark_viterbi.cc
+ * \brief Benchmark for the Viterbi decoding of a Galileo I/NAV page part
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Galileo I/NAV page part: 240 symbols, K=7, rate 1/2
+constexpr int32_t KK = 7;
+constexpr int32_t NN = 2;
+constexpr int32_t LL = 240 / NN - (KK - 1);
+
+int32_t parity(int32_t word)
+{
+    int32_t p = 0;
+    while (word)
+        {
+            p ^= word & 1;
+            word >>= 1;
+        }
+    return p;
+}
+
+
+std::vector<float> encoded_page(const std::array<int32_t, 2>& g)
+{
+    std::mt19937 gen(1);
+    std::normal_distribution<float> noise(0.0, 0.5);
+    std::vector<float> symbols;
+    int32_t state = 0;
+    for (int32_t t = 0; t < LL + KK - 1; t++)
+        {
+            const int32_t bit = (t < LL) ? static_cast<int32_t>(gen() & 1U) : 0;
+            const int32_t word = (bit << (KK - 1)) ^ state;
+            for (int32_t i = 0; i < NN; i++)
+                {
+                    symbols.push_back((parity(word & g[i]) ? 1.0F : -1.0F) + noise(gen));
+                }
+            state = word >> 1;
+        }
+    return symbols;
+}
+
+
+void bm_viterbi_generic_trellis(benchmark::State& state)
+{
+    // Same code with the polynomials swapped, which is decoded by the generic trellis
+    const std::array<int32_t, 2> g{91, 121};
+    const std::vector<float> symbols = encoded_page(g);
+    std::vector<int32_t> bits(LL);
+    Viterbi_Decoder decoder(KK, NN, LL, g);
+    while (state.KeepRunning())
+        {
+            decoder.decode(bits, symbols);
+            benchmark::DoNotOptimize(bits.data());
+        }
+}
+
+
+void bm_viterbi_k7r12_kernel(benchmark::State& state)
+{
+    const std::array<int32_t, 2> g{121, 91};
+    const std::vector<float> symbols = encoded_page(g);
+    std::vector<int32_t> bits(LL);
+    Viterbi_Decoder decoder(KK, NN, LL, g);
+    while (state.KeepRunning())
+        {
+            decoder.decode(bits, symbols);
+            benchmark::DoNotOptimize(bits.data());
+        }
+}
+
+
+BENCHMARK(bm_viterbi_generic_trellis);
+BENCHMARK(bm_viterbi_k7r12_kernel);
+
+BENCHMARK_MAIN();
@@ -54,6 +54,7 @@ DECLARE_string(log_dir);
 #include "unit-tests/arithmetic/magnitude_squared_test.cc"
 #include "unit-tests/arithmetic/multiply_test.cc"
 #include "unit-tests/arithmetic/preamble_correlator_test.cc"
+#include "unit-tests/control-plane/concurrent_queue_test.cc"
 #include "unit-tests/control-plane/control_thread_test.cc"
 #include "unit-tests/control-plane/file_configuration_test.cc"
 #include "unit-tests/control-plane/gnss_block_factory_test.cc"
@@ -61,6 +62,9 @@ DECLARE_string(log_dir);
 #include "unit-tests/control-plane/in_memory_configuration_test.cc"
 #include "unit-tests/control-plane/protobuf_test.cc"
 #include "unit-tests/control-plane/string_converter_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_batch_engine_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_replica_cache_test.cc"
+#include "unit-tests/signal-processing-blocks/acquisition/acq_worker_pool_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_8ms_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc2013_test.cc"
 #include "unit-tests/signal-processing-blocks/acquisition/galileo_e1_pcps_ambiguous_acquisition_gsoc_test.cc"
@@ -88,6 +92,8 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/sources/gnss_sdr_valve_test.cc"
 #include "unit-tests/signal-processing-blocks/sources/unpack_2bit_samples_test.cc"
 // #include "unit-tests/signal-processing-blocks/acquisition/glonass_l2_ca_pcps_acquisition_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/binary_dump_writer_test.cc"
+#include "unit-tests/signal-processing-blocks/libs/gnss_replica_store_test.cc"
 #include "unit-tests/signal-processing-blocks/libs/item_type_helpers_test.cc"
 
 #if OPENCL_BLOCKS_TEST
@@ -99,6 +105,7 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/cubature_filter_test.cc"
 // #include "unit-tests/signal-processing-blocks/tracking/unscented_filter_test.cc"
 #endif
+#include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_batch_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_real_codes_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/cpu_multicorrelator_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/discriminator_test.cc"
@@ -107,6 +114,11 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/galileo_e5b_dll_pll_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_c_aid_tracking_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/glonass_l1_ca_dll_pll_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/gps_l1_ca_dll_pll_multichannel_tracking_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/kalman_filter_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/lock_detectors_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tracking_aligned_epochs_test.cc"
+#include "unit-tests/signal-processing-blocks/tracking/tracking_epoch_grid_test.cc"
 #include "unit-tests/signal-processing-blocks/tracking/tracking_loop_filter_test.cc"
 
 
@@ -120,17 +132,23 @@ DECLARE_string(log_dir);
 #include "unit-tests/signal-processing-blocks/tracking/gps_l1_ca_dll_pll_tracking_test_fpga.cc"
 #endif
 
+#include "unit-tests/signal-processing-blocks/observables/observables_history_test.cc"
+
 #include "unit-tests/signal-processing-blocks/pvt/nmea_printer_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rcu_snapshot_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rinex_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_printer_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/rtcm_test.cc"
+#include "unit-tests/signal-processing-blocks/pvt/rtklib_solver_multiband_test.cc"
 #include "unit-tests/signal-processing-blocks/pvt/serdes_monitor_pvt_test.cc"
 #include "unit-tests/signal-processing-blocks/telemetry_decoder/galileo_fnav_inav_decoder_test.cc"
+#include "unit-tests/signal-processing-blocks/telemetry_decoder/viterbi_decoder_test.cc"
 #include "unit-tests/system-parameters/galileo_e1b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/galileo_e6b_reed_solomon_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_crc_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_ephemeris_test.cc"
 #include "unit-tests/system-parameters/glonass_gnav_nav_message_test.cc"
+#include "unit-tests/system-parameters/gnss_synchro_test.cc"
 #include "unit-tests/system-parameters/has_decoding_test.cc"
 
 #if EXTRA_TESTS
@@ -0,0 +1,105 @@
+/*!
+ * \file concurrent_queue_test.cc
+ * \brief This file implements unit tests for the Concurrent_Queue class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "concurrent_queue.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+TEST(ConcurrentQueueTest, FifoOrderAndMoveOnlyItems)
+{
+    Concurrent_Queue<std::unique_ptr<int>> queue;
+    EXPECT_TRUE(queue.empty());
+    for (int i = 0; i < 10; i++)
+        {
+            EXPECT_TRUE(queue.push(std::make_unique<int>(i)));
+        }
+    EXPECT_TRUE(queue.emplace(new int(10)));
+    EXPECT_EQ(queue.size(), 11U);
+
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(*value, 0);
+
+    std::vector<std::unique_ptr<int>> batch;
+    EXPECT_EQ(queue.drain(batch, 4), 4U);
+    EXPECT_EQ(queue.drain(batch), 6U);
+    ASSERT_EQ(batch.size(), 10U);
+    for (int i = 0; i < 10; i++)
+        {
+            EXPECT_EQ(*batch[i], i + 1);
+        }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_FALSE(queue.timed_wait_and_pop(value, 1));
+}
+
+
+TEST(ConcurrentQueueTest, BoundedCapacity)
+{
+    Concurrent_Queue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 3U);
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_TRUE(queue.push(3));
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_FALSE(queue.push(5));
+    EXPECT_EQ(queue.overflows(), 2U);
+    EXPECT_EQ(queue.size(), 3U);
+
+    int value = 0;
+    queue.wait_and_pop(value);
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(queue.push(6));
+    EXPECT_EQ(queue.overflows(), 2U);
+}
+
+
+TEST(ConcurrentQueueTest, MultipleProducers)
+{
+    Concurrent_Queue<int> queue;
+    const int num_producers = 8;
+    const int items_per_producer = 10000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; p++)
+        {
+            producers.emplace_back([&queue, p]() {
+                for (int i = 0; i < items_per_producer; i++)
+                    {
+                        queue.push(p * items_per_producer + i);
+                    }
+            });
+        }
+
+    // Items from each producer arrive in order
+    std::vector<int> last(num_producers, -1);
+    int received = 0;
+    int value = 0;
+    while (received < num_producers * items_per_producer)
+        {
+            ASSERT_TRUE(queue.timed_wait_and_pop(value, 1000));
+            const int producer = value / items_per_producer;
+            EXPECT_GT(value, last[producer]);
+            last[producer] = value;
+            received++;
+        }
+    for (auto& producer : producers)
+        {
+            producer.join();
+        }
+    EXPECT_TRUE(queue.empty());
+}
@@ -21,6 +21,7 @@
 
 #include "acquisition_interface.h"
 #include "channel.h"
+#include "channel_interface.h"
 #include "concurrent_queue.h"
 #include "gnss_block_factory.h"
 #include "gnss_block_interface.h"
@@ -399,6 +400,36 @@ TEST(GNSSBlockFactoryTest, InstantiateChannels)
 }
 
 
+TEST(GNSSBlockFactoryTest, InstantiateMultichannelTrackingChannels)
+{
+    std::shared_ptr<InMemoryConfiguration> configuration = std::make_shared<InMemoryConfiguration>();
+    configuration->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+    configuration->set_property("Channels_1C.count", "3");
+    configuration->set_property("Channels_1E.count", "0");
+    configuration->set_property("Channels.in_acquisition", "1");
+    configuration->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    configuration->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Multichannel_Tracking");
+    configuration->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+    std::shared_ptr<Concurrent_Queue<pmt::pmt_t>> queue = std::make_shared<Concurrent_Queue<pmt::pmt_t>>();
+    std::unique_ptr<GNSSBlockFactory> factory = std::make_unique<GNSSBlockFactory>();
+    std::unique_ptr<std::vector<std::unique_ptr<GNSSBlockInterface>>> channels = factory->GetChannels(configuration.get(), queue.get());
+    ASSERT_EQ(static_cast<unsigned int>(3), channels->size());
+
+    // The channels share one tracking block, each one on its own output port
+    auto* first = dynamic_cast<ChannelInterface*>(channels->at(0).get());
+    ASSERT_NE(nullptr, first);
+    for (int32_t i = 0; i < 3; i++)
+        {
+            auto* channel = dynamic_cast<ChannelInterface*>(channels->at(i).get());
+            ASSERT_NE(nullptr, channel);
+            EXPECT_EQ(first->get_right_block_trk(), channel->get_right_block_trk());
+            EXPECT_EQ(first->get_left_block_trk(), channel->get_left_block_trk());
+            EXPECT_EQ(i, channel->get_right_block_trk_port());
+        }
+    channels->erase(channels->begin(), channels->end());
+}
+
+
 TEST(GNSSBlockFactoryTest, InstantiateWrongObservables)
 {
     std::shared_ptr<InMemoryConfiguration> configuration = std::make_shared<InMemoryConfiguration>();
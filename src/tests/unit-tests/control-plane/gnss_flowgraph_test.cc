@@ -249,3 +249,43 @@ TEST(GNSSFlowgraph /*unused*/, InstantiateConnectStartStopHybrid /*unused*/)
     flowgraph->stop();
     EXPECT_FALSE(flowgraph->running());
 }
+
+
+TEST(GNSSFlowgraph /*unused*/, InstantiateConnectStartStopMultichannelTracking /*unused*/)
+{
+    // The GPS L1 C/A channels share one multichannel tracking block. Each one
+    // is wired to its own output port and message ports of the block, and to
+    // its own input of the tracking monitor.
+    std::shared_ptr<ConfigurationInterface> config = std::make_shared<InMemoryConfiguration>();
+    config->set_property("GNSS-SDR.internal_fs_sps", "4000000");
+    config->set_property("SignalSource.sampling_frequency", "4000000");
+    config->set_property("SignalSource.implementation", "File_Signal_Source");
+    config->set_property("SignalSource.item_type", "gr_complex");
+    config->set_property("SignalSource.repeat", "true");
+    std::string path = std::string(TEST_PATH);
+    std::string filename = path + "signal_samples/Galileo_E1_ID_1_Fs_4Msps_8ms.dat";
+    config->set_property("SignalSource.filename", filename);
+    config->set_property("SignalConditioner.implementation", "Pass_Through");
+    config->set_property("Channels_1C.count", "4");
+    config->set_property("Channels.in_acquisition", "1");
+    config->set_property("Channel.signal", "1C");
+    config->set_property("Acquisition_1C.implementation", "GPS_L1_CA_PCPS_Acquisition");
+    config->set_property("Acquisition_1C.threshold", "1");
+    config->set_property("Acquisition_1C.doppler_max", "5000");
+    config->set_property("Tracking_1C.implementation", "GPS_L1_CA_DLL_PLL_Multichannel_Tracking");
+    config->set_property("TelemetryDecoder_1C.implementation", "GPS_L1_CA_Telemetry_Decoder");
+    config->set_property("Observables.implementation", "Hybrid_Observables");
+    config->set_property("PVT.implementation", "RTKLIB_PVT");
+    config->set_property("TrackingMonitor.enable_monitor", "true");
+    config->set_property("TrackingMonitor.client_addresses", "127.0.0.1");
+
+    std::shared_ptr<GNSSFlowgraph> flowgraph = std::make_shared<GNSSFlowgraph>(config, std::make_shared<Concurrent_Queue<pmt::pmt_t>>());
+
+    EXPECT_NO_THROW(flowgraph->connect());
+    EXPECT_TRUE(flowgraph->connected());
+
+    EXPECT_NO_THROW(flowgraph->start());
+    EXPECT_TRUE(flowgraph->running());
+    flowgraph->stop();
+    EXPECT_FALSE(flowgraph->running());
+}
@@ -0,0 +1,247 @@
+/*!
+ * \file acq_batch_engine_test.cc
+ * \brief This file implements unit tests for the store of input spectra
+ * shared by the PCPS acquisition blocks in batch mode.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_batch_engine.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <complex>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+// Fingerprint of the samples of the block at stamp, as seen by channels with aligned sample counters
+uint64_t block_fingerprint(uint64_t stamp)
+{
+    const std::vector<std::complex<float>> samples(16, std::complex<float>(static_cast<float>(stamp), 1.0));
+    return Acq_Batch_Engine::fingerprint(samples.data(), samples.size());
+}
+}  // namespace
+
+
+TEST(AcqBatchEngineTest, SharesSpectraBetweenChannels)
+{
+    auto& engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    Acq_Batch_Key key;
+    key.signal = "1C";
+    key.fs = 4000000;
+    key.fft_size = 4000;
+    key.consumed_samples = 4000;
+
+    int calls = 0;
+    const auto compute = [&calls](Acq_Batch_Engine::spectrum_type& out) {
+        calls++;
+        std::fill(out.begin(), out.end(), std::complex<float>(static_cast<float>(calls), 0.0));
+    };
+
+    // Eight channels search the same block on the same Doppler bin
+    const auto first = engine.input_spectrum(key, 0, 4000, block_fingerprint(4000), -5000.0, compute);
+    for (uint32_t channel = 1; channel < 8; channel++)
+        {
+            const auto other = engine.input_spectrum(key, channel, 4000, block_fingerprint(4000), -5000.0, compute);
+            EXPECT_EQ(first.get(), other.get());
+        }
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(engine.requested(), 8U);
+    EXPECT_EQ(engine.computed(), 1U);
+
+    // Another Doppler bin, another block or another signal lead to a new computation
+    engine.input_spectrum(key, 0, 4000, block_fingerprint(4000), -4500.0, compute);
+    engine.input_spectrum(key, 0, 8000, block_fingerprint(8000), -5000.0, compute);
+    Acq_Batch_Key galileo_key = key;
+    galileo_key.signal = "1B";
+    engine.input_spectrum(galileo_key, 8, 4000, block_fingerprint(4000), -5000.0, compute);
+    EXPECT_EQ(calls, 4);
+    EXPECT_EQ((*first)[0], std::complex<float>(1.0, 0.0));
+    engine.clear();
+}
+
+
+TEST(AcqBatchEngineTest, DropsOldBlocks)
+{
+    auto& engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    Acq_Batch_Key key;
+    key.signal = "1C";
+    key.fs = 4000000;
+    key.fft_size = 16;
+    key.consumed_samples = 16;
+
+    int calls = 0;
+    const auto compute = [&calls](Acq_Batch_Engine::spectrum_type& /*out*/) { calls++; };
+    for (uint64_t block = 1; block <= Acq_Batch_Engine::MAX_BLOCKS + 1; block++)
+        {
+            engine.input_spectrum(key, 0, block * 16, block_fingerprint(block * 16), 0.0, compute);
+        }
+    EXPECT_EQ(calls, static_cast<int>(Acq_Batch_Engine::MAX_BLOCKS) + 1);
+
+    // The first block is gone, the last one is still shared
+    engine.input_spectrum(key, 1, 16, block_fingerprint(16), 0.0, compute);
+    engine.input_spectrum(key, 1, (Acq_Batch_Engine::MAX_BLOCKS + 1) * 16, block_fingerprint((Acq_Batch_Engine::MAX_BLOCKS + 1) * 16), 0.0, compute);
+    EXPECT_EQ(calls, static_cast<int>(Acq_Batch_Engine::MAX_BLOCKS) + 2);
+    engine.clear();
+}
+
+
+TEST(AcqBatchEngineTest, ConcurrentChannelsComputeOnce)
+{
+    auto& engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    Acq_Batch_Key key;
+    key.signal = "1C";
+    key.fs = 4000000;
+    key.fft_size = 1024;
+    key.consumed_samples = 1024;
+
+    const int num_channels = 8;
+    const int num_bins = 40;
+    std::atomic<int> calls{0};
+    const auto compute = [&calls](Acq_Batch_Engine::spectrum_type& out) {
+        calls++;
+        std::fill(out.begin(), out.end(), std::complex<float>(1.0, 0.0));
+    };
+
+    std::vector<std::thread> channels;
+    for (int channel = 0; channel < num_channels; channel++)
+        {
+            channels.emplace_back([&, channel]() {
+                for (int bin = 0; bin < num_bins; bin++)
+                    {
+                        const auto spectrum = engine.input_spectrum(key, channel, 1024, block_fingerprint(1024), static_cast<float>(-5000 + 250 * bin), compute);
+                        EXPECT_EQ(spectrum->size(), 1024U);
+                        EXPECT_EQ((*spectrum)[1023], std::complex<float>(1.0, 0.0));
+                    }
+            });
+        }
+    for (auto& channel : channels)
+        {
+            channel.join();
+        }
+    EXPECT_EQ(calls.load(), num_bins);
+    EXPECT_EQ(engine.requested(), static_cast<uint64_t>(num_channels * num_bins));
+    engine.clear();
+}
+
+
+TEST(AcqBatchEngineTest, TwoSourcesAndAChannelThatStopsEarly)
+{
+    auto& engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    Acq_Batch_Key first_source;
+    first_source.signal = "1C";
+    first_source.fs = 4000000;
+    first_source.fft_size = 16;
+    first_source.consumed_samples = 16;
+    Acq_Batch_Key second_source = first_source;
+    second_source.rf_channel = 1;
+
+    int calls = 0;
+    const auto compute = [&calls](Acq_Batch_Engine::spectrum_type& /*out*/) { calls++; };
+
+    // Channels 0 and 1 read the first source, channel 2 the second one
+    engine.input_spectrum(first_source, 0, 16, block_fingerprint(16), 0.0, compute);
+    engine.input_spectrum(first_source, 1, 16, block_fingerprint(16), 0.0, compute);
+    engine.input_spectrum(second_source, 2, 16, block_fingerprint(16), 0.0, compute);
+    EXPECT_EQ(calls, 2);
+
+    // The block stays until both channels of the first source are done with it
+    engine.release(first_source, 0, 16);
+    EXPECT_EQ(engine.stored_blocks(first_source), 1U);
+    engine.release(first_source, 1, 16);
+    EXPECT_EQ(engine.stored_blocks(first_source), 0U);
+    EXPECT_EQ(engine.stored_blocks(second_source), 1U);
+
+    // Channel 1 requests the next block and stops before releasing it
+    engine.input_spectrum(first_source, 1, 32, block_fingerprint(32), 0.0, compute);
+    engine.unsubscribe(first_source, 1);
+
+    // Channel 0 goes on alone: it gets the block computed by channel 1, and
+    // its blocks are dropped as soon as it releases them
+    calls = 0;
+    for (uint64_t stamp = 32; stamp <= 32 * Acq_Batch_Engine::MAX_BLOCKS; stamp += 16)
+        {
+            engine.input_spectrum(first_source, 0, stamp, block_fingerprint(stamp), 0.0, compute);
+            engine.release(first_source, 0, stamp);
+            EXPECT_EQ(engine.stored_blocks(first_source), 0U);
+        }
+    EXPECT_EQ(calls, static_cast<int>(2 * Acq_Batch_Engine::MAX_BLOCKS) - 2);
+
+    // A channel a dwell behind does not stop channel 2 from sharing its blocks
+    engine.input_spectrum(second_source, 3, 16, block_fingerprint(16), 0.0, compute);
+    for (uint64_t stamp = 32; stamp <= 16 * (Acq_Batch_Engine::MAX_BLOCKS + 2); stamp += 16)
+        {
+            engine.input_spectrum(second_source, 2, stamp, block_fingerprint(stamp), 0.0, compute);
+            engine.release(second_source, 2, stamp);
+            EXPECT_LE(engine.stored_blocks(second_source), static_cast<size_t>(Acq_Batch_Engine::MAX_BLOCKS));
+        }
+    engine.unsubscribe(second_source, 2);
+    engine.unsubscribe(second_source, 3);
+    EXPECT_EQ(engine.stored_blocks(second_source), 0U);
+    engine.clear();
+}
+
+
+TEST(AcqBatchEngineTest, MisalignedSampleCounters)
+{
+    auto& engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    Acq_Batch_Key key;
+    key.signal = "1C";
+    key.fs = 4000000;
+    key.fft_size = 16;
+    key.consumed_samples = 16;
+
+    std::vector<std::complex<float>> stream(64);
+    for (size_t i = 0; i < stream.size(); i++)
+        {
+            stream[i] = std::complex<float>(static_cast<float>(i), -static_cast<float>(i));
+        }
+    // Channel 1 started reading the stream 16 samples after channel 0, so
+    // its block at stamp 16 holds the samples of the block at stamp 32 of
+    // channel 0
+    const uint64_t channel_0_fingerprint = Acq_Batch_Engine::fingerprint(&stream[16], 16);
+    const uint64_t channel_1_fingerprint = Acq_Batch_Engine::fingerprint(&stream[32], 16);
+    EXPECT_NE(channel_0_fingerprint, channel_1_fingerprint);
+    EXPECT_EQ(channel_0_fingerprint, Acq_Batch_Engine::fingerprint(&stream[16], 16));
+
+    int calls = 0;
+    const auto compute = [&calls](Acq_Batch_Engine::spectrum_type& out) {
+        calls++;
+        std::fill(out.begin(), out.end(), std::complex<float>(static_cast<float>(calls), 0.0));
+    };
+    const auto channel_0_spectrum = engine.input_spectrum(key, 0, 16, channel_0_fingerprint, 0.0, compute);
+    const auto channel_1_spectrum = engine.input_spectrum(key, 1, 16, channel_1_fingerprint, 0.0, compute);
+    EXPECT_EQ(calls, 2);
+    EXPECT_NE(channel_0_spectrum.get(), channel_1_spectrum.get());
+    EXPECT_EQ((*channel_1_spectrum)[0], std::complex<float>(2.0, 0.0));
+    EXPECT_EQ(engine.mismatched(), 1U);
+
+    // The block keeps the spectra of the first channel, and channels aligned with it still share them
+    const auto channel_2_spectrum = engine.input_spectrum(key, 2, 16, channel_0_fingerprint, 0.0, compute);
+    EXPECT_EQ(channel_0_spectrum.get(), channel_2_spectrum.get());
+    EXPECT_EQ(calls, 2);
+    engine.clear();
+    EXPECT_EQ(engine.mismatched(), 0U);
+}
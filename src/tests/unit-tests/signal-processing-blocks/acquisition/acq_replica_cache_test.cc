@@ -0,0 +1,102 @@
+/*!
+ * \file acq_replica_cache_test.cc
+ * \brief This file implements unit tests for the shared cache of replica
+ * spectra used by the PCPS acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_replica_cache.h"
+#include <gtest/gtest.h>
+#include <complex>
+#include <utility>
+#include <vector>
+
+
+TEST(AcqReplicaCacheTest, SharesSpectraBetweenChannels)
+{
+    auto& cache = Acq_Replica_Cache::instance();
+    cache.clear();
+
+    std::vector<std::complex<float>> code(4000, std::complex<float>(1.0, 0.0));
+    Acq_Replica_Key key;
+    key.signal = "1C";
+    key.prn = 1;
+    key.fs = 4000000;
+    key.fft_size = 4000;
+    key.code_fingerprint = Acq_Replica_Cache::fingerprint(code.data(), code.size());
+
+    EXPECT_EQ(cache.find(key), nullptr);
+    Acq_Replica_Cache::spectrum_type spectrum(key.fft_size, std::complex<float>(2.0, 0.0));
+    const auto first = cache.insert(key, std::move(spectrum));
+    ASSERT_NE(first, nullptr);
+
+    // A second channel gets the very same object
+    const auto second = cache.find(key);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(cache.size(), 1U);
+
+    // Inserting again the same key keeps the stored spectrum
+    Acq_Replica_Cache::spectrum_type other(key.fft_size, std::complex<float>(3.0, 0.0));
+    const auto third = cache.insert(key, std::move(other));
+    EXPECT_EQ(first.get(), third.get());
+    EXPECT_EQ((*third)[0], std::complex<float>(2.0, 0.0));
+
+    // Different code options lead to a different entry
+    code[0] = std::complex<float>(-1.0, 0.0);
+    Acq_Replica_Key pilot_key = key;
+    pilot_key.code_fingerprint = Acq_Replica_Cache::fingerprint(code.data(), code.size());
+    EXPECT_NE(pilot_key.code_fingerprint, key.code_fingerprint);
+    EXPECT_EQ(cache.find(pilot_key), nullptr);
+
+    // Holders keep the spectrum alive after clearing the cache
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0U);
+    EXPECT_EQ((*first)[0], std::complex<float>(2.0, 0.0));
+}
+
+
+TEST(AcqReplicaCacheTest, ReleasesUnusedSpectra)
+{
+    auto& cache = Acq_Replica_Cache::instance();
+    cache.clear();
+
+    Acq_Replica_Key data_key;
+    data_key.signal = "1B";
+    data_key.code_options = "data boc";
+    data_key.prn = 11;
+    data_key.fs = 4000000;
+    data_key.fft_size = 16000;
+    data_key.consumed_samples = 16000;
+    Acq_Replica_Key pilot_key = data_key;
+    pilot_key.code_options = "pilot boc";
+
+    auto data = cache.insert(data_key, Acq_Replica_Cache::spectrum_type(data_key.fft_size));
+    auto data_copy = cache.find(data_key);
+    auto pilot = cache.insert(pilot_key, Acq_Replica_Cache::spectrum_type(pilot_key.fft_size));
+    EXPECT_NE(data.get(), pilot.get());
+    EXPECT_EQ(cache.size(), 2U);
+
+    // The entry lives as long as any channel holds it
+    data.reset();
+    EXPECT_EQ(cache.size(), 2U);
+    EXPECT_EQ(cache.find(data_key).get(), data_copy.get());
+    data_copy.reset();
+    EXPECT_EQ(cache.size(), 1U);
+    EXPECT_EQ(cache.find(data_key), nullptr);
+
+    // A released key can be inserted again
+    data = cache.insert(data_key, Acq_Replica_Cache::spectrum_type(data_key.fft_size));
+    EXPECT_EQ(cache.size(), 2U);
+    pilot.reset();
+    data.reset();
+    EXPECT_EQ(cache.size(), 0U);
+}
@@ -0,0 +1,109 @@
+/*!
+ * \file acq_worker_pool_test.cc
+ * \brief This file implements unit tests for the pool of worker threads
+ * shared by the PCPS acquisition blocks.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "acq_worker_pool.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+TEST(AcqWorkerPoolTest, SharesJobsAmongPersistentThreads)
+{
+    auto& pool = Acq_Worker_Pool::instance();
+    const uint32_t num_items = 1000;
+
+    for (int run = 0; run < 10; run++)
+        {
+            std::vector<std::atomic<int>> processed(num_items);
+            std::atomic<uint32_t> next_item{0U};
+            const std::function<void()> job = [&]() {
+                for (uint32_t i = next_item++; i < num_items; i = next_item++)
+                    {
+                        processed[i]++;
+                    }
+            };
+            pool.run(64, job);
+            for (const auto& count : processed)
+                {
+                    EXPECT_EQ(count, 1);
+                }
+        }
+
+    // The pool is bounded and does not grow with the number of runs
+    EXPECT_LE(pool.num_threads(), pool.max_threads());
+    EXPECT_LT(pool.max_threads(), static_cast<size_t>(std::max(std::thread::hardware_concurrency(), 2U)));
+}
+
+
+TEST(AcqWorkerPoolTest, ConcurrentChannels)
+{
+    // Several channels using the pool at the same time get all their items done
+    const uint32_t num_items = 500;
+    std::vector<std::thread> channels;
+    std::atomic<uint32_t> total{0U};
+    for (int ch = 0; ch < 8; ch++)
+        {
+            channels.emplace_back([&total]() {
+                for (int dwell = 0; dwell < 20; dwell++)
+                    {
+                        std::atomic<uint32_t> next_item{0U};
+                        const std::function<void()> job = [&]() {
+                            for (uint32_t i = next_item++; i < num_items; i = next_item++)
+                                {
+                                    total++;
+                                }
+                        };
+                        Acq_Worker_Pool::instance().run(3, job);
+                    }
+            });
+        }
+    for (auto& channel : channels)
+        {
+            channel.join();
+        }
+    EXPECT_EQ(total, 8U * 20U * num_items);
+}
+
+
+TEST(AcqWorkerPoolTest, RethrowsInTheCaller)
+{
+    if (Acq_Worker_Pool::instance().max_threads() == 0)
+        {
+            GTEST_SKIP() << "No worker threads on a single core machine";
+        }
+    const std::thread::id caller = std::this_thread::get_id();
+    std::atomic<bool> helper_started{false};
+    const std::function<void()> job = [caller, &helper_started]() {
+        if (std::this_thread::get_id() != caller)
+            {
+                helper_started = true;
+                throw std::runtime_error("helper failure");
+            }
+        // Give the helper time to start
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!helper_started && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::yield();
+            }
+    };
+    EXPECT_THROW(Acq_Worker_Pool::instance().run(1, job), std::runtime_error);
+}
@@ -18,6 +18,7 @@
 
 
 #include "GPS_L1_CA.h"
+#include "acq_batch_engine.h"
 #include "acquisition_dump_reader.h"
 #include "concurrent_queue.h"
 #include "gnss_block_interface.h"
@@ -32,12 +33,16 @@
 #include <gnuradio/analog/sig_source_waveform.h>
 #include <gnuradio/blocks/file_source.h>
 #include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/blocks/skiphead.h>
 #include <gnuradio/top_block.h>
 #include <gtest/gtest.h>
 #include <pmt/pmt.h>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #if HAS_GENERIC_LAMBDA
 #else
@@ -135,6 +140,8 @@ protected:
 
     void init();
     void plot_grid() const;
+    float acquire_signal_file(const std::string &dump_dir);
+    void acquire_batched(unsigned int channel, uint64_t skipped_samples);
 
     gr::top_block_sptr top_block;
     std::shared_ptr<InMemoryConfiguration> config;
@@ -240,6 +247,76 @@ void GpsL1CaPcpsAcquisitionTest::plot_grid() const
 }
 
 
+// Acquires the test signal file with the current configuration. The code phase
+// and Doppler are left in gnss_synchro, and the dumped test statistic is returned.
+float GpsL1CaPcpsAcquisitionTest::acquire_signal_file(const std::string &dump_dir)
+{
+    if (fs::exists(dump_dir))
+        {
+            fs::remove_all(dump_dir);
+        }
+    config->supersede_property("Acquisition_1C.dump", "true");
+    config->supersede_property("Acquisition_1C.dump_filename", dump_dir + "/acquisition");
+    gnss_synchro.Acq_delay_samples = 0.0;
+    gnss_synchro.Acq_doppler_hz = 0.0;
+    top_block = gr::make_top_block("Acquisition test");
+    auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    auto msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    acquisition->set_channel(1);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_threshold(0.001);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+    acquisition->connect(top_block);
+    const std::string file = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+    auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), file.c_str(), false);
+    top_block->connect(file_source, 0, acquisition->get_left_block(), 0);
+    top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    acquisition->set_local_code();
+    acquisition->set_state(1);
+    acquisition->init();
+    top_block->run();
+    EXPECT_EQ(1, msg_rx->rx_message) << "Acquisition failure. Expected message: 1=ACQ SUCCESS.";
+
+    Acquisition_Dump_Reader acq_dump(dump_dir + "/acquisition_G_1C", gnss_synchro.PRN, doppler_max, doppler_step, 4000, 1);
+    EXPECT_TRUE(acq_dump.read_binary_acq()) << "Error reading the acquisition dump file";
+    EXPECT_EQ(1, acq_dump.positive_acq);
+    fs::remove_all(dump_dir);
+    return acq_dump.test_statistic;
+}
+
+
+// Acquires the test signal file in batch mode, on the given channel, after
+// dropping its first skipped_samples samples. The code phase and Doppler are
+// left in gnss_synchro.
+void GpsL1CaPcpsAcquisitionTest::acquire_batched(unsigned int channel, uint64_t skipped_samples)
+{
+    config->supersede_property("Acquisition_1C.batch_acquisition", "true");
+    gnss_synchro.Acq_delay_samples = 0.0;
+    gnss_synchro.Acq_doppler_hz = 0.0;
+    top_block = gr::make_top_block("Acquisition test");
+    auto acquisition = gnss_make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
+    auto msg_rx = GpsL1CaPcpsAcquisitionTest_msg_rx_make();
+    acquisition->set_channel(channel);
+    acquisition->set_gnss_synchro(&gnss_synchro);
+    acquisition->set_threshold(0.001);
+    acquisition->set_doppler_max(doppler_max);
+    acquisition->set_doppler_step(doppler_step);
+    acquisition->connect(top_block);
+    const std::string file = std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat";
+    auto file_source = gr::blocks::file_source::make(sizeof(gr_complex), file.c_str(), false);
+    auto skiphead = gr::blocks::skiphead::make(sizeof(gr_complex), skipped_samples);
+    top_block->connect(file_source, 0, skiphead, 0);
+    top_block->connect(skiphead, 0, acquisition->get_left_block(), 0);
+    top_block->msg_connect(acquisition->get_right_block(), pmt::mp("events"), msg_rx, pmt::mp("events"));
+    acquisition->set_local_code();
+    acquisition->set_state(1);
+    acquisition->init();
+    top_block->run();
+    EXPECT_EQ(1, msg_rx->rx_message) << "Acquisition failure in channel " << channel << ". Expected message: 1=ACQ SUCCESS.";
+}
+
+
 TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, Instantiate /*unused*/)
 {
     std::shared_ptr<GpsL1CaPcpsAcquisition> acquisition = std::make_shared<GpsL1CaPcpsAcquisition>(config.get(), "Acquisition_1C", 1, 0);
@@ -365,3 +442,87 @@ TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ValidationOfResults /*unused*/)
             plot_grid();
         }
 }
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, FrequencyDomainDoppler /*unused*/)
+{
+    // The frequency-domain Doppler search must find the same peak as the time-domain search
+    init();
+    config->supersede_property("Acquisition_1C.frequency_domain_doppler", "false");
+    const float time_domain_statistic = acquire_signal_file("./tmp-acq-gps1-td");
+    const double time_domain_delay_samples = gnss_synchro.Acq_delay_samples;
+    const double time_domain_doppler_hz = gnss_synchro.Acq_doppler_hz;
+
+    config->supersede_property("Acquisition_1C.frequency_domain_doppler", "true");
+    const float frequency_domain_statistic = acquire_signal_file("./tmp-acq-gps1-fd");
+
+    EXPECT_EQ(time_domain_delay_samples, gnss_synchro.Acq_delay_samples);
+    EXPECT_EQ(time_domain_doppler_hz, gnss_synchro.Acq_doppler_hz);
+    EXPECT_NEAR(time_domain_statistic, frequency_domain_statistic, 1e-4 * time_domain_statistic);
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, ParallelDopplerSearch /*unused*/)
+{
+    // Splitting the Doppler grid among threads must not change the results
+    init();
+    config->supersede_property("Acquisition_1C.doppler_threads", "1");
+    const float serial_statistic = acquire_signal_file("./tmp-acq-gps1-serial");
+    const double serial_delay_samples = gnss_synchro.Acq_delay_samples;
+    const double serial_doppler_hz = gnss_synchro.Acq_doppler_hz;
+
+    config->supersede_property("Acquisition_1C.doppler_threads", "4");
+    const float parallel_statistic = acquire_signal_file("./tmp-acq-gps1-parallel");
+
+    EXPECT_EQ(serial_delay_samples, gnss_synchro.Acq_delay_samples);
+    EXPECT_EQ(serial_doppler_hz, gnss_synchro.Acq_doppler_hz);
+    EXPECT_FLOAT_EQ(serial_statistic, parallel_statistic);
+}
+
+
+TEST_F(GpsL1CaPcpsAcquisitionTest /*unused*/, BatchedMisalignedSampleCounters /*unused*/)
+{
+    // Channels whose sample counters are not aligned see other samples under
+    // the same sample stamp, and must not use the spectra of each other
+    init();
+    const auto num_bins = static_cast<int>(std::ceil(2.0 * doppler_max / doppler_step));
+    const uint64_t skipped_samples = 1000;
+    auto &engine = Acq_Batch_Engine::instance();
+    engine.clear();
+
+    // Keep the spectra of the first block in the engine while the channels
+    // run one after the other, as if another channel was still searching it
+    Acq_Batch_Key key;
+    key.signal = "1C";
+    key.fs = 4000000;
+    key.fft_size = 4000;
+    key.consumed_samples = 4000;
+    std::vector<gr_complex> first_block(key.consumed_samples);
+    std::ifstream file(std::string(TEST_PATH) + "signal_samples/GPS_L1_CA_ID_1_Fs_4Msps_2ms.dat", std::ios::binary);
+    ASSERT_TRUE(file.read(reinterpret_cast<char *>(first_block.data()), first_block.size() * sizeof(gr_complex))) << "Error reading the test signal file";
+    engine.input_spectrum(key, 100, 0, Acq_Batch_Engine::fingerprint(first_block.data(), first_block.size()), 1.0e9F, [](Acq_Batch_Engine::spectrum_type & /*out*/) {});
+
+    acquire_batched(1, 0);
+    const double delay_samples = gnss_synchro.Acq_delay_samples;
+    const double doppler_hz = gnss_synchro.Acq_doppler_hz;
+    const uint64_t computed = engine.computed();
+    EXPECT_EQ(computed, static_cast<uint64_t>(num_bins + 1));
+
+    // An aligned channel gets all its spectra from the engine
+    acquire_batched(2, 0);
+    EXPECT_EQ(engine.computed(), computed);
+    EXPECT_EQ(engine.mismatched(), 0U);
+    EXPECT_EQ(delay_samples, gnss_synchro.Acq_delay_samples);
+    EXPECT_EQ(doppler_hz, gnss_synchro.Acq_doppler_hz);
+
+    // A channel that started reading the stream later computes its own
+    // spectra, and finds the code phase shifted by the samples it missed
+    acquire_batched(3, skipped_samples);
+    EXPECT_EQ(engine.mismatched(), static_cast<uint64_t>(num_bins));
+    EXPECT_EQ(engine.computed(), computed + num_bins);
+    EXPECT_NEAR(std::fmod(delay_samples - static_cast<double>(skipped_samples) + 4000.0, 4000.0), gnss_synchro.Acq_delay_samples, 1.0);
+    EXPECT_EQ(doppler_hz, gnss_synchro.Acq_doppler_hz);
+
+    engine.unsubscribe(key, 100);
+    engine.clear();
+}
@@ -0,0 +1,99 @@
+/*!
+ * \file binary_dump_writer_test.cc
+ * \brief This file implements unit tests for the Binary_Dump_Writer class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "binary_dump_writer.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+#pragma pack(push, 1)
+struct Test_Dump_Record
+{
+    uint64_t counter;
+    double value;
+    uint32_t tag;
+};
+#pragma pack(pop)
+}  // namespace
+
+
+TEST(BinaryDumpWriterTest, WritesAllRecordsInOrder)
+{
+    const std::string filename = "binary_dump_writer_test.dat";
+    const uint64_t num_records = 100000;
+    Binary_Dump_Writer writer;
+    ASSERT_TRUE(writer.open(filename, sizeof(Test_Dump_Record), 1024));
+    EXPECT_TRUE(writer.is_open());
+    uint64_t pushed = 0;
+    for (uint64_t i = 0; i < num_records; i++)
+        {
+            const Test_Dump_Record record{i, static_cast<double>(i) * 0.5, static_cast<uint32_t>(i % 7)};
+            if (writer.push(record))
+                {
+                    pushed++;
+                }
+        }
+    writer.close();
+    EXPECT_FALSE(writer.is_open());
+    EXPECT_EQ(writer.written_records(), pushed);
+    EXPECT_EQ(writer.written_records() + writer.dropped_records(), num_records);
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(file.is_open());
+    EXPECT_EQ(static_cast<uint64_t>(file.tellg()), pushed * sizeof(Test_Dump_Record));
+    file.seekg(0, std::ios::beg);
+    std::vector<Test_Dump_Record> records(pushed);
+    file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(pushed * sizeof(Test_Dump_Record)));
+    file.close();
+    // dropped records leave gaps, but the written ones keep their order
+    for (uint64_t i = 1; i < pushed; i++)
+        {
+            EXPECT_LT(records[i - 1].counter, records[i].counter);
+            EXPECT_DOUBLE_EQ(records[i].value, static_cast<double>(records[i].counter) * 0.5);
+            EXPECT_EQ(records[i].tag, static_cast<uint32_t>(records[i].counter % 7));
+        }
+    std::remove(filename.c_str());
+}
+
+
+TEST(BinaryDumpWriterTest, DropsRecordsWhenNotOpen)
+{
+    Binary_Dump_Writer writer;
+    const Test_Dump_Record record{1, 2.0, 3};
+    EXPECT_FALSE(writer.is_open());
+    EXPECT_FALSE(writer.push(record));
+    EXPECT_EQ(writer.written_records(), 0U);
+}
+
+
+TEST(BinaryDumpWriterTest, RejectsRecordsOfWrongSize)
+{
+    const std::string filename = "binary_dump_writer_size_test.dat";
+    Binary_Dump_Writer writer;
+    ASSERT_TRUE(writer.open(filename, sizeof(Test_Dump_Record)));
+    EXPECT_FALSE(writer.open(filename, sizeof(Test_Dump_Record)));
+    const uint32_t wrong_record = 0;
+    EXPECT_FALSE(writer.push(wrong_record));
+    const Test_Dump_Record record{1, 2.0, 3};
+    EXPECT_TRUE(writer.push(record));
+    writer.close();
+    EXPECT_EQ(writer.written_records(), 1U);
+    std::remove(filename.c_str());
+}
@@ -0,0 +1,210 @@
+/*!
+ * \file gnss_replica_store_test.cc
+ * \brief This file implements unit tests for the Gnss_Replica_Store class
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_e1_signal_replica.h"
+#include "gnss_replica_store.h"
+#include "gps_sdr_signal_replica.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <complex>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+
+TEST(GnssReplicaStoreTest, GeneratorsServeStoredReplicas)
+{
+    Gnss_Replica_Store& store = Gnss_Replica_Store::instance();
+    store.clear();
+    const std::array<char, 3> signal_id{'1', 'B', '\0'};
+    const int32_t fs = 6000000;
+    const uint32_t samples_per_code = 24000;  // 4 ms at 6 Msps
+
+    std::vector<std::complex<float>> first(samples_per_code);
+    galileo_e1_code_gen_complex_sampled(first, signal_id, true, 7, fs, 0);
+    const size_t stored = store.size();
+    EXPECT_GT(stored, 0U);
+
+    std::vector<std::complex<float>> second(samples_per_code, std::complex<float>(5.0, 5.0));
+    galileo_e1_code_gen_complex_sampled(second, signal_id, true, 7, fs, 0);
+    EXPECT_EQ(store.size(), stored);
+    EXPECT_EQ(first, second);
+
+    // other PRN, options or code phase are different replicas
+    std::vector<std::complex<float>> other(samples_per_code);
+    galileo_e1_code_gen_complex_sampled(other, signal_id, true, 8, fs, 0);
+    EXPECT_NE(first, other);
+    galileo_e1_code_gen_complex_sampled(other, signal_id, false, 7, fs, 0);
+    EXPECT_NE(first, other);
+    galileo_e1_code_gen_complex_sampled(other, signal_id, true, 7, fs, 10);
+    EXPECT_NE(first, other);
+
+    // the store copies only the samples of one code period
+    std::vector<std::complex<float>> gps(2 * 2048, std::complex<float>(3.0, 3.0));
+    gps_l1_ca_code_gen_complex_sampled(gps, 1, 2048000, 0);
+    gps_l1_ca_code_gen_complex_sampled(gps, 1, 2048000, 0);
+    EXPECT_EQ(gps[2048], std::complex<float>(3.0, 3.0));
+    store.clear();
+    EXPECT_EQ(store.size(), 0U);
+    EXPECT_EQ(store.bytes(), 0U);
+}
+
+
+TEST(GnssReplicaStoreTest, SaveAndLoadCacheFile)
+{
+    const std::string filename = "gnss_replica_store_test.bin";
+    Gnss_Replica_Store& store = Gnss_Replica_Store::instance();
+    store.clear();
+    std::vector<float> replica(1001);
+    for (size_t i = 0; i < replica.size(); i++)
+        {
+            replica[i] = static_cast<float>(i) * 0.25F - 100.0F;
+        }
+    std::vector<std::complex<float>> complex_replica(333, std::complex<float>(1.0, -1.0));
+    store.insert(Gnss_Replica_Key("test_float", 4000000, 3, 2), replica);
+    store.insert(Gnss_Replica_Key("test_complex_odd_name", 0, 12), complex_replica);
+    EXPECT_EQ(store.size(), 2U);
+    ASSERT_TRUE(store.save(filename));
+
+    store.clear();
+    std::vector<float> copied(replica.size());
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 2), copied));
+    ASSERT_TRUE(store.load(filename));
+    EXPECT_EQ(store.size(), 2U);
+    EXPECT_EQ(store.bytes(), 0U);  // mapped from the file
+
+    // the first replica of each generator is generated again and compared
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 2), copied));
+    store.insert(Gnss_Replica_Key("test_float", 4000000, 3, 2), replica);
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 2), copied));
+    EXPECT_EQ(copied, replica);
+    std::vector<std::complex<float>> copied_complex(complex_replica.size());
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("test_complex_odd_name", 0, 12), copied_complex));
+    store.insert(Gnss_Replica_Key("test_complex_odd_name", 0, 12), complex_replica);
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("test_complex_odd_name", 0, 12), copied_complex));
+    EXPECT_EQ(copied_complex, complex_replica);
+    EXPECT_EQ(store.size(), 2U);
+    EXPECT_EQ(store.bytes(), 0U);
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 3), copied));
+    std::vector<float> shorter(replica.size() - 1);
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 2), shorter));
+
+    // saving while the file is mapped replaces it
+    ASSERT_TRUE(store.save(filename));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("test_float", 4000000, 3, 2), copied));
+    EXPECT_EQ(copied, replica);
+    store.clear();
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssReplicaStoreTest, DropsOutdatedCacheReplicas)
+{
+    const std::string filename = "gnss_replica_store_outdated.bin";
+    Gnss_Replica_Store& store = Gnss_Replica_Store::instance();
+    store.clear();
+    store.insert(Gnss_Replica_Key("changed", 0, 1), std::vector<float>(100, 1.0F));
+    store.insert(Gnss_Replica_Key("changed", 0, 2), std::vector<float>(100, 2.0F));
+    store.insert(Gnss_Replica_Key("unchanged", 0, 1), std::vector<float>(100, 3.0F));
+    ASSERT_TRUE(store.save(filename));
+    store.clear();
+    ASSERT_TRUE(store.load(filename));
+
+    // the generator now produces other values
+    std::vector<float> copied(100);
+    const std::vector<float> generated(100, -1.0F);
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("changed", 0, 1), copied));
+    store.insert(Gnss_Replica_Key("changed", 0, 1), generated);
+    EXPECT_EQ(store.size(), 2U);
+    EXPECT_EQ(store.bytes(), 100 * sizeof(float));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("changed", 0, 1), copied));
+    EXPECT_EQ(copied, generated);
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("changed", 0, 2), copied));
+
+    // replicas of other generators are kept
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("unchanged", 0, 1), copied));
+    store.insert(Gnss_Replica_Key("unchanged", 0, 1), std::vector<float>(100, 3.0F));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("unchanged", 0, 1), copied));
+    EXPECT_EQ(copied, std::vector<float>(100, 3.0F));
+    store.clear();
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssReplicaStoreTest, RejectsInvalidCacheFiles)
+{
+    const std::string filename = "gnss_replica_store_invalid.bin";
+    Gnss_Replica_Store& store = Gnss_Replica_Store::instance();
+    store.clear();
+    EXPECT_FALSE(store.load("non_existent_gnss_replica_store.bin"));
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "This is not a replica cache file";
+    }
+    EXPECT_FALSE(store.load(filename));
+
+    // truncated file
+    store.insert(Gnss_Replica_Key("test", 0, 1), std::vector<float>(100, 1.0F));
+    ASSERT_TRUE(store.save(filename));
+    store.clear();
+    std::vector<char> content;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file.write(content.data(), static_cast<std::streamsize>(content.size() - 8));
+    }
+    EXPECT_FALSE(store.load(filename));
+    EXPECT_EQ(store.size(), 0U);
+    std::remove(filename.c_str());
+}
+
+
+TEST(GnssReplicaStoreTest, MemoryLimit)
+{
+    Gnss_Replica_Store& store = Gnss_Replica_Store::instance();
+    store.clear();
+    store.set_max_bytes(1000 * sizeof(float));
+    std::vector<float> copied(400);
+    store.insert(Gnss_Replica_Key("a", 0, 1), std::vector<float>(400, 1.0F));
+    store.insert(Gnss_Replica_Key("b", 0, 1), std::vector<float>(400, 2.0F));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("a", 0, 1), copied));
+
+    // the least recently used replica is evicted
+    store.insert(Gnss_Replica_Key("c", 0, 1), std::vector<float>(400, 3.0F));
+    EXPECT_EQ(store.size(), 2U);
+    EXPECT_EQ(store.bytes(), 800 * sizeof(float));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("a", 0, 1), copied));
+    EXPECT_FALSE(store.copy(Gnss_Replica_Key("b", 0, 1), copied));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("c", 0, 1), copied));
+
+    // lowering the limit evicts
+    store.set_max_bytes(500 * sizeof(float));
+    EXPECT_EQ(store.size(), 1U);
+    EXPECT_EQ(store.bytes(), 400 * sizeof(float));
+    EXPECT_TRUE(store.copy(Gnss_Replica_Key("c", 0, 1), copied));
+
+    // replicas larger than the limit are still generated but not stored
+    std::vector<std::complex<float>> code(4000);
+    gps_l1_ca_code_gen_complex_sampled(code, 1, 4000000, 0);
+    EXPECT_EQ(store.size(), 1U);
+    EXPECT_FLOAT_EQ(std::abs(code[0]), 1.0F);
+    store.set_max_bytes(static_cast<size_t>(64) * 1024 * 1024);
+    store.clear();
+}
@@ -0,0 +1,180 @@
+/*!
+ * \file observables_history_test.cc
+ * \brief  This file implements tests for the Observables_History class
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include "observables_history.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+// Tracking observable of a channel at sample counter, one every 4000 samples
+Gnss_Synchro observable_at(uint64_t sample_counter, uint32_t tow_ms)
+{
+    Gnss_Synchro gs{};
+    gs.PRN = 3;
+    gs.fs = 4000000;
+    gs.Tracking_sample_counter = sample_counter;
+    gs.TOW_at_current_symbol_ms = tow_ms;
+    const double t = static_cast<double>(sample_counter) / static_cast<double>(gs.fs);
+    gs.Carrier_phase_rads = 100.0 * t + 30.0 * t * t + 5.0 * t * t * t;
+    gs.Carrier_Doppler_hz = 1000.0 + 50.0 * t;
+    return gs;
+}
+
+
+double rx_time_s(const Gnss_Synchro& gs)
+{
+    return static_cast<double>(gs.Tracking_sample_counter) / static_cast<double>(gs.fs);
+}
+}  // namespace
+
+
+TEST(ObservablesHistoryTest, LinearInterpolation)
+{
+    Observables_History history(100, 2);
+    for (uint32_t k = 1; k <= 10; k++)
+        {
+            const Gnss_Synchro gs = observable_at(4000ULL * k, 1000U + k);
+            history.push_back(1, gs, rx_time_s(gs));
+        }
+    EXPECT_EQ(history.size(0), 0U);
+    EXPECT_EQ(history.size(1), 10U);
+
+    Gnss_Synchro obs{};
+    const double max_distance_s = 0.02;
+    EXPECT_FALSE(history.interpolate(0, 20000ULL, max_distance_s, obs));
+    EXPECT_FALSE(history.interpolate(1, 3999ULL, max_distance_s, obs));   // before the first one
+    EXPECT_FALSE(history.interpolate(1, 40001ULL, max_distance_s, obs));  // after the last one
+    EXPECT_FALSE(history.interpolate(1, 21000ULL, 0.0002, obs));          // too far from the nearest
+
+    ASSERT_TRUE(history.interpolate(1, 21000ULL, max_distance_s, obs));
+    const Gnss_Synchro gs1 = observable_at(20000ULL, 1005U);
+    const Gnss_Synchro gs2 = observable_at(24000ULL, 1006U);
+    EXPECT_EQ(obs.Tracking_sample_counter, 20000ULL);  // fields of the nearest one
+    EXPECT_DOUBLE_EQ(obs.RX_time, rx_time_s(gs1));
+    EXPECT_DOUBLE_EQ(obs.Carrier_phase_rads, gs1.Carrier_phase_rads + (gs2.Carrier_phase_rads - gs1.Carrier_phase_rads) * 0.25);
+    EXPECT_DOUBLE_EQ(obs.Carrier_Doppler_hz, gs1.Carrier_Doppler_hz + (gs2.Carrier_Doppler_hz - gs1.Carrier_Doppler_hz) * 0.25);
+    EXPECT_DOUBLE_EQ(obs.interp_TOW_ms, 1005.25);
+
+    ASSERT_TRUE(history.interpolate(1, 24000ULL, max_distance_s, obs));
+    EXPECT_EQ(obs.Tracking_sample_counter, 24000ULL);
+    EXPECT_DOUBLE_EQ(obs.interp_TOW_ms, 1006.0);
+}
+
+
+TEST(ObservablesHistoryTest, ExactHits)
+{
+    for (uint32_t order : {1U, 3U})
+        {
+            Observables_History history(100, 1, order);
+            for (uint32_t k = 1; k <= 10; k++)
+                {
+                    const Gnss_Synchro gs = observable_at(4000ULL * k, 1000U + k);
+                    history.push_back(0, gs, rx_time_s(gs));
+                }
+            // the first, an intermediate and the last stored observables
+            for (uint32_t k : {1U, 6U, 10U})
+                {
+                    const Gnss_Synchro gs = observable_at(4000ULL * k, 1000U + k);
+                    Gnss_Synchro obs{};
+                    ASSERT_TRUE(history.interpolate(0, 4000ULL * k, 0.02, obs)) << "Order " << order << ", observable " << k;
+                    EXPECT_EQ(obs.Tracking_sample_counter, gs.Tracking_sample_counter);
+                    EXPECT_DOUBLE_EQ(obs.RX_time, rx_time_s(gs));
+                    EXPECT_EQ(obs.Carrier_phase_rads, gs.Carrier_phase_rads);
+                    EXPECT_EQ(obs.Carrier_Doppler_hz, gs.Carrier_Doppler_hz);
+                    EXPECT_EQ(obs.interp_TOW_ms, static_cast<double>(gs.TOW_at_current_symbol_ms));
+                }
+        }
+
+    // a single stored observable
+    Observables_History history(100, 1);
+    const Gnss_Synchro gs = observable_at(4000ULL, 1001U);
+    history.push_back(0, gs, rx_time_s(gs));
+    Gnss_Synchro obs{};
+    EXPECT_FALSE(history.interpolate(0, 4001ULL, 0.02, obs));
+    ASSERT_TRUE(history.interpolate(0, 4000ULL, 0.02, obs));
+    EXPECT_EQ(obs.Carrier_phase_rads, gs.Carrier_phase_rads);
+    EXPECT_EQ(obs.interp_TOW_ms, 1001.0);
+}
+
+
+TEST(ObservablesHistoryTest, LagrangeInterpolation)
+{
+    Observables_History linear(100, 1, 1);
+    Observables_History cubic(100, 1, 3);
+    for (uint32_t k = 1; k <= 10; k++)
+        {
+            const Gnss_Synchro gs = observable_at(4000ULL * k, 1000U + k);
+            linear.push_back(0, gs, rx_time_s(gs));
+            cubic.push_back(0, gs, rx_time_s(gs));
+        }
+    for (uint64_t rx_clock : {4001ULL, 17000ULL, 21000ULL, 39999ULL})
+        {
+            const Gnss_Synchro exact = observable_at(rx_clock, 0U);
+            Gnss_Synchro obs{};
+            ASSERT_TRUE(cubic.interpolate(0, rx_clock, 0.02, obs));
+            EXPECT_NEAR(obs.Carrier_phase_rads, exact.Carrier_phase_rads, 1e-9);
+            EXPECT_NEAR(obs.Carrier_Doppler_hz, exact.Carrier_Doppler_hz, 1e-9);
+            EXPECT_NEAR(obs.interp_TOW_ms, 1000.0 + static_cast<double>(rx_clock) / 4000.0, 1e-9);
+            ASSERT_TRUE(linear.interpolate(0, rx_clock, 0.02, obs));
+            EXPECT_NEAR(obs.Carrier_Doppler_hz, exact.Carrier_Doppler_hz, 1e-9);
+        }
+}
+
+
+TEST(ObservablesHistoryTest, WeekRollover)
+{
+    for (uint32_t order : {1U, 2U})
+        {
+            Observables_History history(100, 1, order);
+            const uint32_t tows[] = {604799980U, 604800000U - 10U, 0U, 10U};
+            for (uint32_t k = 0; k < 4; k++)
+                {
+                    const Gnss_Synchro gs = observable_at(4000ULL * (k + 1), tows[k]);
+                    history.push_back(0, gs, rx_time_s(gs));
+                }
+            Gnss_Synchro obs{};
+            ASSERT_TRUE(history.interpolate(0, 10000ULL, 0.02, obs));
+            EXPECT_NEAR(obs.interp_TOW_ms, 604800000.0 - 10.0 + 5.0, 1e-6);
+        }
+}
+
+
+TEST(ObservablesHistoryTest, RestartsOnNewSatellite)
+{
+    Observables_History history(5, 1);
+    for (uint32_t k = 1; k <= 8; k++)
+        {
+            const Gnss_Synchro gs = observable_at(4000ULL * k, k);
+            history.push_back(0, gs, rx_time_s(gs));
+        }
+    EXPECT_EQ(history.size(0), 5U);  // capacity
+
+    Gnss_Synchro gs = observable_at(36000ULL, 9U);
+    gs.PRN = 4;
+    history.push_back(0, gs, rx_time_s(gs));
+    EXPECT_EQ(history.size(0), 1U);
+
+    gs = observable_at(20000ULL, 5U);
+    gs.PRN = 4;
+    history.push_back(0, gs, rx_time_s(gs));  // the sample counter went backwards
+    EXPECT_EQ(history.size(0), 1U);
+
+    history.clear(0);
+    EXPECT_EQ(history.size(0), 0U);
+}
@@ -0,0 +1,86 @@
+/*!
+ * \file rcu_snapshot_test.cc
+ * \brief Implements Unit Tests for the Rcu_Snapshot class.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gps_ephemeris.h"
+#include "rcu_snapshot.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <map>
+#include <thread>
+
+
+TEST(RcuSnapshotTest, PublishAndLoad)
+{
+    Rcu_Snapshot<std::map<int, Gps_Ephemeris>> snapshot;
+    EXPECT_EQ(snapshot.version(), 0U);
+    ASSERT_TRUE(snapshot.load() != nullptr);
+    EXPECT_TRUE(snapshot.load()->empty());
+
+    std::map<int, Gps_Ephemeris> eph_map;
+    eph_map[1].PRN = 1;
+    snapshot.publish(eph_map);
+    const auto first = snapshot.load();
+    EXPECT_EQ(snapshot.version(), 1U);
+
+    eph_map[2].PRN = 2;
+    snapshot.publish(eph_map);
+    EXPECT_EQ(snapshot.version(), 2U);
+
+    // The old version is still valid for the reader that holds it
+    EXPECT_EQ(first->size(), 1U);
+    EXPECT_EQ(first->at(1).PRN, 1U);
+    EXPECT_EQ(snapshot.load()->size(), 2U);
+}
+
+
+TEST(RcuSnapshotTest, ConcurrentReaders)
+{
+    Rcu_Snapshot<std::map<int, int>> snapshot;
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+
+    std::thread reader([&]() {
+        while (!done.load())
+            {
+                const auto data = snapshot.load();
+                // Every published map holds the keys 0..n-1 with value n
+                const auto n = static_cast<int>(data->size());
+                for (const auto& it : *data)
+                    {
+                        if (it.second != n)
+                            {
+                                consistent = false;
+                            }
+                    }
+            }
+    });
+
+    std::map<int, int> data;
+    for (int n = 1; n <= 1000; n++)
+        {
+            data[n - 1] = n;
+            for (auto& it : data)
+                {
+                    it.second = n;
+                }
+            snapshot.publish(data);
+        }
+    done = true;
+    reader.join();
+
+    EXPECT_TRUE(consistent.load());
+    EXPECT_EQ(snapshot.version(), 1000U);
+    EXPECT_EQ(snapshot.load()->size(), 1000U);
+}
@@ -18,8 +18,10 @@
 #include "rinex_printer.h"
 #include "rtklib_rtkpos.h"
 #include "rtklib_solver.h"
+#include <algorithm>
 #include <fstream>
 #include <string>
+#include <vector>
 
 
 class RinexPrinterTest : public ::testing::Test
@@ -139,6 +141,79 @@ void RinexPrinterTest::conf()
 }
 
 
+std::vector<std::string> read_rinex_lines(const std::string& filename)
+{
+    std::vector<std::string> lines;
+    std::ifstream file(filename);
+    std::string line_str;
+    while (std::getline(file, line_str))
+        {
+            lines.push_back(line_str);
+        }
+    return lines;
+}
+
+
+std::vector<std::string>::iterator find_rinex_record(std::vector<std::string>& lines, const std::string& record)
+{
+    // Header records are identified by their label in columns 61-80 and,
+    // for the labels shared by several systems, by the first four columns
+    return std::find_if(lines.begin(), lines.end(), [&record](const std::string& line_str) {
+        return line_str.size() == record.size() && line_str.compare(60, 20, record, 60, 20) == 0 && line_str.compare(0, 4, record, 0, 4) == 0;
+    });
+}
+
+
+// Expected result of the former header update, which rewrote the whole
+// file: the reserved record is not there, the LEAP SECONDS record follows
+// TIME OF FIRST OBS, and the navigation header records are replaced
+void expect_rinex_update(const std::string& reference_obsfile, const std::string& updated_obsfile,
+    const std::string& reference_navfile, const std::string& updated_navfile,
+    const std::string& leap_seconds_record, const std::vector<std::string>& nav_records)
+{
+    std::vector<std::string> expected_obs = read_rinex_lines(reference_obsfile);
+    const std::vector<std::string> updated_obs = read_rinex_lines(updated_obsfile);
+    auto record = std::find_if(expected_obs.begin(), expected_obs.end(), [](const std::string& line_str) { return line_str.find("LEAP SECONDS NOT AVAILABLE YET") == 0; });
+    ASSERT_NE(record, expected_obs.end());
+    expected_obs.erase(record);
+    record = std::find_if(expected_obs.begin(), expected_obs.end(), [](const std::string& line_str) { return line_str.find("TIME OF FIRST OBS", 59) != std::string::npos; });
+    ASSERT_NE(record, expected_obs.end());
+    expected_obs.insert(record + 1, leap_seconds_record);
+
+    std::vector<std::string> expected_nav = read_rinex_lines(reference_navfile);
+    const std::vector<std::string> updated_nav = read_rinex_lines(updated_navfile);
+    for (const auto& nav_record : nav_records)
+        {
+            record = find_rinex_record(expected_nav, nav_record);
+            ASSERT_NE(record, expected_nav.end()) << nav_record;
+            *record = nav_record;
+        }
+
+    // Both files were created at the same time, except maybe for the seconds
+    // in the file creation date
+    ASSERT_EQ(expected_obs.size(), updated_obs.size());
+    for (size_t i = 0; i < expected_obs.size(); i++)
+        {
+            if (expected_obs[i].find("PGM / RUN BY / DATE", 59) == std::string::npos)
+                {
+                    EXPECT_EQ(expected_obs[i], updated_obs[i]) << "Observation file line " << i + 1;
+                }
+        }
+    ASSERT_EQ(expected_nav.size(), updated_nav.size());
+    for (size_t i = 0; i < expected_nav.size(); i++)
+        {
+            if (expected_nav[i].find("PGM / RUN BY / DATE", 59) == std::string::npos)
+                {
+                    EXPECT_EQ(expected_nav[i], updated_nav[i]) << "Navigation file line " << i + 1;
+                }
+        }
+
+    // The headers were updated in place
+    EXPECT_EQ(fs::file_size(reference_obsfile), fs::file_size(updated_obsfile));
+    EXPECT_EQ(fs::file_size(reference_navfile), fs::file_size(updated_navfile));
+}
+
+
 TEST_F(RinexPrinterTest, GalileoObsHeader)
 {
     auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", 4, false, false);
@@ -1010,3 +1085,222 @@ TEST_F(RinexPrinterTest, MixedObsLogGpsGlo)
     fs::remove(navfile);
     fs::remove(obsfile);
 }
+
+
+TEST_F(RinexPrinterTest, GpsHeaderUpdate)
+{
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 1;
+    eph.WN = 161;
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs = Gnss_Synchro();
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+    gs.PRN = 3;
+    gs.Pseudorange_m = 22000000;
+    gs.Carrier_phase_rads = 23.4;
+    gs.Carrier_Doppler_hz = 1534;
+    gs.CN0_dB_hz = 42;
+    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(1, gs));
+
+    for (int version : {2, 3})
+        {
+            auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", 1, false, false);
+            pvt_solution->gps_ephemeris_map[1] = eph;
+
+            // The reference files keep the headers written before the UTC model is received
+            auto rp_reference = std::make_shared<Rinex_Printer>(version, ".", "reference");
+            auto rp_updated = std::make_shared<Rinex_Printer>(version, ".", "updated");
+            rp_reference->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 0.0, 1, true);
+            rp_updated->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 0.0, 1, true);
+            rp_reference->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 1.0, 1, true);
+
+            pvt_solution->gps_utc_model.A0 = 1.5e-9;
+            pvt_solution->gps_utc_model.A1 = 2.5e-14;
+            pvt_solution->gps_utc_model.tot = 319488;
+            pvt_solution->gps_utc_model.WN_T = 137;
+            pvt_solution->gps_utc_model.DeltaT_LS = 18;
+            pvt_solution->gps_utc_model.DeltaT_LSF = 18;
+            pvt_solution->gps_utc_model.WN_LSF = 137;
+            pvt_solution->gps_utc_model.DN = 7;
+            pvt_solution->gps_iono.alpha0 = 1.1e-8;
+            pvt_solution->gps_iono.alpha1 = 1.49e-8;
+            pvt_solution->gps_iono.alpha2 = -5.96e-8;
+            pvt_solution->gps_iono.alpha3 = -1.19e-7;
+            pvt_solution->gps_iono.beta0 = 88064;
+            pvt_solution->gps_iono.beta1 = 49152;
+            pvt_solution->gps_iono.beta2 = -131072;
+            pvt_solution->gps_iono.beta3 = -327680;
+            rp_updated->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 1.0, 1, true);
+
+            const std::string reference_obsfile = rp_reference->get_obsfilename();
+            const std::string reference_navfile = rp_reference->get_navfilename()[0];
+            const std::string updated_obsfile = rp_updated->get_obsfilename();
+            const std::string updated_navfile = rp_updated->get_navfilename()[0];
+            rp_reference = nullptr;  // close the RINEX files so we can inspect them
+            rp_updated = nullptr;
+
+            if (version == 2)
+                {
+                    expect_rinex_update(reference_obsfile, updated_obsfile, reference_navfile, updated_navfile,
+                        "    18                                                      LEAP SECONDS        ",
+                        {"     .1100D-07   .1490D-07  -.5960D-07  -.1190D-06          ION ALPHA           ",
+                            "     .8806D+05   .4915D+05  -.1311D+06  -.3277D+06          ION BETA            ",
+                            "     .150000000000D-08  .250000000000D-13   319488     2185 DELTA-UTC: A0,A1,T,W",
+                            "    18                                                      LEAP SECONDS        "});
+                }
+            else
+                {
+                    expect_rinex_update(reference_obsfile, updated_obsfile, reference_navfile, updated_navfile,
+                        "    18    18   137     7                                    LEAP SECONDS        ",
+                        {"GPSA    .1100D-07   .1490D-07  -.5960D-07  -.1190D-06       IONOSPHERIC CORR    ",
+                            "GPSB    .8806D+05   .4915D+05  -.1311D+06  -.3277D+06       IONOSPHERIC CORR    ",
+                            "GPUT   .1500000000D-08  .250000000D-13 319488 2185          TIME SYSTEM CORR    ",
+                            "    18    18   137     7                                    LEAP SECONDS        "});
+                }
+            fs::remove(reference_obsfile);
+            fs::remove(reference_navfile);
+            fs::remove(updated_obsfile);
+            fs::remove(updated_navfile);
+        }
+}
+
+
+TEST_F(RinexPrinterTest, GalileoHeaderUpdate)
+{
+    auto eph = Galileo_Ephemeris();
+    eph.PRN = 1;
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs = Gnss_Synchro();
+    gs.System = 'E';
+    std::memcpy(static_cast<void*>(gs.Signal), "1B", 3);
+    gs.PRN = 22;
+    gs.Pseudorange_m = 22000000;
+    gs.Carrier_phase_rads = 23.4;
+    gs.Carrier_Doppler_hz = 1534;
+    gs.CN0_dB_hz = 42;
+    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(1, gs));
+
+    auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", 4, false, false);
+    pvt_solution->galileo_ephemeris_map[1] = eph;
+
+    auto rp_reference = std::make_shared<Rinex_Printer>(3, ".", "reference");
+    auto rp_updated = std::make_shared<Rinex_Printer>(3, ".", "updated");
+    rp_reference->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 0.0, 4, true);
+    rp_updated->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 0.0, 4, true);
+    rp_reference->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 1.0, 4, true);
+
+    pvt_solution->galileo_utc_model.A0 = 1.5e-9;
+    pvt_solution->galileo_utc_model.A1 = 2.5e-14;
+    pvt_solution->galileo_utc_model.tot = 319488;
+    pvt_solution->galileo_utc_model.WNot = 137;
+    pvt_solution->galileo_utc_model.Delta_tLS = 18;
+    pvt_solution->galileo_utc_model.Delta_tLSF = 18;
+    pvt_solution->galileo_utc_model.WN_LSF = 137;
+    pvt_solution->galileo_utc_model.DN = 7;
+    pvt_solution->galileo_iono.ai0 = 51.75;
+    pvt_solution->galileo_iono.ai1 = 0.2;
+    pvt_solution->galileo_iono.ai2 = 0.01;
+    rp_updated->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 1.0, 4, true);
+
+    const std::string reference_obsfile = rp_reference->get_obsfilename();
+    const std::string reference_navfile = rp_reference->get_navfilename()[0];
+    const std::string updated_obsfile = rp_updated->get_obsfilename();
+    const std::string updated_navfile = rp_updated->get_navfilename()[0];
+    rp_reference = nullptr;  // close the RINEX files so we can inspect them
+    rp_updated = nullptr;
+
+    expect_rinex_update(reference_obsfile, updated_obsfile, reference_navfile, updated_navfile,
+        "    18    18   137     7                                    LEAP SECONDS        ",
+        {"GAL     .5175D+02   .2000D+00   .1000D-01   .0000D+00       IONOSPHERIC CORR    ",
+            "GAUT   .1500000000D-08  .250000000D-13 319488  137          TIME SYSTEM CORR    ",
+            "    18    18   137     7                                    LEAP SECONDS        "});
+    fs::remove(reference_obsfile);
+    fs::remove(reference_navfile);
+    fs::remove(updated_obsfile);
+    fs::remove(updated_navfile);
+}
+
+
+TEST_F(RinexPrinterTest, LeapSecondsRecordUpdate)
+{
+    auto eph = Gps_Ephemeris();
+    eph.PRN = 1;
+    eph.WN = 161;
+    std::map<int, Gnss_Synchro> gnss_observables_map;
+    Gnss_Synchro gs = Gnss_Synchro();
+    gs.System = 'G';
+    std::memcpy(static_cast<void*>(gs.Signal), "1C", 3);
+    gs.PRN = 3;
+    gs.Pseudorange_m = 22000000;
+    gs.Carrier_phase_rads = 23.4;
+    gs.Carrier_Doppler_hz = 1534;
+    gs.CN0_dB_hz = 42;
+    gnss_observables_map.insert(std::pair<int, Gnss_Synchro>(1, gs));
+    const std::string leap_seconds_record("    18    18   137     7                                    LEAP SECONDS        ");
+    const std::string outdated_record("    17    18   137     7                                    LEAP SECONDS        ");
+
+    // Observation file headers with the reserved record, without it, and
+    // with an outdated LEAP SECONDS record instead, as written by former versions
+    const std::vector<std::string> header_types{"reserved", "none", "outdated"};
+    for (const auto& header_type : header_types)
+        {
+            auto pvt_solution = std::make_shared<Rtklib_Solver>(rtk, "filename", 1, false, false);
+            pvt_solution->gps_ephemeris_map[1] = eph;
+            auto rp = std::make_shared<Rinex_Printer>(3, ".", "leap_seconds");
+            rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 0.0, 1, true);
+            const std::string obsfile = rp->get_obsfilename();
+            const std::string navfile = rp->get_navfilename()[0];
+            rp = nullptr;  // close the RINEX files so we can edit them
+
+            std::vector<std::string> written = read_rinex_lines(obsfile);
+            auto record = std::find_if(written.begin(), written.end(), [](const std::string& line_str) { return line_str.find("LEAP SECONDS NOT AVAILABLE YET") == 0; });
+            ASSERT_NE(record, written.end());
+            if (header_type == "none")
+                {
+                    written.erase(record);
+                }
+            else if (header_type == "outdated")
+                {
+                    *record = outdated_record;
+                }
+            std::ofstream legacy_file(obsfile, std::ios::trunc);
+            for (const auto& line : written)
+                {
+                    legacy_file << line << '\n';
+                }
+            legacy_file.close();
+
+            // A new printer appends its records to the existing file, and
+            // updates the first header when the UTC model is received
+            pvt_solution->gps_utc_model.A0 = 1.5e-9;
+            pvt_solution->gps_utc_model.A1 = 2.5e-14;
+            pvt_solution->gps_utc_model.tot = 319488;
+            pvt_solution->gps_utc_model.WN_T = 137;
+            pvt_solution->gps_utc_model.DeltaT_LS = 18;
+            pvt_solution->gps_utc_model.DeltaT_LSF = 18;
+            pvt_solution->gps_utc_model.WN_LSF = 137;
+            pvt_solution->gps_utc_model.DN = 7;
+            rp = std::make_shared<Rinex_Printer>(3, ".", "leap_seconds");
+            rp->print_rinex_annotation(pvt_solution.get(), gnss_observables_map, 1.0, 1, true);
+            rp = nullptr;
+
+            const std::vector<std::string> updated = read_rinex_lines(obsfile);
+            const auto end_of_header = std::find_if(updated.begin(), updated.end(), [](const std::string& line_str) { return line_str.find("END OF HEADER", 59) != std::string::npos; });
+            ASSERT_NE(end_of_header, updated.end());
+            const auto first_obs = std::find_if(updated.begin(), end_of_header, [](const std::string& line_str) { return line_str.find("TIME OF FIRST OBS", 59) != std::string::npos; });
+            ASSERT_NE(first_obs, end_of_header);
+            EXPECT_EQ(*(first_obs + 1), leap_seconds_record) << header_type;
+            EXPECT_EQ(std::count_if(updated.begin(), end_of_header, [](const std::string& line_str) { return line_str.find("LEAP SECONDS", 59) != std::string::npos; }), 1) << header_type;
+            EXPECT_EQ(std::count_if(updated.begin(), end_of_header, [](const std::string& line_str) { return line_str.find("LEAP SECONDS NOT AVAILABLE YET") == 0; }), 0) << header_type;
+
+            // The records after the first header are kept
+            const auto written_end_of_header = std::find_if(written.begin(), written.end(), [](const std::string& line_str) { return line_str.find("END OF HEADER", 59) != std::string::npos; });
+            ASSERT_NE(written_end_of_header, written.end());
+            ASSERT_GE(updated.end() - end_of_header, written.end() - written_end_of_header);
+            EXPECT_TRUE(std::equal(written_end_of_header, written.end(), end_of_header)) << header_type;
+
+            fs::remove(obsfile);
+            fs::remove(navfile);
+        }
+}
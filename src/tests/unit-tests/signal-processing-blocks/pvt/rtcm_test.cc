@@ -18,6 +18,9 @@
 
 #include "Galileo_INAV.h"
 #include "rtcm.h"
+#include "rtcm_bit_writer.h"
+#include <cstring>
+#include <map>
 #include <memory>
 #include <thread>
 
@@ -172,6 +175,41 @@ TEST(RtcmTest, CheckCRC)
 }
 
 
+TEST(RtcmTest, BitWriter)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    std::string reference_msg = rtcm->bin_to_binary_data(rtcm->hex_to_bin("D300133ED7D30202980EDEEF34B4BD62AC0941986F33360B98"));
+    const uint64_t mask_38_bits = (uint64_t(1) << 38) - 1;
+
+    // MT1005 data fields, in message order
+    Rtcm_Bit_Writer writer;
+    writer.append(1005, 12);
+    writer.append(2003, 12);
+    writer.append(0, 6);
+    writer.append(std::bitset<4>("1000"));
+    writer.append(11141045999, 38);
+    writer.append(0, 2);
+    writer.append(static_cast<uint64_t>(-48507297108) & mask_38_bits, 38);
+    writer.append(0, 2);
+    writer.append(39755214643, 38);
+    EXPECT_EQ(static_cast<uint32_t>(152), writer.size());
+    EXPECT_EQ(0, reference_msg.compare(writer.frame()));
+
+    // The same fields, put into a reserved block in reverse order
+    writer.clear();
+    writer.skip(152);
+    writer.put(114, 39755214643, 38);
+    writer.put(74, static_cast<uint64_t>(-48507297108) & mask_38_bits, 38);
+    writer.put(34, 11141045999, 38);
+    writer.put(30, std::bitset<4>("1000"));
+    writer.put(12, 2003, 12);
+    writer.put(0, 1005, 12);
+    EXPECT_EQ(static_cast<uint32_t>(152), writer.size());
+    EXPECT_EQ(0, reference_msg.compare(writer.frame()));
+    EXPECT_EQ(true, rtcm->check_CRC(writer.frame()));
+}
+
+
 TEST(RtcmTest, MT1001)
 {
     auto rtcm = std::make_shared<Rtcm>();
@@ -594,6 +632,168 @@ TEST(RtcmTest, MSM1)
 }
 
 
+namespace
+{
+Gnss_Synchro rtcm_test_observable(char system, const char* signal, uint32_t prn, double pseudorange_m, double carrier_phase_rads, double carrier_doppler_hz, double cn0_db_hz)
+{
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.System = system;
+    std::memcpy(static_cast<void*>(gnss_synchro.Signal), signal, 3);
+    gnss_synchro.PRN = prn;
+    gnss_synchro.Pseudorange_m = pseudorange_m;
+    gnss_synchro.Carrier_phase_rads = carrier_phase_rads;
+    gnss_synchro.Carrier_Doppler_hz = carrier_doppler_hz;
+    gnss_synchro.CN0_dB_hz = cn0_db_hz;
+    return gnss_synchro;
+}
+
+
+// GPS L1 C/A, L2C and L5 observables: PRN 3 and 17 on L1 and L2, PRN 8 and 29 on L1 and L5
+std::map<int32_t, Gnss_Synchro> rtcm_test_gps_observables()
+{
+    std::map<int32_t, Gnss_Synchro> observables;
+    observables[0] = rtcm_test_observable('G', "1C", 3, 21234567.891, 111601234.5, -1234.56, 45.3);
+    observables[1] = rtcm_test_observable('G', "1C", 8, 23456789.123, 123265432.1, 2345.67, 38.9);
+    observables[2] = rtcm_test_observable('G', "1C", 17, 20567890.456, 108123456.7, 321.09, 47.6);
+    observables[3] = rtcm_test_observable('G', "1C", 29, 24789012.345, 130234567.8, -3210.98, 33.1);
+    observables[4] = rtcm_test_observable('G', "2S", 3, 21234570.012, 86961234.5, -962.0, 41.2);
+    observables[5] = rtcm_test_observable('G', "2S", 17, 20567893.789, 84251234.5, 250.2, 43.8);
+    observables[6] = rtcm_test_observable('G', "L5", 8, 23456791.456, 92051234.5, 1752.3, 48.1);
+    observables[7] = rtcm_test_observable('G', "L5", 29, 24789015.678, 97261234.5, -2398.7, 36.4);
+    return observables;
+}
+
+
+// Galileo E1, E5a and E5b observables of three satellites
+std::map<int32_t, Gnss_Synchro> rtcm_test_galileo_observables()
+{
+    std::map<int32_t, Gnss_Synchro> observables;
+    observables[0] = rtcm_test_observable('E', "1B", 11, 23987654.321, 126012345.6, -876.54, 44.4);
+    observables[1] = rtcm_test_observable('E', "1B", 19, 25123456.789, 132012345.6, 1987.65, 40.2);
+    observables[2] = rtcm_test_observable('E', "1B", 33, 26234567.891, 137912345.6, 54.32, 37.7);
+    observables[3] = rtcm_test_observable('E', "5X", 11, 23987656.654, 94112345.6, -654.7, 46.9);
+    observables[4] = rtcm_test_observable('E', "5X", 33, 26234570.123, 103012345.6, 40.6, 35.2);
+    observables[5] = rtcm_test_observable('E', "7X", 19, 25123459.012, 101512345.6, 1521.3, 42.0);
+    return observables;
+}
+
+
+// GLONASS L1 and L2 C/A observables: PRN 7 and 22 on both bands, PRN 15 on L1 only
+std::map<int32_t, Gnss_Synchro> rtcm_test_glonass_observables()
+{
+    std::map<int32_t, Gnss_Synchro> observables;
+    observables[0] = rtcm_test_observable('R', "1C", 7, 19876543.21, 105012345.6, -1543.2, 43.5);
+    observables[1] = rtcm_test_observable('R', "1C", 15, 21987654.32, 116012345.6, 987.6, 39.8);
+    observables[2] = rtcm_test_observable('R', "1C", 22, 22765432.10, 120012345.6, 12.3, 36.1);
+    observables[3] = rtcm_test_observable('R', "2C", 7, 19876545.67, 81712345.6, -1200.1, 40.7);
+    observables[4] = rtcm_test_observable('R', "2C", 22, 22765434.56, 93412345.6, 9.5, 33.6);
+    return observables;
+}
+}  // namespace
+
+
+/*
+ * The following golden frames were produced by the string-based encoder
+ * that preceded Rtcm_Bit_Writer. Each message is printed twice, 321 s
+ * apart, so that the second frame carries nonzero lock time indicators.
+ */
+TEST(RtcmTest, MSMGoldenFrames)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.WN = 2231;
+    gps_eph.PRN = 3;
+    Gps_CNAV_Ephemeris gps_cnav_eph = Gps_CNAV_Ephemeris();
+    gps_cnav_eph.WN = 2231;
+    Galileo_Ephemeris gal_eph = Galileo_Ephemeris();
+    gal_eph.WN = 1207;
+    gal_eph.PRN = 11;
+    Glonass_Gnav_Ephemeris glo_eph = Glonass_Gnav_Ephemeris();
+    glo_eph.PRN = 7;
+    glo_eph.i_satellite_slot_number = 7;
+    glo_eph.i_satellite_freq_channel = 5;
+    glo_eph.d_N_T = 1110;
+    glo_eph.d_yr = 2022;
+
+    const std::map<int32_t, Gnss_Synchro> gps_observables = rtcm_test_gps_observables();
+    const std::map<int32_t, Gnss_Synchro> gal_observables = rtcm_test_galileo_observables();
+    const std::map<int32_t, Gnss_Synchro> glo_observables = rtcm_test_glonass_observables();
+
+    std::string MSM4;
+    std::string MSM5;
+    std::string MSM7_gps;
+    std::string MSM7_glo;
+    for (double obs_time : {432000.0, 432321.0})
+        {
+            MSM4 = rtcm->print_MSM_4(gps_eph, gps_cnav_eph, {}, {}, obs_time, gps_observables, 1234, 0, 0, 0, false, false);
+            MSM5 = rtcm->print_MSM_5({}, {}, gal_eph, {}, obs_time, gal_observables, 1234, 0, 0, 0, false, true);
+            MSM7_gps = rtcm->print_MSM_7(gps_eph, gps_cnav_eph, {}, {}, obs_time, gps_observables, 1234, 1, 2, 3, true, false);
+            MSM7_glo = rtcm->print_MSM_7({}, {}, {}, glo_eph, obs_time, glo_observables, 1234, 0, 0, 0, false, false);
+        }
+
+    const std::string MSM4_ref =
+        "D300504324D26712C7A0000010804004000000002001000077232722296A67CCDD60757CEBE644C4"
+        "8DA6AC1D6F9BD178007FFFDFFFFA70000D0000000000120004A7FFFF00000022202220005B4CF861"
+        "643200B4B570";
+    const std::string MSM5_ref =
+        "D300534474D26712C7A200000010100040000000080080805D5414D5C0000FCDA09029FE86FFDB16"
+        "063420CB41B5CA2814CD00015BFFFBDFFFDAFFFFAD0000440003244444402CBE8AA68FC187997ED7"
+        "81D1796C727C831D79";
+    const std::string MSM7_gps_ref =
+        "D300794354D26712C7A00038908040040000000020010000772327222900006A67CCDD6001D7F217"
+        "F86131F57C675F319131511B3E6AC146B7BCEF456EFFFF7FFFDE7FFE9C8000CF0000000000130001"
+        "287FFFF000000011044110001104411000005AB49CDD815F55EC25237D3AFA8DC6CA0007C0AF8140"
+        "49200000F6FB21";
+    const std::string MSM7_glo_ref =
+        "D3005643F4D26712C7A00000010102000000000020800000008492960009A2BFE0024DFA27FFC3C5"
+        "CE3E83826785CD907CFB720003F40003B8000241FFFB73FFF9EA44110441104402B8A2E7D90A1A16"
+        "17D8BC398F41EE9AE02277DB";
+
+    EXPECT_EQ(MSM4_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MSM4)));
+    EXPECT_EQ(MSM5_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MSM5)));
+    EXPECT_EQ(MSM7_gps_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MSM7_gps)));
+    EXPECT_EQ(MSM7_glo_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MSM7_glo)));
+    EXPECT_EQ(true, rtcm->check_CRC(MSM7_gps));
+}
+
+
+TEST(RtcmTest, MT1004MT1012GoldenFrames)
+{
+    auto rtcm = std::make_shared<Rtcm>();
+    Gps_Ephemeris gps_eph = Gps_Ephemeris();
+    gps_eph.WN = 2231;
+    Gps_CNAV_Ephemeris gps_cnav_eph = Gps_CNAV_Ephemeris();
+    gps_cnav_eph.WN = 2231;
+    Glonass_Gnav_Ephemeris glo_eph = Glonass_Gnav_Ephemeris();
+    glo_eph.PRN = 7;
+    glo_eph.i_satellite_slot_number = 7;
+    glo_eph.i_satellite_freq_channel = 5;
+    glo_eph.d_N_T = 1110;
+    glo_eph.d_yr = 2022;
+
+    const std::map<int32_t, Gnss_Synchro> gps_observables = rtcm_test_gps_observables();
+    const std::map<int32_t, Gnss_Synchro> glo_observables = rtcm_test_glonass_observables();
+
+    std::string MT1004;
+    std::string MT1012;
+    for (double obs_time : {432000.0, 432321.0})
+        {
+            MT1004 = rtcm->print_MT1004(gps_eph, gps_cnav_eph, obs_time, gps_observables, 1234);
+            MT1012 = rtcm->print_MT1012(glo_eph, glo_eph, obs_time, glo_observables, 1234);
+        }
+
+    const std::string MT1004_ref =
+        "D300283EC4D26712C7A0200D7C1710E5A776D1AD401AA00002DD2A28ADB86B072FB6897C014D0000"
+        "16EBC0D07873";
+    const std::string MT1012_ref =
+        "D300293F44D2A4CBFCE100E611364A83AFBEDA1AE007B80000B746B19BB1B8F2D805B6964001EE00"
+        "002DC300FAECAA";
+
+    EXPECT_EQ(MT1004_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MT1004)));
+    EXPECT_EQ(MT1012_ref, rtcm->bin_to_hex(rtcm->binary_data_to_bin(MT1012)));
+}
+
+
 TEST(RtcmTest, InstantiateServer)
 {
     auto rtcm = std::make_shared<Rtcm>();
@@ -0,0 +1,305 @@
+/*!
+ * \file rtklib_solver_multiband_test.cc
+ * \brief Tests the PVT solutions of the RTKLIB solver with dual frequency
+ * observables of GPS, Galileo and GLONASS, and with ephemerides replaced
+ * between epochs
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "galileo_ephemeris.h"
+#include "glonass_gnav_ephemeris.h"
+#include "glonass_gnav_utc_model.h"
+#include "gnss_sdr_make_unique.h"
+#include "gnss_synchro.h"
+#include "gps_cnav_ephemeris.h"
+#include "gps_ephemeris.h"
+#include "rtklib_conversions.h"
+#include "rtklib_ephemeris.h"
+#include "rtklib_rtkcmn.h"
+#include "rtklib_rtkpos.h"
+#include "rtklib_solver.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+
+
+namespace
+{
+// Ephemerides and error free observables of GPS (L1 C/A, plus L5 for the even
+// PRNs), Galileo (E1B + E5a) and GLONASS (L1 + L2) satellites in view of the
+// receiver, 10 minutes after the reference time of the ephemerides. Every
+// issue is 30 minutes after the previous one and has other orbits.
+struct Multiband_Epoch
+{
+    std::map<int, Gps_Ephemeris> gps_ephemeris_map;
+    std::map<int, Gps_CNAV_Ephemeris> gps_cnav_ephemeris_map;
+    std::map<int, Galileo_Ephemeris> galileo_ephemeris_map;
+    std::map<int, Glonass_Gnav_Ephemeris> glonass_gnav_ephemeris_map;
+    std::map<int, Gnss_Synchro> observables;
+};
+
+
+// Pseudorange from the receiver to the satellite of eph or geph, or 0.0 if it
+// is below 20 degrees of elevation
+double multiband_pseudorange(const std::array<double, 3>& rr, gtime_t time, eph_t eph, geph_t geph)
+{
+    nav_t nav{};
+    nav.eph = &eph;
+    nav.geph = &geph;
+    nav.n = eph.sat > 0 ? 1 : 0;
+    nav.ng = geph.sat > 0 ? 1 : 0;
+    obsd_t obs{};
+    obs.time = time;
+    obs.sat = eph.sat > 0 ? eph.sat : geph.sat;
+    obs.P[0] = 2.2e7;
+    std::array<double, 6> rs{};
+    std::array<double, 2> dts{};
+    std::array<double, 3> e{};
+    double var;
+    int svh;
+    for (int iter = 0; iter < 3; iter++)
+        {
+            satposs(time, &obs, 1, &nav, EPHOPT_BRDC, rs.data(), dts.data(), &var, &svh);
+            obs.P[0] = geodist(rs.data(), rr.data(), e.data()) - SPEED_OF_LIGHT_M_S * dts[0];
+        }
+    std::array<double, 3> pos{};
+    std::array<double, 2> azel{};
+    ecef2pos(rr.data(), pos.data());
+    satazel(pos.data(), e.data(), azel.data());
+    return azel[1] < 20.0 * D2R ? 0.0 : obs.P[0];
+}
+
+
+Multiband_Epoch multiband_epoch(const std::array<double, 3>& rr, int issue)
+{
+    constexpr double glonass_radius_m = 25510e3;
+    constexpr double earth_gm = 3.9860044e14;
+    constexpr double earth_rotation_rate = 7.292115e-5;
+    constexpr int32_t eph_age_s = 600;
+    Multiband_Epoch epoch;
+
+    // The reference time of the GLONASS ephemerides is given in calendar
+    // terms, so the other systems follow it
+    Glonass_Gnav_Ephemeris glo_eph{};
+    glo_eph.d_yr = 2022;
+    glo_eph.d_N_T = 100;
+    glo_eph.d_t_b = 12.0 * 3600.0 + 1800.0 * issue;
+    glo_eph.d_t_k = glo_eph.d_t_b;
+    int week;
+    const gtime_t toe_time = eph_to_rtklib(glo_eph, Glonass_Gnav_Utc_Model{}).toe;
+    const auto toe = static_cast<int32_t>(std::round(time2gpst(toe_time, &week)));
+    const gtime_t time = timeadd(toe_time, eph_age_s);
+
+    auto add_observable = [&](char system, const char* signal, int prn, double pseudorange_m) {
+        Gnss_Synchro gnss_synchro{};
+        gnss_synchro.System = system;
+        gnss_synchro.Signal[0] = signal[0];
+        gnss_synchro.Signal[1] = signal[1];
+        gnss_synchro.PRN = prn;
+        gnss_synchro.Channel_ID = static_cast<int32_t>(epoch.observables.size());
+        gnss_synchro.Pseudorange_m = pseudorange_m;
+        gnss_synchro.CN0_dB_hz = 45.0;
+        gnss_synchro.RX_time = toe + eph_age_s;
+        gnss_synchro.Flag_valid_pseudorange = true;
+        epoch.observables[gnss_synchro.Channel_ID] = gnss_synchro;
+    };
+
+    // Orbital planes and positions are tried along the R2 low discrepancy
+    // sequence until the satellite is in view
+    int trial = 1000 * issue;
+    for (int prn = 1; prn <= 4; prn++)
+        {
+            double pseudorange_m = 0.0;
+            while (pseudorange_m == 0.0)
+                {
+                    trial++;
+                    Gps_Ephemeris eph{};
+                    eph.PRN = prn;
+                    eph.sqrtA = 5153.6;
+                    eph.ecc = 0.01;
+                    eph.i_0 = 55.0 * D2R;
+                    eph.OMEGA_0 = TWO_PI * std::fmod(trial * 0.7548776662, 1.0);
+                    eph.M_0 = TWO_PI * std::fmod(trial * 0.5698402910, 1.0);
+                    eph.WN = week;
+                    eph.toe = toe;
+                    eph.toc = toe;
+                    eph.tow = toe;
+                    pseudorange_m = multiband_pseudorange(rr, time, eph_to_rtklib(eph, false), geph_t{});
+                    if (pseudorange_m != 0.0)
+                        {
+                            epoch.gps_ephemeris_map[prn] = eph;
+                            add_observable('G', "1C", prn, pseudorange_m);
+                            if (prn % 2 == 0)
+                                {
+                                    Gps_CNAV_Ephemeris cnav_eph{};
+                                    cnav_eph.PRN = prn;
+                                    cnav_eph.sqrtA = eph.sqrtA;
+                                    cnav_eph.ecc = eph.ecc;
+                                    cnav_eph.i_0 = eph.i_0;
+                                    cnav_eph.OMEGA_0 = eph.OMEGA_0;
+                                    cnav_eph.M_0 = eph.M_0;
+                                    cnav_eph.WN = week;
+                                    cnav_eph.toe1 = toe;
+                                    cnav_eph.toe2 = toe;
+                                    cnav_eph.toc = toe;
+                                    cnav_eph.tow = toe;
+                                    epoch.gps_cnav_ephemeris_map[prn] = cnav_eph;
+                                    add_observable('G', "L5", prn, pseudorange_m);
+                                }
+                        }
+                }
+        }
+    for (int prn = 1; prn <= 3; prn++)
+        {
+            double pseudorange_m = 0.0;
+            while (pseudorange_m == 0.0)
+                {
+                    trial++;
+                    Galileo_Ephemeris eph{};
+                    eph.PRN = prn;
+                    eph.sqrtA = 5440.6;
+                    eph.ecc = 0.0002;
+                    eph.i_0 = 56.0 * D2R;
+                    eph.OMEGA_0 = TWO_PI * std::fmod(trial * 0.7548776662, 1.0);
+                    eph.M_0 = TWO_PI * std::fmod(trial * 0.5698402910, 1.0);
+                    eph.WN = week - 1024;
+                    eph.toe = toe;
+                    eph.toc = toe;
+                    eph.tow = toe;
+                    pseudorange_m = multiband_pseudorange(rr, time, eph_to_rtklib(eph), geph_t{});
+                    if (pseudorange_m != 0.0)
+                        {
+                            epoch.galileo_ephemeris_map[prn] = eph;
+                            add_observable('E', "1B", prn, pseudorange_m);
+                            add_observable('E', "5X", prn, pseudorange_m);
+                        }
+                }
+        }
+    for (int prn = 1; prn <= 3; prn++)
+        {
+            double pseudorange_m = 0.0;
+            while (pseudorange_m == 0.0)
+                {
+                    // circular orbit, with the velocity in the rotating Earth-fixed frame
+                    trial++;
+                    const double raan = TWO_PI * std::fmod(trial * 0.7548776662, 1.0);
+                    const double arg_lat = TWO_PI * std::fmod(trial * 0.5698402910, 1.0);
+                    const double speed = std::sqrt(earth_gm / glonass_radius_m);
+                    const double cos_i = std::cos(64.8 * D2R);
+                    const double sin_i = std::sin(64.8 * D2R);
+                    const std::array<double, 3> r{
+                        glonass_radius_m * (std::cos(raan) * std::cos(arg_lat) - std::sin(raan) * std::sin(arg_lat) * cos_i),
+                        glonass_radius_m * (std::sin(raan) * std::cos(arg_lat) + std::cos(raan) * std::sin(arg_lat) * cos_i),
+                        glonass_radius_m * std::sin(arg_lat) * sin_i};
+                    const std::array<double, 3> v{
+                        speed * (-std::cos(raan) * std::sin(arg_lat) - std::sin(raan) * std::cos(arg_lat) * cos_i) + earth_rotation_rate * r[1],
+                        speed * (-std::sin(raan) * std::sin(arg_lat) + std::cos(raan) * std::cos(arg_lat) * cos_i) - earth_rotation_rate * r[0],
+                        speed * std::cos(arg_lat) * sin_i};
+                    Glonass_Gnav_Ephemeris eph = glo_eph;
+                    eph.PRN = prn;
+                    eph.i_satellite_slot_number = prn;
+                    eph.i_satellite_freq_channel = prn - 4;
+                    eph.d_WN = week;
+                    eph.d_Xn = r[0] / 1e3;
+                    eph.d_Yn = r[1] / 1e3;
+                    eph.d_Zn = r[2] / 1e3;
+                    eph.d_VXn = v[0] / 1e3;
+                    eph.d_VYn = v[1] / 1e3;
+                    eph.d_VZn = v[2] / 1e3;
+                    pseudorange_m = multiband_pseudorange(rr, time, eph_t{}, eph_to_rtklib(eph, Glonass_Gnav_Utc_Model{}));
+                    if (pseudorange_m != 0.0)
+                        {
+                            epoch.glonass_gnav_ephemeris_map[prn] = eph;
+                            add_observable('R', "1G", prn, pseudorange_m);
+                            add_observable('R', "2G", prn, pseudorange_m);
+                        }
+                }
+        }
+    return epoch;
+}
+
+
+double multiband_position_error(const Rtklib_Solver& solver, const std::array<double, 3>& rr)
+{
+    return std::sqrt(std::pow(solver.pvt_sol.rr[0] - rr[0], 2) + std::pow(solver.pvt_sol.rr[1] - rr[1], 2) + std::pow(solver.pvt_sol.rr[2] - rr[2], 2));
+}
+}  // namespace
+
+
+TEST(RTKLibSolverTest, MultibandEphemerisUpdate)
+{
+    // Single point solution of GPS L1 C/A + L5, Galileo E1B + E5a and
+    // GLONASS L1 + L2, before and after all the ephemerides are replaced
+    prcopt_t opt{};
+    opt.mode = PMODE_SINGLE;
+    opt.nf = 1;
+    opt.navsys = SYS_GPS | SYS_GLO | SYS_GAL;
+    opt.elmin = 10.0 * D2R;
+    opt.sateph = EPHOPT_BRDC;
+    opt.ionoopt = IONOOPT_OFF;
+    opt.tropopt = TROPOPT_OFF;
+    opt.maxgdop = 30.0;
+    rtk_t rtk{};
+    rtkinit(&rtk, &opt);
+    auto solver = std::make_unique<Rtklib_Solver>(rtk, "", 0, false, false);
+
+    const std::array<double, 3> pos{41.275 * D2R, 1.987 * D2R, 80.0};
+    std::array<double, 3> rr{};
+    pos2ecef(pos.data(), rr.data());
+
+    const Multiband_Epoch first = multiband_epoch(rr, 0);
+    for (const auto& eph : first.gps_ephemeris_map)
+        {
+            solver->store_ephemeris(eph.second);
+        }
+    for (const auto& eph : first.gps_cnav_ephemeris_map)
+        {
+            solver->store_ephemeris(eph.second);
+        }
+    for (const auto& eph : first.galileo_ephemeris_map)
+        {
+            solver->store_ephemeris(eph.second);
+        }
+    for (const auto& eph : first.glonass_gnav_ephemeris_map)
+        {
+            solver->store_ephemeris(eph.second);
+        }
+    ASSERT_TRUE(solver->get_PVT(first.observables, false));
+    EXPECT_EQ(solver->get_num_valid_observations(), 10);
+    EXPECT_LT(multiband_position_error(*solver, rr), 0.01);
+
+    // The GPS and Galileo entries are replaced directly in the maps, as the
+    // RINEX and RTCM tests do, and the GLONASS ones through store_ephemeris()
+    const Multiband_Epoch second = multiband_epoch(rr, 1);
+    for (const auto& eph : second.gps_ephemeris_map)
+        {
+            solver->gps_ephemeris_map[eph.first] = eph.second;
+        }
+    for (const auto& eph : second.gps_cnav_ephemeris_map)
+        {
+            solver->gps_cnav_ephemeris_map[eph.first] = eph.second;
+        }
+    for (const auto& eph : second.galileo_ephemeris_map)
+        {
+            solver->galileo_ephemeris_map[eph.first] = eph.second;
+        }
+    for (const auto& eph : second.glonass_gnav_ephemeris_map)
+        {
+            solver->store_ephemeris(eph.second);
+        }
+    ASSERT_TRUE(solver->get_PVT(second.observables, false));
+    EXPECT_EQ(solver->get_num_valid_observations(), 10);
+    EXPECT_LT(multiband_position_error(*solver, rr), 0.01);
+}
@@ -401,7 +401,7 @@ TEST(RTKLibSolverTest, test1)
                     std::cout << "SUPL: Read XML Ephemeris for GPS SV " << gps_eph_iter->first << '\n';
                     std::shared_ptr<Gps_Ephemeris> tmp_obj = std::make_shared<Gps_Ephemeris>(gps_eph_iter->second);
                     // update/insert new ephemeris record to the global ephemeris map
-                    d_ls_pvt->gps_ephemeris_map[gps_eph_iter->first] = *tmp_obj;
+                    d_ls_pvt->store_ephemeris(*tmp_obj);
                 }
         }
     else
@@ -0,0 +1,524 @@
+/*!
+ * \file tlm_allocation_test.cc
+ * \brief Checks that the telemetry decoder blocks do not allocate heap memory
+ * while processing navigation pages in steady state, navigation message
+ * parsers included.
+ *
+ * This test replaces the global allocation functions, so it is built as a
+ * separate executable (tlm_allocation_test) and not as part of run_tests.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GLONASS_L1_L2_CA.h"
+#include "beidou_b1i_telemetry_decoder_gs.h"
+#include "beidou_b3i_telemetry_decoder_gs.h"
+#include "galileo_telemetry_decoder_gs.h"
+#include "glonass_l1_ca_telemetry_decoder_gs.h"
+#include "glonass_l2_ca_telemetry_decoder_gs.h"
+#include "gnss_satellite.h"
+#include "gnss_synchro.h"
+#include "gps_l1_ca_telemetry_decoder_gs.h"
+#include "tlm_allocation_counter.h"
+#include "tlm_conf.h"
+#include <boost/crc.hpp>
+#include <glog/logging.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_b.h>
+#include <gnuradio/blocks/vector_source_b.h>
+#endif
+
+
+// Replace the global allocation functions of the test program, so every heap
+// allocation is reported to the telemetry allocation counter.
+void *operator new(std::size_t size)
+{
+    Tlm_Allocation_Counter::on_allocation();
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    return p;
+}
+
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete(void *p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
+
+void operator delete[](void *p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
+
+namespace
+{
+// Generators of valid navigation messages, as the symbols delivered by the
+// tracking blocks (+1 for a bit 1, -1 for a bit 0)
+
+int parity_of(uint32_t value)
+{
+    int parity = 0;
+    for (; value != 0; value &= value - 1)
+        {
+            parity ^= 1;
+        }
+    return parity;
+}
+
+
+void append_bits(std::vector<int> &bits, uint64_t value, int length)
+{
+    for (int i = length - 1; i >= 0; i--)
+        {
+            bits.push_back(static_cast<int>((value >> i) & 1U));
+        }
+}
+
+
+void append_symbols(std::vector<float> &symbols, const std::vector<int> &bits, int symbols_per_bit = 1)
+{
+    for (const int bit : bits)
+        {
+            symbols.insert(symbols.end(), symbols_per_bit, bit ? 1.0F : -1.0F);
+        }
+}
+
+
+// Galileo E1B I/NAV page part: preamble, then the FEC-encoded (K = 7, G1 = 171,
+// G2 = 133 inverted) and interleaved (30 columns x 8 rows) page part
+void append_galileo_inav_page_part(std::vector<float> &symbols, const std::vector<int> &bits)
+{
+    std::vector<int> encoded;
+    uint32_t state = 0;
+    for (const int bit : bits)
+        {
+            const uint32_t word = (static_cast<uint32_t>(bit) << 6U) | state;
+            encoded.push_back(parity_of(word & 0x79U));
+            encoded.push_back(1 - parity_of(word & 0x5BU));
+            state = word >> 1U;
+        }
+    append_symbols(symbols, {0, 1, 0, 1, 1, 0, 0, 0, 0, 0});
+    std::vector<int> interleaved;
+    for (int r = 0; r < 8; r++)
+        {
+            for (int c = 0; c < 30; c++)
+                {
+                    interleaved.push_back(encoded[c * 8 + r]);
+                }
+        }
+    append_symbols(symbols, interleaved);
+}
+
+
+// Galileo E1B I/NAV nominal pages carrying word type 0 (WN and TOW)
+std::vector<float> galileo_e1b_inav_symbols(int num_pages, uint32_t tow)
+{
+    std::vector<float> symbols;
+    for (int page = 0; page < num_pages; page++)
+        {
+            std::vector<int> word;
+            append_bits(word, 0, 6);                // Type
+            append_bits(word, 2, 2);                // Time
+            append_bits(word, 0, 88);               // Spare
+            append_bits(word, 1200, 12);            // WN
+            append_bits(word, tow + 2 * page, 20);  // TOW
+            std::vector<int> even{0, 0};            // Even/odd, page type
+            even.insert(even.end(), word.begin(), word.begin() + 112);
+            std::vector<int> odd{1, 0};
+            odd.insert(odd.end(), word.begin() + 112, word.end());
+            append_bits(odd, 0, 64);  // Reserved 1, SAR, spare
+
+            // CRC-24Q of the even part and the odd part up to the CRC, as 25 bytes
+            std::vector<int> crc_bits(4, 0);
+            crc_bits.insert(crc_bits.end(), even.begin(), even.end());
+            crc_bits.insert(crc_bits.end(), odd.begin(), odd.end());
+            std::array<unsigned char, 25> crc_bytes{};
+            for (size_t i = 0; i < crc_bits.size(); i++)
+                {
+                    crc_bytes[i / 8] |= static_cast<unsigned char>(crc_bits[i] << (7 - i % 8));
+                }
+            boost::crc_optimal<24, 0x1864CFBU, 0x0, 0x0, false, false> crc24q;
+            crc24q.process_bytes(crc_bytes.data(), crc_bytes.size());
+            append_bits(odd, crc24q.checksum(), 24);
+            append_bits(odd, 0, 8);   // Reserved 2
+            append_bits(even, 0, 6);  // Tail
+            append_bits(odd, 0, 6);
+
+            append_galileo_inav_page_part(symbols, even);
+            append_galileo_inav_page_part(symbols, odd);
+        }
+    return symbols;
+}
+
+
+// GPS LNAV word: 24 data bits followed by the parity bits of IS-GPS-200,
+// given the last two bits of the previous word (D29*, D30*)
+uint32_t gps_lnav_word(uint32_t data, uint32_t previous_word)
+{
+    static const std::array<std::vector<int>, 6> equations{{{1, 2, 3, 5, 6, 10, 11, 12, 13, 14, 17, 18, 20, 23},
+        {2, 3, 4, 6, 7, 11, 12, 13, 14, 15, 18, 19, 21, 24},
+        {1, 3, 4, 5, 7, 8, 12, 13, 14, 15, 16, 19, 20, 22},
+        {2, 4, 5, 6, 8, 9, 13, 14, 15, 16, 17, 20, 21, 23},
+        {1, 3, 5, 6, 7, 9, 10, 14, 15, 16, 17, 18, 21, 22, 24},
+        {3, 5, 6, 8, 9, 10, 11, 13, 15, 19, 22, 23, 24}}};
+    const uint32_t d29_star = (previous_word >> 1U) & 1U;
+    const uint32_t d30_star = previous_word & 1U;
+    uint32_t word = (d30_star ? ~data : data) & 0xFFFFFFU;
+    for (size_t p = 0; p < equations.size(); p++)
+        {
+            // D25, D27 and D30 start from D29*; D26, D28 and D29 from D30*
+            uint32_t parity = (p == 0 || p == 2 || p == 5) ? d29_star : d30_star;
+            for (const int i : equations[p])
+                {
+                    parity ^= (data >> (24 - i)) & 1U;
+                }
+            word = (word << 1U) | parity;
+        }
+    return word;
+}
+
+
+// GPS L1 C/A LNAV subframes 1 to 5, with the TOW count of the HOW increasing
+std::vector<float> gps_l1_ca_lnav_symbols(int num_subframes, uint32_t tow_count)
+{
+    std::vector<int> bits;
+    uint32_t previous_word = 0;
+    for (int subframe = 0; subframe < num_subframes; subframe++)
+        {
+            std::array<uint32_t, 10> data{};
+            data[0] = 0x8BU << 16U;  // TLM preamble
+            data[1] = ((tow_count + subframe + 1) << 7U) | ((subframe % 5 + 1) << 2U);
+            for (size_t w = 0; w < data.size(); w++)
+                {
+                    uint32_t word = gps_lnav_word(data[w], previous_word);
+                    if (w == 1 || w == 9)
+                        {
+                            // Solve bits 23 and 24 so that D29 = D30 = 0
+                            for (uint32_t t = 1; t < 4 && (word & 3U) != 0; t++)
+                                {
+                                    word = gps_lnav_word(data[w] | t, previous_word);
+                                }
+                        }
+                    append_bits(bits, word, 30);
+                    previous_word = word;
+                }
+        }
+    std::vector<float> symbols;
+    append_symbols(symbols, bits);
+    return symbols;
+}
+
+
+// BeiDou D1 BCH(15,11) codeword of 11 information bits (generator x^4 + x + 1)
+uint32_t bch15_11_codeword(uint32_t info)
+{
+    uint32_t reg = 0;
+    for (int i = 10; i >= 0; i--)
+        {
+            const uint32_t feedback = ((info >> i) & 1U) ^ ((reg >> 3U) & 1U);
+            reg = ((reg << 1U) & 0xFU) ^ (feedback ? 0x3U : 0x0U);
+        }
+    return (info << 4U) | reg;
+}
+
+
+// BeiDou D1 subframes 1 to 5, with the SOW advancing 6 s per subframe
+std::vector<float> beidou_d1_symbols(int num_subframes, uint32_t sow)
+{
+    std::vector<int> bits;
+    for (int subframe = 0; subframe < num_subframes; subframe++)
+        {
+            const uint32_t subframe_sow = sow + 6 * subframe;
+            // Word 1: preamble, Rev, FraID and the 8 MSBs of SOW, then the parity of its last 11 bits
+            const uint32_t word1 = (0x712U << 15U) | ((subframe % 5 + 1) << 8U) | (subframe_sow >> 12U);
+            append_bits(bits, word1, 26);
+            append_bits(bits, bch15_11_codeword(word1 & 0x7FFU) & 0xFU, 4);
+            // Words 2 to 10: two interleaved BCH(15,11) codewords of 11 information bits each
+            for (int w = 2; w <= 10; w++)
+                {
+                    const uint32_t info = (w == 2) ? ((subframe_sow & 0xFFFU) << 10U) : 0U;
+                    const uint32_t first = bch15_11_codeword(info >> 11U);
+                    const uint32_t second = bch15_11_codeword(info & 0x7FFU);
+                    for (int c = 14; c >= 0; c--)
+                        {
+                            bits.push_back(static_cast<int>((first >> c) & 1U));
+                            bits.push_back(static_cast<int>((second >> c) & 1U));
+                        }
+                }
+        }
+    std::vector<float> symbols;
+    append_symbols(symbols, bits);
+    return symbols;
+}
+
+
+// GLONASS GNAV strings 1 to 5 (t_k, N_T and N_4 set, so the TOW can be
+// computed), with the Hamming code, relative code and bi-binary (meander)
+// code of the ICD, each preceded by the time mark
+std::vector<float> glonass_gnav_symbols(int num_strings)
+{
+    const std::vector<int> time_mark(GLONASS_GNAV_PREAMBLE);
+    std::vector<float> symbols;
+    for (int s = 0; s < num_strings; s++)
+        {
+            // string[i] holds bit 85 - i of the string
+            std::array<int, GLONASS_GNAV_STRING_BITS> string{};
+            const auto set_field = [&string](int first, int length, uint32_t value) {
+                for (int j = 0; j < length; j++)
+                    {
+                        string[first - 1 + j] = static_cast<int>((value >> (length - 1 - j)) & 1U);
+                    }
+            };
+            const int string_id = s % 5 + 1;
+            set_field(STRING_ID[0].first, STRING_ID[0].second, string_id);
+            if (string_id == 1)
+                {
+                    set_field(T_K_HR[0].first, T_K_HR[0].second, 10);
+                }
+            else if (string_id == 4)
+                {
+                    set_field(N_T[0].first, N_T[0].second, 100);
+                }
+            else if (string_id == 5)
+                {
+                    set_field(N_4[0].first, N_4[0].second, 7);
+                }
+            const auto bit = [&string](int n) -> int & { return string[GLONASS_GNAV_STRING_BITS - n]; };
+            const std::array<const std::vector<int32_t> *, 7> checks{&GLONASS_GNAV_CRC_I_INDEX, &GLONASS_GNAV_CRC_J_INDEX,
+                &GLONASS_GNAV_CRC_K_INDEX, &GLONASS_GNAV_CRC_L_INDEX, &GLONASS_GNAV_CRC_M_INDEX, &GLONASS_GNAV_CRC_N_INDEX,
+                &GLONASS_GNAV_CRC_P_INDEX};
+            int overall_parity = 0;
+            for (int n = 9; n <= GLONASS_GNAV_STRING_BITS; n++)
+                {
+                    overall_parity ^= bit(n);
+                }
+            for (size_t c = 0; c < checks.size(); c++)
+                {
+                    for (const int32_t n : *checks[c])
+                        {
+                            bit(static_cast<int>(c) + 1) ^= bit(n);
+                        }
+                    overall_parity ^= bit(static_cast<int>(c) + 1);
+                }
+            bit(8) = overall_parity;
+
+            std::vector<int> chips;
+            int relative = 0;
+            for (const int data_bit : string)
+                {
+                    relative ^= data_bit;
+                    chips.push_back(relative);
+                    chips.push_back(1 - relative);
+                }
+            append_symbols(symbols, time_mark, GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_PREAMBLE_BIT);
+            append_symbols(symbols, chips, GLONASS_GNAV_TELEMETRY_SYMBOLS_PER_BIT);
+        }
+    return symbols;
+}
+
+
+// Runs a telemetry decoder block on a stream of symbols and returns its output
+std::vector<Gnss_Synchro> run_telemetry_decoder(const gr::block_sptr &tlm,
+    const std::vector<float> &symbols,
+    char system,
+    const std::string &signal,
+    uint32_t prn,
+    int64_t samples_per_symbol)
+{
+    std::vector<uint8_t> items(sizeof(Gnss_Synchro) * symbols.size());
+    for (size_t n = 0; n < symbols.size(); n++)
+        {
+            Gnss_Synchro gs{};
+            gs.System = system;
+            std::memcpy(static_cast<void *>(gs.Signal), signal.c_str(), 3);
+            gs.PRN = prn;
+            gs.fs = 4000000;
+            gs.Tracking_sample_counter = n * samples_per_symbol;
+            gs.Flag_valid_symbol_output = true;
+            gs.Prompt_I = symbols[n];
+            std::memcpy(&items[n * sizeof(Gnss_Synchro)], &gs, sizeof(Gnss_Synchro));
+        }
+
+    auto source = gr::blocks::vector_source_b::make(items, false, sizeof(Gnss_Synchro));
+    auto sink = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+    auto top_block = gr::make_top_block("Telemetry allocation test");
+    top_block->connect(source, 0, tlm, 0);
+    top_block->connect(tlm, 0, sink, 0);
+    Tlm_Allocation_Counter::reset();
+    top_block->run();
+
+    const std::vector<unsigned char> data = sink->data();
+    std::vector<Gnss_Synchro> output(data.size() / sizeof(Gnss_Synchro));
+    std::memcpy(static_cast<void *>(output.data()), data.data(), output.size() * sizeof(Gnss_Synchro));
+    return output;
+}
+
+
+bool has_valid_word(const std::vector<Gnss_Synchro> &output)
+{
+    return std::any_of(output.cbegin(), output.cend(), [](const Gnss_Synchro &gs) { return gs.Flag_valid_word; });
+}
+
+
+Tlm_Conf monitor_conf()
+{
+    // The GPS L1 C/A block only builds the monitored subframe bits when asked to
+    Tlm_Conf conf;
+    conf.enable_navdata_monitor = true;
+    return conf;
+}
+}  // namespace
+
+
+class TlmAllocationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        if (!Tlm_Allocation_Counter::enabled())
+            {
+                GTEST_SKIP() << "The allocation counter is only active in builds without NDEBUG";
+            }
+        Tlm_Allocation_Counter::reset();
+        // The parsers log the decoded fields at INFO level. glog builds each
+        // message in a thread-local buffer, and only writes it out (which may
+        // allocate) when its severity reaches minloglevel.
+        FLAGS_minloglevel = google::GLOG_WARNING;
+    }
+
+    void TearDown() override
+    {
+        FLAGS_minloglevel = d_minloglevel;
+    }
+
+    const int32_t d_minloglevel{FLAGS_minloglevel};
+};
+
+
+TEST_F(TlmAllocationTest, ScopeCountsAllocations)
+{
+    {
+        const Tlm_Allocation_Scope not_steady(false);
+        std::vector<int> v(100);
+        EXPECT_EQ(v.size(), 100U);
+    }
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::pages(), 0U);
+    {
+        const Tlm_Allocation_Scope steady(true);
+        std::vector<int> v(100);
+        EXPECT_EQ(v.size(), 100U);
+    }
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 1U);
+    EXPECT_EQ(Tlm_Allocation_Counter::pages(), 1U);
+    Tlm_Allocation_Counter::reset();
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, GalileoE1bInav)
+{
+    auto tlm = galileo_make_telemetry_decoder_gs(Gnss_Satellite(std::string("Galileo"), 1), monitor_conf(), 1);
+    const auto output = run_telemetry_decoder(tlm, galileo_e1b_inav_symbols(30, 345600), 'E', "1B", 1, 16368);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, GpsL1Ca)
+{
+    auto tlm = gps_l1_ca_make_telemetry_decoder_gs(Gnss_Satellite(std::string("GPS"), 1), monitor_conf());
+    std::vector<float> symbols = gps_l1_ca_lnav_symbols(15, 57600);
+    // The block inserts the preamble itself before the first symbol
+    symbols.erase(symbols.begin(), symbols.begin() + 8);
+    const auto output = run_telemetry_decoder(tlm, symbols, 'G', "1C", 1, 80000);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, BeidouB1i)
+{
+    auto tlm = beidou_b1i_make_telemetry_decoder_gs(Gnss_Satellite(std::string("Beidou"), 10), monitor_conf());
+    const auto output = run_telemetry_decoder(tlm, beidou_d1_symbols(15, 345600), 'C', "B1", 10, 80000);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, BeidouB3i)
+{
+    auto tlm = beidou_b3i_make_telemetry_decoder_gs(Gnss_Satellite(std::string("Beidou"), 10), monitor_conf());
+    const auto output = run_telemetry_decoder(tlm, beidou_d1_symbols(15, 345600), 'C', "B3", 10, 80000);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, GlonassL1Ca)
+{
+    auto tlm = glonass_l1_ca_make_telemetry_decoder_gs(Gnss_Satellite(std::string("Glonass"), 1), monitor_conf());
+    const auto output = run_telemetry_decoder(tlm, glonass_gnav_symbols(16), 'R', "1G", 1, 4000);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
+
+
+TEST_F(TlmAllocationTest, GlonassL2Ca)
+{
+    auto tlm = glonass_l2_ca_make_telemetry_decoder_gs(Gnss_Satellite(std::string("Glonass"), 1), monitor_conf());
+    const auto output = run_telemetry_decoder(tlm, glonass_gnav_symbols(16), 'R', "2G", 1, 4000);
+    EXPECT_TRUE(has_valid_word(output));
+    EXPECT_GT(Tlm_Allocation_Counter::pages(), 0U);
+    EXPECT_EQ(Tlm_Allocation_Counter::allocations(), 0U);
+}
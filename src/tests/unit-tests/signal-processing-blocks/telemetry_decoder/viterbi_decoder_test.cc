@@ -0,0 +1,142 @@
+/*!
+ * \file viterbi_decoder_test.cc
+ * \brief Tests the Viterbi decoder with frames of the K=7, rate 1/2
+ * convolutional code
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "viterbi_decoder.h"
+#include <gtest/gtest.h>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+class ViterbiDecoderTest : public ::testing::Test
+{
+protected:
+    // Encodes bits followed by KK - 1 tail bits. The newest bit is the MSB of
+    // the shift register, and a logical one is sent as a positive symbol.
+    std::vector<float> encode(const std::vector<int32_t>& bits, const std::array<int32_t, 2>& g) const
+    {
+        std::vector<float> symbols;
+        int32_t shift_register = 0;
+        for (int32_t t = 0; t < LL + KK - 1; t++)
+            {
+                const int32_t bit = (t < LL ? bits[t] : 0);
+                shift_register = (bit << (KK - 1)) | (shift_register >> 1);
+                for (const int32_t polynomial : g)
+                    {
+                        const bool coded_bit = std::bitset<KK>(static_cast<uint32_t>(shift_register & polynomial)).count() % 2 == 1;
+                        symbols.push_back(coded_bit ? 1.0F : -1.0F);
+                    }
+            }
+        return symbols;
+    }
+
+    std::vector<std::vector<int32_t>> random_frames(int frames) const
+    {
+        std::mt19937 generator(1234);
+        std::uniform_int_distribution<int32_t> bit(0, 1);
+        std::vector<std::vector<int32_t>> data(frames, std::vector<int32_t>(LL));
+        for (auto& frame : data)
+            {
+                for (auto& b : frame)
+                    {
+                        b = bit(generator);
+                    }
+            }
+        return data;
+    }
+
+    // Decodes the frames, each one twice, with one decoder instance
+    void decode_frames(const std::array<int32_t, 2>& g, int flipped_symbols) const
+    {
+        Viterbi_Decoder decoder(KK, nn, LL, g);
+        const auto frames = random_frames(8);
+        std::vector<int32_t> decoded(LL);
+        for (int pass = 0; pass < 2; pass++)
+            {
+                for (size_t f = 0; f < frames.size(); f++)
+                    {
+                        auto symbols = encode(frames[f], g);
+                        // Isolated errors, further apart than the decoding depth of the code
+                        for (int e = 0; e < flipped_symbols; e++)
+                            {
+                                const size_t position = 7 + f + 40 * e;
+                                symbols[position] = -symbols[position];
+                            }
+                        decoder.decode(decoded, symbols);
+                        EXPECT_EQ(decoded, frames[f]) << "Polynomials " << g[0] << ", " << g[1] << ", frame " << f << ", pass " << pass << ", " << flipped_symbols << " flipped symbols";
+                    }
+            }
+    }
+
+    static constexpr int32_t KK = 7;
+    static constexpr int32_t nn = 2;
+    static constexpr int32_t LL = 114;  // Galileo I/NAV page part: 240 symbols
+    // Generator polynomials 171 and 133 (octal), used by Galileo I/NAV and F/NAV, GPS L2C / L5 CNAV and SBAS
+    const std::array<int32_t, 2> g_k7r12{{121, 91}};
+    // The same code with the outputs swapped, decoded by the generic trellis
+    const std::array<int32_t, 2> g_swapped{{91, 121}};
+};
+
+
+TEST_F(ViterbiDecoderTest, NoiselessFrames)
+{
+    decode_frames(g_k7r12, 0);
+    decode_frames(g_swapped, 0);
+}
+
+
+TEST_F(ViterbiDecoderTest, FramesWithSymbolErrors)
+{
+    decode_frames(g_k7r12, 5);
+    decode_frames(g_swapped, 5);
+}
+
+
+TEST_F(ViterbiDecoderTest, DecodingDoesNotDependOnPreviousFrames)
+{
+    // A frame of weak noise leaves all the path metrics close to each other.
+    // Both the kernel and the generic trellis must nevertheless start the next
+    // frame in the all-zeros state, and decode it as a fresh instance does.
+    for (const auto& g : {g_k7r12, g_swapped})
+        {
+            std::mt19937 generator(4321);
+            std::normal_distribution<float> noise(0.0, 1.0);
+            const auto frames = random_frames(200);
+            Viterbi_Decoder reused(KK, nn, LL, g);
+            std::vector<float> noise_frame(nn * (LL + KK - 1));
+            std::vector<int32_t> decoded(LL);
+            std::vector<int32_t> fresh(LL);
+            for (size_t f = 0; f < frames.size(); f++)
+                {
+                    for (auto& symbol : noise_frame)
+                        {
+                            symbol = 0.01F * noise(generator);
+                        }
+                    auto symbols = encode(frames[f], g);
+                    for (auto& symbol : symbols)
+                        {
+                            symbol += 0.8F * noise(generator);
+                        }
+                    Viterbi_Decoder(KK, nn, LL, g).decode(fresh, symbols);
+                    reused.decode(decoded, noise_frame);
+                    reused.decode(decoded, symbols);
+                    EXPECT_EQ(decoded, fresh) << "Polynomials " << g[0] << ", " << g[1] << ", frame " << f;
+                }
+        }
+}
@@ -0,0 +1,210 @@
+/*!
+ * \file cpu_multicorrelator_batch_test.cc
+ * \brief Checks the multichannel batch correlator against
+ * Cpu_Multicorrelator_Real_Codes.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "cpu_multicorrelator_batch.h"
+#include "cpu_multicorrelator_real_codes.h"
+#include "gps_sdr_signal_replica.h"
+#include <gnuradio/gr_complex.h>
+#include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr_alloc.h>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace
+{
+void check_batch_correlator(bool high_dynamics, bool with_rates)
+{
+    const int num_channels = 8;
+    const int n_taps = 3;
+    const auto code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    const int buffer_length = 20000;
+    const int chunk_length = 1000;  // not a multiple of the tile size
+
+    std::vector<volk_gnsssdr::vector<float>> codes(num_channels, volk_gnsssdr::vector<float>(code_length));
+    volk_gnsssdr::vector<float> shifts_chips{-0.5, 0.0, 0.5};
+    std::vector<float> rem_carrier(num_channels);
+    std::vector<float> carrier_step(num_channels);
+    std::vector<float> carrier_rate(num_channels, 0.0);
+    std::vector<float> rem_code(num_channels);
+    std::vector<float> code_step(num_channels);
+    std::vector<float> code_rate(num_channels, 0.0);
+    std::vector<int> start(num_channels);
+    std::vector<int> length(num_channels);
+
+    std::default_random_engine gen(1234);
+    std::uniform_real_distribution<float> uniform(-1.0, 1.0);
+    std::normal_distribution<float> noise(0.0, 1.0);
+
+    // Input signal: the sum of the codes of all the channels plus noise
+    volk_gnsssdr::vector<gr_complex> signal(buffer_length);
+    for (auto& s : signal)
+        {
+            s = gr_complex(noise(gen), noise(gen));
+        }
+    for (int ch = 0; ch < num_channels; ch++)
+        {
+            gps_l1_ca_code_gen_float(codes[ch], ch + 1, 0);
+            rem_carrier[ch] = 3.0F * uniform(gen);
+            carrier_step[ch] = 0.2F * uniform(gen);
+            rem_code[ch] = 0.5F * (uniform(gen) + 1.0F);
+            code_step[ch] = 0.25F + 0.001F * uniform(gen);  // 4 samples per chip
+            if (with_rates)
+                {
+                    carrier_rate[ch] = 1e-7F * uniform(gen);
+                    code_rate[ch] = 1e-8F * uniform(gen);
+                }
+            length[ch] = static_cast<int>(std::ceil((code_length - rem_code[ch]) / code_step[ch]));
+            start[ch] = 1000 + 1500 * ch;
+            for (int n = 0; n < length[ch]; n++)
+                {
+                    const auto t = static_cast<float>(n);
+                    auto chip = static_cast<int>(std::floor(code_step[ch] * t + code_rate[ch] * t * t - rem_code[ch]));
+                    chip = (chip + code_length) % code_length;
+                    const float phase = rem_carrier[ch] + carrier_step[ch] * t + carrier_rate[ch] * t * t;
+                    signal[start[ch] + n] += codes[ch][chip] * gr_complex(std::cos(phase), std::sin(phase));
+                }
+        }
+
+    // Reference: one Cpu_Multicorrelator_Real_Codes per channel
+    std::vector<volk_gnsssdr::vector<gr_complex>> expected(num_channels, volk_gnsssdr::vector<gr_complex>(n_taps));
+    for (int ch = 0; ch < num_channels; ch++)
+        {
+            Cpu_Multicorrelator_Real_Codes correlator;
+            correlator.set_high_dynamics_resampler(high_dynamics);
+            correlator.init(length[ch], n_taps);
+            correlator.set_local_code_and_taps(code_length, codes[ch].data(), shifts_chips.data());
+            correlator.set_input_output_vectors(expected[ch].data(), &signal[start[ch]]);
+            correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier[ch], carrier_step[ch], carrier_rate[ch], rem_code[ch], code_step[ch], code_rate[ch], length[ch]);
+        }
+
+    // Batch correlator, fed in chunks
+    std::vector<volk_gnsssdr::vector<gr_complex>> result(num_channels, volk_gnsssdr::vector<gr_complex>(n_taps));
+    Cpu_Multicorrelator_Batch batch;
+    batch.set_high_dynamics_resampler(high_dynamics);
+    ASSERT_TRUE(batch.init(num_channels, n_taps));
+    for (int ch = 0; ch < num_channels; ch++)
+        {
+            ASSERT_TRUE(batch.set_local_code_and_taps(ch, code_length, codes[ch].data(), shifts_chips.data()));
+            ASSERT_TRUE(batch.set_epoch(ch, result[ch].data(), start[ch], length[ch], rem_carrier[ch], carrier_step[ch], carrier_rate[ch], rem_code[ch], code_step[ch], code_rate[ch]));
+        }
+    EXPECT_EQ(batch.active_channels(), num_channels);
+    for (int first = 0; first < buffer_length; first += chunk_length)
+        {
+            batch.correlate(&signal[first], first, std::min(chunk_length, buffer_length - first));
+        }
+    EXPECT_EQ(batch.active_channels(), 0);
+
+    for (int ch = 0; ch < num_channels; ch++)
+        {
+            EXPECT_TRUE(batch.epoch_done(ch));
+            if (high_dynamics || !with_rates)
+                {
+                    // the prompt correlator sees the channel signal (the
+                    // rotator-resampler ignores the rates, and loses it)
+                    EXPECT_GT(std::abs(expected[ch][1]), 0.9F * static_cast<float>(length[ch]));
+                }
+            // a few code samples may round to a different chip
+            const float tolerance = 0.01F * static_cast<float>(length[ch]);
+            for (int tap = 0; tap < n_taps; tap++)
+                {
+                    EXPECT_NEAR(result[ch][tap].real(), expected[ch][tap].real(), tolerance) << "channel " << ch << ", tap " << tap;
+                    EXPECT_NEAR(result[ch][tap].imag(), expected[ch][tap].imag(), tolerance) << "channel " << ch << ", tap " << tap;
+                }
+        }
+}
+}  // namespace
+
+
+TEST(CpuMulticorrelatorBatchTest, MatchesRealCodesCorrelator)
+{
+    check_batch_correlator(false, false);
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, MatchesRealCodesCorrelatorHighDynamics)
+{
+    check_batch_correlator(true, false);
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, MatchesRealCodesCorrelatorWithRates)
+{
+    check_batch_correlator(false, true);
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, MatchesRealCodesCorrelatorHighDynamicsWithRates)
+{
+    check_batch_correlator(true, true);
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, ChannelTaps)
+{
+    // A channel may use fewer taps than the correlator hosts
+    const int code_length = 4;
+    volk_gnsssdr::vector<float> code{1.0, -1.0, 1.0, 1.0};
+    volk_gnsssdr::vector<float> shifts_chips{-1.0, 0.0, 1.0};
+    volk_gnsssdr::vector<gr_complex> signal(64);
+    for (int n = 0; n < 64; n++)
+        {
+            signal[n] = gr_complex(code[n % code_length], 0.0);
+        }
+    volk_gnsssdr::vector<gr_complex> all_taps(3);
+    volk_gnsssdr::vector<gr_complex> one_tap(2, gr_complex(-1.0, -1.0));
+
+    Cpu_Multicorrelator_Batch batch;
+    ASSERT_TRUE(batch.init(2, 3, 16));
+    EXPECT_FALSE(batch.set_local_code_and_taps(1, code_length, code.data(), &shifts_chips[1], 4));
+    ASSERT_TRUE(batch.set_local_code_and_taps(0, code_length, code.data(), shifts_chips.data()));
+    ASSERT_TRUE(batch.set_local_code_and_taps(1, code_length, code.data(), &shifts_chips[1], 1));
+    ASSERT_TRUE(batch.set_epoch(0, all_taps.data(), 0, 64, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0));
+    ASSERT_TRUE(batch.set_epoch(1, one_tap.data(), 0, 64, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0));
+    batch.correlate(signal.data(), 0, 64);
+    EXPECT_EQ(all_taps[1], gr_complex(64.0, 0.0));
+    EXPECT_EQ(one_tap[0], all_taps[1]);
+    EXPECT_EQ(one_tap[1], gr_complex(-1.0, -1.0));  // not written
+}
+
+
+TEST(CpuMulticorrelatorBatchTest, ReleaseCancelsEpoch)
+{
+    const int code_length = 4;
+    volk_gnsssdr::vector<float> code{1.0, -1.0, 1.0, 1.0};
+    volk_gnsssdr::vector<float> shifts_chips{0.0};
+    volk_gnsssdr::vector<gr_complex> signal(64, gr_complex(1.0, 0.0));
+    gr_complex out(0.0, 0.0);
+
+    Cpu_Multicorrelator_Batch batch;
+    ASSERT_TRUE(batch.init(2, 1, 16));
+    EXPECT_FALSE(batch.set_epoch(0, &out, 0, 32, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0));  // no code yet
+    ASSERT_TRUE(batch.set_local_code_and_taps(0, code_length, code.data(), shifts_chips.data()));
+    ASSERT_TRUE(batch.set_epoch(0, &out, 0, 32, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0));
+    batch.correlate(signal.data(), 0, 16);
+    EXPECT_EQ(batch.active_channels(), 1);
+    EXPECT_FALSE(batch.epoch_done(0));
+    batch.release(0);
+    EXPECT_EQ(batch.active_channels(), 0);
+    batch.correlate(&signal[16], 16, 48);
+    EXPECT_FALSE(batch.epoch_done(0));
+    EXPECT_EQ(out, gr_complex(0.0, 0.0));
+}
@@ -21,11 +21,14 @@
 #include <gflags/gflags.h>
 #include <gnuradio/gr_complex.h>
 #include <gtest/gtest.h>
+#include <volk_gnsssdr/volk_gnsssdr.h>
 #include <volk_gnsssdr/volk_gnsssdr_alloc.h>
 #include <chrono>
+#include <cmath>
 #include <complex>
 #include <random>
 #include <thread>
+#include <vector>
 
 
 DEFINE_int32(cpu_multicorrelator_real_codes_iterations_test, 100, "Number of averaged iterations in CPU multicorrelator test timing test");
@@ -252,3 +255,111 @@ TEST(CpuMulticorrelatorRealCodesTest, MeasureExecutionTimeAlloc)
             correlator_pool[n]->free();
         }
 }
+
+
+TEST(CpuMulticorrelatorRealCodesTest, FusedResamplerMatchesTwoStepCorrelation)
+{
+    const auto code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    const int n_taps = 3;
+    const int correlation_size = 8185;  // not a multiple of the SIMD width
+    volk_gnsssdr::vector<float> ca_code(code_length);
+    volk_gnsssdr::vector<float> shifts_chips{-0.5, 0.0, 0.5};
+    volk_gnsssdr::vector<gr_complex> in_cpu(correlation_size);
+    gps_l1_ca_code_gen_float(ca_code, 1, 0);
+    std::default_random_engine e1(1234);
+    std::uniform_real_distribution<float> uniform_dist(-1.0, 1.0);
+    for (auto& s : in_cpu)
+        {
+            s = gr_complex(uniform_dist(e1), uniform_dist(e1));
+        }
+
+    const float rem_carrier_phase_rad = 0.4;
+    const float carrier_phase_step_rad = 0.013;
+    const float rem_code_phase_chips = 0.37;
+    const float code_phase_step_chips = 0.2493;
+
+    // Non high dynamics correlator: code resampled on the fly
+    volk_gnsssdr::vector<gr_complex> fused(n_taps);
+    Cpu_Multicorrelator_Real_Codes correlator;
+    correlator.set_high_dynamics_resampler(false);
+    correlator.init(correlation_size, n_taps);
+    correlator.set_local_code_and_taps(code_length, ca_code.data(), shifts_chips.data());
+    correlator.set_input_output_vectors(fused.data(), in_cpu.data());
+    correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_size);
+
+    // Reference: resampled replicas stored in memory, then correlated
+    std::vector<volk_gnsssdr::vector<float>> replicas(n_taps, volk_gnsssdr::vector<float>(correlation_size));
+    std::vector<float*> replicas_ptrs(n_taps);
+    for (int n = 0; n < n_taps; n++)
+        {
+            replicas_ptrs[n] = replicas[n].data();
+        }
+    volk_gnsssdr_32f_xn_resampler_32f_xn(replicas_ptrs.data(), ca_code.data(), rem_code_phase_chips, code_phase_step_chips, shifts_chips.data(), code_length, n_taps, correlation_size);
+    lv_32fc_t phase[1] = {lv_cmake(std::cos(rem_carrier_phase_rad), -std::sin(rem_carrier_phase_rad))};
+    volk_gnsssdr::vector<gr_complex> expected(n_taps);
+    volk_gnsssdr_32fc_32f_rotator_dot_prod_32fc_xn(expected.data(), in_cpu.data(), std::exp(lv_32fc_t(0.0, -carrier_phase_step_rad)), phase, const_cast<const float**>(replicas_ptrs.data()), n_taps, correlation_size);
+
+    for (int n = 0; n < n_taps; n++)
+        {
+            EXPECT_NEAR(fused[n].real(), expected[n].real(), 0.01);
+            EXPECT_NEAR(fused[n].imag(), expected[n].imag(), 0.01);
+        }
+}
+
+
+TEST(CpuMulticorrelatorRealCodesTest, IntegerInputMatchesFloatInput)
+{
+    const auto code_length = static_cast<int>(GPS_L1_CA_CODE_LENGTH_CHIPS);
+    const int n_taps = 3;
+    const int correlation_size = 8185;  // not a multiple of the SIMD width
+    volk_gnsssdr::vector<float> ca_code(code_length);
+    volk_gnsssdr::vector<float> shifts_chips{-0.5, 0.0, 0.5};
+    gps_l1_ca_code_gen_float(ca_code, 1, 0);
+
+    // The same sample values in the three input formats
+    volk_gnsssdr::vector<gr_complex> in_32fc(correlation_size);
+    volk_gnsssdr::vector<lv_16sc_t> in_16sc(correlation_size);
+    volk_gnsssdr::vector<lv_8sc_t> in_8sc(correlation_size);
+    std::default_random_engine e1(1234);
+    std::uniform_int_distribution<int> uniform_dist(-127, 127);
+    for (int n = 0; n < correlation_size; n++)
+        {
+            const int re = uniform_dist(e1);
+            const int im = uniform_dist(e1);
+            in_32fc[n] = gr_complex(static_cast<float>(re), static_cast<float>(im));
+            in_16sc[n] = lv_16sc_t(static_cast<int16_t>(re), static_cast<int16_t>(im));
+            in_8sc[n] = lv_8sc_t(static_cast<int8_t>(re), static_cast<int8_t>(im));
+        }
+
+    const float rem_carrier_phase_rad = 0.4;
+    const float carrier_phase_step_rad = 0.013;
+    const float rem_code_phase_chips = 0.37;
+    const float code_phase_step_chips = 0.2493;
+
+    Cpu_Multicorrelator_Real_Codes correlator;
+    correlator.set_high_dynamics_resampler(false);
+    correlator.init(correlation_size, n_taps);
+    correlator.set_local_code_and_taps(code_length, ca_code.data(), shifts_chips.data());
+
+    volk_gnsssdr::vector<gr_complex> expected(n_taps);
+    correlator.set_input_output_vectors(expected.data(), in_32fc.data());
+    correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_size);
+
+    volk_gnsssdr::vector<gr_complex> out_16sc(n_taps);
+    correlator.set_input_output_vectors(out_16sc.data(), in_16sc.data());
+    correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_size);
+
+    volk_gnsssdr::vector<gr_complex> out_8sc(n_taps);
+    correlator.set_input_output_vectors(out_8sc.data(), in_8sc.data());
+    correlator.Carrier_wipeoff_multicorrelator_resampler(rem_carrier_phase_rad, carrier_phase_step_rad, 0.0, rem_code_phase_chips, code_phase_step_chips, 0.0, correlation_size);
+
+    // integer samples are accumulated in floating point, there is no saturation
+    const float tolerance = 1e-3 * std::abs(expected[1]) + 1.0;
+    for (int n = 0; n < n_taps; n++)
+        {
+            EXPECT_NEAR(out_16sc[n].real(), expected[n].real(), tolerance);
+            EXPECT_NEAR(out_16sc[n].imag(), expected[n].imag(), tolerance);
+            EXPECT_NEAR(out_8sc[n].real(), expected[n].real(), tolerance);
+            EXPECT_NEAR(out_8sc[n].imag(), expected[n].imag(), tolerance);
+        }
+}
@@ -0,0 +1,254 @@
+/*!
+ * \file gps_l1_ca_dll_pll_multichannel_tracking_test.cc
+ * \brief  This file implements a test of the multichannel DLL/PLL tracking
+ * block for GPS L1 C/A against one dll_pll_veml_tracking block per channel
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "GPS_L1_CA.h"
+#include "MATH_CONSTANTS.h"
+#include "dll_pll_conf.h"
+#include "dll_pll_multichannel_tracking.h"
+#include "dll_pll_veml_tracking.h"
+#include "gnss_synchro.h"
+#include "gps_sdr_signal_replica.h"
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_sink_b.h>
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+namespace
+{
+constexpr int32_t FS_IN = 2000000;
+constexpr uint32_t SAMPLES_PER_CODE = 2000;                   // 1 ms
+constexpr uint32_t SIGNAL_SAMPLES = 3000 * SAMPLES_PER_CODE;  // the pull-in lasts one second
+constexpr uint32_t PREAMBLE_FIRST_BIT = 60;                   // the bit synchronization searches the TLM preamble
+constexpr int32_t N_CHANNELS = 3;
+const std::array<uint32_t, N_CHANNELS> PRNS{1, 11, 23};
+const std::array<double, N_CHANNELS> DELAYS_SAMPLES{501.0, 1200.25, 1666.5};
+const std::array<double, N_CHANNELS> DOPPLERS_HZ{1250.0, -2730.0, 3410.0};
+
+
+// Code phase [chips] of satellite sat at sample n, zero at the start of a code period
+double code_phase_chips(int32_t sat, double n)
+{
+    const double code_rate_cps = GPS_L1_CA_CODE_RATE_CPS * (1.0 + DOPPLERS_HZ[sat] / GPS_L1_FREQ_HZ);
+    return (n - DELAYS_SAMPLES[sat]) * code_rate_cps / static_cast<double>(FS_IN);
+}
+
+
+// Three satellites with 20 ms navigation bits, at about 46 dB-Hz. The bits
+// are random, but for a TLM preamble sent after the pull-in
+std::vector<gr_complex> generate_signal()
+{
+    std::vector<gr_complex> signal(SIGNAL_SAMPLES);
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : signal)
+        {
+            sample = gr_complex(noise(generator), noise(generator));
+        }
+    std::uniform_int_distribution<int32_t> bit(0, 1);
+    for (int32_t sat = 0; sat < N_CHANNELS; sat++)
+        {
+            std::array<int32_t, 1023> code{};
+            gps_l1_ca_code_gen_int(code, static_cast<int32_t>(PRNS[sat]), 0);
+            std::vector<float> bits(SIGNAL_SAMPLES / (20 * SAMPLES_PER_CODE) + 1);
+            for (auto& b : bits)
+                {
+                    b = bit(generator) == 1 ? 1.0F : -1.0F;
+                }
+            const std::array<float, 8> preamble{1.0F, -1.0F, -1.0F, -1.0F, 1.0F, -1.0F, 1.0F, 1.0F};
+            std::copy(preamble.cbegin(), preamble.cend(), bits.begin() + PREAMBLE_FIRST_BIT);
+            for (uint32_t n = 0; n < SIGNAL_SAMPLES; n++)
+                {
+                    const double chips = code_phase_chips(sat, n);
+                    const auto chip = static_cast<int64_t>(std::floor(chips));
+                    const auto bit_period = static_cast<int64_t>(std::floor(chips / (20.0 * GPS_L1_CA_CODE_LENGTH_CHIPS)));
+                    const int64_t chip_index = ((chip % 1023) + 1023) % 1023;
+                    const auto bit_index = static_cast<size_t>(std::max(bit_period, static_cast<int64_t>(0)));
+                    const double phase = TWO_PI * DOPPLERS_HZ[sat] * static_cast<double>(n) / static_cast<double>(FS_IN);
+                    const float amplitude = 0.2F * bits[bit_index] * static_cast<float>(code[chip_index]);
+                    signal[n] += gr_complex(amplitude * static_cast<float>(std::cos(phase)), amplitude * static_cast<float>(std::sin(phase)));
+                }
+        }
+    return signal;
+}
+
+
+Dll_Pll_Conf tracking_conf()
+{
+    Dll_Pll_Conf trk_params;
+    trk_params.fs_in = FS_IN;
+    trk_params.vector_length = SAMPLES_PER_CODE;
+    trk_params.system = 'G';
+    trk_params.signal[0] = '1';
+    trk_params.signal[1] = 'C';
+    trk_params.pull_in_time_s = 0;
+    trk_params.dump = false;
+    return trk_params;
+}
+
+
+Gnss_Synchro acquisition(int32_t sat)
+{
+    // A coarse acquisition: one sample and 20 Hz off
+    Gnss_Synchro gnss_synchro{};
+    gnss_synchro.System = 'G';
+    gnss_synchro.Signal[0] = '1';
+    gnss_synchro.Signal[1] = 'C';
+    gnss_synchro.PRN = PRNS[sat];
+    gnss_synchro.Acq_delay_samples = std::round(DELAYS_SAMPLES[sat]) + 1.0;
+    gnss_synchro.Acq_doppler_hz = DOPPLERS_HZ[sat] + 20.0;
+    gnss_synchro.Acq_samplestamp_samples = 0;
+    return gnss_synchro;
+}
+
+
+std::vector<Gnss_Synchro> to_gnss_synchro(const std::vector<unsigned char>& data)
+{
+    std::vector<Gnss_Synchro> output(data.size() / sizeof(Gnss_Synchro));
+    std::memcpy(static_cast<void*>(output.data()), data.data(), output.size() * sizeof(Gnss_Synchro));
+    return output;
+}
+
+
+// Outputs of one dll_pll_veml_tracking block per satellite
+std::array<std::vector<Gnss_Synchro>, N_CHANNELS> run_single_channel(const std::vector<gr_complex>& signal)
+{
+    std::array<std::vector<Gnss_Synchro>, N_CHANNELS> outputs;
+    for (int32_t sat = 0; sat < N_CHANNELS; sat++)
+        {
+            Gnss_Synchro gnss_synchro = acquisition(sat);
+            auto top_block = gr::make_top_block("Single channel tracking");
+            auto source = gr::blocks::vector_source_c::make(signal, false);
+            auto tracking = dll_pll_veml_make_tracking(tracking_conf());
+            auto sink = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+            top_block->connect(source, 0, tracking, 0);
+            top_block->connect(tracking, 0, sink, 0);
+            tracking->set_channel(sat);
+            tracking->set_gnss_synchro(&gnss_synchro);
+            tracking->start_tracking();
+            top_block->run();
+            outputs[sat] = to_gnss_synchro(sink->data());
+        }
+    return outputs;
+}
+
+
+// Outputs of the slots of one dll_pll_multichannel_tracking block
+std::array<std::vector<Gnss_Synchro>, N_CHANNELS> run_multichannel(const std::vector<gr_complex>& signal)
+{
+    std::array<Gnss_Synchro, N_CHANNELS> gnss_synchro{};
+    std::array<gr::blocks::vector_sink_b::sptr, N_CHANNELS> sinks;
+    auto top_block = gr::make_top_block("Multichannel tracking");
+    auto source = gr::blocks::vector_source_c::make(signal, false);
+    auto tracking = dll_pll_multichannel_make_tracking(tracking_conf(), N_CHANNELS);
+    top_block->connect(source, 0, tracking, 0);
+    for (int32_t sat = 0; sat < N_CHANNELS; sat++)
+        {
+            const int32_t slot = tracking->add_channel();
+            EXPECT_EQ(slot, sat);
+            sinks[sat] = gr::blocks::vector_sink_b::make(sizeof(Gnss_Synchro));
+            top_block->connect(tracking, slot, sinks[sat], 0);
+            gnss_synchro[sat] = acquisition(sat);
+            tracking->set_channel(slot, sat);
+            tracking->set_gnss_synchro(slot, &gnss_synchro[sat]);
+            tracking->start_tracking(slot);
+        }
+    top_block->run();
+
+    std::array<std::vector<Gnss_Synchro>, N_CHANNELS> outputs;
+    for (int32_t sat = 0; sat < N_CHANNELS; sat++)
+        {
+            outputs[sat] = to_gnss_synchro(sinks[sat]->data());
+        }
+    return outputs;
+}
+
+
+// The single channel output of the epoch starting closest to sample
+const Gnss_Synchro& closest_epoch(const std::vector<Gnss_Synchro>& outputs, uint64_t sample)
+{
+    size_t closest = 0;
+    for (size_t i = 1; i < outputs.size(); i++)
+        {
+            if (std::llabs(static_cast<int64_t>(outputs[i].Tracking_sample_counter - sample)) <
+                std::llabs(static_cast<int64_t>(outputs[closest].Tracking_sample_counter - sample)))
+                {
+                    closest = i;
+                }
+        }
+    return outputs[closest];
+}
+
+
+// Sample [samples] where the tracking block places the start of a code period
+double code_start_samples(const Gnss_Synchro& synchro)
+{
+    return static_cast<double>(synchro.Tracking_sample_counter) + synchro.Code_phase_samples;
+}
+
+
+// Distance [chips] from the start of the code period estimated by synchro to the closest true one
+double code_phase_error_chips(int32_t sat, const Gnss_Synchro& synchro)
+{
+    const double chips = code_phase_chips(sat, code_start_samples(synchro));
+    return chips - GPS_L1_CA_CODE_LENGTH_CHIPS * std::round(chips / GPS_L1_CA_CODE_LENGTH_CHIPS);
+}
+}  // namespace
+
+
+TEST(GpsL1CADllPllMultichannelTrackingTest, MatchesSingleChannelTracking)
+{
+    const std::vector<gr_complex> signal = generate_signal();
+    const auto single = run_single_channel(signal);
+    const auto multi = run_multichannel(signal);
+
+    for (int32_t sat = 0; sat < N_CHANNELS; sat++)
+        {
+            // One output per 20 ms bit once the bit synchronization is locked
+            ASSERT_GT(single[sat].size(), 50U) << "Satellite " << sat << " not tracked by dll_pll_veml_tracking";
+            ASSERT_GT(multi[sat].size(), 50U) << "Satellite " << sat << " not tracked by the multichannel block";
+            for (const auto& synchro : multi[sat])
+                {
+                    EXPECT_TRUE(synchro.Flag_valid_symbol_output) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+                    EXPECT_EQ(synchro.PRN, PRNS[sat]);
+                    EXPECT_GT(synchro.CN0_dB_hz, 40.0);
+                    EXPECT_NEAR(synchro.Carrier_Doppler_hz, DOPPLERS_HZ[sat], 15.0) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+                    EXPECT_NEAR(code_phase_error_chips(sat, synchro), 0.0, 0.05) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+
+                    const Gnss_Synchro& reference = closest_epoch(single[sat], synchro.Tracking_sample_counter);
+                    EXPECT_TRUE(reference.Flag_valid_symbol_output);
+                    EXPECT_NEAR(static_cast<double>(synchro.Tracking_sample_counter), static_cast<double>(reference.Tracking_sample_counter), 1.0);
+                    EXPECT_NEAR(code_start_samples(synchro), code_start_samples(reference), 0.1) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+                    EXPECT_NEAR(synchro.Carrier_Doppler_hz, reference.Carrier_Doppler_hz, 10.0) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+                    EXPECT_NEAR(synchro.CN0_dB_hz, reference.CN0_dB_hz, 3.0) << "Satellite " << sat << ", sample " << synchro.Tracking_sample_counter;
+                }
+        }
+}
@@ -0,0 +1,94 @@
+/*!
+ * \file kalman_filter_test.cc
+ * \brief This file implements numerical accuracy tests for the fixed-size
+ * Kalman filter core.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "kalman_filter.h"
+#include <armadillo>
+#include <gtest/gtest.h>
+
+#define KALMAN_TEST_N_TRIALS 1000
+#define KALMAN_TEST_TOLERANCE 1e-6
+
+
+TEST(KalmanFilterComputationTest, MatchesTextbookKalmanFilter)
+{
+    using Kf = Kalman_Filter<4, 2>;
+    Kf kf;
+    for (int k = 0; k < KALMAN_TEST_N_TRIALS; k++)
+        {
+            const arma::vec x0 = arma::randn<arma::vec>(4);
+            const arma::mat P0 = arma::diagmat(arma::randu<arma::vec>(4) + 0.1);
+            const arma::mat F = arma::randu<arma::mat>(4, 4);
+            const arma::mat Q = arma::diagmat(arma::randu<arma::vec>(4));
+            const arma::mat H = arma::randu<arma::mat>(2, 4);
+            const arma::mat R = arma::diagmat(arma::randu<arma::vec>(2) + 0.1);
+            const arma::vec z = arma::randn<arma::vec>(2);
+
+            kf.x() = x0;
+            kf.P() = P0;
+            kf.predict(Kf::State_Matrix(F), Kf::State_Matrix(Q));
+
+            const arma::vec x_pred = F * x0;
+            const arma::mat P_pred = F * P0 * F.t() + Q;
+            EXPECT_TRUE(arma::approx_equal(arma::vec(kf.x()), x_pred, "both", KALMAN_TEST_TOLERANCE, KALMAN_TEST_TOLERANCE));
+            EXPECT_TRUE(arma::approx_equal(arma::mat(kf.P()), P_pred, "both", KALMAN_TEST_TOLERANCE, KALMAN_TEST_TOLERANCE));
+
+            ASSERT_TRUE(kf.update(Kf::Measurement(z), Kf::Measurement_Matrix(H), Kf::Measurement_Covariance(R)));
+
+            const arma::mat K = P_pred * H.t() * arma::inv(H * P_pred * H.t() + R);
+            const arma::vec x_est = x_pred + K * z;
+            const arma::mat P_est = (arma::eye(4, 4) - K * H) * P_pred;
+            EXPECT_TRUE(arma::approx_equal(arma::mat(kf.K()), K, "both", KALMAN_TEST_TOLERANCE, KALMAN_TEST_TOLERANCE));
+            EXPECT_TRUE(arma::approx_equal(arma::vec(kf.x()), x_est, "both", KALMAN_TEST_TOLERANCE, KALMAN_TEST_TOLERANCE));
+            EXPECT_TRUE(arma::approx_equal(arma::mat(kf.P()), P_est, "both", KALMAN_TEST_TOLERANCE, KALMAN_TEST_TOLERANCE));
+            // Joseph form keeps the covariance symmetric
+            EXPECT_TRUE(kf.P().is_symmetric());
+        }
+}
+
+
+TEST(KalmanFilterComputationTest, GainWithDynamicMatrices)
+{
+    for (int k = 0; k < KALMAN_TEST_N_TRIALS; k++)
+        {
+            const arma::uword nx = 1 + k % 6;
+            const arma::uword nz = 1 + k % 4;
+            const arma::mat A = arma::randu<arma::mat>(nz, nz);
+            const arma::mat S = A * A.t() + arma::eye(nz, nz);
+            const arma::mat P_xz = arma::randn<arma::mat>(nx, nz);
+            arma::mat L(nz, nz);
+            arma::mat K(nx, nz);
+            ASSERT_TRUE(kalman_gain(P_xz, S, L, K));
+            EXPECT_TRUE(arma::approx_equal(K, P_xz * arma::inv(S), "absdiff", KALMAN_TEST_TOLERANCE));
+        }
+}
+
+
+TEST(KalmanFilterComputationTest, RejectsIndefiniteInnovationCovariance)
+{
+    using Kf = Kalman_Filter<2, 1>;
+    Kf kf;
+    kf.x() = {1.0, 2.0};
+    kf.P().zeros();
+    Kf::Measurement z;
+    z.at(0) = 1.0;
+    Kf::Measurement_Matrix H;
+    H.ones();
+    Kf::Measurement_Covariance R;
+    R.at(0, 0) = -1.0;
+    EXPECT_FALSE(kf.update(z, H, R));
+    EXPECT_DOUBLE_EQ(kf.x().at(0), 1.0);
+    EXPECT_DOUBLE_EQ(kf.x().at(1), 2.0);
+}
@@ -0,0 +1,155 @@
+/*!
+ * \file lock_detectors_test.cc
+ * \brief  This file implements tests for the CN0 estimators and the carrier
+ * lock detector
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "lock_detectors.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Scalar implementations used as reference for the vectorized estimators
+float cn0_svn_reference(const std::vector<gr_complex>& prompt, float coh_integration_time_s)
+{
+    double Psig = 0.0;
+    double Ptot = 0.0;
+    for (const auto& p : prompt)
+        {
+            Psig += std::abs(p.real());
+            Ptot += static_cast<double>(std::norm(p));
+        }
+    Psig /= static_cast<double>(prompt.size());
+    Psig = Psig * Psig;
+    Ptot /= static_cast<double>(prompt.size());
+    return static_cast<float>(10.0 * std::log10(Psig / (Ptot - Psig)) - 10.0 * std::log10(coh_integration_time_s));
+}
+
+
+float cn0_m2m4_reference(const std::vector<gr_complex>& prompt, float coh_integration_time_s)
+{
+    double Psig = 0.0;
+    double m_2 = 0.0;
+    double m_4 = 0.0;
+    for (const auto& p : prompt)
+        {
+            const double aux = std::norm(p);
+            Psig += std::abs(p.real());
+            m_2 += aux;
+            m_4 += aux * aux;
+        }
+    const auto n = static_cast<double>(prompt.size());
+    Psig /= n;
+    Psig = Psig * Psig;
+    m_2 /= n;
+    m_4 /= n;
+    const double aux = std::sqrt(2.0 * m_2 * m_2 - m_4);
+    const double snr = std::isnan(aux) ? Psig / (m_2 - Psig) : aux / (m_2 - aux);
+    return static_cast<float>(10.0 * std::log10(snr) - 10.0 * std::log10(coh_integration_time_s));
+}
+
+
+float carrier_lock_reference(const std::vector<gr_complex>& prompt)
+{
+    double sum_I = 0.0;
+    double sum_Q = 0.0;
+    for (const auto& p : prompt)
+        {
+            sum_I += p.real();
+            sum_Q += p.imag();
+        }
+    return static_cast<float>((sum_I * sum_I - sum_Q * sum_Q) / (sum_I * sum_I + sum_Q * sum_Q));
+}
+
+
+// Prompt correlator outputs with navigation bits, a carrier phase error and
+// white Gaussian noise
+std::vector<gr_complex> prompt_history(int length, float amplitude, float phase_rad, float noise_sigma, unsigned int seed)
+{
+    std::mt19937 gen(seed);
+    std::normal_distribution<float> noise(0.0, noise_sigma);
+    std::bernoulli_distribution bit(0.5);
+    std::vector<gr_complex> prompt(length);
+    const gr_complex carrier = std::polar(amplitude, phase_rad);
+    for (auto& p : prompt)
+        {
+            p = (bit(gen) ? carrier : -carrier) + gr_complex(noise(gen), noise(gen));
+        }
+    return prompt;
+}
+}  // namespace
+
+
+TEST(LockDetectorsTest, Cn0EstimatorsMatchScalarReference)
+{
+    const float coh_integration_time_s = 0.001;
+    for (int length : {1, 3, 4, 7, 8, 20, 33, 100, 1000})
+        {
+            for (float noise_sigma : {0.1F, 0.5F, 1.0F})
+                {
+                    const auto prompt = prompt_history(length, 1.0, 0.3, noise_sigma, 1234U + length);
+                    const float svn = cn0_svn_estimator(prompt.data(), length, coh_integration_time_s);
+                    const float m2m4 = cn0_m2m4_estimator(prompt.data(), length, coh_integration_time_s);
+                    const float svn_ref = cn0_svn_reference(prompt, coh_integration_time_s);
+                    const float m2m4_ref = cn0_m2m4_reference(prompt, coh_integration_time_s);
+                    if (std::isfinite(svn_ref))
+                        {
+                            EXPECT_NEAR(svn, svn_ref, 1e-2) << "length: " << length << " sigma: " << noise_sigma;
+                        }
+                    if (std::isfinite(m2m4_ref))
+                        {
+                            EXPECT_NEAR(m2m4, m2m4_ref, 1e-2) << "length: " << length << " sigma: " << noise_sigma;
+                        }
+                }
+        }
+}
+
+
+TEST(LockDetectorsTest, Cn0EstimatorsAccuracy)
+{
+    // A^2 / (2 * sigma^2) = 100 -> 20 dB + 30 dB-Hz for 1 ms integration
+    const float coh_integration_time_s = 0.001;
+    const float noise_sigma = 0.1 / std::sqrt(2.0);
+    const int length = 20000;
+    const auto prompt = prompt_history(length, 1.0, 0.0, noise_sigma, 42U);
+    EXPECT_NEAR(cn0_svn_estimator(prompt.data(), length, coh_integration_time_s), 50.0, 0.5);
+    EXPECT_NEAR(cn0_m2m4_estimator(prompt.data(), length, coh_integration_time_s), 50.0, 0.5);
+}
+
+
+TEST(LockDetectorsTest, CarrierLockDetector)
+{
+    for (int length : {1, 5, 20, 64})
+        {
+            std::vector<gr_complex> prompt(length, gr_complex(1.0, 0.0));
+            EXPECT_FLOAT_EQ(carrier_lock_detector(prompt.data(), length), 1.0);
+            std::fill(prompt.begin(), prompt.end(), gr_complex(0.0, 2.0));
+            EXPECT_FLOAT_EQ(carrier_lock_detector(prompt.data(), length), -1.0);
+        }
+    for (float phase_rad : {0.0F, 0.2F, 0.7F, 1.3F})
+        {
+            const int length = 20;
+            auto prompt = prompt_history(length, 1.0, phase_rad, 0.05, 7U);
+            for (auto& p : prompt)
+                {
+                    // remove the navigation bits
+                    p = (std::real(p * std::polar(1.0F, -phase_rad)) < 0.0F) ? -p : p;
+                }
+            EXPECT_NEAR(carrier_lock_detector(prompt.data(), length), carrier_lock_reference(prompt), 1e-5);
+            EXPECT_NEAR(carrier_lock_detector(prompt.data(), length), std::cos(2.0F * phase_rad), 0.05);
+        }
+}
@@ -0,0 +1,156 @@
+/*!
+ * \file tracking_aligned_epochs_test.cc
+ * \brief  This file implements a test of the DLL/PLL tracking block with
+ * Tracking_XX.aligned_integration_epochs enabled
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "Galileo_E1.h"
+#include "dll_pll_conf.h"
+#include "dll_pll_veml_tracking.h"
+#include "galileo_e1_signal_replica.h"
+#include "gnss_synchro.h"
+#include "tracking_dump_records.h"
+#include <gnuradio/blocks/head.h>
+#include <gnuradio/blocks/null_sink.h>
+#include <gnuradio/gr_complex.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef GR_GREATER_38
+#include <gnuradio/blocks/vector_source.h>
+#else
+#include <gnuradio/blocks/vector_source_c.h>
+#endif
+
+
+namespace
+{
+constexpr int32_t FS_IN = 4092000;
+constexpr uint32_t SAMPLES_PER_CODE = 16368;  // 4 ms
+constexpr int32_t EXTEND_SYMBOLS = 5;         // 20 ms integrations
+constexpr uint64_t GRID_PERIOD_SAMPLES = EXTEND_SYMBOLS * SAMPLES_PER_CODE;
+const std::string DUMP_FILENAME = "./aligned_epochs_trk_";
+
+
+// Sample stamps of the loop updates written by the tracking block of channel
+std::vector<uint64_t> loop_update_samples(uint32_t channel)
+{
+    const std::string filename = DUMP_FILENAME + std::to_string(channel) + ".dat";
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint64_t> updates;
+    Dll_Pll_Veml_Dump_Record record{};
+    while (file.read(reinterpret_cast<char*>(&record), sizeof(record)))
+        {
+            const uint64_t sample = record.loop_update_sample_count;
+            if (sample != 0 && (updates.empty() || updates.back() != sample))
+                {
+                    updates.push_back(sample);
+                }
+        }
+    file.close();
+    std::remove(filename.c_str());
+    return updates;
+}
+}  // namespace
+
+
+TEST(TrackingAlignedEpochsTest, GalileoE1PilotChannels)
+{
+    // Two Galileo E1 satellites at different code phases, one secondary code
+    // period (100 ms) of signal repeated with fixed noise
+    const std::array<uint32_t, 2> prns{11, 19};
+    const std::array<uint32_t, 2> delays_samples{3001, 10001};
+    const uint32_t period_samples = SAMPLES_PER_CODE * GALILEO_E1_C_SECONDARY_CODE_LENGTH;
+    std::vector<gr_complex> signal(period_samples);
+    std::mt19937 generator(1234);
+    std::normal_distribution<float> noise(0.0, 1.0);
+    for (auto& sample : signal)
+        {
+            sample = gr_complex(noise(generator), noise(generator));
+        }
+    for (size_t sat = 0; sat < prns.size(); sat++)
+        {
+            std::vector<float> data(SAMPLES_PER_CODE);
+            std::vector<float> pilot(period_samples);
+            galileo_e1_code_gen_float_sampled(data, {'1', 'B', '\0'}, false, prns[sat], FS_IN, 0, false);
+            galileo_e1_code_gen_float_sampled(pilot, {'1', 'C', '\0'}, false, prns[sat], FS_IN, 0, true);
+            for (uint32_t n = 0; n < period_samples; n++)
+                {
+                    // E1-B and E1-C are in anti-phase
+                    signal[(n + delays_samples[sat]) % period_samples] += (data[n % SAMPLES_PER_CODE] - pilot[n]) / static_cast<float>(std::sqrt(2.0));
+                }
+        }
+
+    Dll_Pll_Conf trk_params;
+    trk_params.fs_in = FS_IN;
+    trk_params.vector_length = SAMPLES_PER_CODE;
+    trk_params.system = 'E';
+    trk_params.signal[0] = '1';
+    trk_params.signal[1] = 'B';
+    trk_params.track_pilot = true;
+    trk_params.extend_correlation_symbols = EXTEND_SYMBOLS;
+    trk_params.aligned_integration_epochs = true;
+    trk_params.pull_in_time_s = 0;
+    trk_params.dump = true;
+    trk_params.dump_mat = false;
+    trk_params.dump_filename = DUMP_FILENAME;
+
+    std::array<Gnss_Synchro, 2> gnss_synchro{};
+    {
+        auto top_block = gr::make_top_block("Aligned epochs test");
+        auto source = gr::blocks::vector_source_c::make(signal, true);
+        auto head = gr::blocks::head::make(sizeof(gr_complex), 750 * static_cast<uint64_t>(SAMPLES_PER_CODE));  // 3 s
+        top_block->connect(source, 0, head, 0);
+        std::vector<dll_pll_veml_tracking_sptr> channels;
+        for (uint32_t ch = 0; ch < prns.size(); ch++)
+            {
+                channels.push_back(dll_pll_veml_make_tracking(trk_params));
+                top_block->connect(head, 0, channels.back(), 0);
+                top_block->connect(channels.back(), 0, gr::blocks::null_sink::make(sizeof(Gnss_Synchro)), 0);
+                gnss_synchro[ch].System = 'E';
+                gnss_synchro[ch].Signal[0] = '1';
+                gnss_synchro[ch].Signal[1] = 'B';
+                gnss_synchro[ch].PRN = prns[ch];
+                gnss_synchro[ch].Acq_delay_samples = delays_samples[ch];
+                gnss_synchro[ch].Acq_doppler_hz = 0.0;
+                gnss_synchro[ch].Acq_samplestamp_samples = 0;
+                channels.back()->set_channel(ch);
+                channels.back()->set_gnss_synchro(&gnss_synchro[ch]);
+                channels.back()->start_tracking();
+            }
+        top_block->run();
+    }  // the dump files are closed with the blocks
+
+    for (uint32_t ch = 0; ch < prns.size(); ch++)
+        {
+            const std::vector<uint64_t> updates = loop_update_samples(ch);
+            ASSERT_GT(updates.size(), 20U) << "Channel " << ch << " did not reach the extended integration";
+            // the last integrations last EXTEND_SYMBOLS code periods and end
+            // within half a code period of the grid shared by all the channels
+            for (size_t i = updates.size() - 20; i < updates.size(); i++)
+                {
+                    const uint64_t phase = updates[i] % GRID_PERIOD_SAMPLES;
+                    EXPECT_LE(std::min(phase, GRID_PERIOD_SAMPLES - phase), SAMPLES_PER_CODE / 2) << "Channel " << ch << ", loop update at sample " << updates[i];
+                    EXPECT_NEAR(static_cast<double>(updates[i] - updates[i - 1]), static_cast<double>(GRID_PERIOD_SAMPLES), SAMPLES_PER_CODE / 2.0) << "Channel " << ch;
+                }
+        }
+}
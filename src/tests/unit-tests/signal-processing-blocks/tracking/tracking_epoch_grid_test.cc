@@ -0,0 +1,75 @@
+/*!
+ * \file tracking_epoch_grid_test.cc
+ * \brief  This file implements tests for the alignment of the extended
+ * coherent integrations to the tracking epoch grid
+ *
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "tracking_epoch_grid.h"
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+
+
+TEST(TrackingEpochGridTest, NoExtendedIntegration)
+{
+    EXPECT_EQ(aligned_integration_symbols(12345ULL, 4000.0, 1), 1);
+    EXPECT_EQ(aligned_integration_symbols(12345ULL, 4000.0, 0), 1);
+    EXPECT_EQ(aligned_integration_symbols(12345ULL, 0.0, 20), 1);
+}
+
+
+TEST(TrackingEpochGridTest, AlignedStart)
+{
+    const double code_period_samples = 4000.0;  // 1 ms at 4 Msps
+    EXPECT_EQ(aligned_integration_symbols(0ULL, code_period_samples, 20), 20);
+    EXPECT_EQ(aligned_integration_symbols(80000ULL, code_period_samples, 20), 20);
+    EXPECT_EQ(aligned_integration_symbols(80001ULL, code_period_samples, 20), 20);
+    EXPECT_EQ(aligned_integration_symbols(79999ULL, code_period_samples, 20), 20);
+    EXPECT_EQ(aligned_integration_symbols(4000ULL, code_period_samples, 20), 19);
+    EXPECT_EQ(aligned_integration_symbols(76000ULL, code_period_samples, 20), 1);
+}
+
+
+TEST(TrackingEpochGridTest, ChannelsConvergeToTheGrid)
+{
+    // Channels start at arbitrary code phases and their code periods drift
+    // with the Doppler; the ends of their integrations stay within half a
+    // code period of the shared grid after the first one
+    const int32_t extend_symbols = 20;
+    const double nominal_code_period_samples = 4000.0;
+    const double grid_period_samples = nominal_code_period_samples * extend_symbols;
+    for (double doppler_ratio : {-3e-6, 0.0, 1e-6, 4e-6})
+        {
+            for (uint64_t first_sample : {0ULL, 1234ULL, 39999ULL, 77777ULL, 123456789ULL})
+                {
+                    const double code_period_samples = nominal_code_period_samples * (1.0 + doppler_ratio);
+                    double start_sample = static_cast<double>(first_sample);
+                    int shortened_integrations = 0;
+                    for (int n = 0; n < 5000; n++)
+                        {
+                            const int32_t symbols = aligned_integration_symbols(static_cast<uint64_t>(std::round(start_sample)), nominal_code_period_samples, extend_symbols);
+                            ASSERT_GE(symbols, 1);
+                            ASSERT_LE(symbols, extend_symbols);
+                            if (symbols < extend_symbols)
+                                {
+                                    shortened_integrations++;
+                                }
+                            start_sample += symbols * code_period_samples;
+                            const double grid_error = std::remainder(start_sample, grid_period_samples);
+                            EXPECT_LE(std::abs(grid_error), nominal_code_period_samples / 2.0 + 1.0);
+                        }
+                    EXPECT_LE(shortened_integrations, 3);
+                }
+        }
+}
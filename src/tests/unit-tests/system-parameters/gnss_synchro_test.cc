@@ -0,0 +1,54 @@
+/*!
+ * \file gnss_synchro_test.cc
+ * \brief This file implements unit tests for the layout of the Gnss_Synchro
+ * stream item.
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * GNSS-SDR is a Global Navigation Satellite System software-defined receiver.
+ * This file is part of GNSS-SDR.
+ *
+ * Copyright (C) 2010-2022  (see AUTHORS file for a list of contributors)
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ * -----------------------------------------------------------------------------
+ */
+
+#include "gnss_synchro.h"
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+
+TEST(GnssSynchroTest, TriviallyCopyable)
+{
+    EXPECT_TRUE(std::is_trivially_copyable<Gnss_Synchro>::value);
+
+    // The fields used from tracking to PVT fit in two cache lines
+    EXPECT_LE(offsetof(Gnss_Synchro, Flag_PLL_180_deg_phase_locked), 127U);
+    EXPECT_LE(sizeof(Gnss_Synchro), 152U);
+
+    std::vector<Gnss_Synchro> in(8);
+    for (size_t i = 0; i < in.size(); i++)
+        {
+            in[i].System = 'G';
+            in[i].Signal[0] = '1';
+            in[i].Signal[1] = 'C';
+            in[i].PRN = static_cast<uint32_t>(i + 1);
+            in[i].Pseudorange_m = 2.0e7 + static_cast<double>(i);
+            in[i].Acq_doppler_hz = -1250.0;
+            in[i].Flag_valid_pseudorange = true;
+        }
+    std::vector<Gnss_Synchro> out(in.size());
+    std::memcpy(out.data(), in.data(), in.size() * sizeof(Gnss_Synchro));
+    for (size_t i = 0; i < in.size(); i++)
+        {
+            EXPECT_EQ(out[i].PRN, in[i].PRN);
+            EXPECT_EQ(out[i].Signal[1], 'C');
+            EXPECT_DOUBLE_EQ(out[i].Pseudorange_m, in[i].Pseudorange_m);
+            EXPECT_DOUBLE_EQ(out[i].Acq_doppler_hz, -1250.0);
+            EXPECT_TRUE(out[i].Flag_valid_pseudorange);
+        }
+}